@@ -0,0 +1,124 @@
+// Benchmark: find() one key at a time vs findMany() for the same batches
+// Usage: batch_lookup_benchmark [entries]
+// The default size keeps every map well above a typical last-level cache.
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include "benchmark_utils.hpp"
+#include "core/btree_map.hpp"
+#include "core/flat_map.hpp"
+#include "core/hash_map.hpp"
+#include "core/map.hpp"
+
+using namespace cpp_ex::benchmark;
+
+constexpr std::size_t kBatchSize = 128;
+
+template <typename MapType>
+void runSuite(const std::string &label, MapType &map, const cpp_ex::Vector<std::uint64_t> &queries)
+{
+    std::size_t n = queries.getSize();
+    cpp_ex::Vector<cpp_ex::Vector<std::uint64_t>> batches;
+    for (std::size_t first = 0; first < n; first += kBatchSize)
+    {
+        cpp_ex::Vector<std::uint64_t> batch;
+        for (std::size_t i = first; i < n && i < first + kBatchSize; ++i)
+        {
+            batch.pushBack(queries[i]);
+        }
+        batches.pushBack(std::move(batch));
+    }
+
+    measure(label + " find (one by one)", n, [&]
+            {
+                std::uint64_t sum = 0;
+                for (const auto &batch : batches)
+                {
+                    for (const auto &key : batch)
+                    {
+                        auto it = map.find(key);
+                        sum += it != map.end() ? it->second : 0;
+                    }
+                }
+                doNotOptimize(sum); });
+
+    measure(label + " findMany", n, [&]
+            {
+                std::uint64_t sum = 0;
+                cpp_ex::Vector<typename MapType::iterator> results;
+                for (const auto &batch : batches)
+                {
+                    map.findMany(batch, results);
+                    for (const auto &it : results)
+                    {
+                        sum += it != map.end() ? it->second : 0;
+                    }
+                }
+                doNotOptimize(sum); });
+
+    measure(label + " containsMany", n, [&]
+            {
+                std::size_t found = 0;
+                cpp_ex::Vector<bool> flags;
+                for (const auto &batch : batches)
+                {
+                    found += map.containsMany(batch, flags);
+                }
+                doNotOptimize(found); });
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t n = sizeArgument(argc, argv, 4000000);
+    Random random;
+
+    cpp_ex::Vector<std::uint64_t> keys;
+    cpp_ex::Vector<std::uint64_t> queries;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        keys.pushBack(random.next());
+    }
+    // Mitad aciertos, mitad fallos, en orden aleatorio
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        auto value = random.next();
+        queries.pushBack((value & 1) ? keys[value % n] : value);
+    }
+
+    std::cout << "entries: " << n << ", batch: " << kBatchSize << std::endl;
+    {
+        cpp_ex::HashMap<std::uint64_t, std::uint64_t> map;
+        map.reserve(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            map[keys[i]] = i;
+        }
+        runSuite("HashMap", map, queries);
+    }
+    {
+        cpp_ex::Vector<std::uint64_t> sorted = keys;
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+        cpp_ex::Vector<std::uint64_t> values(sorted.getSize(), 1);
+        auto map = cpp_ex::FlatMap<std::uint64_t, std::uint64_t>::fromSorted(std::move(sorted), std::move(values));
+        runSuite("FlatMap", map, queries);
+    }
+    {
+        cpp_ex::BTreeMap<std::uint64_t, std::uint64_t> map;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            map[keys[i]] = i;
+        }
+        runSuite("BTreeMap", map, queries);
+    }
+    {
+        cpp_ex::Map<std::uint64_t, std::uint64_t> map;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            map[keys[i]] = i;
+        }
+        runSuite("Map", map, queries);
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file benchmark_utils.hpp
+ * @brief Minimal timing helpers shared by the cpp_ex benchmarks
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_BENCHMARK_UTILS_HPP
+#define CPPEX_BENCHMARK_UTILS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace cpp_ex
+{
+    namespace benchmark
+    {
+
+        // Evita que el compilador elimine un resultado que no se usa
+        template <typename T>
+        inline void doNotOptimize(const T &value)
+        {
+            asm volatile("" : : "r,m"(value) : "memory");
+        }
+
+        // Lee el tamaño del problema del primer argumento (o usa el valor por defecto)
+        inline std::size_t sizeArgument(int argc, char **argv, std::size_t defaultSize)
+        {
+            if (argc > 1)
+            {
+                return static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));
+            }
+            return defaultSize;
+        }
+
+        // Pseudo-random generator (splitmix64), deterministic between runs
+        class Random
+        {
+        private:
+            std::uint64_t state;
+
+        public:
+            explicit Random(std::uint64_t seed = 0x9E3779B97F4A7C15ULL) : state(seed) {}
+
+            std::uint64_t next()
+            {
+                std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                return z ^ (z >> 31);
+            }
+        };
+
+        /**
+         * @brief Runs func once and prints the elapsed time and the time per operation
+         *
+         * @param name Label printed in the report
+         * @param operations Number of operations performed by func (for ns/op)
+         * @param func Callable to time
+         * @return Elapsed nanoseconds
+         */
+        template <typename Func>
+        double measure(const std::string &name, std::size_t operations, Func func)
+        {
+            auto start = std::chrono::steady_clock::now();
+            func();
+            auto stop = std::chrono::steady_clock::now();
+            double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+
+            std::cout << std::left << std::setw(48) << name
+                      << std::right << std::setw(12) << std::fixed << std::setprecision(2) << ns / 1e6 << " ms"
+                      << std::setw(12) << std::setprecision(2) << (operations ? ns / static_cast<double>(operations) : 0.0) << " ns/op"
+                      << std::endl;
+            return ns;
+        }
+
+    } // namespace benchmark
+} // namespace cpp_ex
+
+#endif // CPPEX_BENCHMARK_UTILS_HPP
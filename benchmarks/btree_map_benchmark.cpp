@@ -0,0 +1,107 @@
+// Benchmark: cpp_ex::BTreeMap vs cpp_ex::Map (std::map)
+// Usage: btree_map_benchmark [entries]
+
+#include <cstdint>
+#include <string>
+#include "benchmark_utils.hpp"
+#include "core/btree_map.hpp"
+#include "core/map.hpp"
+
+using namespace cpp_ex::benchmark;
+
+// Tamaño estimado de un nodo de std::map (libstdc++): cabecera del árbol rojo-negro + par
+template <typename Key, typename Value>
+std::size_t estimateStdMapBytes(std::size_t entries)
+{
+    return entries * (32 + sizeof(std::pair<const Key, Value>));
+}
+
+template <typename MapType>
+void runSuite(const std::string &label, const cpp_ex::Vector<std::int64_t> &keys)
+{
+    MapType map;
+    std::size_t n = keys.getSize();
+    constexpr std::size_t kScanLength = 100;
+
+    measure(label + " random insert", n, [&]
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    map[keys[i]] = i;
+                } });
+
+    measure(label + " find (hit)", n, [&]
+            {
+                std::size_t sum = 0;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    sum += map.find(keys[i])->second;
+                }
+                doNotOptimize(sum); });
+
+    std::size_t scans = n / 10;
+    measure(label + " range scan (100 entries)", scans, [&]
+            {
+                std::size_t sum = 0;
+                for (std::size_t i = 0; i < scans; ++i)
+                {
+                    auto it = map.lowerBound(keys[i]);
+                    for (std::size_t step = 0; step < kScanLength && it != map.end(); ++step, ++it)
+                    {
+                        sum += it->second;
+                    }
+                }
+                doNotOptimize(sum); });
+
+    measure(label + " iterate", n, [&]
+            {
+                std::size_t sum = 0;
+                for (auto it = map.begin(); it != map.end(); ++it)
+                {
+                    sum += it->second;
+                }
+                doNotOptimize(sum); });
+
+    measure(label + " erase", n, [&]
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    map.erase(keys[i]);
+                } });
+
+    measure(label + " sorted load (end hint)", n, [&]
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    map.emplaceHint(map.end(), static_cast<std::int64_t>(i), i);
+                } });
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t n = sizeArgument(argc, argv, 1000000);
+    Random random;
+
+    cpp_ex::Vector<std::int64_t> keys;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        keys.pushBack(static_cast<std::int64_t>(random.next() >> 1));
+    }
+
+    std::cout << "entries: " << n << std::endl;
+    runSuite<cpp_ex::BTreeMap<std::int64_t, std::size_t>>("BTreeMap<int64>", keys);
+    runSuite<cpp_ex::Map<std::int64_t, std::size_t>>("Map<int64>", keys);
+
+    cpp_ex::BTreeMap<std::int64_t, std::size_t> random_tree;
+    cpp_ex::BTreeMap<std::int64_t, std::size_t> sorted_tree;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        random_tree[keys[i]] = i;
+        sorted_tree.emplaceHint(sorted_tree.end(), static_cast<std::int64_t>(i), i);
+    }
+    std::cout << "memory BTreeMap (random inserts): " << random_tree.getMemoryUsage() << " bytes, height " << random_tree.getHeight() << std::endl;
+    std::cout << "memory BTreeMap (sorted load):    " << sorted_tree.getMemoryUsage() << " bytes, height " << sorted_tree.getHeight() << std::endl;
+    std::cout << "memory std::map (estimated):      " << estimateStdMapBytes<std::int64_t, std::size_t>(n) << " bytes" << std::endl;
+
+    return 0;
+}
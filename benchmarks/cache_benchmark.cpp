@@ -0,0 +1,149 @@
+// Benchmark: replay of a synthetic Zipfian trace against the cache policies
+// Compares LruCache, LfuCache, ArcCache and ShardedCache with the usual
+// hand-written LRU (cpp_ex::Map + std::list).
+// Usage: cache_benchmark [requests]
+
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <string>
+#include "benchmark_utils.hpp"
+#include "core/cache.hpp"
+#include "core/map.hpp"
+
+using namespace cpp_ex::benchmark;
+
+constexpr std::size_t kKeySpace = 1 << 20;
+constexpr std::size_t kCapacity = kKeySpace / 100;
+
+// Muestreo Zipf por la inversa de la CDF (tabla acumulada + búsqueda binaria)
+class ZipfGenerator
+{
+private:
+    cpp_ex::Vector<double> cdf;
+    Random random;
+
+public:
+    ZipfGenerator(std::size_t n, double skew)
+    {
+        cdf.reserve(n);
+        double sum = 0;
+        for (std::size_t i = 1; i <= n; ++i)
+        {
+            sum += 1.0 / std::pow(static_cast<double>(i), skew);
+            cdf.pushBack(sum);
+        }
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            cdf[i] /= sum;
+        }
+    }
+
+    std::uint64_t next()
+    {
+        double u = static_cast<double>(random.next() >> 11) * 0x1.0p-53;
+        auto rank = std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin();
+        // Dispersa los rangos para que las claves calientes no sean consecutivas
+        return (static_cast<std::uint64_t>(rank) * 0x9E3779B97F4A7C15ULL) % kKeySpace;
+    }
+};
+
+// LRU escrito a mano como en los servicios: Map + std::list
+class MapListLru
+{
+private:
+    std::size_t capacity;
+    std::list<std::pair<std::uint64_t, std::uint64_t>> recency;
+    cpp_ex::Map<std::uint64_t, std::list<std::pair<std::uint64_t, std::uint64_t>>::iterator> index;
+    cpp_ex::CacheStats stats;
+
+public:
+    explicit MapListLru(std::size_t capacity) : capacity(capacity) {}
+
+    std::uint64_t *find(std::uint64_t key)
+    {
+        auto it = index.find(key);
+        if (it == index.end())
+        {
+            ++stats.misses;
+            return nullptr;
+        }
+        ++stats.hits;
+        recency.splice(recency.begin(), recency, it->second);
+        return &it->second->second;
+    }
+
+    void put(std::uint64_t key, std::uint64_t value)
+    {
+        if (recency.size() == capacity)
+        {
+            index.erase(recency.back().first);
+            recency.pop_back();
+        }
+        recency.emplace_front(key, value);
+        index[key] = recency.begin();
+    }
+
+    const cpp_ex::CacheStats &getStats() const
+    {
+        return stats;
+    }
+};
+
+template <typename CacheType>
+void replay(const std::string &label, CacheType &cache, const cpp_ex::Vector<std::uint64_t> &trace)
+{
+    measure(label, trace.getSize(), [&]
+            {
+                for (auto key : trace)
+                {
+                    if (cache.find(key) == nullptr)
+                    {
+                        cache.put(key, key);
+                    }
+                } });
+    std::cout << "    hit ratio: " << std::setprecision(4) << cache.getStats().getHitRatio() * 100 << " %" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t requests = sizeArgument(argc, argv, 5000000);
+
+    for (double skew : {0.8, 0.99})
+    {
+        ZipfGenerator zipf(kKeySpace, skew);
+        cpp_ex::Vector<std::uint64_t> trace;
+        trace.reserve(requests);
+        for (std::size_t i = 0; i < requests; ++i)
+        {
+            trace.pushBack(zipf.next());
+        }
+
+        std::cout << "requests: " << requests << ", keys: " << kKeySpace << ", capacity: " << kCapacity
+                  << ", zipf skew: " << skew << std::endl;
+
+        MapListLru baseline(kCapacity);
+        replay("Map + std::list LRU", baseline, trace);
+
+        cpp_ex::LruCache<std::uint64_t, std::uint64_t> lru(kCapacity);
+        replay("LruCache", lru, trace);
+
+        cpp_ex::LfuCache<std::uint64_t, std::uint64_t> lfu(kCapacity);
+        replay("LfuCache", lfu, trace);
+
+        cpp_ex::ArcCache<std::uint64_t, std::uint64_t> arc(kCapacity);
+        replay("ArcCache", arc, trace);
+
+        cpp_ex::ShardedCache<cpp_ex::LruCache<std::uint64_t, std::uint64_t>> sharded(kCapacity, 16);
+        measure("ShardedCache<LruCache> (1 thread)", trace.getSize(), [&]
+                {
+                    for (auto key : trace)
+                    {
+                        sharded.getOrLoad(key, [](std::uint64_t k)
+                                          { return k; });
+                    } });
+        std::cout << "    hit ratio: " << std::setprecision(4) << sharded.getStats().getHitRatio() * 100 << " %" << std::endl;
+    }
+
+    return 0;
+}
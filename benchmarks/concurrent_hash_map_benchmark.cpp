@@ -0,0 +1,95 @@
+// Benchmark: cpp_ex::ConcurrentHashMap vs cpp_ex::Map behind one global mutex
+// Sweeps the read percentage and the number of threads.
+// Usage: concurrent_hash_map_benchmark [operations per thread]
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "benchmark_utils.hpp"
+#include "core/concurrent_hash_map.hpp"
+#include "core/map.hpp"
+
+using namespace cpp_ex::benchmark;
+
+constexpr std::uint64_t kKeySpace = 1 << 16;
+
+// Map con un único mutex global: la situación actual de los servicios
+class GlobalLockMap
+{
+private:
+    std::mutex mutex;
+    cpp_ex::Map<std::uint64_t, std::uint64_t> map;
+
+public:
+    void insertOrAssign(std::uint64_t key, std::uint64_t value)
+    {
+        std::lock_guard lock(mutex);
+        map[key] = value;
+    }
+
+    bool contains(std::uint64_t key)
+    {
+        std::lock_guard lock(mutex);
+        return map.contains(key);
+    }
+};
+
+template <typename MapType>
+void runMix(const std::string &label, MapType &map, std::size_t threadCount, unsigned readPercent, std::size_t operations)
+{
+    measure(label + " " + std::to_string(readPercent) + "% reads, " + std::to_string(threadCount) + " threads",
+            operations * threadCount, [&]
+            {
+                std::vector<std::thread> threads;
+                for (std::size_t t = 0; t < threadCount; ++t)
+                {
+                    threads.emplace_back([&map, readPercent, operations, t]
+                                         {
+                                             Random random(t + 1);
+                                             std::size_t hits = 0;
+                                             for (std::size_t i = 0; i < operations; ++i)
+                                             {
+                                                 auto value = random.next();
+                                                 auto key = value % kKeySpace;
+                                                 if ((value >> 32) % 100 < readPercent)
+                                                 {
+                                                     hits += map.contains(key);
+                                                 }
+                                                 else
+                                                 {
+                                                     map.insertOrAssign(key, value);
+                                                 }
+                                             }
+                                             doNotOptimize(hits); });
+                }
+                for (auto &thread : threads)
+                {
+                    thread.join();
+                } });
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t operations = sizeArgument(argc, argv, 1000000);
+    std::size_t maxThreads = std::max(8u, std::thread::hardware_concurrency());
+
+    std::cout << "operations per thread: " << operations << ", keys: " << kKeySpace << std::endl;
+    for (unsigned readPercent : {50u, 90u, 99u})
+    {
+        for (std::size_t threads = 1; threads <= maxThreads; threads *= 2)
+        {
+            cpp_ex::ConcurrentHashMap<std::uint64_t, std::uint64_t> concurrent;
+            GlobalLockMap global;
+            for (std::uint64_t key = 0; key < kKeySpace; key += 2)
+            {
+                concurrent.insertOrAssign(key, key);
+                global.insertOrAssign(key, key);
+            }
+            runMix("ConcurrentHashMap", concurrent, threads, readPercent, operations);
+            runMix("Map + global mutex", global, threads, readPercent, operations);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,129 @@
+// Benchmark: counting keys with cpp_ex::Counter and cpp_ex::ConcurrentCounter
+// Single thread: the contains() + operator[] idiom on a Map against Counter with Map
+// and HashMap backends. Several threads: a HashMap behind one mutex and
+// ConcurrentHashMap::upsert() against ConcurrentCounter.
+// Usage: counter_benchmark [increments per thread]
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "benchmark_utils.hpp"
+#include "core/concurrent_hash_map.hpp"
+#include "core/counter.hpp"
+#include "core/hash_map.hpp"
+#include "core/map.hpp"
+
+using namespace cpp_ex::benchmark;
+
+constexpr std::uint64_t kKeySpace = 1 << 12;
+
+// HashMap con un único mutex global
+class GlobalLockCounter
+{
+private:
+    std::mutex mutex;
+    cpp_ex::HashMap<std::uint64_t, std::int64_t> counts;
+
+public:
+    void increment(std::uint64_t key)
+    {
+        std::lock_guard lock(mutex);
+        ++counts[key];
+    }
+};
+
+class UpsertCounter
+{
+private:
+    cpp_ex::ConcurrentHashMap<std::uint64_t, std::int64_t> counts;
+
+public:
+    void increment(std::uint64_t key)
+    {
+        counts.upsert(key, 1, [](std::int64_t &count)
+                      { ++count; });
+    }
+};
+
+template <typename CounterType>
+void runThreads(const std::string &label, std::size_t threadCount, std::size_t increments)
+{
+    CounterType counter;
+    measure(label + ", " + std::to_string(threadCount) + " threads", increments * threadCount, [&]
+            {
+                std::vector<std::thread> threads;
+                for (std::size_t t = 0; t < threadCount; ++t)
+                {
+                    threads.emplace_back([&counter, increments, t]
+                                         {
+                                             Random random(t + 1);
+                                             for (std::size_t i = 0; i < increments; ++i)
+                                             {
+                                                 counter.increment(random.next() % kKeySpace);
+                                             } });
+                }
+                for (auto &thread : threads)
+                {
+                    thread.join();
+                } });
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t increments = sizeArgument(argc, argv, 2000000);
+    Random random;
+
+    cpp_ex::Vector<std::uint64_t> keys;
+    keys.reserve(increments);
+    for (std::size_t i = 0; i < increments; ++i)
+    {
+        keys.pushBack(random.next() % kKeySpace);
+    }
+
+    std::cout << "increments per thread: " << increments << ", keys: " << kKeySpace << std::endl;
+
+    measure("Map contains() + operator[]", increments, [&]
+            {
+                cpp_ex::Map<std::uint64_t, std::int64_t> counts;
+                for (std::uint64_t key : keys)
+                {
+                    if (counts.contains(key))
+                    {
+                        counts[key] += 1;
+                    }
+                    else
+                    {
+                        counts[key] = 1;
+                    }
+                }
+                doNotOptimize(counts.getSize()); });
+
+    measure("Counter<Map> increment", increments, [&]
+            {
+                cpp_ex::Counter<std::uint64_t, cpp_ex::Map> counts;
+                for (std::uint64_t key : keys)
+                {
+                    counts.increment(key);
+                }
+                doNotOptimize(counts.getSize()); });
+
+    measure("Counter<HashMap> increment", increments, [&]
+            {
+                cpp_ex::Counter<std::uint64_t> counts;
+                for (std::uint64_t key : keys)
+                {
+                    counts.increment(key);
+                }
+                doNotOptimize(counts.getSize()); });
+
+    std::size_t maxThreads = std::max(8u, std::thread::hardware_concurrency());
+    for (std::size_t threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        runThreads<GlobalLockCounter>("HashMap + global mutex", threads, increments);
+        runThreads<UpsertCounter>("ConcurrentHashMap upsert", threads, increments);
+        runThreads<cpp_ex::ConcurrentCounter<std::uint64_t>>("ConcurrentCounter", threads, increments);
+    }
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+// Benchmark: passing containers by value through several layers, deep copies vs Cow
+// Each "request" hands the same Map, Vector and String down kLayers calls by value
+// and only reads them; the last variant also modifies the copy once (the single
+// lazy copy Cow pays).
+// Usage: cow_benchmark [requests]
+
+#include <string>
+#include "benchmark_utils.hpp"
+#include "core/cow.hpp"
+#include "core/map.hpp"
+#include "core/string.hpp"
+#include "core/vector.hpp"
+
+using namespace cpp_ex::benchmark;
+
+namespace
+{
+    constexpr int kLayers = 4;
+
+    using Config = cpp_ex::Map<cpp_ex::String, cpp_ex::String>;
+
+    // Capas que reciben por valor y sólo leen
+    template <typename MapType, typename VectorType, typename StringType>
+    std::size_t handle(MapType config, VectorType ids, StringType body, int depth)
+    {
+        if (depth == 0)
+        {
+            const Config &map = config;
+            const cpp_ex::Vector<std::uint64_t> &vector = ids;
+            const cpp_ex::String &text = body;
+            return map.getSize() + vector[vector.getSize() / 2] + text.getLength();
+        }
+        return handle<MapType, VectorType, StringType>(config, ids, body, depth - 1);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t requests = sizeArgument(argc, argv, 2000);
+
+    Config config;
+    for (int i = 0; i < 1000; ++i)
+    {
+        config[cpp_ex::String("setting." + std::to_string(i))] = cpp_ex::String("value-" + std::to_string(i * 31));
+    }
+    cpp_ex::Vector<std::uint64_t> ids;
+    for (std::uint64_t i = 0; i < 100000; ++i)
+    {
+        ids.pushBack(i);
+    }
+    cpp_ex::String body(std::string(64 * 1024, 'x'));
+
+    cpp_ex::CowMap<cpp_ex::String, cpp_ex::String> cowConfig(config);
+    cpp_ex::CowVector<std::uint64_t> cowIds(ids);
+    cpp_ex::CowString cowBody(body);
+
+    std::cout << "requests: " << requests << ", layers: " << kLayers
+              << " (1000-entry Map, 100k-element Vector, 64 KiB String)" << std::endl;
+
+    measure("deep copies, read-only", requests, [&]
+            {
+                std::size_t sum = 0;
+                for (std::size_t r = 0; r < requests; ++r)
+                {
+                    sum += handle<Config, cpp_ex::Vector<std::uint64_t>, cpp_ex::String>(config, ids, body, kLayers);
+                }
+                doNotOptimize(sum); });
+
+    measure("Cow copies, read-only", requests, [&]
+            {
+                std::size_t sum = 0;
+                for (std::size_t r = 0; r < requests; ++r)
+                {
+                    sum += handle<decltype(cowConfig), decltype(cowIds), decltype(cowBody)>(cowConfig, cowIds, cowBody, kLayers);
+                }
+                doNotOptimize(sum); });
+
+    measure("deep copy + one write", requests, [&]
+            {
+                std::size_t sum = 0;
+                for (std::size_t r = 0; r < requests; ++r)
+                {
+                    Config local = config;
+                    local[cpp_ex::String("request")] = cpp_ex::String(std::to_string(r));
+                    sum += local.getSize();
+                }
+                doNotOptimize(sum); });
+
+    measure("Cow copy + one write", requests, [&]
+            {
+                std::size_t sum = 0;
+                for (std::size_t r = 0; r < requests; ++r)
+                {
+                    auto local = cowConfig;
+                    local.write()[cpp_ex::String("request")] = cpp_ex::String(std::to_string(r));
+                    sum += local->getSize();
+                }
+                doNotOptimize(sum); });
+
+    return 0;
+}
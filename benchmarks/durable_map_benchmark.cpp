@@ -0,0 +1,110 @@
+// Benchmark: cpp_ex::DurableMap write throughput per SyncMode and recovery time
+// Writes go to a scratch directory under the system temp directory (set TMPDIR to
+// measure another disk). Recovery is timed from a snapshot plus a log tail of 10%
+// of the entries, against replaying the whole history from the log alone.
+// Usage: durable_map_benchmark [writes]
+
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+#include "benchmark_utils.hpp"
+#include "core/durable_map.hpp"
+#include "core/string.hpp"
+
+using namespace cpp_ex::benchmark;
+
+namespace
+{
+    using StringMap = cpp_ex::DurableMap<cpp_ex::String, cpp_ex::String>;
+
+    std::filesystem::path scratchDirectory(const std::string &name)
+    {
+        auto path = std::filesystem::temp_directory_path() / ("cpp_ex_durable_bench_" + std::to_string(::getpid()) + "_" + name);
+        std::filesystem::remove_all(path);
+        return path;
+    }
+
+    cpp_ex::String keyFor(std::uint64_t i)
+    {
+        return cpp_ex::String("session:" + std::to_string(i));
+    }
+
+    cpp_ex::String valueFor(std::uint64_t i)
+    {
+        return cpp_ex::String("token-" + std::to_string(i * 0x9E3779B97F4A7C15ULL));
+    }
+
+    void runWrites(const std::string &label, cpp_ex::SyncMode mode, std::size_t writes)
+    {
+        auto dir = scratchDirectory(label);
+        cpp_ex::DurabilityOptions options;
+        options.syncMode = mode;
+        options.compactLogBytes = 0;
+        Random random;
+        measure("insertOrAssign, " + label, writes, [&]
+                {
+                    StringMap map(dir, options);
+                    for (std::size_t i = 0; i < writes; ++i)
+                    {
+                        auto id = random.next() % (writes / 2 + 1);
+                        map.insertOrAssign(keyFor(id), valueFor(i));
+                    }
+                    map.flush(); });
+        std::filesystem::remove_all(dir);
+    }
+
+    void runRecovery(std::size_t entries)
+    {
+        auto compacted = scratchDirectory("compacted");
+        auto logOnly = scratchDirectory("log_only");
+        cpp_ex::DurabilityOptions options;
+        options.syncMode = cpp_ex::SyncMode::OsBuffered;
+        options.compactLogBytes = 0;
+        {
+            StringMap withSnapshot(compacted, options);
+            StringMap withLog(logOnly, options);
+            for (std::size_t i = 0; i < entries; ++i)
+            {
+                withSnapshot.insertOrAssign(keyFor(i), valueFor(i));
+                withLog.insertOrAssign(keyFor(i), valueFor(i));
+            }
+            withSnapshot.compact();
+            for (std::size_t i = 0; i < entries / 10; ++i)
+            {
+                withSnapshot.insertOrAssign(keyFor(i * 7), valueFor(i));
+                withLog.insertOrAssign(keyFor(i * 7), valueFor(i));
+            }
+        }
+
+        std::string suffix = ", " + std::to_string(entries) + " entries";
+        measure("recover snapshot + log tail" + suffix, entries, [&]
+                {
+                    StringMap map(compacted);
+                    doNotOptimize(map.getSize()); });
+        measure("recover full log" + suffix, entries, [&]
+                {
+                    StringMap map(logOnly);
+                    doNotOptimize(map.getSize()); });
+        std::filesystem::remove_all(compacted);
+        std::filesystem::remove_all(logOnly);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t writes = sizeArgument(argc, argv, 200000);
+
+    std::cout << "writes: " << writes << ", directory: " << std::filesystem::temp_directory_path() << std::endl;
+
+    // Cada fdatasync cuesta del orden de un acceso al disco: se limita el número de escrituras
+    runWrites("EveryWrite", cpp_ex::SyncMode::EveryWrite, std::max<std::size_t>(writes / 100, 100));
+    runWrites("GroupCommit", cpp_ex::SyncMode::GroupCommit, writes);
+    runWrites("OsBuffered", cpp_ex::SyncMode::OsBuffered, writes);
+
+    for (std::size_t entries : {writes / 10, writes, writes * 10})
+    {
+        runRecovery(entries);
+    }
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Benchmark: periodic eviction of expired sessions, full scan vs timing wheel
+// Usage: expiring_map_benchmark [entries]
+// Sessions live 1-600 s. Time moves in 1 s steps; each step evicts the expired
+// sessions and opens as many new ones, so the table size stays constant.
+
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include "benchmark_utils.hpp"
+#include "core/expiring_map.hpp"
+#include "core/map.hpp"
+
+using namespace cpp_ex::benchmark;
+
+constexpr std::size_t kSteps = 600;
+
+int main(int argc, char **argv)
+{
+    std::size_t n = sizeArgument(argc, argv, 200000);
+    Random random;
+    auto ttlSeconds = [&random]
+    { return static_cast<std::int64_t>(random.next() % 600 + 1); };
+
+    // Tabla actual: Map con el vencimiento junto al valor, barrida entera cada segundo
+    cpp_ex::Map<std::uint64_t, std::pair<std::int64_t, std::uint64_t>> scanned;
+    cpp_ex::ManualClock clock;
+    cpp_ex::ExpiringMap<std::uint64_t, std::uint64_t, cpp_ex::ManualClock> expiring(std::chrono::seconds(600), std::chrono::milliseconds(1), clock);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        auto key = random.next();
+        auto ttl = ttlSeconds();
+        scanned[key] = {ttl, i};
+        expiring.put(key, i, std::chrono::seconds(ttl));
+    }
+
+    std::cout << "sessions: " << n << ", steps: " << kSteps << std::endl;
+
+    std::size_t evicted = 0;
+    measure("Map full scan per step", kSteps, [&]
+            {
+                for (std::int64_t now = 1; now <= static_cast<std::int64_t>(kSteps); ++now)
+                {
+                    cpp_ex::Vector<std::uint64_t> expired;
+                    for (const auto &[key, entry] : scanned)
+                    {
+                        if (entry.first <= now)
+                        {
+                            expired.pushBack(key);
+                        }
+                    }
+                    for (auto key : expired)
+                    {
+                        scanned.erase(key);
+                        scanned[random.next()] = {now + ttlSeconds(), 0};
+                    }
+                    evicted += expired.getSize();
+                } });
+    doNotOptimize(evicted);
+
+    evicted = 0;
+    measure("ExpiringMap expire() per step", kSteps, [&]
+            {
+                for (std::size_t step = 0; step < kSteps; ++step)
+                {
+                    clock.advance(std::chrono::seconds(1));
+                    auto expired = expiring.expire();
+                    for (std::size_t i = 0; i < expired; ++i)
+                    {
+                        expiring.put(random.next(), 0, std::chrono::seconds(ttlSeconds()));
+                    }
+                    evicted += expired;
+                } });
+    std::cout << "evicted per step: " << evicted / kSteps << ", size: " << expiring.getSize() << std::endl;
+
+    std::uint64_t hits = 0;
+    cpp_ex::Vector<std::uint64_t> probes;
+    expiring.forEach([&probes](std::uint64_t key, std::uint64_t)
+                     { probes.pushBack(key); });
+    measure("ExpiringMap find (live keys)", probes.getSize(), [&]
+            {
+                for (auto key : probes)
+                {
+                    hits += expiring.find(key) != nullptr ? 1 : 0;
+                }
+                doNotOptimize(hits); });
+    return 0;
+}
@@ -0,0 +1,74 @@
+// Benchmark: contains() on large maps when most lookups miss, with and without a filter front
+// Usage: filter_benchmark [entries]
+// 90% of the queries are absent keys, as in deny-lists and dedupe tables.
+
+#include <cstdint>
+#include <string>
+#include "benchmark_utils.hpp"
+#include "core/filter.hpp"
+#include "core/hash_map.hpp"
+#include "core/map.hpp"
+
+using namespace cpp_ex::benchmark;
+
+template <typename MapType>
+void runLookups(const std::string &label, const MapType &map, const cpp_ex::Vector<std::uint64_t> &queries)
+{
+    measure(label, queries.getSize(), [&]
+            {
+                std::size_t found = 0;
+                for (auto key : queries)
+                {
+                    found += map.contains(key) ? 1 : 0;
+                }
+                doNotOptimize(found); });
+}
+
+template <typename MapType>
+void runSuite(const std::string &label, const MapType &map, const cpp_ex::Vector<std::uint64_t> &queries)
+{
+    runLookups(label + " contains", map, queries);
+    runLookups(label + " + BloomFilter contains", cpp_ex::FilteredMap<MapType>(map), queries);
+    runLookups(label + " + BinaryFuseFilter contains",
+               cpp_ex::FilteredMap<MapType, cpp_ex::BinaryFuseFilter<std::uint64_t>>(map), queries);
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t n = sizeArgument(argc, argv, 2000000);
+    Random random;
+
+    cpp_ex::Vector<std::uint64_t> keys;
+    cpp_ex::Map<std::uint64_t, std::uint64_t> map;
+    cpp_ex::HashMap<std::uint64_t, std::uint64_t> hashMap;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        auto key = random.next();
+        keys.pushBack(key);
+        map[key] = i;
+        hashMap[key] = i;
+    }
+    cpp_ex::Vector<std::uint64_t> queries;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        auto value = random.next();
+        queries.pushBack(value % 10 == 0 ? keys[value % n] : value);
+    }
+
+    std::cout << "entries: " << n << ", queries: " << n << " (90% misses)" << std::endl;
+    runSuite("Map", map, queries);
+    runSuite("HashMap", hashMap, queries);
+
+    measure("BloomFilter build (1%)", n, [&]
+            { doNotOptimize(cpp_ex::BloomFilter<std::uint64_t>::fromKeys(keys).getByteSize()); });
+    measure("BinaryFuseFilter build, 1 thread", n, [&]
+            { doNotOptimize(cpp_ex::BinaryFuseFilter<std::uint64_t>::fromKeys(keys, 1).getByteSize()); });
+    measure("BinaryFuseFilter build, all threads", n, [&]
+            { doNotOptimize(cpp_ex::BinaryFuseFilter<std::uint64_t>::fromKeys(keys).getByteSize()); });
+
+    auto bloom = cpp_ex::BloomFilter<std::uint64_t>::fromKeys(keys);
+    auto fuse = cpp_ex::BinaryFuseFilter<std::uint64_t>::fromKeys(keys);
+    std::cout << "BloomFilter: " << bloom.getByteSize() * 8.0 / static_cast<double>(n) << " bits/key, "
+              << "BinaryFuseFilter: " << fuse.getByteSize() * 8.0 / static_cast<double>(n) << " bits/key" << std::endl;
+    return 0;
+}
@@ -0,0 +1,89 @@
+// Benchmark: cpp_ex::HashMap vs cpp_ex::Map vs std::unordered_map
+// Usage: hash_map_benchmark [entries]
+
+#include <string>
+#include <unordered_map>
+#include "benchmark_utils.hpp"
+#include "core/hash_map.hpp"
+#include "core/map.hpp"
+#include "core/string.hpp"
+
+using namespace cpp_ex::benchmark;
+
+template <typename MapType, typename KeyType>
+void runSuite(const std::string &label, const cpp_ex::Vector<KeyType> &keys, const cpp_ex::Vector<KeyType> &missing)
+{
+    MapType map;
+    std::size_t n = keys.getSize();
+
+    measure(label + " insert", n, [&]
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    map[keys[i]] = i;
+                } });
+
+    measure(label + " find (hit)", n, [&]
+            {
+                std::size_t sum = 0;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    sum += map.find(keys[i])->second;
+                }
+                doNotOptimize(sum); });
+
+    measure(label + " find (miss)", n, [&]
+            {
+                std::size_t found = 0;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    found += map.find(missing[i]) != map.end();
+                }
+                doNotOptimize(found); });
+
+    measure(label + " iterate", n, [&]
+            {
+                std::size_t sum = 0;
+                for (const auto &pair : map)
+                {
+                    sum += pair.second;
+                }
+                doNotOptimize(sum); });
+
+    measure(label + " erase", n, [&]
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    map.erase(keys[i]);
+                } });
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t n = sizeArgument(argc, argv, 1000000);
+    Random random;
+
+    cpp_ex::Vector<int> intKeys;
+    cpp_ex::Vector<int> intMissing;
+    cpp_ex::Vector<cpp_ex::String> stringKeys;
+    cpp_ex::Vector<cpp_ex::String> stringMissing;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        auto value = random.next();
+        intKeys.pushBack(static_cast<int>(value & 0x3FFFFFFF));
+        intMissing.pushBack(static_cast<int>((value & 0x3FFFFFFF) | 0x40000000));
+        stringKeys.pushBack(cpp_ex::String("key/" + std::to_string(value)));
+        stringMissing.pushBack(cpp_ex::String("miss/" + std::to_string(value)));
+    }
+
+    std::cout << "entries: " << n << std::endl;
+    runSuite<cpp_ex::HashMap<int, std::size_t>>("HashMap<int>", intKeys, intMissing);
+    runSuite<std::unordered_map<int, std::size_t>>("std::unordered_map<int>", intKeys, intMissing);
+    runSuite<cpp_ex::Map<int, std::size_t>>("Map<int>", intKeys, intMissing);
+
+    runSuite<cpp_ex::HashMap<cpp_ex::String, std::size_t>>("HashMap<String>", stringKeys, stringMissing);
+    runSuite<std::unordered_map<cpp_ex::String, std::size_t>>("std::unordered_map<String>", stringKeys, stringMissing);
+    runSuite<cpp_ex::Map<cpp_ex::String, std::size_t>>("Map<String>", stringKeys, stringMissing);
+
+    return 0;
+}
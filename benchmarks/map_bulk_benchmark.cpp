@@ -0,0 +1,85 @@
+// Benchmark: rebuilding a cpp_ex::Map from data that is already sorted by key
+// Compares repeated insert() with the range constructor, fromSorted(), insertSorted()
+// and the hinted mapValues()/filterEntries().
+// Usage: map_bulk_benchmark [entries]
+
+#include <cstdint>
+#include <utility>
+#include "benchmark_utils.hpp"
+#include "core/map.hpp"
+
+using namespace cpp_ex::benchmark;
+
+using IntMap = cpp_ex::Map<std::int64_t, std::int64_t>;
+
+int main(int argc, char **argv)
+{
+    std::size_t n = sizeArgument(argc, argv, 10000000);
+
+    cpp_ex::Vector<std::pair<std::int64_t, std::int64_t>> rows;
+    rows.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        auto key = static_cast<std::int64_t>(i * 2);
+        rows.pushBack({key, key});
+    }
+
+    std::cout << "entries: " << n << std::endl;
+
+    {
+        IntMap map;
+        measure("insert() one by one", n, [&]
+                {
+                    for (const auto &row : rows)
+                    {
+                        map.insert(row);
+                    } });
+        doNotOptimize(map.getSize());
+    }
+
+    {
+        IntMap map;
+        measure("Map(first, last)", n, [&]
+                { map = IntMap(rows.begin(), rows.end()); });
+        doNotOptimize(map.getSize());
+    }
+
+    IntMap map;
+    measure("Map::fromSorted()", n, [&]
+            { map = IntMap::fromSorted(rows); });
+
+    // Lote intercalado con las claves existentes (claves impares)
+    cpp_ex::Vector<std::pair<std::int64_t, std::int64_t>> batch;
+    batch.reserve(n / 10);
+    for (std::size_t i = 0; i < n / 10; ++i)
+    {
+        auto key = static_cast<std::int64_t>(i * 20 + 1);
+        batch.pushBack({key, key});
+    }
+
+    {
+        IntMap target = map;
+        measure("insert(first, last) of a sorted 10% batch", batch.getSize(), [&]
+                { target.insert(batch.begin(), batch.end()); });
+    }
+
+    {
+        IntMap target = map;
+        measure("insertSorted() of a sorted 10% batch", batch.getSize(), [&]
+                { doNotOptimize(target.insertSorted(batch)); });
+    }
+
+    measure("mapValues()", n, [&]
+            {
+                auto doubled = map.mapValues<std::int64_t>([](std::int64_t value)
+                                                           { return value * 2; });
+                doNotOptimize(doubled.getSize()); });
+
+    measure("filterEntries() (keeps 50%)", n, [&]
+            {
+                auto kept = map.filterEntries([](std::int64_t key, std::int64_t)
+                                              { return key % 4 == 0; });
+                doNotOptimize(kept.getSize()); });
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+// Benchmark: replicating a Map by full copies vs diff() / journal deltas
+// Usage: map_delta_benchmark [entries]
+// Each round changes 1% of the entries (updates, inserts and erases).
+
+#include <cstdint>
+#include <string>
+#include "benchmark_utils.hpp"
+#include "core/map.hpp"
+#include "core/serialization.hpp"
+
+using namespace cpp_ex::benchmark;
+
+using IdMap = cpp_ex::Map<std::uint64_t, std::uint64_t>;
+
+// Cambia un 1% de las entradas: la mitad actualizaciones, un cuarto altas y un cuarto bajas
+void mutate(IdMap &map, Random &random, std::size_t n)
+{
+    for (std::size_t i = 0; i < n / 100; ++i)
+    {
+        auto key = random.next() % (n * 2);
+        switch (i % 4)
+        {
+        case 0:
+        case 1:
+            map[key] = random.next();
+            break;
+        case 2:
+            map.insert({key, random.next()});
+            break;
+        default:
+            map.erase(key);
+            break;
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t n = sizeArgument(argc, argv, 1000000);
+    Random random;
+
+    IdMap primary;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        primary[random.next() % (n * 2)] = i;
+    }
+    auto previous = primary;
+    primary.enableJournal();
+    mutate(primary, random, n);
+    std::cout << "entries: " << primary.getSize() << ", changed keys: " << primary.getJournalSize() << std::endl;
+
+    std::size_t fullBytes = 0;
+    measure("full copy: serialize entries", 1, [&]
+            {
+                cpp_ex::BinaryWriter out;
+                out.write(primary.getEntries());
+                fullBytes = out.getSize(); });
+    cpp_ex::MapDelta<std::uint64_t, std::uint64_t> delta;
+    measure("diff() against the previous copy", 1, [&]
+            { delta = previous.diff(primary); });
+    std::cout << "delta changes: " << delta.getChangeCount() << std::endl;
+
+    cpp_ex::MapDelta<std::uint64_t, std::uint64_t> journaled;
+    measure("checkpoint() from the journal", 1, [&]
+            { journaled = primary.checkpoint(); });
+    std::cout << "journal delta == diff: " << (journaled == delta ? "yes" : "no") << std::endl;
+
+    std::size_t deltaBytes = 0;
+    measure("serialize delta", 1, [&]
+            {
+                cpp_ex::BinaryWriter out;
+                out.write(delta);
+                deltaBytes = out.getSize(); });
+    std::cout << "bytes: full " << fullBytes << ", delta " << deltaBytes << std::endl;
+
+    auto replica = previous;
+    measure("applyDelta() on a replica", delta.getChangeCount(), [&]
+            { replica.applyDelta(delta); });
+    measure("rebuild the replica from a full copy", n, [&]
+            {
+                auto entries = primary.getEntries();
+                replica = IdMap::fromSorted(entries);
+                doNotOptimize(replica.getSize()); });
+    std::cout << "replica == primary: " << (replica == primary ? "yes" : "no") << std::endl;
+    return 0;
+}
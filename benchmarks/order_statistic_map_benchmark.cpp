@@ -0,0 +1,114 @@
+// Benchmark: rank and select queries on cpp_ex::OrderStatisticMap vs cpp_ex::Map
+// Map answers them with std::distance / std::next (O(n)); OrderStatisticMap uses
+// its subtree sizes (O(log n)). Inserts are timed too, to show the cost of the
+// extra bookkeeping.
+// Usage: order_statistic_map_benchmark [entries]
+
+#include <iterator>
+#include "benchmark_utils.hpp"
+#include "core/map.hpp"
+#include "core/order_statistic_map.hpp"
+
+using namespace cpp_ex::benchmark;
+
+int main(int argc, char **argv)
+{
+    std::size_t n = sizeArgument(argc, argv, 200000);
+    Random random;
+
+    cpp_ex::Vector<std::uint64_t> keys;
+    keys.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        keys.pushBack(random.next());
+    }
+
+    cpp_ex::Map<std::uint64_t, std::uint64_t> map;
+    cpp_ex::OrderStatisticMap<std::uint64_t, std::uint64_t> statMap;
+
+    std::cout << "entries: " << n << std::endl;
+
+    measure("Map insert", n, [&]
+            {
+                for (std::uint64_t key : keys)
+                {
+                    map[key] = key;
+                }
+                doNotOptimize(map.getSize()); });
+
+    measure("OrderStatisticMap insert", n, [&]
+            {
+                for (std::uint64_t key : keys)
+                {
+                    statMap[key] = key;
+                }
+                doNotOptimize(statMap.getSize()); });
+
+    measure("Map find", n, [&]
+            {
+                std::uint64_t sum = 0;
+                for (std::uint64_t key : keys)
+                {
+                    sum += map.find(key)->second;
+                }
+                doNotOptimize(sum); });
+
+    measure("OrderStatisticMap find", n, [&]
+            {
+                std::uint64_t sum = 0;
+                for (std::uint64_t key : keys)
+                {
+                    sum += statMap.find(key)->second;
+                }
+                doNotOptimize(sum); });
+
+    // Las consultas O(n) de Map se limitan para que el benchmark termine
+    std::size_t linearQueries = std::max<std::size_t>(1, 20000000 / n);
+
+    measure("Map rank (std::distance)", linearQueries, [&]
+            {
+                std::size_t sum = 0;
+                for (std::size_t q = 0; q < linearQueries; ++q)
+                {
+                    sum += static_cast<std::size_t>(std::distance(map.begin(), map.lowerBound(keys[q % n])));
+                }
+                doNotOptimize(sum); });
+
+    measure("OrderStatisticMap rankOf", n, [&]
+            {
+                std::size_t sum = 0;
+                for (std::uint64_t key : keys)
+                {
+                    sum += statMap.rankOf(key);
+                }
+                doNotOptimize(sum); });
+
+    measure("Map select (std::next)", linearQueries, [&]
+            {
+                std::uint64_t sum = 0;
+                for (std::size_t q = 0; q < linearQueries; ++q)
+                {
+                    sum += std::next(map.begin(), static_cast<std::ptrdiff_t>(keys[q % n] % n))->first;
+                }
+                doNotOptimize(sum); });
+
+    measure("OrderStatisticMap atIndex", n, [&]
+            {
+                std::uint64_t sum = 0;
+                for (std::uint64_t key : keys)
+                {
+                    sum += statMap.atIndex(key % n).first;
+                }
+                doNotOptimize(sum); });
+
+    measure("OrderStatisticMap percentile", n, [&]
+            {
+                std::uint64_t sum = 0;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    sum += statMap.percentile(static_cast<double>(i % 101)).first;
+                }
+                doNotOptimize(sum); });
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Benchmark: sequential vs parallel forEach / mapValues / filterEntries
+// Usage: parallel_map_benchmark [entries]
+// The value transform costs about a microsecond, like a parse or a checksum.
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include "benchmark_utils.hpp"
+#include "core/flat_map.hpp"
+#include "core/hash_map.hpp"
+#include "core/map.hpp"
+
+using namespace cpp_ex::benchmark;
+
+// Transformación cara: 256 rondas de splitmix64
+std::uint64_t expensive(std::uint64_t value)
+{
+    for (int round = 0; round < 256; ++round)
+    {
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    }
+    return value;
+}
+
+template <typename MapType>
+void runSuite(const std::string &label, const MapType &map)
+{
+    std::size_t n = map.getSize();
+    auto keep = [](std::uint64_t, std::uint64_t value)
+    { return (expensive(value) & 3) == 0; };
+
+    measure(label + " forEach", n, [&]
+            {
+                std::uint64_t sum = 0;
+                map.forEach([&sum](std::uint64_t, std::uint64_t value)
+                            { sum += expensive(value); });
+                doNotOptimize(sum); });
+    measure(label + " parallelForEach", n, [&]
+            {
+                std::atomic<std::uint64_t> sum{0};
+                map.parallelForEach([&sum](std::uint64_t, std::uint64_t value)
+                                    { sum.fetch_add(expensive(value), std::memory_order_relaxed); });
+                doNotOptimize(sum.load()); });
+
+    measure(label + " mapValues", n, [&]
+            {
+                auto result = map.template mapValues<std::uint64_t>(expensive);
+                doNotOptimize(result.getSize()); });
+    measure(label + " parallelMapValues", n, [&]
+            {
+                auto result = map.template parallelMapValues<std::uint64_t>(expensive);
+                doNotOptimize(result.getSize()); });
+
+    measure(label + " filterEntries", n, [&]
+            {
+                auto result = map.filterEntries(keep);
+                doNotOptimize(result.getSize()); });
+    measure(label + " parallelFilterEntries", n, [&]
+            {
+                auto result = map.parallelFilterEntries(keep);
+                doNotOptimize(result.getSize()); });
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t n = sizeArgument(argc, argv, 1000000);
+    Random random;
+
+    cpp_ex::Map<std::uint64_t, std::uint64_t> map;
+    cpp_ex::FlatMap<std::uint64_t, std::uint64_t> flatMap;
+    cpp_ex::HashMap<std::uint64_t, std::uint64_t> hashMap;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        auto key = random.next();
+        map[key] = i;
+        hashMap[key] = i;
+    }
+    flatMap = cpp_ex::FlatMap<std::uint64_t, std::uint64_t>::fromSorted(map.getKeys(), map.getValues());
+
+    std::cout << "entries: " << n << ", hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    runSuite("Map", map);
+    runSuite("FlatMap", flatMap);
+    runSuite("HashMap", hashMap);
+    return 0;
+}
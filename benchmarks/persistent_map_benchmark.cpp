@@ -0,0 +1,75 @@
+// Benchmark: publishing snapshots of a table after every update
+// Compares copying a cpp_ex::Map (copy + insert) with PersistentMap::with().
+// Usage: persistent_map_benchmark [entries]
+
+#include <cstdint>
+#include "benchmark_utils.hpp"
+#include "core/map.hpp"
+#include "core/persistent_map.hpp"
+
+using namespace cpp_ex::benchmark;
+
+int main(int argc, char **argv)
+{
+    std::size_t n = sizeArgument(argc, argv, 100000);
+    constexpr std::size_t kUpdates = 1000;
+    Random random;
+
+    cpp_ex::Map<std::uint64_t, std::uint64_t> map;
+    cpp_ex::PersistentMap<std::uint64_t, std::uint64_t> persistent;
+    cpp_ex::Vector<std::uint64_t> keys;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        auto key = random.next();
+        keys.pushBack(key);
+        map[key] = i;
+    }
+    measure("PersistentMap build (with())", n, [&]
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    persistent = persistent.with(keys[i], i);
+                } });
+
+    std::cout << "entries: " << n << ", snapshots: " << kUpdates << std::endl;
+
+    measure("Map copy + insert per snapshot", kUpdates, [&]
+            {
+                auto published = map;
+                for (std::size_t i = 0; i < kUpdates; ++i)
+                {
+                    auto next = published;
+                    next[keys[i % n]] = i;
+                    published = std::move(next);
+                }
+                doNotOptimize(published.getSize()); });
+
+    measure("PersistentMap::with() per snapshot", kUpdates, [&]
+            {
+                auto published = persistent;
+                for (std::size_t i = 0; i < kUpdates; ++i)
+                {
+                    published = published.with(keys[i % n], i);
+                }
+                doNotOptimize(published.getSize()); });
+
+    measure("Map find", n, [&]
+            {
+                std::uint64_t sum = 0;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    sum += map.find(keys[i])->second;
+                }
+                doNotOptimize(sum); });
+
+    measure("PersistentMap find", n, [&]
+            {
+                std::uint64_t sum = 0;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    sum += *persistent.find(keys[i]);
+                }
+                doNotOptimize(sum); });
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+// Benchmark: build / lookup / clear cycles with the default allocator and a node pool
+// Compares cpp_ex::Map with cpp_ex::PooledMap, for many short-lived small maps and
+// for one large map.
+// Usage: pool_map_benchmark [entries]
+
+#include <cstdint>
+#include "benchmark_utils.hpp"
+#include "core/map.hpp"
+
+using namespace cpp_ex::benchmark;
+
+template <typename MapType>
+void runCycles(const std::string &name, const cpp_ex::Vector<std::uint64_t> &keys, std::size_t mapSize)
+{
+    std::size_t cycles = keys.getSize() / mapSize;
+    measure(name, cycles * mapSize, [&]
+            {
+                std::uint64_t sum = 0;
+                for (std::size_t cycle = 0; cycle < cycles; ++cycle)
+                {
+                    MapType map;
+                    std::size_t offset = cycle * mapSize;
+                    for (std::size_t i = 0; i < mapSize; ++i)
+                    {
+                        map[keys[offset + i]] = i;
+                    }
+                    for (std::size_t i = 0; i < mapSize; ++i)
+                    {
+                        sum += map.find(keys[offset + i])->second;
+                    }
+                    map.clear();
+                }
+                doNotOptimize(sum); });
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t n = sizeArgument(argc, argv, 1000000);
+    Random random;
+
+    cpp_ex::Vector<std::uint64_t> keys;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        keys.pushBack(random.next());
+    }
+
+    std::cout << "entries: " << n << std::endl;
+
+    using Plain = cpp_ex::Map<std::uint64_t, std::uint64_t>;
+    using Pooled = cpp_ex::PooledMap<std::uint64_t, std::uint64_t>;
+
+    runCycles<Plain>("Map, 64-entry maps", keys, 64);
+    runCycles<Pooled>("PooledMap, 64-entry maps", keys, 64);
+    runCycles<Plain>("Map, 4096-entry maps", keys, 4096);
+    runCycles<Pooled>("PooledMap, 4096-entry maps", keys, 4096);
+    runCycles<Plain>("Map, one map", keys, n);
+    runCycles<Pooled>("PooledMap, one map", keys, n);
+
+    // Un mapa que se reutiliza: el pool conserva sus páginas tras clear()
+    Pooled reused;
+    measure("PooledMap reused across clear()", n, [&]
+            {
+                for (std::size_t offset = 0; offset + 4096 <= n; offset += 4096)
+                {
+                    for (std::size_t i = 0; i < 4096; ++i)
+                    {
+                        reused[keys[offset + i]] = i;
+                    }
+                    reused.clear();
+                }
+                doNotOptimize(reused.getSize()); });
+
+    return 0;
+}
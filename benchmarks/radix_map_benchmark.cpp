@@ -0,0 +1,97 @@
+// Benchmark: URL-like keys with long shared prefixes
+// Compares cpp_ex::Map<String, int> with RadixMap<int> for building, exact lookups,
+// prefix queries (lowerBound + startsWith loop on Map) and memory use.
+// Usage: radix_map_benchmark [entries]
+
+#include <string>
+#include "benchmark_utils.hpp"
+#include "core/map.hpp"
+#include "core/radix_map.hpp"
+#include "core/string.hpp"
+
+using namespace cpp_ex::benchmark;
+
+int main(int argc, char **argv)
+{
+    std::size_t n = sizeArgument(argc, argv, 500000);
+    constexpr std::size_t kTenants = 100;
+    constexpr std::size_t kQueries = 10000;
+    Random random;
+
+    cpp_ex::Vector<cpp_ex::String> keys;
+    std::size_t keyHeapBytes = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        std::string key = "/api/v1/tenants/" + std::to_string(i % kTenants) + "/users/" + std::to_string(random.next() % 1000000) + "/settings";
+        keyHeapBytes += key.size() > 15 ? key.capacity() + 1 : 0;
+        keys.pushBack(cpp_ex::String(std::move(key)));
+    }
+
+    std::cout << "entries: " << n << std::endl;
+
+    cpp_ex::Map<cpp_ex::String, int> map;
+    cpp_ex::RadixMap<int> radix;
+    measure("Map insert", n, [&]
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    map[keys[i]] = static_cast<int>(i);
+                } });
+    measure("RadixMap insert", n, [&]
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    radix[keys[i]] = static_cast<int>(i);
+                } });
+
+    measure("Map find", n, [&]
+            {
+                long sum = 0;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    sum += map.find(keys[i])->second;
+                }
+                doNotOptimize(sum); });
+    measure("RadixMap find", n, [&]
+            {
+                long sum = 0;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    sum += *radix.find(keys[i]);
+                }
+                doNotOptimize(sum); });
+
+    // Todas las claves de un usuario concreto (pocos resultados por consulta)
+    cpp_ex::Vector<std::string> prefixes;
+    for (std::size_t i = 0; i < kQueries; ++i)
+    {
+        std::string key = keys[random.next() % n].getStringView().data();
+        prefixes.pushBack(key.substr(0, key.size() - 9)); // Sin "/settings"
+    }
+    measure("Map prefix query (lowerBound + startsWith)", kQueries, [&]
+            {
+                std::size_t found = 0;
+                for (const auto &prefix : prefixes)
+                {
+                    for (auto it = map.lowerBound(cpp_ex::String(prefix)); it != map.end() && it->first.startsWith(prefix); ++it)
+                    {
+                        ++found;
+                    }
+                }
+                doNotOptimize(found); });
+    measure("RadixMap forEachWithPrefix", kQueries, [&]
+            {
+                std::size_t found = 0;
+                for (const auto &prefix : prefixes)
+                {
+                    radix.forEachWithPrefix(prefix, [&found](std::string_view, int)
+                                            { ++found; });
+                }
+                doNotOptimize(found); });
+
+    std::size_t mapBytes = map.getSize() * (32 + sizeof(std::pair<const cpp_ex::String, int>)) + keyHeapBytes;
+    std::cout << "memory Map (estimated): " << mapBytes << " bytes" << std::endl;
+    std::cout << "memory RadixMap:        " << radix.getMemoryUsage() << " bytes, " << radix.getNodeCount() << " nodes" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+// Benchmark: per-request tiny maps, cpp_ex::Map vs cpp_ex::SmallMap
+// Each "request" builds a map of a few headers (String keys) and a few flags (int
+// keys), looks some of them up and destroys the maps. Heap allocations are counted
+// through the global operator new.
+// Usage: small_map_benchmark [requests]
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include "benchmark_utils.hpp"
+#include "core/map.hpp"
+#include "core/small_map.hpp"
+#include "core/string.hpp"
+
+using namespace cpp_ex::benchmark;
+
+namespace
+{
+    std::atomic<std::size_t> allocationCount{0};
+}
+
+// GCC flags free() on memory from operator new once the replacements are inlined
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void *operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace
+{
+    constexpr int kHeaders = 6;
+    constexpr int kFlags = 5;
+
+    // Claves cortas: caben en el buffer SSO, así sólo se cuentan las asignaciones del mapa
+    const char *const kHeaderNames[kHeaders] = {"host", "accept", "agent", "cookie", "length", "type"};
+
+    template <typename HeaderMap, typename FlagMap>
+    std::size_t handleRequest(std::size_t request)
+    {
+        HeaderMap headers;
+        for (int i = 0; i < kHeaders; ++i)
+        {
+            headers[cpp_ex::String(kHeaderNames[(i + request) % kHeaders])] = static_cast<int>(request + i);
+        }
+        FlagMap flags;
+        for (int i = 0; i < kFlags; ++i)
+        {
+            flags[static_cast<int>((request * 7 + i * 13) % 64)] = (i & 1) != 0;
+        }
+
+        std::size_t sum = 0;
+        sum += static_cast<std::size_t>(headers.find(cpp_ex::String("host"))->second);
+        sum += headers.contains(cpp_ex::String("cookie")) ? 1 : 0;
+        for (int f = 0; f < 64; f += 8)
+        {
+            sum += flags.contains(f) ? 1 : 0;
+        }
+        return sum;
+    }
+
+    template <typename HeaderMap, typename FlagMap>
+    void run(const std::string &name, std::size_t requests)
+    {
+        std::size_t before = allocationCount.load(std::memory_order_relaxed);
+        measure(name, requests, [&]
+                {
+                    std::size_t sum = 0;
+                    for (std::size_t r = 0; r < requests; ++r)
+                    {
+                        sum += handleRequest<HeaderMap, FlagMap>(r);
+                    }
+                    doNotOptimize(sum); });
+        std::size_t allocations = allocationCount.load(std::memory_order_relaxed) - before;
+        std::cout << "  allocations per request: " << static_cast<double>(allocations) / static_cast<double>(requests) << std::endl;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t requests = sizeArgument(argc, argv, 500000);
+
+    std::cout << "requests: " << requests << " (" << kHeaders << " headers, " << kFlags << " flags each)" << std::endl;
+
+    run<cpp_ex::Map<cpp_ex::String, int>, cpp_ex::Map<int, bool>>("Map", requests);
+    run<cpp_ex::SmallMap<cpp_ex::String, int, 8>, cpp_ex::SmallMap<int, bool, 8>>("SmallMap<8>", requests);
+    // Capacidad menor que el número de entradas: migra al Map en cada petición
+    run<cpp_ex::SmallMap<cpp_ex::String, int, 4>, cpp_ex::SmallMap<int, bool, 4>>("SmallMap<4> (spills)", requests);
+
+    return 0;
+}
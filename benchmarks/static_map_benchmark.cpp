@@ -0,0 +1,87 @@
+// Benchmark: classifying HTTP header names against a fixed set of known headers
+// Compares cpp_ex::Map<String, int> and HashMap<String, int> built at startup with a
+// constexpr StaticMap.
+// Usage: static_map_benchmark [lookups]
+
+#include <string_view>
+#include "benchmark_utils.hpp"
+#include "core/hash_map.hpp"
+#include "core/map.hpp"
+#include "core/static_map.hpp"
+#include "core/string.hpp"
+
+using namespace cpp_ex::benchmark;
+
+namespace
+{
+    constexpr auto kHeaders = cpp_ex::makeStaticMap<std::string_view, int>({
+        {"accept", 1}, {"accept-charset", 2}, {"accept-encoding", 3}, {"accept-language", 4},
+        {"authorization", 5}, {"cache-control", 6}, {"connection", 7}, {"content-encoding", 8},
+        {"content-length", 9}, {"content-type", 10}, {"cookie", 11}, {"date", 12},
+        {"etag", 13}, {"expect", 14}, {"forwarded", 15}, {"host", 16},
+        {"if-match", 17}, {"if-modified-since", 18}, {"if-none-match", 19}, {"if-range", 20},
+        {"last-modified", 21}, {"location", 22}, {"origin", 23}, {"pragma", 24},
+        {"range", 25}, {"referer", 26}, {"server", 27}, {"set-cookie", 28},
+        {"te", 29}, {"trailer", 30}, {"transfer-encoding", 31}, {"upgrade", 32},
+        {"user-agent", 33}, {"vary", 34}, {"via", 35}, {"www-authenticate", 36},
+        {"x-forwarded-for", 37}, {"x-forwarded-proto", 38}, {"x-request-id", 39}, {"x-real-ip", 40}});
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t n = sizeArgument(argc, argv, 5000000);
+    Random random;
+
+    cpp_ex::Map<cpp_ex::String, int> map;
+    cpp_ex::HashMap<cpp_ex::String, int> hashMap;
+    cpp_ex::Vector<cpp_ex::String> names;
+    for (const auto &[name, id] : kHeaders)
+    {
+        map[cpp_ex::String(std::string(name))] = id;
+        hashMap[cpp_ex::String(std::string(name))] = id;
+        names.pushBack(cpp_ex::String(std::string(name)));
+    }
+    names.pushBack("x-custom-header"); // Algunas cabeceras desconocidas
+    names.pushBack("dnt");
+
+    // Secuencia de consultas fija para todas las variantes
+    cpp_ex::Vector<std::size_t> queries;
+    queries.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        queries.pushBack(random.next() % names.getSize());
+    }
+
+    std::cout << "headers: " << kHeaders.getSize() << ", lookups: " << n << std::endl;
+
+    measure("Map<String, int> find", n, [&]
+            {
+                long sum = 0;
+                for (std::size_t q : queries)
+                {
+                    auto it = map.find(names[q]);
+                    sum += it != map.end() ? it->second : 0;
+                }
+                doNotOptimize(sum); });
+
+    measure("HashMap<String, int> find", n, [&]
+            {
+                long sum = 0;
+                for (std::size_t q : queries)
+                {
+                    auto it = hashMap.find(names[q]);
+                    sum += it != hashMap.end() ? it->second : 0;
+                }
+                doNotOptimize(sum); });
+
+    measure("StaticMap find", n, [&]
+            {
+                long sum = 0;
+                for (std::size_t q : queries)
+                {
+                    sum += kHeaders.getOrDefault(names[q], 0);
+                }
+                doNotOptimize(sum); });
+
+    return 0;
+}
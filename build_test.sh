@@ -151,7 +151,7 @@ else
     cd build
     
     echo "Cleaning test targets..."
-    rm -f tests/unit/unit_tests
+    rm -f tests/unit/unit_tests tests/unit/transparent_lookup_tests
     
     # Reconfigure with CMake if needed
     echo "Reconfiguring with CMake..."
@@ -214,36 +214,37 @@ if [ -f "unit/unit_tests" ]; then
     # We'll use a run_test function to properly set the environment variable
     run_test() {
         local tag="$1"
+        local executable="${2:-./unit_tests}"
         
         # Execute the command with appropriate environment variables
         if [ "$USE_VALGRIND" = true ]; then
             # Using Valgrind
             if [ "$tag" = "--list-tests" ]; then
                 if [ -n "$ASAN_OPTIONS" ]; then
-                    env ASAN_OPTIONS="$ASAN_OPTIONS" valgrind ./unit_tests $tag || echo "Test listing failed"
+                    env ASAN_OPTIONS="$ASAN_OPTIONS" valgrind "$executable" $tag || echo "Test listing failed"
                 else
-                    valgrind ./unit_tests $tag || echo "Test listing failed"
+                    valgrind "$executable" $tag || echo "Test listing failed"
                 fi
             else
                 if [ -n "$ASAN_OPTIONS" ]; then
-                    env ASAN_OPTIONS="$ASAN_OPTIONS" valgrind ./unit_tests "[$tag]" || echo "Test with tag [$tag] failed"
+                    env ASAN_OPTIONS="$ASAN_OPTIONS" valgrind "$executable" "[$tag]" || echo "Test with tag [$tag] failed"
                 else
-                    valgrind ./unit_tests "[$tag]" || echo "Test with tag [$tag] failed"
+                    valgrind "$executable" "[$tag]" || echo "Test with tag [$tag] failed"
                 fi
             fi
         else
             # Not using Valgrind
             if [ "$tag" = "--list-tests" ]; then
                 if [ -n "$ASAN_OPTIONS" ]; then
-                    env ASAN_OPTIONS="$ASAN_OPTIONS" ./unit_tests $tag || echo "Test listing failed"
+                    env ASAN_OPTIONS="$ASAN_OPTIONS" "$executable" $tag || echo "Test listing failed"
                 else
-                    ./unit_tests $tag || echo "Test listing failed"
+                    "$executable" $tag || echo "Test listing failed"
                 fi
             else
                 if [ -n "$ASAN_OPTIONS" ]; then
-                    env ASAN_OPTIONS="$ASAN_OPTIONS" ./unit_tests "[$tag]" || echo "Test with tag [$tag] failed"
+                    env ASAN_OPTIONS="$ASAN_OPTIONS" "$executable" "[$tag]" || echo "Test with tag [$tag] failed"
                 else
-                    ./unit_tests "[$tag]" || echo "Test with tag [$tag] failed"
+                    "$executable" "[$tag]" || echo "Test with tag [$tag] failed"
                 fi
             fi
         fi
@@ -271,6 +272,69 @@ if [ -f "unit/unit_tests" ]; then
     echo -e "\nRunning tests with tag [vector]..."
     run_test "vector"
 
+    echo -e "\nRunning tests with tag [hash_map]..."
+    run_test "hash_map"
+
+    echo -e "\nRunning tests with tag [flat_map]..."
+    run_test "flat_map"
+
+    echo -e "\nRunning tests with tag [btree_map]..."
+    run_test "btree_map"
+
+    echo -e "\nRunning tests with tag [map_interface]..."
+    run_test "map_interface"
+
+    echo -e "\nRunning tests with tag [concurrent_hash_map]..."
+    run_test "concurrent_hash_map"
+
+    echo -e "\nRunning tests with tag [cache]..."
+    run_test "cache"
+
+    echo -e "\nRunning tests with tag [transparent_lookup]..."
+    run_test "transparent_lookup" ./transparent_lookup_tests
+
+    echo -e "\nRunning tests with tag [persistent_map]..."
+    run_test "persistent_map"
+
+    echo -e "\nRunning tests with tag [pool_allocator]..."
+    run_test "pool_allocator"
+
+    echo -e "\nRunning tests with tag [interval_map]..."
+    run_test "interval_map"
+
+    echo -e "\nRunning tests with tag [interval_tree]..."
+    run_test "interval_tree"
+
+    echo -e "\nRunning tests with tag [radix_map]..."
+    run_test "radix_map"
+
+    echo -e "\nRunning tests with tag [static_map]..."
+    run_test "static_map"
+
+    echo -e "\nRunning tests with tag [counter]..."
+    run_test "counter"
+
+    echo -e "\nRunning tests with tag [serialization]..."
+    run_test "serialization"
+
+    echo -e "\nRunning tests with tag [durable_map]..."
+    run_test "durable_map"
+
+    echo -e "\nRunning tests with tag [order_statistic_map]..."
+    run_test "order_statistic_map"
+
+    echo -e "\nRunning tests with tag [cow]..."
+    run_test "cow"
+
+    echo -e "\nRunning tests with tag [small_map]..."
+    run_test "small_map"
+
+    echo -e "\nRunning tests with tag [filter]..."
+    run_test "filter"
+
+    echo -e "\nRunning tests with tag [expiring_map]..."
+    run_test "expiring_map"
+
     echo -e "\nRunning tests with tag [safe_shared_ptr]..."
     run_test "safe_shared_ptr"
     
@@ -299,7 +363,7 @@ if [ "$RUN_CTEST" = true ]; then
     # Run unit tests with CTest if they exist
     if [ -f "tests/unit/unit_tests" ]; then
         echo -e "\nRunning unit tests with CTest..."
-        ASAN_OPTIONS=handle_segv=0:allow_user_segv_handler=1:detect_leaks=0 ctest -R unit_tests --output-on-failure
+        ASAN_OPTIONS=handle_segv=0:allow_user_segv_handler=1:detect_leaks=0 ctest -R "unit_tests|transparent_lookup_tests" --output-on-failure
         if [ $? -ne 0 ]; then
             echo -e "WARNING: CTest unit tests failed."
         else
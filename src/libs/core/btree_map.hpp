@@ -0,0 +1,1411 @@
+/**
+ * @file btree_map.hpp
+ * @brief Cache-friendly in-memory B+ tree with the ordered cpp_ex::Map API
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_BTREE_MAP_HPP
+#define CPPEX_BTREE_MAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include "common.hpp"    // Include detail::prefetch
+#include "vector.hpp"    // Include Vector class
+#include "map_entry.hpp" // Include MapEntryRef
+
+namespace cpp_ex
+{
+
+    /**
+     * @brief Ordered map stored in a B+ tree with wide, cache-line aligned nodes
+     *
+     * std::map spends one heap node (three pointers, a color and padding: about 32-48
+     * bytes) per entry and one cache miss per tree level. BTreeMap packs many entries
+     * per node instead: leaves hold up to `kLeafSlots` keys and values in two contiguous
+     * arrays sized to roughly `NodeBytes`, internal nodes only hold separator keys and
+     * child pointers, and leaves are chained so iteration and range scans are linear.
+     * A tree of 100 M small entries is about four levels deep.
+     *
+     * Inserting at the end of the map (sorted bulk loads, end-hinted insertion) fills
+     * leaves completely instead of splitting them in half.
+     *
+     * Unlike cpp_ex::Map, any insertion or erasure may invalidate iterators and
+     * references, because entries move between nodes when they split or merge.
+     * Iterators dereference to a MapEntryRef (`first`/`second`) instead of `std::pair&`.
+     *
+     * @tparam Key Type of the keys (must be copy constructible: separators are copies)
+     * @tparam Value Type of the mapped values
+     * @tparam Compare Comparison function object type, defaults to std::less<Key>
+     * @tparam NodeBytes Target node size in bytes (a multiple of the cache line size)
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::BTreeMap<int64_t, double> series;
+     *
+     * // Sorted loads are appended without searching the tree
+     * for (int64_t t = 0; t < 1000; ++t) {
+     *     series.emplaceHint(series.end(), t, 0.5 * t);
+     * }
+     *
+     * // Range scan
+     * for (auto it = series.lowerBound(100); it != series.upperBound(200); ++it) {
+     *     process(it->first, it->second);
+     * }
+     *
+     * // Range erase
+     * series.erase(series.lowerBound(500), series.end());
+     * ```
+     */
+    template <typename Key, typename Value, typename Compare = std::less<Key>, std::size_t NodeBytes = 256>
+    class BTreeMap
+    {
+    private:
+        static constexpr std::size_t kCacheLine = 64;
+        static constexpr std::size_t kHeaderBytes = 32;
+        static constexpr std::size_t kPayloadBytes = NodeBytes > kHeaderBytes ? NodeBytes - kHeaderBytes : 0;
+
+    public:
+        // Número de entradas por nodo, derivado del tamaño objetivo
+        static constexpr std::size_t kLeafSlots = std::max<std::size_t>(4, kPayloadBytes / (sizeof(Key) + sizeof(Value)));
+        static constexpr std::size_t kInternalSlots = std::max<std::size_t>(4, kPayloadBytes / (sizeof(Key) + sizeof(void *)));
+
+    private:
+        static constexpr std::size_t kMinLeaf = kLeafSlots / 2;
+        static constexpr std::size_t kMinInternal = kInternalSlots / 2;
+
+        static_assert(NodeBytes % kCacheLine == 0, "BTreeMap node size must be a multiple of the cache line size");
+        static_assert(kLeafSlots < 0xFFFF && kInternalSlots < 0xFFFF, "BTreeMap nodes are too wide");
+
+        struct InternalNode;
+
+        struct NodeBase
+        {
+            InternalNode *parent = nullptr;
+            std::uint16_t position = 0; // Índice en parent->children
+            std::uint16_t count = 0;
+            bool leaf = true;
+        };
+
+        // Los arrays tienen un hueco extra: se inserta primero y se divide después
+        struct alignas(kCacheLine) LeafNode : NodeBase
+        {
+            LeafNode *prev = nullptr;
+            LeafNode *next = nullptr;
+            alignas(Key) unsigned char keyStorage[sizeof(Key) * (kLeafSlots + 1)];
+            alignas(Value) unsigned char valueStorage[sizeof(Value) * (kLeafSlots + 1)];
+
+            Key *keys() noexcept
+            {
+                return reinterpret_cast<Key *>(keyStorage);
+            }
+
+            Value *values() noexcept
+            {
+                return reinterpret_cast<Value *>(valueStorage);
+            }
+        };
+
+        struct alignas(kCacheLine) InternalNode : NodeBase
+        {
+            alignas(Key) unsigned char keyStorage[sizeof(Key) * (kInternalSlots + 1)];
+            NodeBase *children[kInternalSlots + 2];
+
+            Key *keys() noexcept
+            {
+                return reinterpret_cast<Key *>(keyStorage);
+            }
+        };
+
+        NodeBase *root = nullptr;
+        LeafNode *firstLeaf = nullptr;
+        LeafNode *lastLeaf = nullptr;
+        std::size_t size = 0;
+        std::size_t height = 0;
+        std::size_t leafNodes = 0;
+        std::size_t internalNodes = 0;
+        [[no_unique_address]] Compare comp;
+
+        // Declare friendship with all other BTreeMap instantiations
+        template <typename K, typename V, typename C, std::size_t B>
+        friend class BTreeMap;
+
+        template <bool IsConst>
+        class Iterator
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = std::pair<Key, Value>;
+            using difference_type = std::ptrdiff_t;
+            using reference = MapEntryRef<Key, std::conditional_t<IsConst, const Value, Value>>;
+            using pointer = MapEntryArrow<reference>;
+
+        private:
+            friend class BTreeMap;
+
+            LeafNode *leaf = nullptr;
+            std::size_t index = 0;
+
+            Iterator(LeafNode *l, std::size_t i) noexcept : leaf(l), index(i) {}
+
+        public:
+            Iterator() = default;
+
+            // Conversión de iterator a const_iterator
+            template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+            Iterator(const Iterator<OtherConst> &other) noexcept : leaf(other.leaf), index(other.index) {}
+
+            reference operator*() const noexcept
+            {
+                return reference(leaf->keys()[index], leaf->values()[index]);
+            }
+
+            pointer operator->() const noexcept
+            {
+                return pointer{**this};
+            }
+
+            Iterator &operator++() noexcept
+            {
+                ++index;
+                if (index == leaf->count && leaf->next != nullptr)
+                {
+                    leaf = leaf->next;
+                    index = 0;
+                }
+                return *this;
+            }
+
+            Iterator operator++(int) noexcept
+            {
+                Iterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            Iterator &operator--() noexcept
+            {
+                if (index == 0)
+                {
+                    leaf = leaf->prev;
+                    index = leaf->count;
+                }
+                --index;
+                return *this;
+            }
+
+            Iterator operator--(int) noexcept
+            {
+                Iterator tmp = *this;
+                --(*this);
+                return tmp;
+            }
+
+            friend bool operator==(const Iterator &a, const Iterator &b) noexcept
+            {
+                return a.leaf == b.leaf && a.index == b.index;
+            }
+
+            friend bool operator!=(const Iterator &a, const Iterator &b) noexcept
+            {
+                return !(a == b);
+            }
+
+            template <bool B>
+            friend class Iterator;
+        };
+
+    public:
+        // Tipos (aliases)
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<Key, Value>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using key_compare = Compare;
+        using reference = MapEntryRef<Key, Value>;
+        using const_reference = MapEntryRef<Key, const Value>;
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        // Constructores
+        BTreeMap() = default;
+
+        explicit BTreeMap(const Compare &comp) : comp(comp) {}
+
+        template <typename InputIt>
+        BTreeMap(InputIt first, InputIt last, const Compare &comp = Compare()) : comp(comp)
+        {
+            insert(first, last);
+        }
+
+        BTreeMap(std::initializer_list<value_type> init, const Compare &comp = Compare())
+            : BTreeMap(init.begin(), init.end(), comp) {}
+
+        // Copia en O(n): las entradas llegan ordenadas y se añaden al final
+        BTreeMap(const BTreeMap &other) : comp(other.comp)
+        {
+            for (auto it = other.begin(); it != other.end(); ++it)
+            {
+                appendBack(it->first, it->second);
+            }
+        }
+
+        BTreeMap(BTreeMap &&other) noexcept
+            : root(std::exchange(other.root, nullptr)),
+              firstLeaf(std::exchange(other.firstLeaf, nullptr)),
+              lastLeaf(std::exchange(other.lastLeaf, nullptr)),
+              size(std::exchange(other.size, 0)),
+              height(std::exchange(other.height, 0)),
+              leafNodes(std::exchange(other.leafNodes, 0)),
+              internalNodes(std::exchange(other.internalNodes, 0)),
+              comp(std::move(other.comp)) {}
+
+        ~BTreeMap()
+        {
+            clear();
+        }
+
+        // Operadores de asignación
+        BTreeMap &operator=(const BTreeMap &other)
+        {
+            if (this != &other)
+            {
+                BTreeMap tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        BTreeMap &operator=(BTreeMap &&other) noexcept
+        {
+            if (this != &other)
+            {
+                BTreeMap tmp(std::move(other));
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        BTreeMap &operator=(std::initializer_list<value_type> ilist)
+        {
+            BTreeMap tmp(ilist, comp);
+            swap(tmp);
+            return *this;
+        }
+
+        // Iteradores
+        iterator begin() noexcept
+        {
+            return iterator(firstLeaf, 0);
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return const_iterator(firstLeaf, 0);
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        iterator end() noexcept
+        {
+            return iterator(lastLeaf, lastLeaf ? lastLeaf->count : 0);
+        }
+
+        const_iterator end() const noexcept
+        {
+            return const_iterator(lastLeaf, lastLeaf ? lastLeaf->count : 0);
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return rbegin();
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        const_reverse_iterator crend() const noexcept
+        {
+            return rend();
+        }
+
+        // Capacidad
+        bool isEmpty() const noexcept
+        {
+            return size == 0;
+        }
+
+        size_type getSize() const noexcept
+        {
+            return size;
+        }
+
+        size_type getMaxSize() const noexcept
+        {
+            return static_cast<size_type>(-1) / sizeof(LeafNode) * kMinLeaf;
+        }
+
+        // Estadísticas de memoria
+        size_type getHeight() const noexcept
+        {
+            return height;
+        }
+
+        size_type getNodeCount() const noexcept
+        {
+            return leafNodes + internalNodes;
+        }
+
+        size_type getMemoryUsage() const noexcept
+        {
+            return sizeof(*this) + leafNodes * sizeof(LeafNode) + internalNodes * sizeof(InternalNode);
+        }
+
+        // Acceso a elementos
+        mapped_type &at(const key_type &key)
+        {
+            auto it = find(key);
+            if (it == end())
+            {
+                throw std::out_of_range("BTreeMap::at: key not found");
+            }
+            return it->second;
+        }
+
+        const mapped_type &at(const key_type &key) const
+        {
+            auto it = find(key);
+            if (it == end())
+            {
+                throw std::out_of_range("BTreeMap::at: key not found");
+            }
+            return it->second;
+        }
+
+        mapped_type &operator[](const key_type &key)
+        {
+            return tryEmplace(key).first->second;
+        }
+
+        mapped_type &operator[](key_type &&key)
+        {
+            return tryEmplace(std::move(key)).first->second;
+        }
+
+        // Modificadores
+        void clear() noexcept
+        {
+            if (root != nullptr)
+            {
+                destroyNode(root);
+            }
+            root = nullptr;
+            firstLeaf = nullptr;
+            lastLeaf = nullptr;
+            size = 0;
+            height = 0;
+            leafNodes = 0;
+            internalNodes = 0;
+        }
+
+        std::pair<iterator, bool> insert(const value_type &value)
+        {
+            return tryEmplace(value.first, value.second);
+        }
+
+        std::pair<iterator, bool> insert(value_type &&value)
+        {
+            return tryEmplace(std::move(value.first), std::move(value.second));
+        }
+
+        template <typename P, typename = std::enable_if_t<std::is_constructible_v<value_type, P &&>>>
+        std::pair<iterator, bool> insert(P &&value)
+        {
+            return emplace(std::forward<P>(value));
+        }
+
+        iterator insert(const_iterator hint, const value_type &value)
+        {
+            return emplaceHint(hint, value.first, value.second);
+        }
+
+        iterator insert(const_iterator hint, value_type &&value)
+        {
+            return emplaceHint(hint, std::move(value.first), std::move(value.second));
+        }
+
+        // Usa el final como hint: las entradas ya ordenadas se añaden sin descender el árbol
+        template <typename InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+            {
+                const auto &entry = *first;
+                emplaceHint(cend(), entry.first, entry.second);
+            }
+        }
+
+        void insert(std::initializer_list<value_type> ilist)
+        {
+            insert(ilist.begin(), ilist.end());
+        }
+
+        template <typename M>
+        std::pair<iterator, bool> insertOrAssign(const key_type &key, M &&value)
+        {
+            auto result = tryEmplace(key, std::forward<M>(value));
+            if (!result.second)
+            {
+                result.first->second = std::forward<M>(value);
+            }
+            return result;
+        }
+
+        template <typename... Args>
+        std::pair<iterator, bool> emplace(Args &&...args)
+        {
+            value_type tmp(std::forward<Args>(args)...);
+            return tryEmplace(std::move(tmp.first), std::move(tmp.second));
+        }
+
+        // Inserción con hint: O(1) amortizado si la clave va justo antes de hint
+        template <typename K, typename... Args>
+        iterator emplaceHint(const_iterator hint, K &&key, Args &&...args)
+        {
+            if (root != nullptr && hintIsValid(hint, key))
+            {
+                return insertInLeaf(hint.leaf, hint.index, Key(std::forward<K>(key)), Value(std::forward<Args>(args)...));
+            }
+            return tryEmplace(std::forward<K>(key), std::forward<Args>(args)...).first;
+        }
+
+        // Construye el valor solo si la clave no existe
+        template <typename K, typename... Args>
+        std::pair<iterator, bool> tryEmplace(K &&key, Args &&...args)
+        {
+            if (root == nullptr)
+            {
+                createRoot();
+            }
+            LeafNode *leaf = findLeaf(key);
+            auto pos = leafLowerBound(leaf, key);
+            if (pos < leaf->count && !comp(key, leaf->keys()[pos]))
+            {
+                return {iterator(leaf, pos), false};
+            }
+            return {insertInLeaf(leaf, pos, Key(std::forward<K>(key)), Value(std::forward<Args>(args)...)), true};
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return eraseAt(pos.leaf, pos.index);
+        }
+
+        iterator erase(iterator pos)
+        {
+            return eraseAt(pos.leaf, pos.index);
+        }
+
+        // Borrado de rango: cada borrado devuelve el siguiente iterador válido
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            auto remaining = std::distance(first, last);
+            if (remaining == static_cast<difference_type>(size))
+            {
+                clear();
+                return end();
+            }
+            iterator it(first.leaf, first.index);
+            for (; remaining > 0; --remaining)
+            {
+                it = eraseAt(it.leaf, it.index);
+            }
+            return it;
+        }
+
+        size_type erase(const key_type &key)
+        {
+            auto it = find(key);
+            if (it == end())
+            {
+                return 0;
+            }
+            eraseAt(it.leaf, it.index);
+            return 1;
+        }
+
+        void swap(BTreeMap &other) noexcept
+        {
+            using std::swap;
+            swap(root, other.root);
+            swap(firstLeaf, other.firstLeaf);
+            swap(lastLeaf, other.lastLeaf);
+            swap(size, other.size);
+            swap(height, other.height);
+            swap(leafNodes, other.leafNodes);
+            swap(internalNodes, other.internalNodes);
+            swap(comp, other.comp);
+        }
+
+        // Lookup
+        size_type count(const key_type &key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        iterator find(const key_type &key)
+        {
+            auto it = lowerBound(key);
+            if (it != end() && !comp(key, it->first))
+            {
+                return it;
+            }
+            return end();
+        }
+
+        const_iterator find(const key_type &key) const
+        {
+            return const_cast<BTreeMap *>(this)->find(key);
+        }
+
+        bool contains(const key_type &key) const
+        {
+            return find(key) != end();
+        }
+
+        std::pair<iterator, iterator> equalRange(const key_type &key)
+        {
+            auto first = lowerBound(key);
+            auto last = first;
+            if (last != end() && !comp(key, last->first))
+            {
+                ++last;
+            }
+            return {first, last};
+        }
+
+        std::pair<const_iterator, const_iterator> equalRange(const key_type &key) const
+        {
+            return const_cast<BTreeMap *>(this)->equalRange(key);
+        }
+
+        iterator lowerBound(const key_type &key)
+        {
+            if (root == nullptr)
+            {
+                return end();
+            }
+            LeafNode *leaf = findLeaf(key);
+            return normalize(leaf, leafLowerBound(leaf, key));
+        }
+
+        const_iterator lowerBound(const key_type &key) const
+        {
+            return const_cast<BTreeMap *>(this)->lowerBound(key);
+        }
+
+        iterator upperBound(const key_type &key)
+        {
+            if (root == nullptr)
+            {
+                return end();
+            }
+            LeafNode *leaf = findLeaf(key);
+            auto pos = static_cast<size_type>(std::upper_bound(leaf->keys(), leaf->keys() + leaf->count, key, comp) - leaf->keys());
+            return normalize(leaf, pos);
+        }
+
+        const_iterator upperBound(const key_type &key) const
+        {
+            return const_cast<BTreeMap *>(this)->upperBound(key);
+        }
+
+        /**
+         * @brief Batched lookups that descend the tree for many keys in lockstep
+         *
+         * `results[i]` is `find(keys[i])` (end() when the key is absent) and `results`
+         * is resized to `keys.getSize()`; containsMany() fills flags instead and
+         * returns how many keys were found. All leaves sit at the same depth, so a
+         * group of detail::kBatchLookupWidth keys descends one level at a time: each
+         * key picks its child and prefetches it, and the child is only read on the
+         * next level, after the rest of the group has issued its own loads.
+         */
+        void findMany(const Vector<Key> &keys, Vector<iterator> &results)
+        {
+            results.resize(keys.getSize());
+            descendMany(keys, [&](size_type i, iterator it)
+                        { results[i] = it; });
+        }
+
+        void findMany(const Vector<Key> &keys, Vector<const_iterator> &results) const
+        {
+            results.resize(keys.getSize());
+            const_cast<BTreeMap *>(this)->descendMany(keys, [&](size_type i, iterator it)
+                                                       { results[i] = it; });
+        }
+
+        size_type containsMany(const Vector<Key> &keys, Vector<bool> &results) const
+        {
+            results.resize(keys.getSize());
+            size_type found = 0;
+            const_cast<BTreeMap *>(this)->descendMany(keys, [&](size_type i, iterator it)
+                                                       {
+                                                           results[i] = it != end();
+                                                           found += it != end() ? 1 : 0; });
+            return found;
+        }
+
+        // Observadores
+        key_compare keyComp() const
+        {
+            return comp;
+        }
+
+        // Operadores de comparación
+        bool operator==(const BTreeMap &other) const
+        {
+            return size == other.size && std::equal(begin(), end(), other.begin(), other.end(),
+                                                    [](const const_reference &a, const const_reference &b)
+                                                    { return a.first == b.first && a.second == b.second; });
+        }
+
+        bool operator!=(const BTreeMap &other) const
+        {
+            return !(*this == other);
+        }
+
+        bool operator<(const BTreeMap &other) const
+        {
+            return std::lexicographical_compare(begin(), end(), other.begin(), other.end(),
+                                                [](const const_reference &a, const const_reference &b)
+                                                {
+                                                    return a.first < b.first || (!(b.first < a.first) && a.second < b.second);
+                                                });
+        }
+
+        bool operator<=(const BTreeMap &other) const
+        {
+            return !(other < *this);
+        }
+
+        bool operator>(const BTreeMap &other) const
+        {
+            return other < *this;
+        }
+
+        bool operator>=(const BTreeMap &other) const
+        {
+            return !(*this < other);
+        }
+
+        // Métodos adicionales que usan cppex::Vector
+
+        // Obtener todas las claves como un Vector
+        Vector<Key> getKeys() const
+        {
+            Vector<Key> keys;
+            keys.reserve(size);
+            forEach([&keys](const Key &key, const Value &)
+                    { keys.pushBack(key); });
+            return keys;
+        }
+
+        // Obtener todos los valores como un Vector
+        Vector<Value> getValues() const
+        {
+            Vector<Value> values;
+            values.reserve(size);
+            forEach([&values](const Key &, const Value &value)
+                    { values.pushBack(value); });
+            return values;
+        }
+
+        // Obtener todos los pares como un Vector
+        Vector<std::pair<Key, Value>> getEntries() const
+        {
+            Vector<std::pair<Key, Value>> entries;
+            entries.reserve(size);
+            forEach([&entries](const Key &key, const Value &value)
+                    { entries.emplaceBack(key, value); });
+            return entries;
+        }
+
+        // Mapear valores a un nuevo tipo (se construye añadiendo al final, O(n))
+        template <typename ResultType, typename UnaryFunc>
+        BTreeMap<Key, ResultType, Compare, NodeBytes> mapValues(UnaryFunc func) const
+        {
+            BTreeMap<Key, ResultType, Compare, NodeBytes> result(comp);
+            forEach([&](const Key &key, const Value &value)
+                    { result.appendBack(key, func(value)); });
+            return result;
+        }
+
+        // Filtrar entradas según un predicado
+        template <typename BinaryPredicate>
+        BTreeMap filterEntries(BinaryPredicate pred) const
+        {
+            BTreeMap result(comp);
+            forEach([&](const Key &key, const Value &value)
+                    {
+                        if (pred(key, value))
+                        {
+                            result.appendBack(key, value);
+                        } });
+            return result;
+        }
+
+        // Ejecutar una función para cada par clave-valor (recorre las hojas enlazadas)
+        template <typename BinaryFunc>
+        void forEach(BinaryFunc func)
+        {
+            for (LeafNode *leaf = firstLeaf; leaf != nullptr; leaf = leaf->next)
+            {
+                for (size_type i = 0; i < leaf->count; ++i)
+                {
+                    func(static_cast<const Key &>(leaf->keys()[i]), leaf->values()[i]);
+                }
+            }
+        }
+
+        template <typename BinaryFunc>
+        void forEach(BinaryFunc func) const
+        {
+            for (LeafNode *leaf = firstLeaf; leaf != nullptr; leaf = leaf->next)
+            {
+                for (size_type i = 0; i < leaf->count; ++i)
+                {
+                    func(static_cast<const Key &>(leaf->keys()[i]), static_cast<const Value &>(leaf->values()[i]));
+                }
+            }
+        }
+
+        // Unión de dos mapas (keys en ambos tomará los valores del mapa actual), fusión lineal
+        BTreeMap merge(const BTreeMap &other) const
+        {
+            BTreeMap result(comp);
+            auto a = begin();
+            auto b = other.begin();
+            while (a != end() && b != other.end())
+            {
+                if (comp(a->first, b->first))
+                {
+                    result.appendBack(a->first, a->second);
+                    ++a;
+                }
+                else if (comp(b->first, a->first))
+                {
+                    result.appendBack(b->first, b->second);
+                    ++b;
+                }
+                else
+                {
+                    result.appendBack(a->first, a->second);
+                    ++a;
+                    ++b;
+                }
+            }
+            for (; a != end(); ++a)
+            {
+                result.appendBack(a->first, a->second);
+            }
+            for (; b != other.end(); ++b)
+            {
+                result.appendBack(b->first, b->second);
+            }
+            return result;
+        }
+
+        // Diferencia: entradas de este mapa que no están en el otro, fusión lineal
+        BTreeMap difference(const BTreeMap &other) const
+        {
+            BTreeMap result(comp);
+            auto b = other.begin();
+            for (auto a = begin(); a != end(); ++a)
+            {
+                while (b != other.end() && comp(b->first, a->first))
+                {
+                    ++b;
+                }
+                if (b == other.end() || comp(a->first, b->first))
+                {
+                    result.appendBack(a->first, a->second);
+                }
+            }
+            return result;
+        }
+
+        // Intersección: entradas con claves en ambos mapas (valores del mapa actual), fusión lineal
+        BTreeMap intersection(const BTreeMap &other) const
+        {
+            BTreeMap result(comp);
+            auto b = other.begin();
+            for (auto a = begin(); a != end() && b != other.end(); ++a)
+            {
+                while (b != other.end() && comp(b->first, a->first))
+                {
+                    ++b;
+                }
+                if (b != other.end() && !comp(a->first, b->first))
+                {
+                    result.appendBack(a->first, a->second);
+                }
+            }
+            return result;
+        }
+
+    private:
+        // Mueve *src a dst (no inicializado) y destruye src
+        template <typename T>
+        static void relocate(T *dst, T *src)
+        {
+            std::construct_at(dst, std::move(*src));
+            std::destroy_at(src);
+        }
+
+        // Desplaza [pos, count) una posición a la derecha; deja pos sin construir
+        template <typename T>
+        static void openGap(T *items, size_type pos, size_type count)
+        {
+            for (size_type i = count; i > pos; --i)
+            {
+                relocate(items + i, items + i - 1);
+            }
+        }
+
+        // pos ya está destruido: desplaza (pos, count) una posición a la izquierda
+        template <typename T>
+        static void closeGap(T *items, size_type pos, size_type count)
+        {
+            for (size_type i = pos; i + 1 < count; ++i)
+            {
+                relocate(items + i, items + i + 1);
+            }
+        }
+
+        static void setChild(InternalNode *node, size_type index, NodeBase *child) noexcept
+        {
+            node->children[index] = child;
+            child->parent = node;
+            child->position = static_cast<std::uint16_t>(index);
+        }
+
+        LeafNode *newLeaf()
+        {
+            auto *leaf = new LeafNode();
+            ++leafNodes;
+            return leaf;
+        }
+
+        InternalNode *newInternal()
+        {
+            auto *node = new InternalNode();
+            node->leaf = false;
+            ++internalNodes;
+            return node;
+        }
+
+        void freeLeaf(LeafNode *leaf) noexcept
+        {
+            std::destroy_n(leaf->keys(), leaf->count);
+            std::destroy_n(leaf->values(), leaf->count);
+            delete leaf;
+            --leafNodes;
+        }
+
+        void freeInternal(InternalNode *node) noexcept
+        {
+            std::destroy_n(node->keys(), node->count);
+            delete node;
+            --internalNodes;
+        }
+
+        void destroyNode(NodeBase *node) noexcept
+        {
+            if (node->leaf)
+            {
+                freeLeaf(static_cast<LeafNode *>(node));
+                return;
+            }
+            auto *internal = static_cast<InternalNode *>(node);
+            for (size_type i = 0; i <= internal->count; ++i)
+            {
+                destroyNode(internal->children[i]);
+            }
+            freeInternal(internal);
+        }
+
+        void createRoot()
+        {
+            auto *leaf = newLeaf();
+            root = leaf;
+            firstLeaf = leaf;
+            lastLeaf = leaf;
+            height = 1;
+        }
+
+        template <typename K>
+        LeafNode *findLeaf(const K &key) const
+        {
+            NodeBase *node = root;
+            while (!node->leaf)
+            {
+                auto *internal = static_cast<InternalNode *>(node);
+                auto index = std::upper_bound(internal->keys(), internal->keys() + internal->count, key, comp) - internal->keys();
+                node = internal->children[index];
+            }
+            return static_cast<LeafNode *>(node);
+        }
+
+        static void prefetchNode(const NodeBase *node) noexcept
+        {
+            auto *bytes = reinterpret_cast<const unsigned char *>(node);
+            for (std::size_t offset = 0; offset < NodeBytes; offset += kCacheLine)
+            {
+                detail::prefetch(bytes + offset);
+            }
+        }
+
+        // Llama a func(i, find(keys[i])) bajando kBatchLookupWidth claves a la vez
+        template <typename Func>
+        void descendMany(const Vector<Key> &keys, Func func)
+        {
+            constexpr size_type kWidth = detail::kBatchLookupWidth;
+            size_type n = keys.getSize();
+            NodeBase *nodes[kWidth];
+            for (size_type first = 0; first < n; first += kWidth)
+            {
+                size_type count = std::min(kWidth, n - first);
+                if (root == nullptr)
+                {
+                    for (size_type j = 0; j < count; ++j)
+                    {
+                        func(first + j, end());
+                    }
+                    continue;
+                }
+                for (size_type j = 0; j < count; ++j)
+                {
+                    nodes[j] = root;
+                }
+                // Todas las hojas están a la misma profundidad: el grupo baja nivel a nivel
+                while (!nodes[0]->leaf)
+                {
+                    for (size_type j = 0; j < count; ++j)
+                    {
+                        auto *internal = static_cast<InternalNode *>(nodes[j]);
+                        auto index = std::upper_bound(internal->keys(), internal->keys() + internal->count, keys[first + j], comp) - internal->keys();
+                        nodes[j] = internal->children[index];
+                        prefetchNode(nodes[j]);
+                    }
+                }
+                for (size_type j = 0; j < count; ++j)
+                {
+                    const Key &key = keys[first + j];
+                    auto *leaf = static_cast<LeafNode *>(nodes[j]);
+                    auto pos = leafLowerBound(leaf, key);
+                    func(first + j, pos < leaf->count && !comp(key, leaf->keys()[pos]) ? iterator(leaf, pos) : end());
+                }
+            }
+        }
+
+        template <typename K>
+        size_type leafLowerBound(LeafNode *leaf, const K &key) const
+        {
+            return static_cast<size_type>(std::lower_bound(leaf->keys(), leaf->keys() + leaf->count, key, comp) - leaf->keys());
+        }
+
+        // Salta al inicio de la hoja siguiente cuando pos queda al final de una hoja intermedia
+        static iterator normalize(LeafNode *leaf, size_type pos) noexcept
+        {
+            if (pos == leaf->count && leaf->next != nullptr)
+            {
+                return iterator(leaf->next, 0);
+            }
+            return iterator(leaf, pos);
+        }
+
+        // El hint es válido si la clave queda entre prev(hint) y hint dentro de la misma hoja
+        // (o al final de la última hoja); en el inicio de una hoja se necesitaría el separador
+        template <typename K>
+        bool hintIsValid(const const_iterator &hint, const K &key) const
+        {
+            LeafNode *leaf = hint.leaf;
+            auto index = hint.index;
+            if (index == 0 && leaf != firstLeaf)
+            {
+                return false;
+            }
+            if (index > 0 && !comp(leaf->keys()[index - 1], key))
+            {
+                return false;
+            }
+            return index == leaf->count || comp(key, leaf->keys()[index]);
+        }
+
+        template <typename V>
+        void appendBack(const Key &key, V &&value)
+        {
+            if (root == nullptr)
+            {
+                createRoot();
+            }
+            insertInLeaf(lastLeaf, lastLeaf->count, Key(key), Value(std::forward<V>(value)));
+        }
+
+        iterator insertInLeaf(LeafNode *leaf, size_type pos, Key &&key, Value &&value)
+        {
+            openGap(leaf->keys(), pos, leaf->count);
+            openGap(leaf->values(), pos, leaf->count);
+            std::construct_at(leaf->keys() + pos, std::move(key));
+            std::construct_at(leaf->values() + pos, std::move(value));
+            ++leaf->count;
+            ++size;
+            if (leaf->count > kLeafSlots)
+            {
+                return splitLeaf(leaf, pos);
+            }
+            return iterator(leaf, pos);
+        }
+
+        void leafEraseAt(LeafNode *leaf, size_type pos)
+        {
+            std::destroy_at(leaf->keys() + pos);
+            std::destroy_at(leaf->values() + pos);
+            closeGap(leaf->keys(), pos, leaf->count);
+            closeGap(leaf->values(), pos, leaf->count);
+            --leaf->count;
+        }
+
+        // Mueve las entradas [from, count) de src al final de dst
+        static void leafMoveTail(LeafNode *src, size_type from, LeafNode *dst)
+        {
+            for (size_type i = from; i < src->count; ++i)
+            {
+                relocate(dst->keys() + dst->count, src->keys() + i);
+                relocate(dst->values() + dst->count, src->values() + i);
+                ++dst->count;
+            }
+            src->count = static_cast<std::uint16_t>(from);
+        }
+
+        iterator splitLeaf(LeafNode *leaf, size_type pos)
+        {
+            LeafNode *right = newLeaf();
+            size_type count = leaf->count;
+            // Inserción al final del mapa: la hoja izquierda queda llena (cargas ordenadas)
+            size_type keep = (leaf == lastLeaf && pos == count - 1) ? count - 1 : count / 2;
+            leafMoveTail(leaf, keep, right);
+
+            right->next = leaf->next;
+            right->prev = leaf;
+            if (leaf->next != nullptr)
+            {
+                leaf->next->prev = right;
+            }
+            else
+            {
+                lastLeaf = right;
+            }
+            leaf->next = right;
+
+            insertIntoParent(leaf, Key(right->keys()[0]), right);
+            return pos < keep ? iterator(leaf, pos) : iterator(right, pos - keep);
+        }
+
+        void insertIntoParent(NodeBase *left, Key &&separator, NodeBase *right)
+        {
+            if (left->parent == nullptr)
+            {
+                auto *newRoot = newInternal();
+                std::construct_at(newRoot->keys(), std::move(separator));
+                newRoot->count = 1;
+                setChild(newRoot, 0, left);
+                setChild(newRoot, 1, right);
+                root = newRoot;
+                ++height;
+                return;
+            }
+            InternalNode *parent = left->parent;
+            internalInsert(parent, left->position, std::move(separator), right);
+            if (parent->count > kInternalSlots)
+            {
+                splitInternal(parent);
+            }
+        }
+
+        // Inserta keys[keyIndex] = separator y children[keyIndex + 1] = child
+        void internalInsert(InternalNode *node, size_type keyIndex, Key &&separator, NodeBase *child)
+        {
+            openGap(node->keys(), keyIndex, node->count);
+            std::construct_at(node->keys() + keyIndex, std::move(separator));
+            for (size_type i = node->count + 1; i > keyIndex + 1; --i)
+            {
+                setChild(node, i, node->children[i - 1]);
+            }
+            setChild(node, keyIndex + 1, child);
+            ++node->count;
+        }
+
+        // Elimina keys[keyIndex] y children[keyIndex + 1]
+        void internalErase(InternalNode *node, size_type keyIndex)
+        {
+            std::destroy_at(node->keys() + keyIndex);
+            closeGap(node->keys(), keyIndex, node->count);
+            for (size_type i = keyIndex + 1; i < node->count; ++i)
+            {
+                setChild(node, i, node->children[i + 1]);
+            }
+            --node->count;
+        }
+
+        void splitInternal(InternalNode *node)
+        {
+            InternalNode *right = newInternal();
+            size_type count = node->count;
+            size_type mid = count / 2;
+
+            Key separator(std::move(node->keys()[mid]));
+            std::destroy_at(node->keys() + mid);
+            for (size_type i = mid + 1; i < count; ++i)
+            {
+                relocate(right->keys() + (i - mid - 1), node->keys() + i);
+            }
+            for (size_type i = mid + 1; i <= count; ++i)
+            {
+                setChild(right, i - mid - 1, node->children[i]);
+            }
+            right->count = static_cast<std::uint16_t>(count - mid - 1);
+            node->count = static_cast<std::uint16_t>(mid);
+
+            insertIntoParent(node, std::move(separator), right);
+        }
+
+        iterator eraseAt(LeafNode *leaf, size_type pos)
+        {
+            leafEraseAt(leaf, pos);
+            --size;
+
+            if (leaf == root)
+            {
+                if (leaf->count == 0)
+                {
+                    clear();
+                    return end();
+                }
+                return normalize(leaf, pos);
+            }
+            if (leaf->count >= kMinLeaf)
+            {
+                return normalize(leaf, pos);
+            }
+
+            // El rebalanceo mueve entradas entre nodos: se vuelve a buscar el siguiente
+            auto next = normalize(leaf, pos);
+            std::optional<Key> nextKey;
+            if (next != end())
+            {
+                nextKey.emplace(next->first);
+            }
+            rebalanceLeaf(leaf);
+            return nextKey ? lowerBound(*nextKey) : end();
+        }
+
+        void rebalanceLeaf(LeafNode *leaf)
+        {
+            InternalNode *parent = leaf->parent;
+            size_type pos = leaf->position;
+            auto *left = pos > 0 ? static_cast<LeafNode *>(parent->children[pos - 1]) : nullptr;
+            auto *right = pos < parent->count ? static_cast<LeafNode *>(parent->children[pos + 1]) : nullptr;
+
+            if (left != nullptr && left->count > kMinLeaf)
+            {
+                // Toma la última entrada del hermano izquierdo
+                size_type last = left->count - 1;
+                openGap(leaf->keys(), 0, leaf->count);
+                openGap(leaf->values(), 0, leaf->count);
+                relocate(leaf->keys(), left->keys() + last);
+                relocate(leaf->values(), left->values() + last);
+                --left->count;
+                ++leaf->count;
+                parent->keys()[pos - 1] = leaf->keys()[0];
+                return;
+            }
+            if (right != nullptr && right->count > kMinLeaf)
+            {
+                // Toma la primera entrada del hermano derecho
+                relocate(leaf->keys() + leaf->count, right->keys());
+                relocate(leaf->values() + leaf->count, right->values());
+                ++leaf->count;
+                closeGap(right->keys(), 0, right->count);
+                closeGap(right->values(), 0, right->count);
+                --right->count;
+                parent->keys()[pos] = right->keys()[0];
+                return;
+            }
+
+            if (left != nullptr)
+            {
+                mergeLeaves(left, leaf);
+                internalErase(parent, pos - 1);
+            }
+            else
+            {
+                mergeLeaves(leaf, right);
+                internalErase(parent, pos);
+            }
+            rebalanceInternal(parent);
+        }
+
+        // Vuelca right en left y libera right
+        void mergeLeaves(LeafNode *left, LeafNode *right)
+        {
+            leafMoveTail(right, 0, left);
+            left->next = right->next;
+            if (right->next != nullptr)
+            {
+                right->next->prev = left;
+            }
+            else
+            {
+                lastLeaf = left;
+            }
+            freeLeaf(right);
+        }
+
+        void rebalanceInternal(InternalNode *node)
+        {
+            if (node == root)
+            {
+                if (node->count == 0)
+                {
+                    root = node->children[0];
+                    root->parent = nullptr;
+                    root->position = 0;
+                    freeInternal(node);
+                    --height;
+                }
+                return;
+            }
+            if (node->count >= kMinInternal)
+            {
+                return;
+            }
+
+            InternalNode *parent = node->parent;
+            size_type pos = node->position;
+            auto *left = pos > 0 ? static_cast<InternalNode *>(parent->children[pos - 1]) : nullptr;
+            auto *right = pos < parent->count ? static_cast<InternalNode *>(parent->children[pos + 1]) : nullptr;
+
+            if (left != nullptr && left->count > kMinInternal)
+            {
+                // Rotación a la derecha a través del separador del padre
+                openGap(node->keys(), 0, node->count);
+                std::construct_at(node->keys(), std::move(parent->keys()[pos - 1]));
+                for (size_type i = node->count + 1; i > 0; --i)
+                {
+                    setChild(node, i, node->children[i - 1]);
+                }
+                setChild(node, 0, left->children[left->count]);
+                ++node->count;
+
+                parent->keys()[pos - 1] = std::move(left->keys()[left->count - 1]);
+                std::destroy_at(left->keys() + left->count - 1);
+                --left->count;
+                return;
+            }
+            if (right != nullptr && right->count > kMinInternal)
+            {
+                // Rotación a la izquierda a través del separador del padre
+                std::construct_at(node->keys() + node->count, std::move(parent->keys()[pos]));
+                setChild(node, node->count + 1, right->children[0]);
+                ++node->count;
+
+                parent->keys()[pos] = std::move(right->keys()[0]);
+                std::destroy_at(right->keys());
+                closeGap(right->keys(), 0, right->count);
+                for (size_type i = 0; i < right->count; ++i)
+                {
+                    setChild(right, i, right->children[i + 1]);
+                }
+                --right->count;
+                return;
+            }
+
+            if (left != nullptr)
+            {
+                mergeInternal(left, parent->keys()[pos - 1], node);
+                internalErase(parent, pos - 1);
+            }
+            else
+            {
+                mergeInternal(node, parent->keys()[pos], right);
+                internalErase(parent, pos);
+            }
+            rebalanceInternal(parent);
+        }
+
+        // left + separador + right en left; libera right
+        void mergeInternal(InternalNode *left, Key &separator, InternalNode *right)
+        {
+            size_type base = left->count;
+            std::construct_at(left->keys() + base, std::move(separator));
+            for (size_type i = 0; i < right->count; ++i)
+            {
+                relocate(left->keys() + base + 1 + i, right->keys() + i);
+            }
+            for (size_type i = 0; i <= right->count; ++i)
+            {
+                setChild(left, base + 1 + i, right->children[i]);
+            }
+            left->count = static_cast<std::uint16_t>(base + 1 + right->count);
+            right->count = 0;
+            freeInternal(right);
+        }
+    };
+
+    // Funciones de utilidad fuera de la clase
+    template <typename Key, typename Value, typename Compare, std::size_t NodeBytes>
+    void swap(BTreeMap<Key, Value, Compare, NodeBytes> &lhs, BTreeMap<Key, Value, Compare, NodeBytes> &rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+} // namespace cppex
+
+#endif // CPPEX_BTREE_MAP_HPP
@@ -0,0 +1,1057 @@
+/**
+ * @file cache.hpp
+ * @brief Bounded caches with LRU, LFU and ARC eviction and O(1) get/put
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_CACHE_HPP
+#define CPPEX_CACHE_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include "vector.hpp"   // Include Vector class
+#include "hash_map.hpp" // Include HashMap class
+
+namespace cpp_ex
+{
+
+    /**
+     * @brief Hit/miss/eviction counters of a cache
+     */
+    struct CacheStats
+    {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t insertions = 0;
+        std::uint64_t evictions = 0;
+        std::uint64_t rejections = 0; // Entradas más grandes que la capacidad completa
+
+        double getHitRatio() const noexcept
+        {
+            auto lookups = hits + misses;
+            return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+        }
+
+        CacheStats &operator+=(const CacheStats &other) noexcept
+        {
+            hits += other.hits;
+            misses += other.misses;
+            insertions += other.insertions;
+            evictions += other.evictions;
+            rejections += other.rejections;
+            return *this;
+        }
+    };
+
+    /**
+     * @brief Default size functor: every entry weighs 1, so capacity is an entry count
+     *
+     * Provide your own functor returning bytes (or any other unit) to bound a cache
+     * by weight, e.g. `[](const Key &, const String &value) { return value.getSize(); }`.
+     */
+    struct CacheEntryCount
+    {
+        template <typename Key, typename Value>
+        std::size_t operator()(const Key &, const Value &) const noexcept
+        {
+            return 1;
+        }
+    };
+
+    namespace detail
+    {
+        constexpr std::uint32_t kCacheNil = std::numeric_limits<std::uint32_t>::max();
+
+        // Lista doblemente enlazada por índices dentro del slab de nodos
+        struct CacheList
+        {
+            std::uint32_t head = kCacheNil;
+            std::uint32_t tail = kCacheNil;
+            std::size_t count = 0;
+            std::size_t weight = 0;
+        };
+
+        template <typename Key, typename Value>
+        struct CacheNode
+        {
+            std::optional<Key> key;
+            std::optional<Value> value; // Vacío en los nodos fantasma de ARC
+            std::size_t weight = 0;
+            std::uint32_t prev = kCacheNil;
+            std::uint32_t next = kCacheNil;
+            std::uint32_t owner = 0; // Lista (ARC) o bucket de frecuencia (LFU)
+        };
+
+        /**
+         * @brief Storage shared by the cache policies
+         *
+         * Nodes live in one slab (a Vector reused through a free list) and are chained
+         * by 32-bit indices, so touching an entry never allocates. A HashMap maps each
+         * key to its node index.
+         */
+        template <typename Key, typename Value, typename SizeFn, typename Hash, typename KeyEqual>
+        class CacheBase
+        {
+        public:
+            // Tipos (aliases)
+            using key_type = Key;
+            using mapped_type = Value;
+            using size_type = std::size_t;
+            using size_fn_type = SizeFn;
+            using hasher = Hash;
+            using key_equal = KeyEqual;
+
+        protected:
+            using Node = CacheNode<Key, Value>;
+
+            Vector<Node> nodes;
+            Vector<std::uint32_t> freeNodes;
+            HashMap<Key, std::uint32_t, Hash, KeyEqual> index;
+            size_type capacity;
+            size_type count = 0;  // Entradas residentes
+            size_type weight = 0; // Peso de las entradas residentes
+            [[no_unique_address]] SizeFn sizeFn;
+            CacheStats stats;
+
+            CacheBase(size_type capacity, const SizeFn &sizeFn) : capacity(capacity), sizeFn(sizeFn) {}
+
+            std::uint32_t lookup(const Key &key) const
+            {
+                auto it = index.find(key);
+                return it == index.end() ? kCacheNil : it->second;
+            }
+
+            bool isResident(std::uint32_t node) const
+            {
+                return node != kCacheNil && nodes[node].value.has_value();
+            }
+
+            template <typename K, typename V>
+            std::uint32_t allocate(K &&key, V &&value, size_type entryWeight)
+            {
+                std::uint32_t node;
+                if (!freeNodes.isEmpty())
+                {
+                    node = freeNodes.getBack();
+                    freeNodes.popBack();
+                }
+                else
+                {
+                    node = static_cast<std::uint32_t>(nodes.getSize());
+                    nodes.emplaceBack();
+                }
+                nodes[node].key.emplace(std::forward<K>(key));
+                nodes[node].value.emplace(std::forward<V>(value));
+                nodes[node].weight = entryWeight;
+                index.tryEmplace(*nodes[node].key, node);
+                ++count;
+                weight += entryWeight;
+                ++stats.insertions;
+                return node;
+            }
+
+            // Libera el nodo (ya desenlazado de su lista) y lo borra del índice
+            void release(std::uint32_t node)
+            {
+                if (nodes[node].value)
+                {
+                    --count;
+                    weight -= nodes[node].weight;
+                }
+                index.erase(*nodes[node].key);
+                nodes[node].key.reset();
+                nodes[node].value.reset();
+                freeNodes.pushBack(node);
+            }
+
+            void pushFront(CacheList &list, std::uint32_t node)
+            {
+                nodes[node].prev = kCacheNil;
+                nodes[node].next = list.head;
+                if (list.head != kCacheNil)
+                {
+                    nodes[list.head].prev = node;
+                }
+                else
+                {
+                    list.tail = node;
+                }
+                list.head = node;
+                ++list.count;
+                list.weight += nodes[node].weight;
+            }
+
+            void unlink(CacheList &list, std::uint32_t node)
+            {
+                auto &n = nodes[node];
+                if (n.prev != kCacheNil)
+                {
+                    nodes[n.prev].next = n.next;
+                }
+                else
+                {
+                    list.head = n.next;
+                }
+                if (n.next != kCacheNil)
+                {
+                    nodes[n.next].prev = n.prev;
+                }
+                else
+                {
+                    list.tail = n.prev;
+                }
+                --list.count;
+                list.weight -= n.weight;
+            }
+
+            // Cambia el valor y el peso de un nodo residente que no está enlazado
+            template <typename V>
+            void assign(std::uint32_t node, V &&value, size_type entryWeight)
+            {
+                weight = weight - nodes[node].weight + entryWeight;
+                nodes[node].weight = entryWeight;
+                *nodes[node].value = std::forward<V>(value);
+            }
+
+            void resetStorage()
+            {
+                nodes.clear();
+                freeNodes.clear();
+                index.clear();
+                count = 0;
+                weight = 0;
+            }
+
+        public:
+            // Capacidad
+            bool isEmpty() const noexcept
+            {
+                return count == 0;
+            }
+
+            size_type getSize() const noexcept
+            {
+                return count;
+            }
+
+            size_type getCapacity() const noexcept
+            {
+                return capacity;
+            }
+
+            // Peso total de las entradas residentes (igual a getSize() con CacheEntryCount)
+            size_type getWeight() const noexcept
+            {
+                return weight;
+            }
+
+            // Estadísticas
+            const CacheStats &getStats() const noexcept
+            {
+                return stats;
+            }
+
+            void resetStats() noexcept
+            {
+                stats = CacheStats();
+            }
+
+            // Lookup sin actualizar la política ni las estadísticas
+            bool contains(const Key &key) const
+            {
+                return isResident(lookup(key));
+            }
+
+            const Value *peek(const Key &key) const
+            {
+                auto node = lookup(key);
+                return isResident(node) ? &*nodes[node].value : nullptr;
+            }
+
+            // Recorre las entradas residentes en orden no especificado
+            template <typename BinaryFunc>
+            void forEach(BinaryFunc func) const
+            {
+                for (size_type i = 0; i < nodes.getSize(); ++i)
+                {
+                    if (nodes[i].value)
+                    {
+                        func(*nodes[i].key, *nodes[i].value);
+                    }
+                }
+            }
+
+            // Obtener todas las claves residentes como un Vector
+            Vector<Key> getKeys() const
+            {
+                Vector<Key> keys;
+                keys.reserve(count);
+                forEach([&keys](const Key &key, const Value &)
+                        { keys.pushBack(key); });
+                return keys;
+            }
+        };
+    }
+
+    /**
+     * @brief Least-recently-used cache
+     *
+     * get/put/erase are O(1): one HashMap probe plus relinking two indices. When the
+     * total weight would exceed the capacity, the least recently used entries are
+     * evicted. Pointers returned by find() stay valid until the next put/erase/clear.
+     *
+     * @tparam Key Type of the keys
+     * @tparam Value Type of the cached values
+     * @tparam SizeFn Functor `size_t(const Key&, const Value&)` giving the weight of an entry
+     * @tparam Hash Hash function object type, defaults to std::hash<Key>
+     * @tparam KeyEqual Equality function object type, defaults to std::equal_to<Key>
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::LruCache<int, std::string> cache(2);
+     * cache.put(1, "one");
+     * cache.put(2, "two");
+     * cache.get(1);          // 1 is now the most recently used
+     * cache.put(3, "three"); // evicts 2
+     * ```
+     */
+    template <typename Key, typename Value, typename SizeFn = CacheEntryCount, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    class LruCache : public detail::CacheBase<Key, Value, SizeFn, Hash, KeyEqual>
+    {
+    private:
+        using Base = detail::CacheBase<Key, Value, SizeFn, Hash, KeyEqual>;
+        using Base::nodes;
+        using Base::stats;
+
+        detail::CacheList recency; // head = más reciente
+
+    public:
+        using typename Base::size_type;
+
+        // Constructores
+        explicit LruCache(size_type capacity, const SizeFn &sizeFn = SizeFn()) : Base(capacity, sizeFn) {}
+
+        // Lookup que actualiza la recencia; nullptr si la clave no está
+        Value *find(const Key &key)
+        {
+            auto node = this->lookup(key);
+            if (node == detail::kCacheNil)
+            {
+                ++stats.misses;
+                return nullptr;
+            }
+            ++stats.hits;
+            this->unlink(recency, node);
+            this->pushFront(recency, node);
+            return &*nodes[node].value;
+        }
+
+        std::optional<Value> get(const Key &key)
+        {
+            auto *value = find(key);
+            return value ? std::optional<Value>(*value) : std::nullopt;
+        }
+
+        // Inserta o actualiza la entrada y la marca como la más reciente
+        template <typename V>
+        void put(const Key &key, V &&value)
+        {
+            size_type entryWeight = this->sizeFn(key, value);
+            auto node = this->lookup(key);
+            if (entryWeight > this->capacity)
+            {
+                erase(key);
+                ++stats.rejections;
+                return;
+            }
+            if (node != detail::kCacheNil)
+            {
+                this->unlink(recency, node);
+                this->assign(node, std::forward<V>(value), entryWeight);
+                makeRoom(0);
+                this->pushFront(recency, node);
+                return;
+            }
+            makeRoom(entryWeight);
+            this->pushFront(recency, this->allocate(key, std::forward<V>(value), entryWeight));
+        }
+
+        bool erase(const Key &key)
+        {
+            auto node = this->lookup(key);
+            if (node == detail::kCacheNil)
+            {
+                return false;
+            }
+            this->unlink(recency, node);
+            this->release(node);
+            return true;
+        }
+
+        void clear()
+        {
+            this->resetStorage();
+            recency = detail::CacheList();
+        }
+
+        // Cambia la capacidad, desalojando lo necesario
+        void setCapacity(size_type capacity)
+        {
+            this->capacity = capacity;
+            makeRoom(0);
+        }
+
+        // Recorre las entradas de la más reciente a la menos reciente
+        template <typename BinaryFunc>
+        void forEachByRecency(BinaryFunc func) const
+        {
+            for (auto node = recency.head; node != detail::kCacheNil; node = nodes[node].next)
+            {
+                func(*nodes[node].key, *nodes[node].value);
+            }
+        }
+
+    private:
+        void makeRoom(size_type incoming)
+        {
+            while (recency.count > 0 && this->weight + incoming > this->capacity)
+            {
+                auto victim = recency.tail;
+                this->unlink(recency, victim);
+                this->release(victim);
+                ++stats.evictions;
+            }
+        }
+    };
+
+    /**
+     * @brief Least-frequently-used cache with O(1) operations
+     *
+     * Entries are grouped in buckets of equal access count, and the buckets form a list
+     * ordered by frequency, so promoting an entry and finding the victim are O(1). Ties
+     * are broken by recency: the least recently used entry of the lowest bucket goes first.
+     *
+     * @tparam Key Type of the keys
+     * @tparam Value Type of the cached values
+     * @tparam SizeFn Functor `size_t(const Key&, const Value&)` giving the weight of an entry
+     * @tparam Hash Hash function object type, defaults to std::hash<Key>
+     * @tparam KeyEqual Equality function object type, defaults to std::equal_to<Key>
+     */
+    template <typename Key, typename Value, typename SizeFn = CacheEntryCount, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    class LfuCache : public detail::CacheBase<Key, Value, SizeFn, Hash, KeyEqual>
+    {
+    private:
+        using Base = detail::CacheBase<Key, Value, SizeFn, Hash, KeyEqual>;
+        using Base::nodes;
+        using Base::stats;
+
+        struct Bucket
+        {
+            std::uint64_t frequency = 0;
+            detail::CacheList entries;
+            std::uint32_t prev = detail::kCacheNil;
+            std::uint32_t next = detail::kCacheNil;
+        };
+
+        Vector<Bucket> buckets;
+        Vector<std::uint32_t> freeBuckets;
+        std::uint32_t lowest = detail::kCacheNil; // Bucket de menor frecuencia
+
+    public:
+        using typename Base::size_type;
+
+        // Constructores
+        explicit LfuCache(size_type capacity, const SizeFn &sizeFn = SizeFn()) : Base(capacity, sizeFn) {}
+
+        // Lookup que incrementa la frecuencia; nullptr si la clave no está
+        Value *find(const Key &key)
+        {
+            auto node = this->lookup(key);
+            if (node == detail::kCacheNil)
+            {
+                ++stats.misses;
+                return nullptr;
+            }
+            ++stats.hits;
+            touch(node);
+            return &*nodes[node].value;
+        }
+
+        std::optional<Value> get(const Key &key)
+        {
+            auto *value = find(key);
+            return value ? std::optional<Value>(*value) : std::nullopt;
+        }
+
+        // Número de accesos registrados para la clave (0 si no está)
+        std::uint64_t getFrequency(const Key &key) const
+        {
+            auto node = this->lookup(key);
+            return node == detail::kCacheNil ? 0 : buckets[nodes[node].owner].frequency;
+        }
+
+        // Inserta o actualiza la entrada; una actualización cuenta como un acceso
+        template <typename V>
+        void put(const Key &key, V &&value)
+        {
+            size_type entryWeight = this->sizeFn(key, value);
+            auto node = this->lookup(key);
+            if (entryWeight > this->capacity)
+            {
+                erase(key);
+                ++stats.rejections;
+                return;
+            }
+            if (node != detail::kCacheNil)
+            {
+                touch(node);
+                auto &bucket = buckets[nodes[node].owner].entries;
+                bucket.weight = bucket.weight - nodes[node].weight + entryWeight;
+                this->assign(node, std::forward<V>(value), entryWeight);
+                while (this->weight > this->capacity)
+                {
+                    evictOne(node);
+                }
+                return;
+            }
+            while (this->count > 0 && this->weight + entryWeight > this->capacity)
+            {
+                evictOne(detail::kCacheNil);
+            }
+            node = this->allocate(key, std::forward<V>(value), entryWeight);
+            if (lowest == detail::kCacheNil || buckets[lowest].frequency != 1)
+            {
+                lowest = newBucket(1, detail::kCacheNil, lowest);
+            }
+            nodes[node].owner = lowest;
+            this->pushFront(buckets[lowest].entries, node);
+        }
+
+        bool erase(const Key &key)
+        {
+            auto node = this->lookup(key);
+            if (node == detail::kCacheNil)
+            {
+                return false;
+            }
+            detach(node);
+            this->release(node);
+            return true;
+        }
+
+        void clear()
+        {
+            this->resetStorage();
+            buckets.clear();
+            freeBuckets.clear();
+            lowest = detail::kCacheNil;
+        }
+
+        void setCapacity(size_type capacity)
+        {
+            this->capacity = capacity;
+            while (this->weight > this->capacity)
+            {
+                evictOne(detail::kCacheNil);
+            }
+        }
+
+    private:
+        std::uint32_t newBucket(std::uint64_t frequency, std::uint32_t prev, std::uint32_t next)
+        {
+            std::uint32_t bucket;
+            if (!freeBuckets.isEmpty())
+            {
+                bucket = freeBuckets.getBack();
+                freeBuckets.popBack();
+                buckets[bucket] = Bucket();
+            }
+            else
+            {
+                bucket = static_cast<std::uint32_t>(buckets.getSize());
+                buckets.emplaceBack();
+            }
+            buckets[bucket].frequency = frequency;
+            buckets[bucket].prev = prev;
+            buckets[bucket].next = next;
+            if (prev != detail::kCacheNil)
+            {
+                buckets[prev].next = bucket;
+            }
+            if (next != detail::kCacheNil)
+            {
+                buckets[next].prev = bucket;
+            }
+            return bucket;
+        }
+
+        void removeBucket(std::uint32_t bucket)
+        {
+            auto &b = buckets[bucket];
+            if (b.prev != detail::kCacheNil)
+            {
+                buckets[b.prev].next = b.next;
+            }
+            else
+            {
+                lowest = b.next;
+            }
+            if (b.next != detail::kCacheNil)
+            {
+                buckets[b.next].prev = b.prev;
+            }
+            freeBuckets.pushBack(bucket);
+        }
+
+        // Saca el nodo de su bucket (y borra el bucket si queda vacío)
+        void detach(std::uint32_t node)
+        {
+            auto bucket = nodes[node].owner;
+            this->unlink(buckets[bucket].entries, node);
+            if (buckets[bucket].entries.count == 0)
+            {
+                removeBucket(bucket);
+            }
+        }
+
+        // Pasa el nodo al bucket de frecuencia + 1
+        void touch(std::uint32_t node)
+        {
+            auto bucket = nodes[node].owner;
+            auto frequency = buckets[bucket].frequency + 1;
+            auto next = buckets[bucket].next;
+            if (next == detail::kCacheNil || buckets[next].frequency != frequency)
+            {
+                next = newBucket(frequency, bucket, next);
+            }
+            detach(node);
+            nodes[node].owner = next;
+            this->pushFront(buckets[next].entries, node);
+        }
+
+        // Desaloja la entrada menos frecuente (y menos reciente) distinta de keep
+        void evictOne(std::uint32_t keep)
+        {
+            auto victim = buckets[lowest].entries.tail;
+            if (victim == keep)
+            {
+                victim = nodes[keep].prev != detail::kCacheNil ? nodes[keep].prev
+                                                                : buckets[buckets[lowest].next].entries.tail;
+            }
+            detach(victim);
+            this->release(victim);
+            ++stats.evictions;
+        }
+    };
+
+    /**
+     * @brief Adaptive replacement cache (ARC)
+     *
+     * Balances recency and frequency by itself: T1 holds entries seen once recently,
+     * T2 entries seen at least twice, and the ghost lists B1/B2 remember the keys (not
+     * the values) recently evicted from each. A hit in a ghost list moves the target
+     * size of T1 towards the list that would have kept the entry. Scans of one-off keys
+     * only churn T1 and cannot flush the frequently used entries in T2.
+     *
+     * All sizes are weights, so the algorithm also works with a byte-based SizeFn.
+     *
+     * @tparam Key Type of the keys
+     * @tparam Value Type of the cached values
+     * @tparam SizeFn Functor `size_t(const Key&, const Value&)` giving the weight of an entry
+     * @tparam Hash Hash function object type, defaults to std::hash<Key>
+     * @tparam KeyEqual Equality function object type, defaults to std::equal_to<Key>
+     */
+    template <typename Key, typename Value, typename SizeFn = CacheEntryCount, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    class ArcCache : public detail::CacheBase<Key, Value, SizeFn, Hash, KeyEqual>
+    {
+    private:
+        using Base = detail::CacheBase<Key, Value, SizeFn, Hash, KeyEqual>;
+        using Base::nodes;
+        using Base::stats;
+
+        enum ListId : std::uint32_t
+        {
+            kT1,
+            kT2,
+            kB1,
+            kB2
+        };
+
+        detail::CacheList lists[4];
+        std::size_t target = 0; // Peso objetivo de T1 (p en el artículo original)
+
+    public:
+        using typename Base::size_type;
+
+        // Constructores
+        explicit ArcCache(size_type capacity, const SizeFn &sizeFn = SizeFn()) : Base(capacity, sizeFn) {}
+
+        // Lookup que promociona la entrada a T2; nullptr si la clave no está
+        Value *find(const Key &key)
+        {
+            auto node = this->lookup(key);
+            if (!this->isResident(node))
+            {
+                ++stats.misses;
+                return nullptr;
+            }
+            ++stats.hits;
+            moveTo(node, kT2);
+            return &*nodes[node].value;
+        }
+
+        std::optional<Value> get(const Key &key)
+        {
+            auto *value = find(key);
+            return value ? std::optional<Value>(*value) : std::nullopt;
+        }
+
+        template <typename V>
+        void put(const Key &key, V &&value)
+        {
+            size_type entryWeight = this->sizeFn(key, value);
+            size_type capacity = this->capacity;
+            auto node = this->lookup(key);
+            if (entryWeight > capacity)
+            {
+                erase(key);
+                ++stats.rejections;
+                return;
+            }
+
+            if (this->isResident(node))
+            {
+                // Caso I: acierto en T1 o T2
+                auto list = static_cast<ListId>(nodes[node].owner);
+                this->unlink(lists[list], node);
+                this->assign(node, std::forward<V>(value), entryWeight);
+                this->pushFront(lists[kT2], node);
+                nodes[node].owner = kT2;
+                while (residentWeight() > capacity)
+                {
+                    replace(false, node);
+                }
+            }
+            else if (node != detail::kCacheNil)
+            {
+                // Casos II y III: acierto fantasma, se adapta el objetivo de T1
+                bool inB2 = nodes[node].owner == kB2;
+                auto &hit = lists[inB2 ? kB2 : kB1];
+                auto &other = lists[inB2 ? kB1 : kB2];
+                size_type delta = std::max<size_type>(1, other.weight / std::max<size_type>(hit.weight, 1)) * entryWeight;
+                target = inB2 ? (target > delta ? target - delta : 0) : std::min(capacity, target + delta);
+
+                this->unlink(hit, node);
+                makeRoom(entryWeight, inB2);
+                nodes[node].value.emplace(std::forward<V>(value));
+                nodes[node].weight = entryWeight;
+                ++this->count;
+                this->weight += entryWeight;
+                ++stats.insertions;
+                this->pushFront(lists[kT2], node);
+                nodes[node].owner = kT2;
+            }
+            else
+            {
+                // Caso IV: clave nueva
+                trimGhosts(entryWeight);
+                makeRoom(entryWeight, false);
+                node = this->allocate(key, std::forward<V>(value), entryWeight);
+                this->pushFront(lists[kT1], node);
+                nodes[node].owner = kT1;
+            }
+            trimGhosts(0);
+        }
+
+        bool erase(const Key &key)
+        {
+            auto node = this->lookup(key);
+            if (node == detail::kCacheNil)
+            {
+                return false;
+            }
+            bool resident = this->isResident(node);
+            this->unlink(lists[nodes[node].owner], node);
+            this->release(node);
+            return resident;
+        }
+
+        void clear()
+        {
+            this->resetStorage();
+            for (auto &list : lists)
+            {
+                list = detail::CacheList();
+            }
+            target = 0;
+        }
+
+        void setCapacity(size_type capacity)
+        {
+            this->capacity = capacity;
+            target = std::min(target, capacity);
+            makeRoom(0, false);
+            trimGhosts(0);
+        }
+
+        // Peso objetivo actual de T1 (para diagnóstico)
+        size_type getRecencyTarget() const noexcept
+        {
+            return target;
+        }
+
+        // Número de claves fantasma recordadas (B1 + B2)
+        size_type getGhostCount() const noexcept
+        {
+            return lists[kB1].count + lists[kB2].count;
+        }
+
+    private:
+        size_type residentWeight() const noexcept
+        {
+            return lists[kT1].weight + lists[kT2].weight;
+        }
+
+        void moveTo(std::uint32_t node, ListId list)
+        {
+            this->unlink(lists[nodes[node].owner], node);
+            this->pushFront(lists[list], node);
+            nodes[node].owner = list;
+        }
+
+        void makeRoom(size_type incoming, bool ghostHitInB2)
+        {
+            while (this->count > 0 && residentWeight() + incoming > this->capacity)
+            {
+                replace(ghostHitInB2, detail::kCacheNil);
+            }
+        }
+
+        // Convierte la entrada LRU de T1 o T2 en fantasma (B1 o B2)
+        void replace(bool ghostHitInB2, std::uint32_t keep)
+        {
+            auto &t1 = lists[kT1];
+            auto &t2 = lists[kT2];
+            bool fromT1 = t1.count > 0 && (t1.weight > target || (ghostHitInB2 && t1.weight == target) || t2.count == 0);
+            if (fromT1 && t1.tail == keep && t1.count == 1)
+            {
+                fromT1 = false;
+            }
+            else if (!fromT1 && t2.tail == keep && t2.count == 1)
+            {
+                fromT1 = true;
+            }
+
+            auto &source = fromT1 ? t1 : t2;
+            auto victim = source.tail == keep ? nodes[keep].prev : source.tail;
+            this->unlink(source, victim);
+            --this->count;
+            this->weight -= nodes[victim].weight;
+            nodes[victim].value.reset();
+            this->pushFront(lists[fromT1 ? kB1 : kB2], victim);
+            nodes[victim].owner = fromT1 ? kB1 : kB2;
+            ++stats.evictions;
+        }
+
+        // Limita la historia: |T1| + |B1| <= c y el total <= 2c
+        void trimGhosts(size_type incoming)
+        {
+            auto &b1 = lists[kB1];
+            auto &b2 = lists[kB2];
+            while (b1.count > 0 && lists[kT1].weight + b1.weight + incoming > this->capacity)
+            {
+                dropGhost(b1);
+            }
+            while (b2.count > 0 && residentWeight() + b1.weight + b2.weight + incoming > 2 * this->capacity)
+            {
+                dropGhost(b2);
+            }
+        }
+
+        void dropGhost(detail::CacheList &ghosts)
+        {
+            auto node = ghosts.tail;
+            this->unlink(ghosts, node);
+            this->release(node);
+        }
+    };
+
+    // El LRU es la política por defecto
+    template <typename Key, typename Value, typename SizeFn = CacheEntryCount, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    using Cache = LruCache<Key, Value, SizeFn, Hash, KeyEqual>;
+
+    /**
+     * @brief Thread-safe cache made of independently locked shards of any cache policy
+     *
+     * Every access updates the policy's bookkeeping, so each shard is guarded by a plain
+     * mutex; spreading keys over many shards keeps contention low. Capacity is split
+     * evenly between shards, which makes eviction approximately (not exactly) global.
+     *
+     * @tparam CacheType LruCache, LfuCache or ArcCache instantiation
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::ShardedCache<cpp_ex::LruCache<int, std::string>> cache(10000);
+     * cache.put(1, "one");             // from any thread
+     * std::optional<std::string> value = cache.get(1);
+     * ```
+     */
+    template <typename CacheType>
+    class ShardedCache
+    {
+    public:
+        // Tipos (aliases)
+        using key_type = typename CacheType::key_type;
+        using mapped_type = typename CacheType::mapped_type;
+        using size_type = std::size_t;
+        using size_fn_type = typename CacheType::size_fn_type;
+        using hasher = typename CacheType::hasher;
+
+    private:
+        static constexpr std::size_t kCacheLine = 64;
+
+        struct alignas(kCacheLine) Shard
+        {
+            mutable std::mutex mutex;
+            CacheType cache;
+
+            Shard(size_type capacity, const size_fn_type &sizeFn) : cache(capacity, sizeFn) {}
+        };
+
+        Vector<std::unique_ptr<Shard>> shards;
+        int shardShift;
+        [[no_unique_address]] hasher hashFn;
+
+    public:
+        // Constructores
+        explicit ShardedCache(size_type capacity, size_type shardCount = 16, const size_fn_type &sizeFn = size_fn_type())
+        {
+            shardCount = std::bit_ceil(std::max<size_type>(shardCount, 1));
+            shardShift = 64 - std::countr_zero(shardCount);
+            size_type perShard = (capacity + shardCount - 1) / shardCount;
+            for (size_type i = 0; i < shardCount; ++i)
+            {
+                shards.pushBack(std::make_unique<Shard>(perShard, sizeFn));
+            }
+        }
+
+        size_type getShardCount() const noexcept
+        {
+            return shards.getSize();
+        }
+
+        std::optional<mapped_type> get(const key_type &key)
+        {
+            Shard &shard = shardFor(key);
+            std::lock_guard lock(shard.mutex);
+            return shard.cache.get(key);
+        }
+
+        template <typename V>
+        void put(const key_type &key, V &&value)
+        {
+            Shard &shard = shardFor(key);
+            std::lock_guard lock(shard.mutex);
+            shard.cache.put(key, std::forward<V>(value));
+        }
+
+        /**
+         * @brief Returns the cached value, computing and caching it on a miss
+         *
+         * The loader runs under the shard lock, so concurrent misses on the same key
+         * call it only once.
+         */
+        template <typename Loader>
+        mapped_type getOrLoad(const key_type &key, Loader loader)
+        {
+            Shard &shard = shardFor(key);
+            std::lock_guard lock(shard.mutex);
+            if (auto *value = shard.cache.find(key))
+            {
+                return *value;
+            }
+            mapped_type value = loader(key);
+            shard.cache.put(key, value);
+            return value;
+        }
+
+        bool erase(const key_type &key)
+        {
+            Shard &shard = shardFor(key);
+            std::lock_guard lock(shard.mutex);
+            return shard.cache.erase(key);
+        }
+
+        bool contains(const key_type &key) const
+        {
+            const Shard &shard = shardFor(key);
+            std::lock_guard lock(shard.mutex);
+            return shard.cache.contains(key);
+        }
+
+        void clear()
+        {
+            for (auto &shard : shards)
+            {
+                std::lock_guard lock(shard->mutex);
+                shard->cache.clear();
+            }
+        }
+
+        size_type getSize() const
+        {
+            size_type total = 0;
+            for (const auto &shard : shards)
+            {
+                std::lock_guard lock(shard->mutex);
+                total += shard->cache.getSize();
+            }
+            return total;
+        }
+
+        size_type getWeight() const
+        {
+            size_type total = 0;
+            for (const auto &shard : shards)
+            {
+                std::lock_guard lock(shard->mutex);
+                total += shard->cache.getWeight();
+            }
+            return total;
+        }
+
+        // Suma de las estadísticas de todos los shards
+        CacheStats getStats() const
+        {
+            CacheStats total;
+            for (const auto &shard : shards)
+            {
+                std::lock_guard lock(shard->mutex);
+                total += shard->cache.getStats();
+            }
+            return total;
+        }
+
+    private:
+        Shard &shardFor(const key_type &key) const
+        {
+            if (shards.getSize() == 1)
+            {
+                return *shards[0];
+            }
+            auto hash = detail::mixHash(static_cast<std::uint64_t>(hashFn(key)));
+            return *shards[static_cast<size_type>(hash >> shardShift)];
+        }
+    };
+
+} // namespace cppex
+
+#endif // CPPEX_CACHE_HPP
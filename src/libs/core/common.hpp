@@ -8,11 +8,32 @@
 #ifndef CPPEX_COMMON_HPP
 #define CPPEX_COMMON_HPP
 
+#include <cstddef>
 #include <stdexcept>
 #include <string>
 
 namespace cpp_ex
 {
+    namespace detail
+    {
+        // Comparador/hash que acepta claves de otros tipos (find("abc") sin construir la clave)
+        template <typename F>
+        concept IsTransparent = requires { typename F::is_transparent; };
+
+        // Claves que findMany()/containsMany() sondean a la vez (búsquedas en vuelo)
+        constexpr std::size_t kBatchLookupWidth = 16;
+
+        // Pide la línea de caché de address sin bloquear (no-op si el compilador no lo soporta)
+        inline void prefetch(const void *address) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(address, 0, 3);
+#else
+            (void)address;
+#endif
+        }
+    }
+
     namespace exceptions
     {
 
@@ -45,6 +66,20 @@ namespace cpp_ex
                 : std::runtime_error(what_arg) {}
         };
 
+        /**
+         * @brief Exception thrown when binary data cannot be decoded
+         *
+         * Thrown by BinaryReader when the input ends early or holds an invalid
+         * encoding, and by the classes that load snapshots or logs when a checksum or
+         * header does not match.
+         */
+        class SerializationError : public std::runtime_error
+        {
+        public:
+            SerializationError(const std::string &what_arg = "Invalid serialized data")
+                : std::runtime_error(what_arg) {}
+        };
+
     } // namespace exceptions
 } // namespace cpp_ex
 
@@ -0,0 +1,393 @@
+/**
+ * @file concurrent_hash_map.hpp
+ * @brief Thread-safe hash map split in independently locked shards
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_CONCURRENT_HASH_MAP_HPP
+#define CPPEX_CONCURRENT_HASH_MAP_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+#include "vector.hpp"   // Include Vector class
+#include "hash_map.hpp" // Include HashMap class
+
+namespace cpp_ex
+{
+
+    /**
+     * @brief Hash map safe to use from many threads at once
+     *
+     * Entries are distributed over a power-of-two number of shards by the high bits of
+     * the (mixed) hash. Each shard is a HashMap protected by its own reader-writer lock
+     * and padded to a cache line, so threads working on different shards never contend
+     * and readers of the same shard run in parallel.
+     *
+     * There are no iterators or references into the map: another thread could erase
+     * the entry or rehash the shard at any time. Lookups return copies (`std::optional`),
+     * and read-modify-write operations (`computeIfAbsent`, `updateWith`) run the
+     * callback while holding the shard's exclusive lock, which makes them atomic with
+     * respect to every other operation on the same key. Callbacks must not call back
+     * into the map.
+     *
+     * `forEach`, `getSize` and the snapshot methods visit shards one after another, so
+     * they are weakly consistent: they see every entry that was present for the whole
+     * call and may or may not see concurrent insertions and erasures.
+     *
+     * @tparam Key Type of the keys
+     * @tparam Value Type of the mapped values (must be copy constructible)
+     * @tparam Hash Hash function object type, defaults to std::hash<Key>
+     * @tparam KeyEqual Equality function object type, defaults to std::equal_to<Key>
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::ConcurrentHashMap<std::string, int> hits;
+     *
+     * // From any thread
+     * hits.computeIfAbsent("/index", [] { return 0; });
+     * hits.updateWith("/index", [](int &count) { ++count; });
+     *
+     * if (auto count = hits.find("/index")) {
+     *     std::cout << *count << std::endl;
+     * }
+     * ```
+     */
+    template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    class ConcurrentHashMap
+    {
+    public:
+        // Tipos (aliases)
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<const Key, Value>;
+        using size_type = std::size_t;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+
+    private:
+        static constexpr std::size_t kCacheLine = 64;
+
+        // Cada shard ocupa sus propias líneas de caché para evitar false sharing
+        struct alignas(kCacheLine) Shard
+        {
+            mutable std::shared_mutex mutex;
+            HashMap<Key, Value, Hash, KeyEqual> map;
+
+            Shard(const Hash &hash, const KeyEqual &equal) : map(0, hash, equal) {}
+        };
+
+        Vector<std::unique_ptr<Shard>> shards;
+        size_type shardCount;
+        int shardShift;
+        [[no_unique_address]] Hash hashFn;
+        [[no_unique_address]] KeyEqual eqFn;
+
+    public:
+        // Constructores
+        ConcurrentHashMap() : ConcurrentHashMap(getDefaultShardCount()) {}
+
+        // El número de shards se redondea a la siguiente potencia de dos; cada shard usa hash y equal
+        explicit ConcurrentHashMap(size_type shardCount, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual())
+            : shardCount(std::bit_ceil(std::max<size_type>(shardCount, 1))),
+              hashFn(hash), eqFn(equal)
+        {
+            shards.reserve(this->shardCount);
+            for (size_type i = 0; i < this->shardCount; ++i)
+            {
+                shards.pushBack(std::make_unique<Shard>(hash, equal));
+            }
+            shardShift = 64 - std::countr_zero(this->shardCount);
+        }
+
+        ConcurrentHashMap(std::initializer_list<value_type> init) : ConcurrentHashMap()
+        {
+            for (const auto &pair : init)
+            {
+                insert(pair.first, pair.second);
+            }
+        }
+
+        // Los mutex no se copian ni se mueven
+        ConcurrentHashMap(const ConcurrentHashMap &) = delete;
+        ConcurrentHashMap &operator=(const ConcurrentHashMap &) = delete;
+
+        // Cuatro shards por hilo hardware: poca contención sin malgastar memoria
+        static size_type getDefaultShardCount() noexcept
+        {
+            return std::bit_ceil(std::max<size_type>(std::thread::hardware_concurrency(), 1) * 4);
+        }
+
+        // Capacidad
+        size_type getShardCount() const noexcept
+        {
+            return shardCount;
+        }
+
+        // Suma de los shards (débilmente consistente)
+        size_type getSize() const
+        {
+            size_type total = 0;
+            for (size_type i = 0; i < shardCount; ++i)
+            {
+                std::shared_lock lock(shards[i]->mutex);
+                total += shards[i]->map.getSize();
+            }
+            return total;
+        }
+
+        bool isEmpty() const
+        {
+            for (size_type i = 0; i < shardCount; ++i)
+            {
+                std::shared_lock lock(shards[i]->mutex);
+                if (!shards[i]->map.isEmpty())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Reparte la reserva entre los shards
+        void reserve(size_type count)
+        {
+            size_type perShard = (count + shardCount - 1) / shardCount;
+            for (size_type i = 0; i < shardCount; ++i)
+            {
+                std::unique_lock lock(shards[i]->mutex);
+                shards[i]->map.reserve(perShard);
+            }
+        }
+
+        // Modificadores
+
+        // Inserta si la clave no existe; devuelve true si se insertó
+        bool insert(const key_type &key, const mapped_type &value)
+        {
+            Shard &shard = shardFor(key);
+            std::unique_lock lock(shard.mutex);
+            return shard.map.tryEmplace(key, value).second;
+        }
+
+        // Inserta o sobrescribe; devuelve true si la clave era nueva
+        template <typename M>
+        bool insertOrAssign(const key_type &key, M &&value)
+        {
+            Shard &shard = shardFor(key);
+            std::unique_lock lock(shard.mutex);
+            return shard.map.insertOrAssign(key, std::forward<M>(value)).second;
+        }
+
+        /**
+         * @brief Returns the value for key, creating it with factory() if it is missing
+         *
+         * The common hit path only takes the shared lock. On a miss the key is checked
+         * again under the exclusive lock, so factory runs at most once per key even
+         * when several threads miss at the same time.
+         *
+         * @param key Key to look up
+         * @param factory Callable with no arguments returning the value to insert
+         * @return Copy of the stored value
+         */
+        template <typename Factory>
+        mapped_type computeIfAbsent(const key_type &key, Factory factory)
+        {
+            Shard &shard = shardFor(key);
+            {
+                std::shared_lock lock(shard.mutex);
+                auto it = shard.map.find(key);
+                if (it != shard.map.end())
+                {
+                    return it->second;
+                }
+            }
+            std::unique_lock lock(shard.mutex);
+            auto it = shard.map.find(key);
+            if (it == shard.map.end())
+            {
+                it = shard.map.tryEmplace(key, factory()).first;
+            }
+            return it->second;
+        }
+
+        /**
+         * @brief Applies func(Value&) to the value of key atomically
+         *
+         * @param key Key to update
+         * @param func Callable receiving a mutable reference to the value
+         * @return true if the key existed (and func was called)
+         */
+        template <typename UnaryFunc>
+        bool updateWith(const key_type &key, UnaryFunc func)
+        {
+            Shard &shard = shardFor(key);
+            std::unique_lock lock(shard.mutex);
+            auto it = shard.map.find(key);
+            if (it == shard.map.end())
+            {
+                return false;
+            }
+            func(it->second);
+            return true;
+        }
+
+        // Actualiza con func, o inserta initial si la clave no existe
+        template <typename UnaryFunc>
+        void upsert(const key_type &key, const mapped_type &initial, UnaryFunc func)
+        {
+            Shard &shard = shardFor(key);
+            std::unique_lock lock(shard.mutex);
+            auto result = shard.map.tryEmplace(key, initial);
+            if (!result.second)
+            {
+                func(result.first->second);
+            }
+        }
+
+        bool erase(const key_type &key)
+        {
+            Shard &shard = shardFor(key);
+            std::unique_lock lock(shard.mutex);
+            return shard.map.erase(key) == 1;
+        }
+
+        // Borra las entradas que cumplen pred(key, value); devuelve cuántas se borraron
+        template <typename BinaryPredicate>
+        size_type eraseIf(BinaryPredicate pred)
+        {
+            size_type erased = 0;
+            for (size_type i = 0; i < shardCount; ++i)
+            {
+                std::unique_lock lock(shards[i]->mutex);
+                auto &map = shards[i]->map;
+                for (auto it = map.begin(); it != map.end();)
+                {
+                    if (pred(it->first, it->second))
+                    {
+                        it = map.erase(it);
+                        ++erased;
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+            }
+            return erased;
+        }
+
+        void clear()
+        {
+            for (size_type i = 0; i < shardCount; ++i)
+            {
+                std::unique_lock lock(shards[i]->mutex);
+                shards[i]->map.clear();
+            }
+        }
+
+        // Lookup
+        std::optional<mapped_type> find(const key_type &key) const
+        {
+            const Shard &shard = shardFor(key);
+            std::shared_lock lock(shard.mutex);
+            auto it = shard.map.find(key);
+            if (it == shard.map.end())
+            {
+                return std::nullopt;
+            }
+            return it->second;
+        }
+
+        mapped_type getOrDefault(const key_type &key, const mapped_type &defaultValue) const
+        {
+            auto value = find(key);
+            return value ? *value : defaultValue;
+        }
+
+        bool contains(const key_type &key) const
+        {
+            const Shard &shard = shardFor(key);
+            std::shared_lock lock(shard.mutex);
+            return shard.map.contains(key);
+        }
+
+        size_type count(const key_type &key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        // Recorrido débilmente consistente: bloquea (en modo compartido) un shard cada vez
+        template <typename BinaryFunc>
+        void forEach(BinaryFunc func) const
+        {
+            for (size_type i = 0; i < shardCount; ++i)
+            {
+                std::shared_lock lock(shards[i]->mutex);
+                shards[i]->map.forEach(func);
+            }
+        }
+
+        // Observadores
+        hasher hashFunction() const
+        {
+            return hashFn;
+        }
+
+        key_equal keyEq() const
+        {
+            return eqFn;
+        }
+
+        // Métodos adicionales que usan cppex::Vector (copias débilmente consistentes)
+
+        Vector<Key> getKeys() const
+        {
+            Vector<Key> keys;
+            forEach([&keys](const Key &key, const Value &)
+                    { keys.pushBack(key); });
+            return keys;
+        }
+
+        Vector<std::pair<Key, Value>> getEntries() const
+        {
+            Vector<std::pair<Key, Value>> entries;
+            forEach([&entries](const Key &key, const Value &value)
+                    { entries.emplaceBack(key, value); });
+            return entries;
+        }
+
+        // Copia a un HashMap normal (para procesarlo sin bloqueos)
+        HashMap<Key, Value, Hash, KeyEqual> toHashMap() const
+        {
+            HashMap<Key, Value, Hash, KeyEqual> result(0, hashFn, eqFn);
+            forEach([&result](const Key &key, const Value &value)
+                    { result.tryEmplace(key, value); });
+            return result;
+        }
+
+    private:
+        // Bits altos del hash mezclado: el HashMap de cada shard usa los bajos
+        Shard &shardFor(const key_type &key) const
+        {
+            if (shardCount == 1)
+            {
+                return *shards[0];
+            }
+            auto hash = detail::mixHash(static_cast<std::uint64_t>(hashFn(key)));
+            return *shards[static_cast<size_type>(hash >> shardShift)];
+        }
+    };
+
+} // namespace cppex
+
+#endif // CPPEX_CONCURRENT_HASH_MAP_HPP
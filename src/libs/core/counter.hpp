@@ -0,0 +1,510 @@
+/**
+ * @file counter.hpp
+ * @brief Multiset-style counters: single-probe increments, top-k and counter arithmetic
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_COUNTER_HPP
+#define CPPEX_COUNTER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include "vector.hpp"   // Include Vector class
+#include "map.hpp"      // Include Map class
+#include "hash_map.hpp" // Include HashMap class
+
+namespace cpp_ex
+{
+
+    /**
+     * @brief Counts occurrences of keys, like Python's `collections.Counter`
+     *
+     * `increment()` does a single probe of the backend (`operator[]` creates the entry
+     * with count 0 if needed), instead of the `contains()` + `operator[]` pair. Only
+     * keys with a positive count are kept: `decrement()` and `subtract()` erase the
+     * entries that drop to zero or below, so `getSize()` is the number of distinct keys
+     * present and `getCount()` returns 0 for the others.
+     *
+     * The backend is any map template taking `<Key, Count>`: `HashMap` (default, fastest
+     * increments) or `Map` (keys iterated in order, and `mostCommon()` breaks ties by
+     * key order).
+     *
+     * @tparam Key Type of the counted keys
+     * @tparam Backend Map template storing the counts
+     * @tparam Count Signed integer type of the counts
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::Counter<cpp_ex::String> words;
+     * for (const auto &word : text.split(" ")) {
+     *     words.increment(word);
+     * }
+     * auto top = words.mostCommon(10); // Vector of (word, count), highest first
+     *
+     * cpp_ex::Counter<char, cpp_ex::Map> letters = {'a', 'b', 'a'};
+     * letters.add(other).subtract(stopLetters);
+     * ```
+     */
+    template <typename Key, template <typename, typename> class Backend = HashMap, typename Count = std::int64_t>
+    class Counter
+    {
+    public:
+        // Tipos (aliases)
+        using key_type = Key;
+        using count_type = Count;
+        using size_type = std::size_t;
+        using backend_type = Backend<Key, Count>;
+        using const_iterator = typename backend_type::const_iterator;
+
+    private:
+        backend_type counts;
+
+    public:
+        // Constructores
+        Counter() = default;
+
+        // Cuenta cada elemento del rango
+        template <typename InputIt>
+        Counter(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+            {
+                increment(*first);
+            }
+        }
+
+        Counter(std::initializer_list<Key> keys) : Counter(keys.begin(), keys.end()) {}
+
+        // Iteradores (sólo lectura: los recuentos se cambian con increment/decrement)
+        const_iterator begin() const
+        {
+            return counts.begin();
+        }
+
+        const_iterator end() const
+        {
+            return counts.end();
+        }
+
+        // Capacidad
+        bool isEmpty() const noexcept
+        {
+            return counts.isEmpty();
+        }
+
+        // Número de claves distintas
+        size_type getSize() const noexcept
+        {
+            return counts.getSize();
+        }
+
+        // Suma de todos los recuentos
+        Count getTotal() const
+        {
+            Count total = 0;
+            for (const auto &[key, count] : counts)
+            {
+                total += count;
+            }
+            return total;
+        }
+
+        // Modificadores
+        /**
+         * @brief Adds n to the count of key with a single lookup
+         *
+         * @return The new count (the entry is erased if it is not positive)
+         */
+        template <typename K>
+        Count increment(K &&key, Count n = 1)
+        {
+            if (n > 0)
+            {
+                return counts[std::forward<K>(key)] += n;
+            }
+            return decrement(std::forward<K>(key), -n);
+        }
+
+        template <typename K>
+        Count decrement(K &&key, Count n = 1)
+        {
+            auto it = counts.find(key);
+            if (it == counts.end())
+            {
+                return 0;
+            }
+            Count result = it->second -= n;
+            if (result <= 0)
+            {
+                counts.erase(it);
+                return 0;
+            }
+            return result;
+        }
+
+        size_type erase(const Key &key)
+        {
+            return counts.erase(key);
+        }
+
+        void clear() noexcept
+        {
+            counts.clear();
+        }
+
+        // Suma elemento a elemento
+        template <template <typename, typename> class OtherBackend>
+        Counter &add(const Counter<Key, OtherBackend, Count> &other)
+        {
+            for (const auto &[key, count] : other)
+            {
+                counts[key] += count;
+            }
+            return *this;
+        }
+
+        // Resta elemento a elemento; desaparecen las claves que quedan en cero o menos
+        template <template <typename, typename> class OtherBackend>
+        Counter &subtract(const Counter<Key, OtherBackend, Count> &other)
+        {
+            for (const auto &[key, count] : other)
+            {
+                decrement(key, count);
+            }
+            return *this;
+        }
+
+        Counter operator+(const Counter &other) const
+        {
+            Counter result = *this;
+            result.add(other);
+            return result;
+        }
+
+        Counter operator-(const Counter &other) const
+        {
+            Counter result = *this;
+            result.subtract(other);
+            return result;
+        }
+
+        // Lookup
+        template <typename K>
+        Count getCount(const K &key) const
+        {
+            auto it = counts.find(key);
+            return it == counts.end() ? 0 : it->second;
+        }
+
+        template <typename K>
+        bool contains(const K &key) const
+        {
+            return counts.contains(key);
+        }
+
+        /**
+         * @brief The k keys with the highest counts, highest first
+         *
+         * Runs in O(n log k). Ties keep the backend's iteration order.
+         */
+        Vector<std::pair<Key, Count>> mostCommon(size_type k) const
+        {
+            // Se ordenan pares (recuento, posición) y sólo se copian las k claves elegidas
+            Vector<const_iterator> positions;
+            Vector<std::pair<Count, size_type>> order;
+            positions.reserve(counts.getSize());
+            order.reserve(counts.getSize());
+            for (auto it = counts.begin(); it != counts.end(); ++it)
+            {
+                order.pushBack({it->second, positions.getSize()});
+                positions.pushBack(it);
+            }
+            k = std::min(k, order.getSize());
+            std::partial_sort(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(k), order.end(),
+                              [](const auto &a, const auto &b)
+                              {
+                                  // Empates: el que aparece antes en el backend
+                                  return a.first != b.first ? a.first > b.first : a.second < b.second;
+                              });
+            Vector<std::pair<Key, Count>> result;
+            result.reserve(k);
+            for (size_type i = 0; i < k; ++i)
+            {
+                result.pushBack({positions[order[i].second]->first, order[i].first});
+            }
+            return result;
+        }
+
+        // Recorrido
+        template <typename BinaryFunc>
+        void forEach(BinaryFunc func) const
+        {
+            for (const auto &[key, count] : counts)
+            {
+                func(key, count);
+            }
+        }
+
+        const backend_type &getBackend() const noexcept
+        {
+            return counts;
+        }
+
+        // Comparación
+        bool operator==(const Counter &other) const
+        {
+            return counts == other.counts;
+        }
+
+        bool operator!=(const Counter &other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    /**
+     * @brief Counter for many threads incrementing at once, merged on read
+     *
+     * Every thread that calls `increment()` gets its own shard of this counter (a
+     * HashMap behind a mutex only that thread locks while counting), so increments
+     * from different threads never touch the same cache lines or wait for each other.
+     * Reads (`getCount`, `snapshot`, `mostCommon`...) lock the shards one by one and
+     * merge them, so they are weakly consistent and cost O(threads) (or O(entries))
+     * each: this type is meant for write-heavy statistics read now and then.
+     *
+     * Shards outlive the threads that created them, so no count is lost when a thread
+     * exits. A thread finds its shard through a thread_local cache keyed by a counter
+     * id that is never reused. The cache holds weak references: the destructor drops
+     * the entry of its own thread, and entries left by destroyed counters in other
+     * threads are pruned whenever the cache doubles in size, so it stays proportional
+     * to the number of live counters each thread uses.
+     *
+     * @tparam Key Type of the counted keys
+     * @tparam Count Signed integer type of the counts
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::ConcurrentCounter<cpp_ex::String> hits;
+     * // From any number of threads
+     * hits.increment(request.getPath());
+     *
+     * // Reporting thread
+     * for (const auto &[path, count] : hits.mostCommon(10)) { ... }
+     * ```
+     */
+    template <typename Key, typename Count = std::int64_t>
+    class ConcurrentCounter
+    {
+    public:
+        // Tipos (aliases)
+        using key_type = Key;
+        using count_type = Count;
+        using size_type = std::size_t;
+
+    private:
+        // Relleno a una línea de caché: cada hilo escribe sólo en el suyo
+        struct alignas(64) Shard
+        {
+            mutable std::mutex mutex;
+            HashMap<Key, Count> counts;
+        };
+
+        // Caché por hilo: id de contador -> fragmento de este hilo (weak_ptr para detectar los destruidos)
+        struct ThreadCache
+        {
+            HashMap<std::uint64_t, std::weak_ptr<Shard>> entries;
+            std::size_t pruneAt = kMinPrune;
+            // El último contador usado por el hilo evita incluso la búsqueda en la caché
+            std::uint64_t lastId = 0;
+            Shard *lastShard = nullptr;
+        };
+        static constexpr std::size_t kMinPrune = 16;
+
+        std::uint64_t id;
+        mutable std::mutex registryMutex;
+        Vector<std::shared_ptr<Shard>> shards;
+
+        static std::uint64_t nextId() noexcept
+        {
+            static std::atomic<std::uint64_t> counter{0};
+            return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+    public:
+        // Constructores
+        ConcurrentCounter() : id(nextId()) {}
+
+        ConcurrentCounter(const ConcurrentCounter &) = delete;
+        ConcurrentCounter &operator=(const ConcurrentCounter &) = delete;
+
+        // Limpia la caché del hilo que destruye el contador; las de otros hilos se purgan después
+        ~ConcurrentCounter()
+        {
+            ThreadCache &cache = threadCache();
+            cache.entries.erase(id);
+            if (cache.lastId == id)
+            {
+                cache.lastId = 0;
+                cache.lastShard = nullptr;
+            }
+        }
+
+        // Modificadores
+        template <typename K>
+        void increment(K &&key, Count n = 1)
+        {
+            Shard &shard = localShard();
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            Count &count = shard.counts[std::forward<K>(key)];
+            count += n;
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> registry(registryMutex);
+            for (auto &shard : shards)
+            {
+                std::lock_guard<std::mutex> lock(shard->mutex);
+                shard->counts.clear();
+            }
+        }
+
+        // Lectura (fusiona los fragmentos)
+        template <typename K>
+        Count getCount(const K &key) const
+        {
+            Count total = 0;
+            std::lock_guard<std::mutex> registry(registryMutex);
+            for (const auto &shard : shards)
+            {
+                std::lock_guard<std::mutex> lock(shard->mutex);
+                auto it = shard->counts.find(key);
+                if (it != shard->counts.end())
+                {
+                    total += it->second;
+                }
+            }
+            return total > 0 ? total : 0;
+        }
+
+        // Todos los recuentos fusionados en un Counter (sin claves en cero o menos)
+        template <template <typename, typename> class Backend = HashMap>
+        Counter<Key, Backend, Count> snapshot() const
+        {
+            // Se suman primero los fragmentos: uno puede tener negativos que otro compensa
+            HashMap<Key, Count> totals;
+            {
+                std::lock_guard<std::mutex> registry(registryMutex);
+                for (const auto &shard : shards)
+                {
+                    std::lock_guard<std::mutex> lock(shard->mutex);
+                    for (const auto &[key, count] : shard->counts)
+                    {
+                        totals[key] += count;
+                    }
+                }
+            }
+            Counter<Key, Backend, Count> merged;
+            for (const auto &[key, count] : totals)
+            {
+                if (count > 0)
+                {
+                    merged.increment(key, count);
+                }
+            }
+            return merged;
+        }
+
+        Vector<std::pair<Key, Count>> mostCommon(size_type k) const
+        {
+            return snapshot().mostCommon(k);
+        }
+
+        Count getTotal() const
+        {
+            return snapshot().getTotal();
+        }
+
+        // Número de hilos que han incrementado este contador
+        size_type getShardCount() const
+        {
+            std::lock_guard<std::mutex> registry(registryMutex);
+            return shards.getSize();
+        }
+
+        // Entradas en la caché del hilo actual, incluidas las de contadores destruidos aún sin purgar
+        static size_type getThreadCacheSize()
+        {
+            return threadCache().entries.getSize();
+        }
+
+    private:
+        static ThreadCache &threadCache()
+        {
+            thread_local ThreadCache cache;
+            return cache;
+        }
+
+        Shard &localShard()
+        {
+            ThreadCache &cache = threadCache();
+            // Los id no se reutilizan: lastShard solo se usa mientras su contador exista
+            if (cache.lastId == id)
+            {
+                return *cache.lastShard;
+            }
+            Shard *shard = nullptr;
+            if (auto it = cache.entries.find(id); it != cache.entries.end())
+            {
+                // Este contador está vivo, así que su fragmento también
+                shard = it->second.lock().get();
+            }
+            else
+            {
+                auto created = std::make_shared<Shard>();
+                {
+                    std::lock_guard<std::mutex> registry(registryMutex);
+                    shards.pushBack(created);
+                }
+                prune(cache);
+                cache.entries[id] = created;
+                shard = created.get();
+            }
+            cache.lastId = id;
+            cache.lastShard = shard;
+            return *shard;
+        }
+
+        // Borra las entradas de contadores destruidos cuando la caché dobla su tamaño: O(1) amortizado por alta
+        static void prune(ThreadCache &cache)
+        {
+            if (cache.entries.getSize() < cache.pruneAt)
+            {
+                return;
+            }
+            for (auto it = cache.entries.begin(); it != cache.entries.end();)
+            {
+                if (it->second.expired())
+                {
+                    it = cache.entries.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            cache.pruneAt = std::max(kMinPrune, cache.entries.getSize() * 2);
+        }
+    };
+
+} // namespace cppex
+
+#endif // CPPEX_COUNTER_HPP
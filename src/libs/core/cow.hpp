@@ -0,0 +1,188 @@
+/**
+ * @file cow.hpp
+ * @brief Copy-on-write handle: O(1) copies of Map, Vector, String or any copyable value
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_COW_HPP
+#define CPPEX_COW_HPP
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "vector.hpp" // Include Vector class
+#include "map.hpp"    // Include Map class
+#include "string.hpp" // Include String class
+
+namespace cpp_ex
+{
+
+    /**
+     * @brief Value-semantic handle that shares its value until the first mutation
+     *
+     * Copying a Cow copies a pointer and bumps an atomic reference count, whatever
+     * the size of the value. All the copies share one buffer and read it through
+     * `read()` (or the implicit conversion to `const T&`). The first `write()` or
+     * `mutate()` on a shared handle copies the value once, so that handle gets its
+     * own buffer and the others never see the change.
+     *
+     * Copies may live in different threads: sharing and unsharing are thread-safe,
+     * and a shared buffer is never written. As with any object, one Cow handle must
+     * not be written from one thread while another thread uses that same handle.
+     *
+     * Obtain the reference from `write()` only when you are about to modify the
+     * value: calling it on a shared handle copies even if nothing changes. A
+     * moved-from Cow may only be assigned to or destroyed.
+     *
+     * @tparam T Type of the value (copy constructible)
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::Cow<cpp_ex::Map<cpp_ex::String, int>> config = loadConfig();
+     * auto snapshot = config;              // O(1), shares the map
+     * render(snapshot.read());             // Read-only: still shared
+     *
+     * config.write()["retries"] = 5;       // Copies once, then modifies
+     * config.mutate([](auto &map) { map.erase("debug"); }); // Already unique: no copy
+     * ```
+     */
+    template <typename T>
+    class Cow
+    {
+        static_assert(std::is_copy_constructible_v<T>, "Cow requires a copy constructible type");
+
+    private:
+        std::shared_ptr<T> value;
+
+    public:
+        // Tipos (aliases)
+        using value_type = T;
+
+        // Constructores
+        Cow() : value(std::make_shared<T>()) {}
+
+        Cow(const T &other) : value(std::make_shared<T>(other)) {}
+
+        Cow(T &&other) : value(std::make_shared<T>(std::move(other))) {}
+
+        // Construye el valor en el propio buffer compartido
+        template <typename... Args>
+        explicit Cow(std::in_place_t, Args &&...args) : value(std::make_shared<T>(std::forward<Args>(args)...)) {}
+
+        // Copia y movimiento O(1) (por defecto: copian o mueven el puntero)
+        Cow(const Cow &) = default;
+        Cow(Cow &&) noexcept = default;
+        Cow &operator=(const Cow &) = default;
+        Cow &operator=(Cow &&) noexcept = default;
+
+        // Lectura (nunca copia)
+        const T &read() const noexcept
+        {
+            return *value;
+        }
+
+        const T &operator*() const noexcept
+        {
+            return *value;
+        }
+
+        const T *operator->() const noexcept
+        {
+            return value.get();
+        }
+
+        operator const T &() const noexcept
+        {
+            return *value;
+        }
+
+        // Escritura
+        /**
+         * @brief Mutable access, copying the value first if it is shared
+         *
+         * The reference is valid until this handle is copied from, assigned to or
+         * destroyed; do not keep it across copies of the handle.
+         */
+        T &write()
+        {
+            if (isShared())
+            {
+                value = std::make_shared<T>(std::as_const(*value));
+            }
+            return *value;
+        }
+
+        // Aplica func al valor (copiándolo antes si es compartido) y devuelve su resultado
+        template <typename UnaryFunc>
+        decltype(auto) mutate(UnaryFunc func)
+        {
+            return std::invoke(func, write());
+        }
+
+        // Devuelve el valor y suelta el buffer: lo mueve si era el único dueño, si no lo copia
+        T take() &&
+        {
+            Cow owned(std::move(*this));
+            if (owned.isShared())
+            {
+                return *owned.value;
+            }
+            return std::move(*owned.value);
+        }
+
+        // Estado
+        bool isShared() const noexcept
+        {
+            if (value.use_count() > 1)
+            {
+                return true;
+            }
+            // Cuenta 1: el último dueño que se fue lo hizo con un decremento acq_rel;
+            // esta barrera ordena sus lecturas antes de nuestras escrituras
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return false;
+        }
+
+        long getUseCount() const noexcept
+        {
+            return value.use_count();
+        }
+
+        // true si ambos handles comparten el mismo buffer
+        bool sharesWith(const Cow &other) const noexcept
+        {
+            return value == other.value;
+        }
+
+        void swap(Cow &other) noexcept
+        {
+            value.swap(other.value);
+        }
+
+        // Comparación (por valor; mismo buffer implica igualdad sin comparar)
+        friend bool operator==(const Cow &a, const Cow &b)
+        {
+            return a.value == b.value || *a.value == *b.value;
+        }
+
+        friend bool operator!=(const Cow &a, const Cow &b)
+        {
+            return !(a == b);
+        }
+    };
+
+    // Aliases para los contenedores de la biblioteca
+    template <typename Key, typename Value, typename Compare = std::less<Key>>
+    using CowMap = Cow<Map<Key, Value, Compare>>;
+
+    template <typename T>
+    using CowVector = Cow<Vector<T>>;
+
+    using CowString = Cow<String>;
+
+} // namespace cppex
+
+#endif // CPPEX_COW_HPP
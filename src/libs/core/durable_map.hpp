@@ -0,0 +1,707 @@
+/**
+ * @file durable_map.hpp
+ * @brief Map persisted through an append-only write-ahead log and compacted snapshots
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_DURABLE_MAP_HPP
+#define CPPEX_DURABLE_MAP_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "common.hpp"        // Include exceptions::SerializationError
+#include "map.hpp"           // Include Map class
+#include "serialization.hpp" // Include BinaryWriter, BinaryReader y crc32c
+
+namespace cpp_ex
+{
+
+    /**
+     * @brief When DurableMap forces its log to stable storage
+     */
+    enum class SyncMode
+    {
+        EveryWrite,  // write() + fdatasync() antes de volver de cada operación
+        GroupCommit, // Registros agrupados: un write() y un fdatasync() por grupo
+        OsBuffered   // Agrupados como GroupCommit, pero sin fdatasync() (sólo flush())
+    };
+
+    /**
+     * @brief Durability and compaction settings of a DurableMap
+     *
+     * With SyncMode::GroupCommit a group is committed when it reaches
+     * `groupCommitRecords` records or `groupCommitBytes` bytes, or when an operation
+     * finds its oldest record waiting for longer than `groupCommitDelay`; a crash loses
+     * at most the records of the open group. `flush()` commits and syncs at any time.
+     */
+    struct DurabilityOptions
+    {
+        SyncMode syncMode = SyncMode::GroupCommit;
+        std::size_t groupCommitRecords = 512;
+        std::size_t groupCommitBytes = 1 << 20;
+        std::chrono::milliseconds groupCommitDelay{10};
+
+        // Compacta cuando el log supera este tamaño y el de la última instantánea (0: nunca)
+        std::uint64_t compactLogBytes = 64ULL << 20;
+    };
+
+    /**
+     * @brief What a DurableMap found on disk when it was opened
+     */
+    struct DurableMapRecovery
+    {
+        std::size_t snapshotEntries = 0;
+        std::size_t replayedRecords = 0;
+        std::size_t skippedRecords = 0;    // Ya incluidos en la instantánea
+        std::uint64_t discardedBytes = 0; // Cola del log incompleta o corrupta
+    };
+
+    namespace detail
+    {
+        [[noreturn]] inline void throwSystemError(const char *what)
+        {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        // Escribe todo el bloque aunque write() lo haga por partes o lo interrumpa una señal
+        inline void writeAll(int fd, std::string_view bytes)
+        {
+            while (!bytes.empty())
+            {
+                ssize_t written = ::write(fd, bytes.data(), bytes.size());
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    throwSystemError("DurableMap: write failed");
+                }
+                bytes.remove_prefix(static_cast<std::size_t>(written));
+            }
+        }
+
+        inline void syncData(int fd)
+        {
+#if defined(__linux__)
+            int result = ::fdatasync(fd);
+#else
+            int result = ::fsync(fd);
+#endif
+            if (result != 0)
+            {
+                throwSystemError("DurableMap: sync failed");
+            }
+        }
+
+        // Tras un rename() hay que sincronizar el directorio para que sobreviva a un apagón
+        inline void syncDirectory(const std::filesystem::path &directory)
+        {
+            int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (fd < 0)
+            {
+                throwSystemError("DurableMap: cannot open directory");
+            }
+            int result = ::fsync(fd);
+            ::close(fd);
+            if (result != 0)
+            {
+                throwSystemError("DurableMap: directory sync failed");
+            }
+        }
+
+        // Fichero proyectado en memoria de sólo lectura (vacío si no existe)
+        class MappedFile
+        {
+        private:
+            void *address = nullptr;
+            std::size_t size = 0;
+
+        public:
+            explicit MappedFile(const std::filesystem::path &path)
+            {
+                int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+                if (fd < 0)
+                {
+                    if (errno == ENOENT)
+                    {
+                        return;
+                    }
+                    throwSystemError("DurableMap: cannot open file");
+                }
+                struct stat info;
+                if (::fstat(fd, &info) != 0)
+                {
+                    ::close(fd);
+                    throwSystemError("DurableMap: stat failed");
+                }
+                size = static_cast<std::size_t>(info.st_size);
+                if (size > 0)
+                {
+                    address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (address == MAP_FAILED)
+                    {
+                        address = nullptr;
+                        ::close(fd);
+                        throwSystemError("DurableMap: mmap failed");
+                    }
+                    ::madvise(address, size, MADV_SEQUENTIAL);
+                }
+                ::close(fd);
+            }
+
+            MappedFile(const MappedFile &) = delete;
+            MappedFile &operator=(const MappedFile &) = delete;
+
+            ~MappedFile()
+            {
+                if (address != nullptr)
+                {
+                    ::munmap(address, size);
+                }
+            }
+
+            std::string_view getView() const noexcept
+            {
+                return address == nullptr ? std::string_view() : std::string_view(static_cast<const char *>(address), size);
+            }
+        };
+    }
+
+    /**
+     * @brief Map whose changes survive restarts and crashes (POSIX only)
+     *
+     * Every `insert()`, `insertOrAssign()`, `erase()` and `clear()` that changes the
+     * map appends a binary record `[length][CRC-32C][sequence, operation, key, value]`
+     * to `<directory>/wal`. Records are committed in groups (one `write()` and one
+     * `fdatasync()` per group, see DurabilityOptions), so the cost of a sync is shared
+     * by many writes.
+     *
+     * Once the log grows past `compactLogBytes`, the whole map is written to
+     * `<directory>/snapshot.tmp`, synced and atomically renamed to `snapshot`, and the
+     * log is truncated. Opening a DurableMap mmaps the snapshot and bulk-loads it in
+     * key order (appending at the end of the Map, O(n)), then replays the log tail.
+     * Records whose sequence is already covered by the snapshot are skipped, so a
+     * crash between the rename and the truncation is harmless. A torn or corrupt
+     * record ends the log: it and everything after it are discarded.
+     *
+     * Reads are plain Map lookups with no I/O. Like Map, a DurableMap is not
+     * thread-safe. If an I/O call fails, std::system_error propagates and the
+     * in-memory map may be ahead of the log. A failed log write is cut back to the
+     * last complete group, which stays pending and is written again by the next
+     * commit; if even that truncation fails, later writes throw std::logic_error
+     * instead of appending behind the torn bytes.
+     *
+     * @tparam Key Type of the keys (needs a Serializer)
+     * @tparam Value Type of the mapped values (needs a Serializer)
+     * @tparam Compare Comparison function object type, defaults to std::less<Key>
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::DurableMap<cpp_ex::String, cpp_ex::String> sessions("/var/lib/app/sessions");
+     * sessions.insertOrAssign("user:42", token);
+     * sessions.erase("user:7");
+     * sessions.flush(); // Everything above is on stable storage
+     * ```
+     */
+    template <typename Key, typename Value, typename Compare = std::less<Key>>
+        requires Serializable<Key> && Serializable<Value>
+    class DurableMap
+    {
+    public:
+        // Tipos (aliases)
+        using key_type = Key;
+        using mapped_type = Value;
+        using size_type = std::size_t;
+        using map_type = Map<Key, Value, Compare>;
+        using const_iterator = typename map_type::const_iterator;
+
+    private:
+        enum Operation : std::uint8_t
+        {
+            kPut = 1,
+            kErase = 2,
+            kClear = 3
+        };
+
+        static constexpr std::string_view kSnapshotMagic{"CPXSNAP1", 8};
+        static constexpr std::size_t kRecordHeader = 8; // Longitud y CRC
+        static constexpr std::size_t kSnapshotChunk = 1 << 20;
+
+        map_type map;
+        std::filesystem::path directory;
+        DurabilityOptions options;
+        int logFd = -1;
+
+        BinaryWriter pending; // Grupo abierto, aún no escrito
+        std::size_t pendingRecords = 0;
+        std::chrono::steady_clock::time_point pendingSince;
+
+        std::uint64_t sequence = 0;
+        std::uint64_t logBytes = 0;
+        std::uint64_t snapshotBytes = 0;
+        bool logBroken = false; // Una escritura fallida dejó bytes que no se pudieron quitar
+        DurableMapRecovery recovery;
+
+    public:
+        // Constructores
+        /**
+         * @brief Opens (creating it if needed) the map stored in directory and recovers it
+         *
+         * @throws std::system_error on I/O errors
+         * @throws exceptions::SerializationError if the snapshot is corrupt
+         */
+        explicit DurableMap(const std::filesystem::path &directory, const DurabilityOptions &options = DurabilityOptions())
+            : directory(directory), options(options)
+        {
+            std::filesystem::create_directories(directory);
+            std::uint64_t snapshotSequence = loadSnapshot();
+            std::uint64_t validLogBytes = replayLog(snapshotSequence);
+            sequence = std::max(sequence, snapshotSequence);
+
+            logFd = ::open(getLogPath().c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+            if (logFd < 0)
+            {
+                detail::throwSystemError("DurableMap: cannot open log");
+            }
+            // Corta la cola dañada para que los registros nuevos no queden detrás de ella
+            if (recovery.discardedBytes > 0)
+            {
+                try
+                {
+                    if (::ftruncate(logFd, static_cast<off_t>(validLogBytes)) != 0)
+                    {
+                        detail::throwSystemError("DurableMap: cannot truncate log");
+                    }
+                    detail::syncData(logFd);
+                }
+                catch (...)
+                {
+                    // El destructor no se ejecuta si el constructor lanza
+                    ::close(logFd);
+                    throw;
+                }
+            }
+            logBytes = validLogBytes;
+        }
+
+        DurableMap(const DurableMap &) = delete;
+        DurableMap &operator=(const DurableMap &) = delete;
+
+        // Destructor: confirma el grupo abierto (los errores ya no se pueden notificar)
+        ~DurableMap()
+        {
+            try
+            {
+                flush();
+            }
+            catch (...)
+            {
+            }
+            ::close(logFd);
+        }
+
+        // Iteradores (sólo lectura)
+        const_iterator begin() const noexcept
+        {
+            return map.begin();
+        }
+
+        const_iterator end() const noexcept
+        {
+            return map.end();
+        }
+
+        // Capacidad
+        bool isEmpty() const noexcept
+        {
+            return map.isEmpty();
+        }
+
+        size_type getSize() const noexcept
+        {
+            return map.getSize();
+        }
+
+        // Lookup
+        const_iterator find(const Key &key) const
+        {
+            return map.find(key);
+        }
+
+        const Value &at(const Key &key) const
+        {
+            return map.at(key);
+        }
+
+        bool contains(const Key &key) const
+        {
+            return map.contains(key);
+        }
+
+        size_type count(const Key &key) const
+        {
+            return map.count(key);
+        }
+
+        const map_type &getMap() const noexcept
+        {
+            return map;
+        }
+
+        // Modificadores
+        // Inserta si la clave no existe; sólo entonces se registra
+        bool insert(const Key &key, const Value &value)
+        {
+            if (!map.emplace(key, value).second)
+            {
+                return false;
+            }
+            appendRecord(kPut, &key, &value);
+            return true;
+        }
+
+        // true si la clave era nueva
+        bool insertOrAssign(const Key &key, const Value &value)
+        {
+            bool inserted = map.getStdMap().insert_or_assign(key, value).second;
+            appendRecord(kPut, &key, &value);
+            return inserted;
+        }
+
+        size_type erase(const Key &key)
+        {
+            if (map.erase(key) == 0)
+            {
+                return 0;
+            }
+            appendRecord(kErase, &key, nullptr);
+            return 1;
+        }
+
+        void clear()
+        {
+            if (map.isEmpty())
+            {
+                return;
+            }
+            map.clear();
+            appendRecord(kClear, nullptr, nullptr);
+        }
+
+        // Durabilidad
+        /**
+         * @brief Writes the open group and syncs the log, whatever the SyncMode
+         */
+        void flush()
+        {
+            writePending();
+            detail::syncData(logFd);
+        }
+
+        /**
+         * @brief Replaces snapshot and log with a fresh snapshot of the current map
+         */
+        void compact()
+        {
+            writePending();
+            detail::syncData(logFd);
+            writeSnapshot();
+            // La instantánea ya cubre todo el log: se puede vaciar
+            if (::ftruncate(logFd, 0) != 0)
+            {
+                detail::throwSystemError("DurableMap: cannot truncate log");
+            }
+            detail::syncData(logFd);
+            logBytes = 0;
+        }
+
+        // Estado
+        std::uint64_t getSequence() const noexcept
+        {
+            return sequence;
+        }
+
+        // Bytes del log ya escritos (sin el grupo abierto)
+        std::uint64_t getLogBytes() const noexcept
+        {
+            return logBytes;
+        }
+
+        std::size_t getPendingRecords() const noexcept
+        {
+            return pendingRecords;
+        }
+
+        const DurableMapRecovery &getRecovery() const noexcept
+        {
+            return recovery;
+        }
+
+        const std::filesystem::path &getDirectory() const noexcept
+        {
+            return directory;
+        }
+
+    private:
+        std::filesystem::path getLogPath() const
+        {
+            return directory / "wal";
+        }
+
+        std::filesystem::path getSnapshotPath() const
+        {
+            return directory / "snapshot";
+        }
+
+        void appendRecord(Operation operation, const Key *key, const Value *value)
+        {
+            if (pendingRecords == 0)
+            {
+                pendingSince = std::chrono::steady_clock::now();
+            }
+            // Cabecera provisional: longitud y CRC se rellenan con el registro ya escrito
+            std::size_t start = pending.getSize();
+            pending.writeU32(0);
+            pending.writeU32(0);
+            pending.writeU64(++sequence);
+            pending.writeU8(operation);
+            if (key != nullptr)
+            {
+                pending.write(*key);
+            }
+            if (value != nullptr)
+            {
+                pending.write(*value);
+            }
+            std::string_view payload = pending.getBuffer().substr(start + kRecordHeader);
+            pending.patchU32(start, static_cast<std::uint32_t>(payload.size()));
+            pending.patchU32(start + 4, crc32c(payload));
+            ++pendingRecords;
+
+            if (options.syncMode == SyncMode::EveryWrite || pendingRecords >= options.groupCommitRecords ||
+                pending.getSize() >= options.groupCommitBytes ||
+                std::chrono::steady_clock::now() - pendingSince >= options.groupCommitDelay)
+            {
+                commit();
+            }
+        }
+
+        void commit()
+        {
+            writePending();
+            if (options.syncMode != SyncMode::OsBuffered)
+            {
+                detail::syncData(logFd);
+            }
+            if (options.compactLogBytes != 0 && logBytes >= options.compactLogBytes && logBytes >= snapshotBytes)
+            {
+                compact();
+            }
+        }
+
+        void writePending()
+        {
+            if (pendingRecords == 0)
+            {
+                return;
+            }
+            if (logBroken)
+            {
+                throw std::logic_error("DurableMap: the log could not be repaired after a failed write");
+            }
+            try
+            {
+                detail::writeAll(logFd, pending.getBuffer());
+            }
+            catch (...)
+            {
+                // Quita lo que llegó a escribirse: un grupo a medias en mitad del log haría que
+                // la recuperación descartara todos los registros posteriores. El grupo sigue pendiente.
+                if (::ftruncate(logFd, static_cast<off_t>(logBytes)) != 0)
+                {
+                    logBroken = true;
+                }
+                throw;
+            }
+            logBytes += pending.getSize();
+            pending.clear();
+            pendingRecords = 0;
+        }
+
+        // Cabecera: magia, secuencia, número de entradas; al final, CRC de todo lo anterior
+        void writeSnapshot()
+        {
+            std::filesystem::path tmpPath = directory / "snapshot.tmp";
+            int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0)
+            {
+                detail::throwSystemError("DurableMap: cannot create snapshot");
+            }
+            try
+            {
+                BinaryWriter out(kSnapshotChunk + 4096);
+                std::uint32_t crc = 0;
+                std::uint64_t written = 0;
+                auto drain = [&]
+                {
+                    crc = crc32c(out.getBuffer(), crc);
+                    detail::writeAll(fd, out.getBuffer());
+                    written += out.getSize();
+                    out.clear();
+                };
+
+                out.writeBytes(kSnapshotMagic.data(), kSnapshotMagic.size());
+                out.writeU64(sequence);
+                out.writeU64(map.getSize());
+                for (const auto &[key, value] : map)
+                {
+                    out.write(key);
+                    out.write(value);
+                    if (out.getSize() >= kSnapshotChunk)
+                    {
+                        drain();
+                    }
+                }
+                drain();
+                out.writeU32(crc);
+                drain();
+                detail::syncData(fd);
+                snapshotBytes = written;
+            }
+            catch (...)
+            {
+                ::close(fd);
+                throw;
+            }
+            ::close(fd);
+            std::filesystem::rename(tmpPath, getSnapshotPath());
+            detail::syncDirectory(directory);
+        }
+
+        // Devuelve la secuencia que cubre la instantánea (0 si no hay)
+        std::uint64_t loadSnapshot()
+        {
+            detail::MappedFile file(getSnapshotPath());
+            std::string_view bytes = file.getView();
+            if (bytes.empty())
+            {
+                return 0;
+            }
+            if (bytes.size() < kSnapshotMagic.size() + 20 || bytes.substr(0, kSnapshotMagic.size()) != kSnapshotMagic)
+            {
+                throw exceptions::SerializationError("DurableMap: invalid snapshot header");
+            }
+            std::string_view body = bytes.substr(0, bytes.size() - 4);
+            BinaryReader trailer(bytes.substr(body.size()));
+            if (crc32c(body) != trailer.readU32())
+            {
+                throw exceptions::SerializationError("DurableMap: snapshot checksum mismatch");
+            }
+
+            BinaryReader in(body);
+            in.skip(kSnapshotMagic.size());
+            std::uint64_t snapshotSequence = in.readU64();
+            std::uint64_t count = in.readU64();
+            // Escrita en orden de clave: cada entrada va al final del Map
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                Key key = in.read<Key>();
+                Value value = in.read<Value>();
+                map.emplaceHint(map.end(), std::move(key), std::move(value));
+            }
+            if (!in.isAtEnd())
+            {
+                throw exceptions::SerializationError("DurableMap: trailing bytes in snapshot");
+            }
+            recovery.snapshotEntries = map.getSize();
+            snapshotBytes = bytes.size();
+            return snapshotSequence;
+        }
+
+        // Devuelve los bytes del log hasta el último registro válido
+        std::uint64_t replayLog(std::uint64_t snapshotSequence)
+        {
+            detail::MappedFile file(getLogPath());
+            std::string_view bytes = file.getView();
+            std::size_t offset = 0;
+            while (bytes.size() - offset >= kRecordHeader)
+            {
+                BinaryReader header(bytes.substr(offset, kRecordHeader));
+                std::uint32_t length = header.readU32();
+                std::uint32_t crc = header.readU32();
+                if (length > bytes.size() - offset - kRecordHeader)
+                {
+                    break; // Registro a medio escribir
+                }
+                std::string_view payload = bytes.substr(offset + kRecordHeader, length);
+                if (crc32c(payload) != crc || !applyRecord(payload, snapshotSequence))
+                {
+                    break;
+                }
+                offset += kRecordHeader + length;
+            }
+            recovery.discardedBytes = bytes.size() - offset;
+            return offset;
+        }
+
+        // false si el registro no se puede decodificar
+        bool applyRecord(std::string_view payload, std::uint64_t snapshotSequence)
+        {
+            try
+            {
+                BinaryReader in(payload);
+                std::uint64_t recordSequence = in.readU64();
+                auto operation = static_cast<Operation>(in.readU8());
+                if (recordSequence <= snapshotSequence)
+                {
+                    ++recovery.skippedRecords;
+                    return true;
+                }
+                switch (operation)
+                {
+                case kPut:
+                {
+                    Key key = in.read<Key>();
+                    Value value = in.read<Value>();
+                    map.getStdMap().insert_or_assign(std::move(key), std::move(value));
+                    break;
+                }
+                case kErase:
+                    map.erase(in.read<Key>());
+                    break;
+                case kClear:
+                    map.clear();
+                    break;
+                default:
+                    return false;
+                }
+                sequence = recordSequence;
+                ++recovery.replayedRecords;
+                return true;
+            }
+            catch (const exceptions::SerializationError &)
+            {
+                return false;
+            }
+        }
+    };
+
+} // namespace cppex
+
+#endif // CPPEX_DURABLE_MAP_HPP
@@ -0,0 +1,715 @@
+/**
+ * @file expiring_map.hpp
+ * @brief Maps whose entries expire after a TTL, evicted through a hierarchical timing wheel
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_EXPIRING_MAP_HPP
+#define CPPEX_EXPIRING_MAP_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "vector.hpp"   // Include Vector class
+#include "hash_map.hpp" // Include HashMap class
+
+namespace cpp_ex
+{
+
+    /**
+     * @brief Clock that only moves when told to, for deterministic tests of expiring maps
+     *
+     * Copies share the same time, so a test can keep one copy and hand another to the
+     * map. Reading and advancing the clock are thread-safe.
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::ManualClock clock;
+     * cpp_ex::ExpiringMap<int, int, cpp_ex::ManualClock> map(std::chrono::seconds(10), std::chrono::seconds(1), clock);
+     * map.put(1, 100);
+     * clock.advance(std::chrono::seconds(10));
+     * map.contains(1); // false
+     * ```
+     */
+    class ManualClock
+    {
+    public:
+        // Tipos (aliases)
+        using rep = std::int64_t;
+        using period = std::nano;
+        using duration = std::chrono::nanoseconds;
+        using time_point = std::chrono::time_point<ManualClock, duration>;
+        static constexpr bool is_steady = true;
+
+    private:
+        std::shared_ptr<std::atomic<rep>> ticks = std::make_shared<std::atomic<rep>>(0);
+
+    public:
+        time_point now() const noexcept
+        {
+            return time_point(duration(ticks->load(std::memory_order_acquire)));
+        }
+
+        void advance(duration amount) noexcept
+        {
+            ticks->fetch_add(amount.count(), std::memory_order_acq_rel);
+        }
+    };
+
+    namespace detail
+    {
+        constexpr std::uint32_t kWheelNil = std::numeric_limits<std::uint32_t>::max();
+        constexpr unsigned kWheelBits = 6;
+        constexpr std::size_t kWheelSlots = std::size_t{1} << kWheelBits;
+        constexpr std::size_t kWheelLevels = 11; // 11 niveles de 6 bits cubren los 64 bits del tick
+
+        template <typename Key, typename Value, typename TimePoint>
+        struct ExpiringNode
+        {
+            std::optional<Key> key;
+            std::optional<Value> value;
+            TimePoint deadline{};
+            std::uint64_t tick = 0; // Primer tick de la rueda en el que deadline ya pasó
+            std::uint32_t prev = kWheelNil;
+            std::uint32_t next = kWheelNil;
+            std::uint32_t slot = kWheelNil; // nivel * kWheelSlots + ranura, kWheelNil si no está en la rueda
+        };
+    }
+
+    /**
+     * @brief Hash map whose entries expire at a deadline
+     *
+     * Every entry gets a deadline when it is put (now + TTL). Lookups treat entries
+     * whose deadline has passed as absent, without modifying the map. Memory is
+     * reclaimed by expire(), which walks a hierarchical timing wheel: eleven levels of
+     * 64 slots, level l holding the entries due within 64^(l+1) ticks. Entries move
+     * down one level at a time as their deadline gets closer, so expire() costs
+     * O(expired entries + levels crossed) instead of a full scan. Empty stretches of
+     * the wheel are skipped through per-level occupancy bitmasks.
+     *
+     * getSize() counts the stored entries, including expired ones that expire() has
+     * not reclaimed yet. Call expire() periodically (or after batches of writes).
+     *
+     * @tparam Key Type of the keys
+     * @tparam Value Type of the values
+     * @tparam Clock Clock with now(), duration and time_point; an instance is stored,
+     *         so stateful clocks such as ManualClock work
+     * @tparam Hash Hash function object type, defaults to std::hash<Key>
+     * @tparam KeyEqual Equality function object type, defaults to std::equal_to<Key>
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::ExpiringMap<cpp_ex::String, Session> sessions(std::chrono::minutes(30));
+     * sessions.put(token, session);
+     * if (auto *session = sessions.find(token)) { sessions.touch(token); }
+     * sessions.expire(); // from a periodic task
+     * ```
+     */
+    template <typename Key, typename Value, typename Clock = std::chrono::steady_clock, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    class ExpiringMap
+    {
+        static_assert(std::is_integral_v<typename Clock::rep>, "ExpiringMap requires a clock with an integral tick count");
+
+    public:
+        // Tipos (aliases)
+        using key_type = Key;
+        using mapped_type = Value;
+        using size_type = std::size_t;
+        using clock_type = Clock;
+        using duration = typename Clock::duration;
+        using time_point = typename Clock::time_point;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+
+    private:
+        using Node = detail::ExpiringNode<Key, Value, time_point>;
+
+        Vector<Node> nodes;
+        Vector<std::uint32_t> freeNodes;
+        HashMap<Key, std::uint32_t, Hash, KeyEqual> index;
+        std::array<std::array<std::uint32_t, detail::kWheelSlots>, detail::kWheelLevels> slots;
+        std::array<std::uint64_t, detail::kWheelLevels> occupied{}; // Bit s: ranura s no vacía
+        [[no_unique_address]] Clock clock;
+        duration defaultTtl;
+        duration tick;
+        time_point epoch;
+        std::uint64_t currentTick = 0; // Todo lo que vence en ticks <= currentTick ya se expiró
+
+    public:
+        // Granularidad por defecto de la rueda: 1 ms (o el tick del reloj si es mayor)
+        static constexpr duration defaultTick() noexcept
+        {
+            return std::max(duration(1), std::chrono::duration_cast<duration>(std::chrono::milliseconds(1)));
+        }
+
+        // Constructores
+        explicit ExpiringMap(duration defaultTtl, duration tick = defaultTick(), Clock clock = Clock())
+            : clock(std::move(clock)), defaultTtl(defaultTtl), tick(tick)
+        {
+            if (defaultTtl <= duration::zero() || tick <= duration::zero())
+            {
+                throw std::invalid_argument("ExpiringMap: ttl and tick must be positive");
+            }
+            epoch = this->clock.now();
+            for (auto &level : slots)
+            {
+                level.fill(detail::kWheelNil);
+            }
+        }
+
+        // Capacidad
+        bool isEmpty() const noexcept
+        {
+            return index.isEmpty();
+        }
+
+        // Entradas almacenadas, incluidas las vencidas que expire() aún no ha recogido
+        size_type getSize() const noexcept
+        {
+            return index.getSize();
+        }
+
+        const Clock &getClock() const noexcept
+        {
+            return clock;
+        }
+
+        duration getDefaultTtl() const noexcept
+        {
+            return defaultTtl;
+        }
+
+        duration getTick() const noexcept
+        {
+            return tick;
+        }
+
+        // Inserta o reemplaza la entrada con el TTL por defecto
+        template <typename V>
+        void put(const Key &key, V &&value)
+        {
+            put(key, std::forward<V>(value), defaultTtl);
+        }
+
+        // Inserta o reemplaza la entrada; un ttl <= 0 la borra
+        template <typename V>
+        void put(const Key &key, V &&value, duration ttl)
+        {
+            if (ttl <= duration::zero())
+            {
+                erase(key);
+                return;
+            }
+            auto deadline = clock.now() + ttl;
+            auto it = index.find(key);
+            if (it != index.end())
+            {
+                auto node = it->second;
+                *nodes[node].value = std::forward<V>(value);
+                reschedule(node, deadline);
+                return;
+            }
+
+            auto node = allocate(key, std::forward<V>(value));
+            nodes[node].deadline = deadline;
+            nodes[node].tick = tickAfter(deadline);
+            link(node);
+        }
+
+        // Lookup; nullptr si la clave no está o ya venció
+        Value *find(const Key &key)
+        {
+            auto node = liveNode(key);
+            return node == detail::kWheelNil ? nullptr : &*nodes[node].value;
+        }
+
+        const Value *find(const Key &key) const
+        {
+            auto node = liveNode(key);
+            return node == detail::kWheelNil ? nullptr : &*nodes[node].value;
+        }
+
+        std::optional<Value> get(const Key &key) const
+        {
+            const Value *value = find(key);
+            return value ? std::optional<Value>(*value) : std::nullopt;
+        }
+
+        bool contains(const Key &key) const
+        {
+            return liveNode(key) != detail::kWheelNil;
+        }
+
+        std::optional<time_point> getDeadline(const Key &key) const
+        {
+            auto node = liveNode(key);
+            return node == detail::kWheelNil ? std::nullopt : std::optional<time_point>(nodes[node].deadline);
+        }
+
+        // Renueva el plazo de una entrada viva (now + ttl); false si no está o ya venció
+        bool touch(const Key &key)
+        {
+            return touch(key, defaultTtl);
+        }
+
+        bool touch(const Key &key, duration ttl)
+        {
+            auto node = liveNode(key);
+            if (node == detail::kWheelNil)
+            {
+                return false;
+            }
+            if (ttl <= duration::zero())
+            {
+                release(node);
+                return true;
+            }
+            reschedule(node, clock.now() + ttl);
+            return true;
+        }
+
+        // Borra la entrada; devuelve true solo si estaba viva
+        bool erase(const Key &key)
+        {
+            auto it = index.find(key);
+            if (it == index.end())
+            {
+                return false;
+            }
+            auto node = it->second;
+            bool live = clock.now() < nodes[node].deadline;
+            release(node);
+            return live;
+        }
+
+        void clear()
+        {
+            nodes.clear();
+            freeNodes.clear();
+            index.clear();
+            for (auto &level : slots)
+            {
+                level.fill(detail::kWheelNil);
+            }
+            occupied.fill(0);
+        }
+
+        /**
+         * @brief Removes the entries whose deadline has passed
+         *
+         * Advances the wheel up to the current tick. Cost is proportional to the number
+         * of expired entries plus the entries moved down a level, not to the map size.
+         *
+         * @return Number of entries removed
+         */
+        size_type expire()
+        {
+            return expire([](const Key &, Value &) {});
+        }
+
+        /**
+         * @brief Removes the expired entries, calling func(key, value) for each first
+         *
+         * func may move the value out, but must not modify the map.
+         */
+        template <typename BinaryFunc>
+        size_type expire(BinaryFunc func)
+        {
+            auto target = tickOf(clock.now());
+            size_type expired = 0;
+            while (true)
+            {
+                auto event = nextEvent();
+                if (event > target)
+                {
+                    break;
+                }
+                currentTick = event;
+                // Primero bajan los niveles altos: sus entradas pueden caer en ranuras de
+                // niveles inferiores que se procesan en este mismo tick
+                for (std::size_t level = detail::kWheelLevels - 1; level > 0; --level)
+                {
+                    auto shift = level * detail::kWheelBits;
+                    if (occupied[level] != 0 && (event & ((std::uint64_t{1} << shift) - 1)) == 0)
+                    {
+                        auto slot = static_cast<std::size_t>((event >> shift) & (detail::kWheelSlots - 1));
+                        cascade(level, slot);
+                    }
+                }
+                auto slot = static_cast<std::size_t>(event & (detail::kWheelSlots - 1));
+                auto node = detach(0, slot);
+                while (node != detail::kWheelNil)
+                {
+                    auto next = nodes[node].next;
+                    func(static_cast<const Key &>(*nodes[node].key), *nodes[node].value);
+                    nodes[node].slot = detail::kWheelNil;
+                    release(node);
+                    ++expired;
+                    node = next;
+                }
+            }
+            currentTick = std::max(currentTick, target);
+            return expired;
+        }
+
+        // Recorre las entradas vivas en orden no especificado
+        template <typename BinaryFunc>
+        void forEach(BinaryFunc func) const
+        {
+            auto now = clock.now();
+            for (size_type i = 0; i < nodes.getSize(); ++i)
+            {
+                if (nodes[i].value && now < nodes[i].deadline)
+                {
+                    func(*nodes[i].key, *nodes[i].value);
+                }
+            }
+        }
+
+    private:
+        std::uint32_t liveNode(const Key &key) const
+        {
+            auto it = index.find(key);
+            if (it == index.end() || !(clock.now() < nodes[it->second].deadline))
+            {
+                return detail::kWheelNil;
+            }
+            return it->second;
+        }
+
+        // Tick en curso en el instante time (redondeo hacia abajo)
+        std::uint64_t tickOf(time_point time) const
+        {
+            auto elapsed = time - epoch;
+            return elapsed <= duration::zero() ? 0 : static_cast<std::uint64_t>(elapsed / tick);
+        }
+
+        // Primer tick que empieza en o después de deadline (redondeo hacia arriba)
+        std::uint64_t tickAfter(time_point deadline) const
+        {
+            auto elapsed = deadline - epoch;
+            if (elapsed <= duration::zero())
+            {
+                return 0;
+            }
+            return static_cast<std::uint64_t>((elapsed + tick - duration(1)) / tick);
+        }
+
+        template <typename V>
+        std::uint32_t allocate(const Key &key, V &&value)
+        {
+            std::uint32_t node;
+            if (!freeNodes.isEmpty())
+            {
+                node = freeNodes.getBack();
+                freeNodes.popBack();
+            }
+            else
+            {
+                node = static_cast<std::uint32_t>(nodes.getSize());
+                nodes.emplaceBack();
+            }
+            nodes[node].key.emplace(key);
+            nodes[node].value.emplace(std::forward<V>(value));
+            index.tryEmplace(key, node);
+            return node;
+        }
+
+        // Desenlaza (si hace falta) el nodo, lo borra del índice y lo devuelve al slab
+        void release(std::uint32_t node)
+        {
+            if (nodes[node].slot != detail::kWheelNil)
+            {
+                unlink(node);
+            }
+            index.erase(*nodes[node].key);
+            nodes[node].key.reset();
+            nodes[node].value.reset();
+            freeNodes.pushBack(node);
+        }
+
+        void reschedule(std::uint32_t node, time_point deadline)
+        {
+            unlink(node);
+            nodes[node].deadline = deadline;
+            nodes[node].tick = tickAfter(deadline);
+            link(node);
+        }
+
+        // Coloca el nodo en el nivel del bloque de 6 bits más alto en que su tick difiere de currentTick
+        void link(std::uint32_t node)
+        {
+            auto &n = nodes[node];
+            auto diff = n.tick ^ currentTick;
+            auto level = diff == 0 ? std::size_t{0} : static_cast<std::size_t>(std::bit_width(diff) - 1) / detail::kWheelBits;
+            auto slot = static_cast<std::size_t>((n.tick >> (level * detail::kWheelBits)) & (detail::kWheelSlots - 1));
+
+            auto &head = slots[level][slot];
+            n.prev = detail::kWheelNil;
+            n.next = head;
+            if (head != detail::kWheelNil)
+            {
+                nodes[head].prev = node;
+            }
+            head = node;
+            occupied[level] |= std::uint64_t{1} << slot;
+            n.slot = static_cast<std::uint32_t>(level * detail::kWheelSlots + slot);
+        }
+
+        void unlink(std::uint32_t node)
+        {
+            auto &n = nodes[node];
+            auto level = n.slot / detail::kWheelSlots;
+            auto slot = n.slot % detail::kWheelSlots;
+            if (n.prev != detail::kWheelNil)
+            {
+                nodes[n.prev].next = n.next;
+            }
+            else
+            {
+                slots[level][slot] = n.next;
+                if (n.next == detail::kWheelNil)
+                {
+                    occupied[level] &= ~(std::uint64_t{1} << slot);
+                }
+            }
+            if (n.next != detail::kWheelNil)
+            {
+                nodes[n.next].prev = n.prev;
+            }
+            n.slot = detail::kWheelNil;
+        }
+
+        // Vacía una ranura y devuelve la cabeza de su lista
+        std::uint32_t detach(std::size_t level, std::size_t slot)
+        {
+            auto head = slots[level][slot];
+            slots[level][slot] = detail::kWheelNil;
+            occupied[level] &= ~(std::uint64_t{1} << slot);
+            return head;
+        }
+
+        // Reparte las entradas de una ranura entre los niveles inferiores
+        void cascade(std::size_t level, std::size_t slot)
+        {
+            auto node = detach(level, slot);
+            while (node != detail::kWheelNil)
+            {
+                auto next = nodes[node].next;
+                link(node);
+                node = next;
+            }
+        }
+
+        /**
+         * @brief First tick after currentTick at which a slot has to be expired or cascaded
+         *
+         * Every entry on level l shares the bits above level l with currentTick and
+         * has a larger slot index on that level, so the next event of each level is its
+         * first occupied slot past the current one.
+         */
+        std::uint64_t nextEvent() const
+        {
+            auto best = std::numeric_limits<std::uint64_t>::max();
+            for (std::size_t level = 0; level < detail::kWheelLevels; ++level)
+            {
+                if (occupied[level] == 0)
+                {
+                    continue;
+                }
+                auto shift = level * detail::kWheelBits;
+                auto current = (currentTick >> shift) & (detail::kWheelSlots - 1);
+                auto ahead = current + 1 == detail::kWheelSlots ? 0 : occupied[level] & (~std::uint64_t{0} << (current + 1));
+                if (ahead == 0)
+                {
+                    continue;
+                }
+                auto upperShift = shift + detail::kWheelBits;
+                auto base = upperShift >= 64 ? 0 : (currentTick >> upperShift) << upperShift;
+                best = std::min(best, base | (static_cast<std::uint64_t>(std::countr_zero(ahead)) << shift));
+            }
+            return best;
+        }
+    };
+
+    /**
+     * @brief Thread-safe ExpiringMap split into independently locked shards
+     *
+     * Each key maps to one shard by its hash, so operations on different shards never
+     * contend. expire() sweeps the shards one after another, holding one lock at a time.
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::ShardedExpiringMap<cpp_ex::String, Session> sessions(std::chrono::minutes(30), 32);
+     * sessions.put(token, session); // from any thread
+     * ```
+     */
+    template <typename Key, typename Value, typename Clock = std::chrono::steady_clock, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    class ShardedExpiringMap
+    {
+    public:
+        // Tipos (aliases)
+        using map_type = ExpiringMap<Key, Value, Clock, Hash, KeyEqual>;
+        using key_type = Key;
+        using mapped_type = Value;
+        using size_type = std::size_t;
+        using duration = typename map_type::duration;
+        using time_point = typename map_type::time_point;
+        using hasher = Hash;
+
+    private:
+        static constexpr std::size_t kCacheLine = 64;
+
+        struct alignas(kCacheLine) Shard
+        {
+            mutable std::mutex mutex;
+            map_type map;
+
+            Shard(duration defaultTtl, duration tick, const Clock &clock) : map(defaultTtl, tick, clock) {}
+        };
+
+        Vector<std::unique_ptr<Shard>> shards;
+        int shardShift;
+        [[no_unique_address]] hasher hashFn;
+
+    public:
+        // Constructores
+        explicit ShardedExpiringMap(duration defaultTtl, size_type shardCount = 16, duration tick = map_type::defaultTick(), Clock clock = Clock())
+        {
+            shardCount = std::bit_ceil(std::max<size_type>(shardCount, 1));
+            shardShift = 64 - std::countr_zero(shardCount);
+            for (size_type i = 0; i < shardCount; ++i)
+            {
+                shards.pushBack(std::make_unique<Shard>(defaultTtl, tick, clock));
+            }
+        }
+
+        size_type getShardCount() const noexcept
+        {
+            return shards.getSize();
+        }
+
+        template <typename V>
+        void put(const key_type &key, V &&value)
+        {
+            Shard &shard = shardFor(key);
+            std::lock_guard lock(shard.mutex);
+            shard.map.put(key, std::forward<V>(value));
+        }
+
+        template <typename V>
+        void put(const key_type &key, V &&value, duration ttl)
+        {
+            Shard &shard = shardFor(key);
+            std::lock_guard lock(shard.mutex);
+            shard.map.put(key, std::forward<V>(value), ttl);
+        }
+
+        std::optional<mapped_type> get(const key_type &key) const
+        {
+            const Shard &shard = shardFor(key);
+            std::lock_guard lock(shard.mutex);
+            return shard.map.get(key);
+        }
+
+        bool contains(const key_type &key) const
+        {
+            const Shard &shard = shardFor(key);
+            std::lock_guard lock(shard.mutex);
+            return shard.map.contains(key);
+        }
+
+        std::optional<time_point> getDeadline(const key_type &key) const
+        {
+            const Shard &shard = shardFor(key);
+            std::lock_guard lock(shard.mutex);
+            return shard.map.getDeadline(key);
+        }
+
+        bool touch(const key_type &key)
+        {
+            Shard &shard = shardFor(key);
+            std::lock_guard lock(shard.mutex);
+            return shard.map.touch(key);
+        }
+
+        bool touch(const key_type &key, duration ttl)
+        {
+            Shard &shard = shardFor(key);
+            std::lock_guard lock(shard.mutex);
+            return shard.map.touch(key, ttl);
+        }
+
+        bool erase(const key_type &key)
+        {
+            Shard &shard = shardFor(key);
+            std::lock_guard lock(shard.mutex);
+            return shard.map.erase(key);
+        }
+
+        // Expira shard a shard; devuelve el total de entradas borradas
+        size_type expire()
+        {
+            return expire([](const key_type &, mapped_type &) {});
+        }
+
+        // func se llama con el lock del shard tomado
+        template <typename BinaryFunc>
+        size_type expire(BinaryFunc func)
+        {
+            size_type total = 0;
+            for (auto &shard : shards)
+            {
+                std::lock_guard lock(shard->mutex);
+                total += shard->map.expire(func);
+            }
+            return total;
+        }
+
+        void clear()
+        {
+            for (auto &shard : shards)
+            {
+                std::lock_guard lock(shard->mutex);
+                shard->map.clear();
+            }
+        }
+
+        size_type getSize() const
+        {
+            size_type total = 0;
+            for (const auto &shard : shards)
+            {
+                std::lock_guard lock(shard->mutex);
+                total += shard->map.getSize();
+            }
+            return total;
+        }
+
+    private:
+        Shard &shardFor(const key_type &key) const
+        {
+            if (shards.getSize() == 1)
+            {
+                return *shards[0];
+            }
+            auto hash = detail::mixHash(static_cast<std::uint64_t>(hashFn(key)));
+            return *shards[static_cast<size_type>(hash >> shardShift)];
+        }
+    };
+
+} // namespace cppex
+
+#endif // CPPEX_EXPIRING_MAP_HPP
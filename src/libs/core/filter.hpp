@@ -0,0 +1,987 @@
+/**
+ * @file filter.hpp
+ * @brief Approximate membership filters (blocked Bloom, binary fuse) and a map front that uses them
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_FILTER_HPP
+#define CPPEX_FILTER_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include "common.hpp"        // Include exceptions::SerializationError
+#include "vector.hpp"        // Include Vector class
+#include "parallel.hpp"      // Include detail::parallelFor
+#include "serialization.hpp" // Include BinaryWriter, BinaryReader y Serializer
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CPPEX_FILTER_AVX2 1
+#endif
+
+namespace cpp_ex
+{
+    namespace detail
+    {
+        // Finalizador de murmur3 (biyectivo): distintas entradas dan distintos hashes
+        inline std::uint64_t filterMix(std::uint64_t h) noexcept
+        {
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return h;
+        }
+
+        // Parte alta de a * b (reduce un hash a [0, b) sin división)
+        inline std::uint64_t mulHigh(std::uint64_t a, std::uint64_t b) noexcept
+        {
+#if defined(__SIZEOF_INT128__)
+            return static_cast<std::uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#else
+            std::uint64_t aLow = a & 0xFFFFFFFF, aHigh = a >> 32;
+            std::uint64_t bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+            std::uint64_t cross = (aLow * bLow >> 32) + (aHigh * bLow & 0xFFFFFFFF) + aLow * bHigh;
+            return aHigh * bHigh + (aHigh * bLow >> 32) + (cross >> 32);
+#endif
+        }
+
+        // Sal de cada palabra del bloque (las de los split block Bloom filters de Parquet)
+        inline constexpr std::uint32_t kBloomSalts[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                                         0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+        /**
+         * @brief Expected false positive rate of a split block Bloom filter
+         *
+         * Each key sets one bit in each of the 8 32-bit words of one 256-bit block.
+         * The number of keys per block follows a Poisson distribution of mean
+         * keysPerBlock; a block holding j keys answers a foreign key with probability
+         * (1 - (31/32)^j)^8.
+         */
+        inline double splitBlockFalsePositiveRate(double keysPerBlock)
+        {
+            if (keysPerBlock <= 0)
+            {
+                return 0.0;
+            }
+            double spread = 12 * std::sqrt(keysPerBlock) + 20;
+            auto first = static_cast<std::uint64_t>(std::max(0.0, keysPerBlock - spread));
+            auto last = static_cast<std::uint64_t>(keysPerBlock + spread);
+            double rate = 0;
+            for (std::uint64_t j = first; j <= last; ++j)
+            {
+                // Poisson en escala logarítmica: no se desborda con medias grandes
+                double logWeight = -keysPerBlock + static_cast<double>(j) * std::log(keysPerBlock) - std::lgamma(static_cast<double>(j) + 1);
+                rate += std::exp(logWeight) * std::pow(1 - std::pow(31.0 / 32.0, static_cast<double>(j)), 8);
+            }
+            return std::min(rate, 1.0);
+        }
+
+        template <typename Filter, typename Key>
+        concept InsertableFilter = requires(Filter &filter, const Key &key) { filter.insert(key); };
+
+        // Filtro que admite claves y se puede dimensionar para un número de claves (BloomFilter)
+        template <typename Filter, typename Key>
+        concept GrowableFilter = InsertableFilter<Filter, Key> && std::constructible_from<Filter, std::size_t> &&
+                                 requires(const Filter &filter) { { filter.getInsertedCount() } -> std::convertible_to<std::size_t>; };
+
+        // Formato serializado de cada filtro
+        constexpr std::uint32_t kBloomFilterMagic = 0x314D4C42;      // "BLM1"
+        constexpr std::uint32_t kBinaryFuseFilterMagic = 0x38554642; // "BFU8"
+    }
+
+    /**
+     * @brief Blocked (split block) Bloom filter: one cache access per query
+     *
+     * Keys are hashed once; the high 32 bits pick a 256-bit block and the low 32 bits,
+     * multiplied by 8 fixed odd salts, pick one bit in each of the block's 8 words.
+     * A query reads a single 32-byte block, so it costs one cache miss, and the 8 bit
+     * tests are one AVX2 compare when the build enables AVX2 (a branchless loop the
+     * compiler vectorizes otherwise). There are no false negatives; the false positive
+     * rate is the one requested at construction while at most `expectedKeys` keys are
+     * inserted, and grows past it.
+     *
+     * Keys cannot be removed. A serialized filter stores the bits only: read it back
+     * with the same Hash, whose results must not change between processes
+     * (std::hash of integers and strings does not in libstdc++ or libc++).
+     *
+     * @tparam Key Type of the keys
+     * @tparam Hash Hash function object type, defaults to std::hash<Key>
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::BloomFilter<cpp_ex::String> denied(1000000, 0.01);
+     * denied.insert("mallory@example.com");
+     * if (!denied.mayContain(email)) {
+     *     return allow(); // Definite miss: the deny-list map is not touched
+     * }
+     * ```
+     */
+    template <typename Key, typename Hash = std::hash<Key>>
+    class BloomFilter
+    {
+    public:
+        // Tipos (aliases)
+        using key_type = Key;
+        using hasher = Hash;
+        using size_type = std::size_t;
+
+        // Bloque de 256 bits: 8 palabras de 32, dos bloques por línea de caché
+        struct alignas(32) Block
+        {
+            std::uint32_t words[8];
+        };
+
+    private:
+        Vector<Block> blocks;
+        size_type inserted = 0;
+        [[no_unique_address]] Hash hashFn;
+
+        template <typename T, typename Enable>
+        friend struct Serializer;
+
+    public:
+        // Constructores
+        BloomFilter() : BloomFilter(0) {}
+
+        /**
+         * @brief Sizes the filter for expectedKeys keys at falsePositiveRate
+         *
+         * @throws std::invalid_argument if falsePositiveRate is not in (0, 1)
+         */
+        explicit BloomFilter(size_type expectedKeys, double falsePositiveRate = 0.01, const Hash &hash = Hash())
+            : blocks(blockCountFor(expectedKeys, falsePositiveRate)), hashFn(hash) {}
+
+        // Filtro con todas las claves del mapa (Map, HashMap, FlatMap...)
+        template <typename MapType>
+        static BloomFilter fromMap(const MapType &map, double falsePositiveRate = 0.01, const Hash &hash = Hash())
+        {
+            BloomFilter filter(map.getSize(), falsePositiveRate, hash);
+            for (const auto &entry : map)
+            {
+                filter.insert(entry.first);
+            }
+            return filter;
+        }
+
+        static BloomFilter fromKeys(const Vector<Key> &keys, double falsePositiveRate = 0.01, const Hash &hash = Hash())
+        {
+            BloomFilter filter(keys.getSize(), falsePositiveRate, hash);
+            for (const auto &key : keys)
+            {
+                filter.insert(key);
+            }
+            return filter;
+        }
+
+        // Modificadores
+        void insert(const Key &key)
+        {
+            auto hash = hashOf(key);
+            auto &block = blocks[blockIndex(hash)];
+            auto fingerprint = static_cast<std::uint32_t>(hash);
+#ifdef CPPEX_FILTER_AVX2
+            auto *words = reinterpret_cast<__m256i *>(block.words);
+            _mm256_store_si256(words, _mm256_or_si256(_mm256_load_si256(words), blockMask(fingerprint)));
+#else
+            for (int i = 0; i < 8; ++i)
+            {
+                block.words[i] |= std::uint32_t{1} << ((fingerprint * detail::kBloomSalts[i]) >> 27);
+            }
+#endif
+            ++inserted;
+        }
+
+        // Añade las claves de otro filtro del mismo tamaño (OR bit a bit)
+        void merge(const BloomFilter &other)
+        {
+            if (other.blocks.getSize() != blocks.getSize())
+            {
+                throw std::invalid_argument("BloomFilter::merge: filters differ in size");
+            }
+            for (size_type b = 0; b < blocks.getSize(); ++b)
+            {
+                for (int i = 0; i < 8; ++i)
+                {
+                    blocks[b].words[i] |= other.blocks[b].words[i];
+                }
+            }
+            inserted += other.inserted;
+        }
+
+        void clear() noexcept
+        {
+            std::fill(blocks.begin(), blocks.end(), Block{});
+            inserted = 0;
+        }
+
+        // Consulta: false es definitivo; true puede ser un falso positivo
+        bool mayContain(const Key &key) const
+        {
+            auto hash = hashOf(key);
+            const auto &block = blocks[blockIndex(hash)];
+            auto fingerprint = static_cast<std::uint32_t>(hash);
+#ifdef CPPEX_FILTER_AVX2
+            auto words = _mm256_load_si256(reinterpret_cast<const __m256i *>(block.words));
+            return _mm256_testc_si256(words, blockMask(fingerprint)) != 0;
+#else
+            std::uint32_t present = 1;
+            for (int i = 0; i < 8; ++i)
+            {
+                present &= block.words[i] >> ((fingerprint * detail::kBloomSalts[i]) >> 27);
+            }
+            return (present & 1) != 0;
+#endif
+        }
+
+        // Capacidad
+        size_type getBlockCount() const noexcept
+        {
+            return blocks.getSize();
+        }
+
+        size_type getByteSize() const noexcept
+        {
+            return blocks.getSize() * sizeof(Block);
+        }
+
+        // Llamadas a insert() (cuenta las claves repetidas)
+        size_type getInsertedCount() const noexcept
+        {
+            return inserted;
+        }
+
+        // Tasa de falsos positivos esperada con las claves insertadas hasta ahora
+        double getFalsePositiveRate() const
+        {
+            return detail::splitBlockFalsePositiveRate(static_cast<double>(inserted) / static_cast<double>(blocks.getSize()));
+        }
+
+        // Observadores
+        hasher hashFunction() const
+        {
+            return hashFn;
+        }
+
+        bool operator==(const BloomFilter &other) const
+        {
+            return blocks.getSize() == other.blocks.getSize() &&
+                   std::memcmp(blocks.getData(), other.blocks.getData(), getByteSize()) == 0;
+        }
+
+        bool operator!=(const BloomFilter &other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        // Menor número de bloques con el que expectedKeys claves dan falsePositiveRate
+        static size_type blockCountFor(size_type expectedKeys, double falsePositiveRate)
+        {
+            if (!(falsePositiveRate > 0 && falsePositiveRate < 1))
+            {
+                throw std::invalid_argument("BloomFilter: false positive rate must be in (0, 1)");
+            }
+            // La tasa crece con las claves por bloque: bisección sobre la carga máxima
+            double low = 1e-3;
+            double high = 256;
+            for (int step = 0; step < 60; ++step)
+            {
+                double mid = (low + high) / 2;
+                (detail::splitBlockFalsePositiveRate(mid) <= falsePositiveRate ? low : high) = mid;
+            }
+            auto count = static_cast<size_type>(std::ceil(static_cast<double>(expectedKeys) / low));
+            return std::clamp<size_type>(count, 1, std::numeric_limits<std::uint32_t>::max());
+        }
+
+        std::uint64_t hashOf(const Key &key) const
+        {
+            return detail::filterMix(static_cast<std::uint64_t>(hashFn(key)));
+        }
+
+        size_type blockIndex(std::uint64_t hash) const noexcept
+        {
+            return static_cast<size_type>(((hash >> 32) * blocks.getSize()) >> 32);
+        }
+
+#ifdef CPPEX_FILTER_AVX2
+        // Un bit por palabra: (fingerprint * sal) >> 27 elige el bit
+        static __m256i blockMask(std::uint32_t fingerprint) noexcept
+        {
+            const auto salts = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(detail::kBloomSalts));
+            auto bits = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(fingerprint)), salts), 27);
+            return _mm256_sllv_epi32(_mm256_set1_epi32(1), bits);
+        }
+#endif
+    };
+
+    /**
+     * @brief Immutable binary fuse filter with 8-bit fingerprints (~9 bits per key)
+     *
+     * Built once from a fixed key set, it answers queries with three reads from an
+     * array of about 1.13 bytes per key, at a false positive rate of about 0.4%.
+     * Each key maps to three slots in consecutive segments; construction peels the
+     * resulting 3-hypergraph and assigns fingerprints so that the XOR of a key's three
+     * slots equals its fingerprint (Graf and Lemire, "Binary Fuse Filters", 2022).
+     *
+     * Construction hashes the keys and groups the hashes by segment on several
+     * threads; the peeling itself is sequential. Repeated keys (and keys with equal
+     * hashes) count once: if an attempt fails, the hashes are deduplicated before the
+     * next one. Keys cannot be added: build a new filter. As with BloomFilter, a
+     * serialized filter must be read with the same Hash.
+     *
+     * @tparam Key Type of the keys
+     * @tparam Hash Hash function object type, defaults to std::hash<Key>
+     *
+     * @example
+     * ```cpp
+     * auto seen = cpp_ex::BinaryFuseFilter<std::uint64_t>::fromMap(dedupeMap);
+     * if (!seen.mayContain(id)) {
+     *     process(id); // Definitely new
+     * }
+     * ```
+     */
+    template <typename Key, typename Hash = std::hash<Key>>
+    class BinaryFuseFilter
+    {
+    public:
+        // Tipos (aliases)
+        using key_type = Key;
+        using hasher = Hash;
+        using size_type = std::size_t;
+
+    private:
+        static constexpr int kMaxAttempts = 100;
+        static constexpr std::uint32_t kMaxSegmentLength = 262144;
+
+        Vector<std::uint8_t> fingerprints;
+        std::uint64_t seed = 0;
+        std::uint32_t segmentLength = 0;
+        std::uint32_t segmentCount = 0;
+        size_type keyCount = 0;
+        [[no_unique_address]] Hash hashFn;
+
+        template <typename T, typename Enable>
+        friend struct Serializer;
+
+    public:
+        // Constructores: el filtro vacío no contiene nada
+        BinaryFuseFilter() = default;
+
+        explicit BinaryFuseFilter(const Hash &hash) : hashFn(hash) {}
+
+        /**
+         * @brief Filter over every key of a map (Map, HashMap, FlatMap...)
+         *
+         * @param threads Threads used to hash and sort (0 = one per hardware thread)
+         * @throws std::length_error with more than 2^31 keys
+         */
+        template <typename MapType>
+        static BinaryFuseFilter fromMap(const MapType &map, size_type threads = 0, const Hash &hash = Hash())
+        {
+            Vector<const Key *> keys;
+            keys.reserve(map.getSize());
+            for (const auto &entry : map)
+            {
+                keys.pushBack(&entry.first);
+            }
+            BinaryFuseFilter filter(hash);
+            filter.build(keys.getSize(), [&](size_type i) -> const Key &
+                         { return *keys[i]; }, threads);
+            return filter;
+        }
+
+        static BinaryFuseFilter fromKeys(const Vector<Key> &keys, size_type threads = 0, const Hash &hash = Hash())
+        {
+            BinaryFuseFilter filter(hash);
+            filter.build(keys.getSize(), [&](size_type i) -> const Key &
+                         { return keys[i]; }, threads);
+            return filter;
+        }
+
+        // Consulta: false es definitivo; true puede ser un falso positivo
+        bool mayContain(const Key &key) const
+        {
+            if (fingerprints.isEmpty())
+            {
+                return false;
+            }
+            auto hash = detail::filterMix(static_cast<std::uint64_t>(hashFn(key)) + seed);
+            auto slots = slotsOf(hash);
+            return (fingerprintOf(hash) ^ fingerprints[slots[0]] ^ fingerprints[slots[1]] ^ fingerprints[slots[2]]) == 0;
+        }
+
+        // Capacidad
+        size_type getKeyCount() const noexcept
+        {
+            return keyCount;
+        }
+
+        size_type getByteSize() const noexcept
+        {
+            return fingerprints.getSize();
+        }
+
+        bool isEmpty() const noexcept
+        {
+            return keyCount == 0;
+        }
+
+        // Observadores
+        hasher hashFunction() const
+        {
+            return hashFn;
+        }
+
+        bool operator==(const BinaryFuseFilter &other) const
+        {
+            return seed == other.seed && segmentLength == other.segmentLength &&
+                   segmentCount == other.segmentCount && fingerprints == other.fingerprints;
+        }
+
+        bool operator!=(const BinaryFuseFilter &other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        static std::uint8_t fingerprintOf(std::uint64_t hash) noexcept
+        {
+            return static_cast<std::uint8_t>(hash ^ (hash >> 32));
+        }
+
+        // Tres slots en segmentos consecutivos: el primero por multiplicación, los otros
+        // dos desplazados un segmento y permutados dentro de él con bits del hash
+        std::array<std::uint32_t, 3> slotsOf(std::uint64_t hash) const noexcept
+        {
+            auto mask = segmentLength - 1;
+            auto h0 = static_cast<std::uint32_t>(detail::mulHigh(hash, std::uint64_t{segmentCount} * segmentLength));
+            auto h1 = (h0 + segmentLength) ^ (static_cast<std::uint32_t>(hash >> 18) & mask);
+            auto h2 = (h0 + 2 * segmentLength) ^ (static_cast<std::uint32_t>(hash) & mask);
+            return {h0, h1, h2};
+        }
+
+        // Segmentos y tamaño del array para size claves (parámetros del artículo, aridad 3)
+        void allocate(size_type size)
+        {
+            segmentLength = size == 0 ? 4 : std::min(kMaxSegmentLength, std::uint32_t{1} << static_cast<int>(std::floor(std::log(static_cast<double>(size)) / std::log(3.33) + 2.25)));
+            double sizeFactor = size <= 1 ? 0 : std::max(1.125, 0.875 + 0.25 * std::log(1000000.0) / std::log(static_cast<double>(size)));
+            auto capacity = static_cast<size_type>(std::round(static_cast<double>(size) * sizeFactor));
+            auto segments = (capacity + segmentLength - 1) / segmentLength;
+            segmentCount = segments > 2 ? static_cast<std::uint32_t>(segments - 2) : 1;
+            fingerprints = Vector<std::uint8_t>((size_type{segmentCount} + 2) * segmentLength);
+        }
+
+        /**
+         * @brief Mixes hashes with the current seed into mixed, grouped by their high bits
+         *
+         * The first slot of a key grows with its mixed hash, so adding the keys in this
+         * order walks the counters almost sequentially instead of at random. A
+         * parallel counting sort: every part counts its keys per bucket, the counts
+         * are turned into offsets (bucket by bucket, part by part) and every part
+         * scatters its keys. The result does not depend on the number of parts.
+         */
+        void mixByHighBits(const Vector<std::uint64_t> &hashes, Vector<std::uint64_t> &mixed, size_type parts) const
+        {
+            size_type n = hashes.getSize();
+            int bits = std::max(1, static_cast<int>(std::bit_width(segmentCount - 1)));
+            size_type buckets = size_type{1} << bits;
+            Vector<size_type> offsets(parts * buckets);
+            detail::parallelFor(parts, [&](std::size_t part)
+                                {
+                                    for (size_type i = detail::partBegin(n, parts, part); i < detail::partBegin(n, parts, part + 1); ++i)
+                                    {
+                                        ++offsets[part * buckets + (detail::filterMix(hashes[i] + seed) >> (64 - bits))];
+                                    } });
+            size_type running = 0;
+            for (size_type bucket = 0; bucket < buckets; ++bucket)
+            {
+                for (size_type part = 0; part < parts; ++part)
+                {
+                    running += std::exchange(offsets[part * buckets + bucket], running);
+                }
+            }
+            detail::parallelFor(parts, [&](std::size_t part)
+                                {
+                                    for (size_type i = detail::partBegin(n, parts, part); i < detail::partBegin(n, parts, part + 1); ++i)
+                                    {
+                                        auto hash = detail::filterMix(hashes[i] + seed);
+                                        mixed[offsets[part * buckets + (hash >> (64 - bits))]++] = hash;
+                                    } });
+        }
+
+        template <typename KeyAt>
+        void build(size_type n, KeyAt keyAt, size_type threads)
+        {
+            if (n > (size_type{1} << 31))
+            {
+                throw std::length_error("BinaryFuseFilter: too many keys");
+            }
+            allocate(n);
+            keyCount = 0;
+            if (n == 0)
+            {
+                fingerprints.clear();
+                return;
+            }
+
+            // Hash de cada clave en paralelo (el Hash del usuario suele ser lo más caro)
+            size_type parts = detail::parallelParts(n, threads);
+            Vector<std::uint64_t> hashes(n);
+            detail::parallelFor(parts, [&](std::size_t part)
+                                {
+                                    for (size_type i = detail::partBegin(n, parts, part); i < detail::partBegin(n, parts, part + 1); ++i)
+                                    {
+                                        hashes[i] = static_cast<std::uint64_t>(hashFn(keyAt(i)));
+                                    } });
+
+            size_type capacity = fingerprints.getSize();
+            Vector<std::uint8_t> counts(capacity);  // (claves << 2) | XOR de la posición (0, 1, 2) de cada clave
+            Vector<std::uint64_t> xors(capacity);   // XOR de los hashes de las claves del slot
+            Vector<std::uint32_t> alone(capacity);  // Cola de slots con una sola clave
+            Vector<std::uint64_t> mixed(n);         // Hashes con la semilla del intento; luego, en orden de pelado
+            Vector<std::uint8_t> peeledSlot(n);     // Posición (0, 1, 2) por la que se peló cada clave
+
+            // La secuencia de semillas es fija: el mismo conjunto da el mismo filtro
+            std::uint64_t seedState = 0x726b2b9d438b9d4dULL;
+            size_type stack = 0;
+            bool deduplicated = false;
+            for (int attempt = 0;; ++attempt)
+            {
+                if (attempt == kMaxAttempts)
+                {
+                    throw std::runtime_error("BinaryFuseFilter: construction failed");
+                }
+                if (attempt > 0 && !deduplicated)
+                {
+                    // Un intento fallido suele deberse a claves repetidas que la detección
+                    // rápida no ve (tres o más copias, o pares en slots compartidos): se
+                    // quitan los hashes repetidos una vez y se sigue con la siguiente semilla
+                    std::sort(hashes.begin(), hashes.end());
+                    hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+                    n = hashes.getSize();
+                    mixed.resize(n);
+                    deduplicated = true;
+                }
+                seedState += 0x9E3779B97F4A7C15ULL;
+                seed = detail::filterMix(seedState);
+                std::fill(counts.begin(), counts.end(), std::uint8_t{0});
+                std::fill(xors.begin(), xors.end(), std::uint64_t{0});
+                mixByHighBits(hashes, mixed, parts);
+
+                bool overflow = false;
+                size_type duplicates = 0;
+                for (auto hash : mixed)
+                {
+                    auto slots = slotsOf(hash);
+                    for (std::uint8_t position = 0; position < 3; ++position)
+                    {
+                        counts[slots[position]] = static_cast<std::uint8_t>((counts[slots[position]] + 4) ^ position);
+                        xors[slots[position]] ^= hash;
+                    }
+                    // Mismo hash que una clave anterior (claves repetidas): se deshace
+                    if ((xors[slots[0]] & xors[slots[1]] & xors[slots[2]]) == 0 &&
+                        ((xors[slots[0]] == 0 && counts[slots[0]] == 8) ||
+                         (xors[slots[1]] == 0 && counts[slots[1]] == 8) ||
+                         (xors[slots[2]] == 0 && counts[slots[2]] == 8)))
+                    {
+                        ++duplicates;
+                        for (std::uint8_t position = 0; position < 3; ++position)
+                        {
+                            counts[slots[position]] = static_cast<std::uint8_t>((counts[slots[position]] - 4) ^ position);
+                            xors[slots[position]] ^= hash;
+                        }
+                    }
+                    for (auto slot : slots)
+                    {
+                        overflow |= counts[slot] < 4; // Más de 63 claves en un slot
+                    }
+                }
+                if (overflow)
+                {
+                    continue;
+                }
+
+                // Pela slots con una sola clave: esa clave se asignará a ese slot
+                size_type queued = 0;
+                for (size_type i = 0; i < capacity; ++i)
+                {
+                    alone[queued] = static_cast<std::uint32_t>(i);
+                    queued += (counts[i] >> 2) == 1 ? 1 : 0;
+                }
+                stack = 0;
+                while (queued > 0)
+                {
+                    auto index = alone[--queued];
+                    if ((counts[index] >> 2) != 1)
+                    {
+                        continue;
+                    }
+                    auto hash = xors[index];
+                    auto slots = slotsOf(hash);
+                    std::uint8_t found = counts[index] & 3;
+                    mixed[stack] = hash;
+                    peeledSlot[stack] = found;
+                    ++stack;
+                    for (std::uint8_t other = 1; other < 3; ++other)
+                    {
+                        auto position = static_cast<std::uint8_t>((found + other) % 3);
+                        auto slot = slots[position];
+                        alone[queued] = slot;
+                        queued += (counts[slot] >> 2) == 2 ? 1 : 0;
+                        counts[slot] = static_cast<std::uint8_t>((counts[slot] - 4) ^ position);
+                        xors[slot] ^= hash;
+                    }
+                }
+                if (stack + duplicates == n)
+                {
+                    break;
+                }
+            }
+
+            // En orden inverso al pelado, cada slot elegido completa el XOR de su clave
+            keyCount = stack;
+            std::fill(fingerprints.begin(), fingerprints.end(), std::uint8_t{0});
+            for (size_type i = stack; i-- > 0;)
+            {
+                auto hash = mixed[i];
+                auto slots = slotsOf(hash);
+                auto found = peeledSlot[i];
+                fingerprints[slots[found]] = static_cast<std::uint8_t>(fingerprintOf(hash) ^ fingerprints[slots[(found + 1) % 3]] ^ fingerprints[slots[(found + 2) % 3]]);
+            }
+        }
+    };
+
+    /**
+     * @brief Map with a membership filter in front of its lookups
+     *
+     * contains(), count(), find() and at() ask the filter first and only touch the
+     * map when it answers "maybe", so misses (the common case of deny-lists and
+     * dedupe tables) cost one filter probe instead of a tree walk or a binary search.
+     * Works with Map, HashMap, FlatMap and any map with the same lookup API. A HashMap
+     * miss on cheap keys already costs about one cache miss, like the filter probe:
+     * there the filter pays off only when hashing or comparing keys is expensive.
+     *
+     * With BloomFilter, insert() and operator[] also add new keys to the filter.
+     * When more keys are added than the filter was sized for (the map's size at
+     * construction, the expectedKeys argument or the last rebuildFilter()), the
+     * filter is rebuilt for twice the current size, so the false positive rate stays
+     * near 1% at an amortized O(1) cost per insertion. An immutable filter (BinaryFuseFilter) only allows erase(); use update() to
+     * modify the map and rebuild the filter in one step. Erased keys stay in the
+     * filter, which is still correct (only more "maybe" answers): rebuildFilter()
+     * drops them.
+     *
+     * @tparam MapType Type of the wrapped map
+     * @tparam FilterType Filter type, defaults to BloomFilter over the map's keys
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::FilteredMap<cpp_ex::HashMap<cpp_ex::String, Reason>> denyList(loadDenyList());
+     * if (denyList.contains(user)) { ... } // Most users are rejected by the filter alone
+     * ```
+     */
+    template <typename MapType, typename FilterType = BloomFilter<typename MapType::key_type>>
+    class FilteredMap
+    {
+    public:
+        // Tipos (aliases)
+        using map_type = MapType;
+        using filter_type = FilterType;
+        using key_type = typename MapType::key_type;
+        using mapped_type = typename MapType::mapped_type;
+        using value_type = typename MapType::value_type;
+        using size_type = typename MapType::size_type;
+        using iterator = typename MapType::iterator;
+        using const_iterator = typename MapType::const_iterator;
+
+    private:
+        // Tamaño mínimo del filtro cuando crece
+        static constexpr size_type kMinFilterKeys = 64;
+
+        MapType map;
+        FilterType filter;
+        size_type filterCapacity = 0; // Claves para las que se dimensionó el filtro
+
+    public:
+        // Constructores: el filtro se construye con las claves del mapa
+        FilteredMap() : filter(FilterType::fromMap(map)) {}
+
+        explicit FilteredMap(MapType source)
+            : map(std::move(source)), filter(FilterType::fromMap(map)), filterCapacity(map.getSize()) {}
+
+        // Mapa vacío con el filtro dimensionado para expectedKeys claves
+        explicit FilteredMap(size_type expectedKeys)
+            requires detail::GrowableFilter<FilterType, key_type>
+            : filter(expectedKeys), filterCapacity(expectedKeys) {}
+
+        // Usa un filtro ya construido (p. ej. deserializado) que debe contener todas las claves
+        FilteredMap(MapType source, FilterType prebuilt)
+            : map(std::move(source)), filter(std::move(prebuilt)), filterCapacity(map.getSize()) {}
+
+        // Lookup
+        bool contains(const key_type &key) const
+        {
+            return filter.mayContain(key) && map.contains(key);
+        }
+
+        size_type count(const key_type &key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        iterator find(const key_type &key)
+        {
+            return filter.mayContain(key) ? map.find(key) : map.end();
+        }
+
+        const_iterator find(const key_type &key) const
+        {
+            return filter.mayContain(key) ? map.find(key) : map.end();
+        }
+
+        mapped_type &at(const key_type &key)
+        {
+            if (!filter.mayContain(key))
+            {
+                throw std::out_of_range("FilteredMap::at: key not found");
+            }
+            return map.at(key);
+        }
+
+        const mapped_type &at(const key_type &key) const
+        {
+            if (!filter.mayContain(key))
+            {
+                throw std::out_of_range("FilteredMap::at: key not found");
+            }
+            return map.at(key);
+        }
+
+        // Modificadores (insertar requiere un filtro que admita claves nuevas)
+        mapped_type &operator[](const key_type &key)
+            requires detail::InsertableFilter<FilterType, key_type>
+        {
+            size_type before = map.getSize();
+            mapped_type &value = map[key];
+            if (map.getSize() != before)
+            {
+                addToFilter(key);
+            }
+            return value;
+        }
+
+        std::pair<iterator, bool> insert(const value_type &value)
+            requires detail::InsertableFilter<FilterType, key_type>
+        {
+            auto result = map.insert(value);
+            if (result.second)
+            {
+                addToFilter(value.first);
+            }
+            return result;
+        }
+
+        std::pair<iterator, bool> insert(value_type &&value)
+            requires detail::InsertableFilter<FilterType, key_type>
+        {
+            auto result = map.insert(std::move(value));
+            if (result.second)
+            {
+                addToFilter(result.first->first);
+            }
+            return result;
+        }
+
+        size_type erase(const key_type &key)
+        {
+            return filter.mayContain(key) ? map.erase(key) : 0;
+        }
+
+        // Modifica el mapa con func(map) y reconstruye el filtro
+        template <typename Func>
+        void update(Func func)
+        {
+            func(map);
+            rebuildFilter();
+        }
+
+        void rebuildFilter()
+        {
+            filter = FilterType::fromMap(map);
+            filterCapacity = map.getSize();
+        }
+
+        // Acceso al mapa y al filtro
+        const MapType &getMap() const noexcept
+        {
+            return map;
+        }
+
+        const FilterType &getFilter() const noexcept
+        {
+            return filter;
+        }
+
+        // Capacidad
+        size_type getSize() const noexcept
+        {
+            return map.getSize();
+        }
+
+        bool isEmpty() const noexcept
+        {
+            return map.isEmpty();
+        }
+
+        // Iteradores (solo lectura: cambiar claves desincronizaría el filtro)
+        const_iterator begin() const
+        {
+            return map.begin();
+        }
+
+        const_iterator end() const
+        {
+            return map.end();
+        }
+
+    private:
+        // Añade una clave nueva; si el filtro se queda pequeño se reconstruye al doble
+        void addToFilter(const key_type &key)
+        {
+            filter.insert(key);
+            if constexpr (detail::GrowableFilter<FilterType, key_type>)
+            {
+                if (filter.getInsertedCount() > filterCapacity)
+                {
+                    filterCapacity = std::max(kMinFilterKeys, map.getSize() * 2);
+                    FilterType grown(filterCapacity);
+                    for (const auto &entry : map)
+                    {
+                        grown.insert(entry.first);
+                    }
+                    filter = std::move(grown);
+                }
+            }
+        }
+    };
+
+    // Formato: magia, bloques, claves insertadas, CRC-32C de los bits y los bits
+    template <typename Key, typename Hash>
+    struct Serializer<BloomFilter<Key, Hash>>
+    {
+        static void write(BinaryWriter &out, const BloomFilter<Key, Hash> &filter)
+        {
+            BinaryWriter bits(filter.getByteSize());
+            for (const auto &block : filter.blocks)
+            {
+                for (auto word : block.words)
+                {
+                    bits.writeU32(word);
+                }
+            }
+            out.writeU32(detail::kBloomFilterMagic);
+            out.writeVarint(filter.blocks.getSize());
+            out.writeVarint(filter.inserted);
+            out.writeU32(crc32c(bits.getBuffer()));
+            out.writeBytes(bits.getBuffer().data(), bits.getSize());
+        }
+
+        static BloomFilter<Key, Hash> read(BinaryReader &in)
+        {
+            if (in.readU32() != detail::kBloomFilterMagic)
+            {
+                throw exceptions::SerializationError("BloomFilter: bad magic");
+            }
+            std::uint64_t blockCount = in.readVarint();
+            std::uint64_t inserted = in.readVarint();
+            std::uint32_t crc = in.readU32();
+            if (blockCount == 0 || blockCount > in.getRemaining() / sizeof(typename BloomFilter<Key, Hash>::Block))
+            {
+                throw exceptions::SerializationError("BloomFilter: invalid block count");
+            }
+            auto bytes = in.readBytes(static_cast<std::size_t>(blockCount) * sizeof(typename BloomFilter<Key, Hash>::Block));
+            if (crc32c(bytes) != crc)
+            {
+                throw exceptions::SerializationError("BloomFilter: checksum mismatch");
+            }
+
+            BloomFilter<Key, Hash> filter;
+            filter.blocks = Vector<typename BloomFilter<Key, Hash>::Block>(static_cast<std::size_t>(blockCount));
+            filter.inserted = static_cast<std::size_t>(inserted);
+            BinaryReader bits(bytes);
+            for (auto &block : filter.blocks)
+            {
+                for (auto &word : block.words)
+                {
+                    word = bits.readU32();
+                }
+            }
+            return filter;
+        }
+    };
+
+    // Formato: magia, semilla, geometría de segmentos, claves, CRC-32C y las huellas
+    template <typename Key, typename Hash>
+    struct Serializer<BinaryFuseFilter<Key, Hash>>
+    {
+        static void write(BinaryWriter &out, const BinaryFuseFilter<Key, Hash> &filter)
+        {
+            std::string_view bytes(reinterpret_cast<const char *>(filter.fingerprints.getData()), filter.fingerprints.getSize());
+            out.writeU32(detail::kBinaryFuseFilterMagic);
+            out.writeU64(filter.seed);
+            out.writeVarint(filter.segmentLength);
+            out.writeVarint(filter.segmentCount);
+            out.writeVarint(filter.keyCount);
+            out.writeU32(crc32c(bytes));
+            out.writeString(bytes);
+        }
+
+        static BinaryFuseFilter<Key, Hash> read(BinaryReader &in)
+        {
+            if (in.readU32() != detail::kBinaryFuseFilterMagic)
+            {
+                throw exceptions::SerializationError("BinaryFuseFilter: bad magic");
+            }
+            BinaryFuseFilter<Key, Hash> filter;
+            filter.seed = in.readU64();
+            std::uint64_t segmentLength = in.readVarint();
+            std::uint64_t segmentCount = in.readVarint();
+            filter.keyCount = static_cast<std::size_t>(in.readVarint());
+            std::uint32_t crc = in.readU32();
+            auto bytes = in.readStringView();
+            bool validGeometry = filter.keyCount == 0
+                                     ? bytes.empty()
+                                     : std::has_single_bit(segmentLength) && segmentLength <= BinaryFuseFilter<Key, Hash>::kMaxSegmentLength &&
+                                           segmentCount > 0 && segmentCount <= std::numeric_limits<std::uint32_t>::max() &&
+                                           bytes.size() == (segmentCount + 2) * segmentLength;
+            if (!validGeometry)
+            {
+                throw exceptions::SerializationError("BinaryFuseFilter: invalid geometry");
+            }
+            if (crc32c(bytes) != crc)
+            {
+                throw exceptions::SerializationError("BinaryFuseFilter: checksum mismatch");
+            }
+            filter.segmentLength = static_cast<std::uint32_t>(segmentLength);
+            filter.segmentCount = static_cast<std::uint32_t>(segmentCount);
+            filter.fingerprints = Vector<std::uint8_t>(bytes.begin(), bytes.end());
+            return filter;
+        }
+    };
+
+} // namespace cppex
+
+#endif // CPPEX_FILTER_HPP
@@ -0,0 +1,977 @@
+/**
+ * @file flat_map.hpp
+ * @brief Sorted flat map backed by contiguous key and value Vectors
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_FLAT_MAP_HPP
+#define CPPEX_FLAT_MAP_HPP
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "common.hpp"    // Include detail::prefetch
+#include "vector.hpp"    // Include Vector class
+#include "map_entry.hpp" // Include MapEntryRef and MapColumnIterator
+#include "parallel.hpp"  // Include detail::parallelFor
+
+namespace cpp_ex
+{
+    namespace detail
+    {
+        // Tipo guardado en la columna de valores de FlatMap: Vector<bool> está empaquetado y no da
+        // bool& ni bool*, así que bool se guarda en un byte (FlatMap::valueData() lo ve como bool)
+        template <typename Value>
+        using FlatValueStorage = std::conditional_t<std::is_same_v<Value, bool>, unsigned char, Value>;
+        static_assert(sizeof(bool) == sizeof(unsigned char));
+    }
+
+    /**
+     * @brief Ordered map stored as two sorted, contiguous columns
+     *
+     * Keys and values live in two parallel cpp_ex::Vector columns kept sorted by key.
+     * Lookups run a branchless binary search over the key column only, so a probe
+     * touches log2(n) keys in a single array instead of chasing tree nodes, and
+     * iteration is a linear scan. Inserting or erasing a single element is O(n); the
+     * type is meant for maps that are built once (or in bulk) and read many times.
+     *
+     * Bulk construction from unsorted input sorts once and removes duplicate keys
+     * (the first occurrence wins, as with repeated Map::insert). Set operations
+     * (merge, difference, intersection) are linear merges of the two sorted columns.
+     *
+     * Iterators are random access and dereference to a MapEntryRef, which exposes
+     * `first` and `second` like the `std::pair` of cpp_ex::Map.
+     *
+     * FlatMap<Key, bool> stores its values one per byte (a Vector<unsigned char> column),
+     * because the bit-packed Vector<bool> cannot hand out bool& or bool*.
+     *
+     * @tparam Key Type of the keys
+     * @tparam Value Type of the mapped values
+     * @tparam Compare Comparison function object type, defaults to std::less<Key>
+     *
+     * @example
+     * ```cpp
+     * // Build once from unsorted data
+     * cpp_ex::FlatMap<int, std::string> codes = {
+     *     {404, "Not Found"},
+     *     {200, "OK"},
+     *     {500, "Internal Server Error"}
+     * };
+     *
+     * // Read many times
+     * auto it = codes.find(200);
+     * auto clientErrors = codes.filterEntries([](int code, const std::string &) {
+     *     return code >= 400 && code < 500;
+     * });
+     * ```
+     */
+    template <typename Key, typename Value, typename Compare = std::less<Key>>
+    class FlatMap
+    {
+    private:
+        Vector<Key> keys;
+        Vector<detail::FlatValueStorage<Value>> values;
+        [[no_unique_address]] Compare comp;
+
+        // Declare friendship with all other FlatMap instantiations
+        template <typename K, typename V, typename C>
+        friend class FlatMap;
+
+    public:
+        // Tipos (aliases)
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<Key, Value>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using key_compare = Compare;
+        using reference = MapEntryRef<Key, Value>;
+        using const_reference = MapEntryRef<Key, const Value>;
+        using iterator = MapColumnIterator<Key, Value>;
+        using const_iterator = MapColumnIterator<Key, const Value>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        using value_column_type = Vector<detail::FlatValueStorage<Value>>; // Vector<Value>; bool usa Vector<unsigned char>
+
+        // Constructores
+        FlatMap() = default;
+
+        explicit FlatMap(const Compare &comp) : comp(comp) {}
+
+        // Construcción en bloque: ordena una vez y elimina claves repetidas (gana la primera)
+        template <typename InputIt>
+        FlatMap(InputIt first, InputIt last, const Compare &comp = Compare()) : comp(comp)
+        {
+            Vector<value_type> entries(first, last);
+            buildFromEntries(entries);
+        }
+
+        FlatMap(std::initializer_list<value_type> init, const Compare &comp = Compare())
+            : FlatMap(init.begin(), init.end(), comp) {}
+
+        FlatMap(const FlatMap &other) = default;
+
+        FlatMap(FlatMap &&other) noexcept = default;
+
+        // Adopta columnas ya ordenadas y sin duplicados en O(n), sin comprobarlas
+        static FlatMap fromSorted(Vector<Key> sortedKeys, Vector<Value> sortedValues, const Compare &comp = Compare())
+        {
+            if (sortedKeys.getSize() != sortedValues.getSize())
+            {
+                throw std::invalid_argument("FlatMap::fromSorted: key and value columns differ in size");
+            }
+            FlatMap result(comp);
+            result.keys = std::move(sortedKeys);
+            if constexpr (std::is_same_v<Value, bool>)
+            {
+                result.values = value_column_type(sortedValues.begin(), sortedValues.end());
+            }
+            else
+            {
+                result.values = std::move(sortedValues);
+            }
+            return result;
+        }
+
+        // Operadores de asignación
+        FlatMap &operator=(const FlatMap &other) = default;
+
+        FlatMap &operator=(FlatMap &&other) noexcept = default;
+
+        FlatMap &operator=(std::initializer_list<value_type> ilist)
+        {
+            FlatMap tmp(ilist, comp);
+            swap(tmp);
+            return *this;
+        }
+
+        // Acceso a las columnas
+        const Vector<Key> &getKeyColumn() const noexcept
+        {
+            return keys;
+        }
+
+        const value_column_type &getValueColumn() const noexcept
+        {
+            return values;
+        }
+
+        // Iteradores
+        iterator begin() noexcept
+        {
+            return iterator(keys.getData(), valueData());
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return const_iterator(keys.getData(), valueData());
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        iterator end() noexcept
+        {
+            return begin() + static_cast<difference_type>(keys.getSize());
+        }
+
+        const_iterator end() const noexcept
+        {
+            return begin() + static_cast<difference_type>(keys.getSize());
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return rbegin();
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        const_reverse_iterator crend() const noexcept
+        {
+            return rend();
+        }
+
+        // Capacidad
+        bool isEmpty() const noexcept
+        {
+            return keys.isEmpty();
+        }
+
+        size_type getSize() const noexcept
+        {
+            return keys.getSize();
+        }
+
+        size_type getMaxSize() const noexcept
+        {
+            return std::min(keys.getMaxSize(), values.getMaxSize());
+        }
+
+        void reserve(size_type newCap)
+        {
+            keys.reserve(newCap);
+            values.reserve(newCap);
+        }
+
+        size_type getCapacity() const noexcept
+        {
+            return std::min(keys.getCapacity(), values.getCapacity());
+        }
+
+        void shrinkToFit()
+        {
+            keys.shrinkToFit();
+            values.shrinkToFit();
+        }
+
+        // Acceso a elementos
+        mapped_type &at(const key_type &key)
+        {
+            auto index = findIndex(key);
+            if (index == keys.getSize())
+            {
+                throw std::out_of_range("FlatMap::at: key not found");
+            }
+            return valueAt(index);
+        }
+
+        const mapped_type &at(const key_type &key) const
+        {
+            auto index = findIndex(key);
+            if (index == keys.getSize())
+            {
+                throw std::out_of_range("FlatMap::at: key not found");
+            }
+            return valueAt(index);
+        }
+
+        mapped_type &operator[](const key_type &key)
+        {
+            return tryEmplace(key).first->second;
+        }
+
+        mapped_type &operator[](key_type &&key)
+        {
+            return tryEmplace(std::move(key)).first->second;
+        }
+
+        // Modificadores
+        void clear() noexcept
+        {
+            keys.clear();
+            values.clear();
+        }
+
+        std::pair<iterator, bool> insert(const value_type &value)
+        {
+            return tryEmplace(value.first, value.second);
+        }
+
+        std::pair<iterator, bool> insert(value_type &&value)
+        {
+            return tryEmplace(std::move(value.first), std::move(value.second));
+        }
+
+        // El hint se usa si es correcto; si no, se hace la búsqueda normal
+        iterator insert(const_iterator hint, const value_type &value)
+        {
+            return emplaceHint(hint, value.first, value.second);
+        }
+
+        iterator insert(const_iterator hint, value_type &&value)
+        {
+            return emplaceHint(hint, std::move(value.first), std::move(value.second));
+        }
+
+        // Inserción en bloque: añade al final, ordena lo nuevo y fusiona (O(n + m log m))
+        template <typename InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            Vector<value_type> entries(first, last);
+            if (entries.isEmpty())
+            {
+                return;
+            }
+            FlatMap incoming(comp);
+            incoming.buildFromEntries(entries);
+            *this = merge(incoming);
+        }
+
+        void insert(std::initializer_list<value_type> ilist)
+        {
+            insert(ilist.begin(), ilist.end());
+        }
+
+        template <typename M>
+        std::pair<iterator, bool> insertOrAssign(const key_type &key, M &&value)
+        {
+            auto result = tryEmplace(key, std::forward<M>(value));
+            if (!result.second)
+            {
+                result.first->second = std::forward<M>(value);
+            }
+            return result;
+        }
+
+        template <typename... Args>
+        std::pair<iterator, bool> emplace(Args &&...args)
+        {
+            value_type tmp(std::forward<Args>(args)...);
+            return tryEmplace(std::move(tmp.first), std::move(tmp.second));
+        }
+
+        template <typename K, typename... Args>
+        iterator emplaceHint(const_iterator hint, K &&key, Args &&...args)
+        {
+            auto index = static_cast<size_type>(hint - cbegin());
+            bool afterPrev = index == 0 || comp(keys[index - 1], key);
+            bool beforeHint = index == keys.getSize() || comp(key, keys[index]);
+            if (!(afterPrev && beforeHint))
+            {
+                return tryEmplace(std::forward<K>(key), std::forward<Args>(args)...).first;
+            }
+            return insertAt(index, std::forward<K>(key), std::forward<Args>(args)...);
+        }
+
+        // Construye el valor solo si la clave no existe
+        template <typename K, typename... Args>
+        std::pair<iterator, bool> tryEmplace(K &&key, Args &&...args)
+        {
+            auto index = lowerBoundIndex(key);
+            if (index < keys.getSize() && !comp(key, keys[index]))
+            {
+                return {begin() + static_cast<difference_type>(index), false};
+            }
+            return {insertAt(index, std::forward<K>(key), std::forward<Args>(args)...), true};
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            auto index = static_cast<difference_type>(pos - cbegin());
+            keys.erase(keys.begin() + index);
+            values.erase(values.begin() + index);
+            return begin() + index;
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            auto from = static_cast<difference_type>(first - cbegin());
+            auto to = static_cast<difference_type>(last - cbegin());
+            keys.erase(keys.begin() + from, keys.begin() + to);
+            values.erase(values.begin() + from, values.begin() + to);
+            return begin() + from;
+        }
+
+        size_type erase(const key_type &key)
+        {
+            auto index = findIndex(key);
+            if (index == keys.getSize())
+            {
+                return 0;
+            }
+            erase(cbegin() + static_cast<difference_type>(index));
+            return 1;
+        }
+
+        void swap(FlatMap &other) noexcept
+        {
+            using std::swap;
+            keys.swap(other.keys);
+            values.swap(other.values);
+            swap(comp, other.comp);
+        }
+
+        // Lookup
+        size_type count(const key_type &key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        iterator find(const key_type &key)
+        {
+            return begin() + static_cast<difference_type>(findIndex(key));
+        }
+
+        const_iterator find(const key_type &key) const
+        {
+            return begin() + static_cast<difference_type>(findIndex(key));
+        }
+
+        bool contains(const key_type &key) const
+        {
+            return findIndex(key) != keys.getSize();
+        }
+
+        std::pair<iterator, iterator> equalRange(const key_type &key)
+        {
+            auto first = lowerBound(key);
+            auto last = first;
+            if (last != end() && !comp(key, last->first))
+            {
+                ++last;
+            }
+            return {first, last};
+        }
+
+        std::pair<const_iterator, const_iterator> equalRange(const key_type &key) const
+        {
+            auto first = lowerBound(key);
+            auto last = first;
+            if (last != end() && !comp(key, last->first))
+            {
+                ++last;
+            }
+            return {first, last};
+        }
+
+        iterator lowerBound(const key_type &key)
+        {
+            return begin() + static_cast<difference_type>(lowerBoundIndex(key));
+        }
+
+        const_iterator lowerBound(const key_type &key) const
+        {
+            return begin() + static_cast<difference_type>(lowerBoundIndex(key));
+        }
+
+        iterator upperBound(const key_type &key)
+        {
+            return begin() + static_cast<difference_type>(upperBoundIndex(key));
+        }
+
+        const_iterator upperBound(const key_type &key) const
+        {
+            return begin() + static_cast<difference_type>(upperBoundIndex(key));
+        }
+
+        /**
+         * @brief Batched lookups that interleave the binary searches of many keys
+         *
+         * `results[i]` is `find(queries[i])` (end() when the key is absent) and
+         * `results` is resized to `queries.getSize()`; containsMany() fills flags
+         * instead and returns how many keys were found. All searches of a group of
+         * detail::kBatchLookupWidth keys halve the same range length in lockstep, so
+         * each step advances every search once and prefetches its next probe; the
+         * cache misses of the group overlap instead of serializing.
+         */
+        void findMany(const Vector<Key> &queries, Vector<iterator> &results)
+        {
+            results.resize(queries.getSize());
+            searchMany(queries, [&](size_type i, size_type index)
+                       { results[i] = begin() + static_cast<difference_type>(index); });
+        }
+
+        void findMany(const Vector<Key> &queries, Vector<const_iterator> &results) const
+        {
+            results.resize(queries.getSize());
+            searchMany(queries, [&](size_type i, size_type index)
+                       { results[i] = begin() + static_cast<difference_type>(index); });
+        }
+
+        size_type containsMany(const Vector<Key> &queries, Vector<bool> &results) const
+        {
+            results.resize(queries.getSize());
+            size_type found = 0;
+            searchMany(queries, [&](size_type i, size_type index)
+                       {
+                           results[i] = index != keys.getSize();
+                           found += index != keys.getSize() ? 1 : 0; });
+            return found;
+        }
+
+        // Observadores
+        key_compare keyComp() const
+        {
+            return comp;
+        }
+
+        // Operadores de comparación
+        bool operator==(const FlatMap &other) const
+        {
+            return keys == other.keys && values == other.values;
+        }
+
+        bool operator!=(const FlatMap &other) const
+        {
+            return !(*this == other);
+        }
+
+        bool operator<(const FlatMap &other) const
+        {
+            return std::lexicographical_compare(begin(), end(), other.begin(), other.end(),
+                                                [](const const_reference &a, const const_reference &b)
+                                                {
+                                                    return a.first < b.first || (!(b.first < a.first) && a.second < b.second);
+                                                });
+        }
+
+        bool operator<=(const FlatMap &other) const
+        {
+            return !(other < *this);
+        }
+
+        bool operator>(const FlatMap &other) const
+        {
+            return other < *this;
+        }
+
+        bool operator>=(const FlatMap &other) const
+        {
+            return !(*this < other);
+        }
+
+        // Métodos adicionales que usan cppex::Vector
+
+        // Obtener todas las claves como un Vector
+        Vector<Key> getKeys() const
+        {
+            return keys;
+        }
+
+        // Obtener todos los valores como un Vector
+        Vector<Value> getValues() const
+        {
+            return Vector<Value>(valueData(), valueData() + values.getSize());
+        }
+
+        // Obtener todos los pares como un Vector
+        Vector<std::pair<Key, Value>> getEntries() const
+        {
+            Vector<std::pair<Key, Value>> entries;
+            entries.reserve(keys.getSize());
+            for (size_type i = 0; i < keys.getSize(); ++i)
+            {
+                entries.emplaceBack(keys[i], valueAt(i));
+            }
+            return entries;
+        }
+
+        // Mapear valores a un nuevo tipo (las claves ya están ordenadas: O(n))
+        template <typename ResultType, typename UnaryFunc>
+        FlatMap<Key, ResultType, Compare> mapValues(UnaryFunc func) const
+        {
+            Vector<ResultType> mapped;
+            mapped.reserve(values.getSize());
+            for (size_type i = 0; i < values.getSize(); ++i)
+            {
+                mapped.pushBack(func(valueAt(i)));
+            }
+            return FlatMap<Key, ResultType, Compare>::fromSorted(keys, std::move(mapped), comp);
+        }
+
+        // Filtrar entradas según un predicado
+        template <typename BinaryPredicate>
+        FlatMap filterEntries(BinaryPredicate pred) const
+        {
+            FlatMap result(comp);
+            for (size_type i = 0; i < keys.getSize(); ++i)
+            {
+                if (pred(keys[i], valueAt(i)))
+                {
+                    result.keys.pushBack(keys[i]);
+                    result.values.pushBack(valueAt(i));
+                }
+            }
+            return result;
+        }
+
+        // Ejecutar una función para cada par clave-valor
+        template <typename BinaryFunc>
+        void forEach(BinaryFunc func)
+        {
+            for (size_type i = 0; i < keys.getSize(); ++i)
+            {
+                func(static_cast<const Key &>(keys[i]), valueAt(i));
+            }
+        }
+
+        template <typename BinaryFunc>
+        void forEach(BinaryFunc func) const
+        {
+            for (size_type i = 0; i < keys.getSize(); ++i)
+            {
+                func(keys[i], valueAt(i));
+            }
+        }
+
+        /**
+         * @brief Parallel versions of forEach(), mapValues() and filterEntries()
+         *
+         * The columns are split into contiguous index ranges of about the same size,
+         * one per thread (`threads == 0` uses every hardware thread, but keeps maps of
+         * a few thousand entries sequential). func/pred run concurrently and must be
+         * safe to call in parallel. Per-thread results are concatenated in index
+         * order, so the output equals the sequential version. If a call throws, every
+         * thread finishes its range and the exception is rethrown.
+         */
+        template <typename BinaryFunc>
+        void parallelForEach(BinaryFunc func, size_type threads = 0)
+        {
+            size_type n = keys.getSize();
+            size_type parts = detail::parallelParts(n, threads);
+            detail::parallelFor(parts, [&](std::size_t part)
+                                {
+                                    for (size_type i = detail::partBegin(n, parts, part); i < detail::partBegin(n, parts, part + 1); ++i)
+                                    {
+                                        func(static_cast<const Key &>(keys[i]), valueAt(i));
+                                    } });
+        }
+
+        template <typename BinaryFunc>
+        void parallelForEach(BinaryFunc func, size_type threads = 0) const
+        {
+            size_type n = keys.getSize();
+            size_type parts = detail::parallelParts(n, threads);
+            detail::parallelFor(parts, [&](std::size_t part)
+                                {
+                                    for (size_type i = detail::partBegin(n, parts, part); i < detail::partBegin(n, parts, part + 1); ++i)
+                                    {
+                                        func(keys[i], valueAt(i));
+                                    } });
+        }
+
+        template <typename ResultType, typename UnaryFunc>
+        FlatMap<Key, ResultType, Compare> parallelMapValues(UnaryFunc func, size_type threads = 0) const
+        {
+            size_type n = keys.getSize();
+            size_type parts = detail::parallelParts(n, threads);
+            Vector<Vector<ResultType>> mapped(parts);
+            detail::parallelFor(parts, [&](std::size_t part)
+                                {
+                                    size_type first = detail::partBegin(n, parts, part);
+                                    size_type last = detail::partBegin(n, parts, part + 1);
+                                    mapped[part].reserve(last - first);
+                                    for (size_type i = first; i < last; ++i)
+                                    {
+                                        mapped[part].pushBack(func(valueAt(i)));
+                                    } });
+
+            Vector<ResultType> column;
+            column.reserve(n);
+            for (auto &part : mapped)
+            {
+                for (auto &&value : part)
+                {
+                    column.pushBack(std::move(value));
+                }
+            }
+            return FlatMap<Key, ResultType, Compare>::fromSorted(keys, std::move(column), comp);
+        }
+
+        template <typename BinaryPredicate>
+        FlatMap parallelFilterEntries(BinaryPredicate pred, size_type threads = 0) const
+        {
+            size_type n = keys.getSize();
+            size_type parts = detail::parallelParts(n, threads);
+            Vector<Vector<size_type>> kept(parts);
+            detail::parallelFor(parts, [&](std::size_t part)
+                                {
+                                    for (size_type i = detail::partBegin(n, parts, part); i < detail::partBegin(n, parts, part + 1); ++i)
+                                    {
+                                        if (pred(keys[i], valueAt(i)))
+                                        {
+                                            kept[part].pushBack(i);
+                                        }
+                                    } });
+
+            FlatMap result(comp);
+            for (const auto &part : kept)
+            {
+                for (size_type i : part)
+                {
+                    result.keys.pushBack(keys[i]);
+                    result.values.pushBack(valueAt(i));
+                }
+            }
+            return result;
+        }
+
+        // Unión de dos mapas (keys en ambos tomará los valores del mapa actual), fusión lineal
+        FlatMap merge(const FlatMap &other) const
+        {
+            FlatMap result(comp);
+            result.reserve(keys.getSize() + other.keys.getSize());
+            size_type i = 0;
+            size_type j = 0;
+            while (i < keys.getSize() && j < other.keys.getSize())
+            {
+                if (comp(keys[i], other.keys[j]))
+                {
+                    result.appendFrom(*this, i++);
+                }
+                else if (comp(other.keys[j], keys[i]))
+                {
+                    result.appendFrom(other, j++);
+                }
+                else
+                {
+                    result.appendFrom(*this, i++);
+                    ++j;
+                }
+            }
+            for (; i < keys.getSize(); ++i)
+            {
+                result.appendFrom(*this, i);
+            }
+            for (; j < other.keys.getSize(); ++j)
+            {
+                result.appendFrom(other, j);
+            }
+            return result;
+        }
+
+        // Diferencia: entradas de este mapa que no están en el otro, fusión lineal
+        FlatMap difference(const FlatMap &other) const
+        {
+            FlatMap result(comp);
+            size_type j = 0;
+            for (size_type i = 0; i < keys.getSize(); ++i)
+            {
+                while (j < other.keys.getSize() && comp(other.keys[j], keys[i]))
+                {
+                    ++j;
+                }
+                if (j == other.keys.getSize() || comp(keys[i], other.keys[j]))
+                {
+                    result.appendFrom(*this, i);
+                }
+            }
+            return result;
+        }
+
+        // Intersección: entradas con claves en ambos mapas (valores del mapa actual), fusión lineal
+        FlatMap intersection(const FlatMap &other) const
+        {
+            FlatMap result(comp);
+            size_type j = 0;
+            for (size_type i = 0; i < keys.getSize() && j < other.keys.getSize(); ++i)
+            {
+                while (j < other.keys.getSize() && comp(other.keys[j], keys[i]))
+                {
+                    ++j;
+                }
+                if (j < other.keys.getSize() && !comp(keys[i], other.keys[j]))
+                {
+                    result.appendFrom(*this, i);
+                }
+            }
+            return result;
+        }
+
+    private:
+        // Búsqueda binaria sin saltos: el compilador la traduce a cmov y evita fallos de predicción
+        template <typename K>
+        size_type lowerBoundIndex(const K &key) const
+        {
+            size_type n = keys.getSize();
+            if (n == 0)
+            {
+                return 0;
+            }
+            const Key *base = keys.getData();
+            while (n > 1)
+            {
+                size_type half = n / 2;
+                base = comp(base[half], key) ? base + half : base;
+                n -= half;
+            }
+            return static_cast<size_type>(base - keys.getData()) + (comp(*base, key) ? 1 : 0);
+        }
+
+        // Llama a func(i, findIndex(queries[i])) con kBatchLookupWidth búsquedas entrelazadas
+        template <typename Func>
+        void searchMany(const Vector<Key> &queries, Func func) const
+        {
+            constexpr size_type kWidth = detail::kBatchLookupWidth;
+            size_type total = keys.getSize();
+            size_type n = queries.getSize();
+            const Key *data = keys.getData();
+            const Key *bases[kWidth];
+            for (size_type first = 0; first < n; first += kWidth)
+            {
+                size_type count = std::min(kWidth, n - first);
+                if (total == 0)
+                {
+                    for (size_type j = 0; j < count; ++j)
+                    {
+                        func(first + j, 0);
+                    }
+                    continue;
+                }
+                for (size_type j = 0; j < count; ++j)
+                {
+                    bases[j] = data;
+                }
+                // Todas las búsquedas comparten la longitud del rango: un paso avanza cada una
+                for (size_type length = total; length > 1;)
+                {
+                    size_type half = length / 2;
+                    size_type nextHalf = (length - half) / 2;
+                    for (size_type j = 0; j < count; ++j)
+                    {
+                        bases[j] = comp(bases[j][half], queries[first + j]) ? bases[j] + half : bases[j];
+                        detail::prefetch(bases[j] + nextHalf);
+                    }
+                    length -= half;
+                }
+                for (size_type j = 0; j < count; ++j)
+                {
+                    const Key &key = queries[first + j];
+                    auto index = static_cast<size_type>(bases[j] - data) + (comp(*bases[j], key) ? 1 : 0);
+                    func(first + j, index < total && !comp(key, data[index]) ? index : total);
+                }
+            }
+        }
+
+        template <typename K>
+        size_type upperBoundIndex(const K &key) const
+        {
+            size_type n = keys.getSize();
+            if (n == 0)
+            {
+                return 0;
+            }
+            const Key *base = keys.getData();
+            while (n > 1)
+            {
+                size_type half = n / 2;
+                base = comp(key, base[half]) ? base : base + half;
+                n -= half;
+            }
+            return static_cast<size_type>(base - keys.getData()) + (comp(key, *base) ? 0 : 1);
+        }
+
+        // Devuelve getSize() si la clave no existe
+        template <typename K>
+        size_type findIndex(const K &key) const
+        {
+            auto index = lowerBoundIndex(key);
+            if (index < keys.getSize() && !comp(key, keys[index]))
+            {
+                return index;
+            }
+            return keys.getSize();
+        }
+
+        template <typename K, typename... Args>
+        iterator insertAt(size_type index, K &&key, Args &&...args)
+        {
+            auto offset = static_cast<difference_type>(index);
+            keys.insert(keys.begin() + offset, Key(std::forward<K>(key)));
+            try
+            {
+                values.insert(values.begin() + offset, Value(std::forward<Args>(args)...));
+            }
+            catch (...)
+            {
+                keys.erase(keys.begin() + offset);
+                throw;
+            }
+            return begin() + offset;
+        }
+
+        // Columna de valores vista como Value (para bool, los bytes 0/1 tienen la representación de bool)
+        Value *valueData() noexcept
+        {
+            if constexpr (std::is_same_v<Value, bool>)
+            {
+                return reinterpret_cast<bool *>(values.getData());
+            }
+            else
+            {
+                return values.getData();
+            }
+        }
+
+        const Value *valueData() const noexcept
+        {
+            if constexpr (std::is_same_v<Value, bool>)
+            {
+                return reinterpret_cast<const bool *>(values.getData());
+            }
+            else
+            {
+                return values.getData();
+            }
+        }
+
+        Value &valueAt(size_type index) noexcept
+        {
+            return valueData()[index];
+        }
+
+        const Value &valueAt(size_type index) const noexcept
+        {
+            return valueData()[index];
+        }
+
+        void appendFrom(const FlatMap &source, size_type index)
+        {
+            keys.pushBack(source.keys[index]);
+            values.pushBack(source.values[index]);
+        }
+
+        // Ordena (estable) y elimina duplicados conservando la primera aparición
+        void buildFromEntries(Vector<value_type> &entries)
+        {
+            auto &raw = entries.getStdVector();
+            std::stable_sort(raw.begin(), raw.end(), [this](const value_type &a, const value_type &b)
+                             { return comp(a.first, b.first); });
+
+            keys.clear();
+            values.clear();
+            reserve(raw.size());
+            for (auto &entry : raw)
+            {
+                if (!keys.isEmpty() && !comp(keys.getBack(), entry.first))
+                {
+                    continue;
+                }
+                keys.pushBack(std::move(entry.first));
+                values.pushBack(std::move(entry.second));
+            }
+        }
+    };
+
+    // Funciones de utilidad fuera de la clase
+    template <typename Key, typename Value, typename Compare>
+    void swap(FlatMap<Key, Value, Compare> &lhs, FlatMap<Key, Value, Compare> &rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+} // namespace cppex
+
+#endif // CPPEX_FLAT_MAP_HPP
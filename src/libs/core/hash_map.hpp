@@ -0,0 +1,1353 @@
+/**
+ * @file hash_map.hpp
+ * @brief Open-addressing (Swiss table) hash map with the same API as cpp_ex::Map
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_HASH_MAP_HPP
+#define CPPEX_HASH_MAP_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "common.hpp" // Include detail::IsTransparent
+#include "vector.hpp" // Include Vector class
+#include "parallel.hpp" // Include detail::parallelFor
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CPPEX_HASH_MAP_SSE2 1
+#endif
+
+namespace cpp_ex
+{
+    namespace detail
+    {
+        // Control byte of a slot: empty, deleted (tombstone) or full (holds the H2 of the hash)
+        using ctrl_t = std::int8_t;
+
+        constexpr ctrl_t kCtrlEmpty = -128;  // 0b10000000
+        constexpr ctrl_t kCtrlDeleted = -2;  // 0b11111110
+
+        inline bool isFull(ctrl_t c) noexcept
+        {
+            return c >= 0;
+        }
+
+        // Mezcla los bits del hash: std::hash<int> es la identidad y dejaría H2 sin entropía
+        inline std::uint64_t mixHash(std::uint64_t h) noexcept
+        {
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            return h;
+        }
+
+        /**
+         * @brief Bit mask with one (group of) bit(s) per slot of a probed group
+         *
+         * @tparam T Underlying integer type
+         * @tparam Shift log2 of the number of bits used per slot
+         */
+        template <typename T, int Shift>
+        class BitMask
+        {
+        private:
+            T mask;
+
+        public:
+            explicit BitMask(T m) noexcept : mask(m) {}
+
+            explicit operator bool() const noexcept
+            {
+                return mask != 0;
+            }
+
+            int lowestBitSet() const noexcept
+            {
+                return std::countr_zero(mask) >> Shift;
+            }
+
+            int trailingZeros() const noexcept
+            {
+                return std::countr_zero(mask) >> Shift;
+            }
+
+            int leadingZeros(int width) const noexcept
+            {
+                constexpr int totalBits = sizeof(T) * 8;
+                return (std::countl_zero(mask) - (totalBits - (width << Shift))) >> Shift;
+            }
+
+            // Iteración sobre los índices con bit activo
+            BitMask &operator++() noexcept
+            {
+                mask &= (mask - 1);
+                return *this;
+            }
+
+            int operator*() const noexcept
+            {
+                return lowestBitSet();
+            }
+
+            BitMask begin() const noexcept
+            {
+                return *this;
+            }
+
+            BitMask end() const noexcept
+            {
+                return BitMask(0);
+            }
+
+            bool operator!=(const BitMask &other) const noexcept
+            {
+                return mask != other.mask;
+            }
+        };
+
+#if defined(CPPEX_HASH_MAP_SSE2)
+        /**
+         * @brief 16 control bytes compared in parallel with SSE2
+         */
+        struct Group
+        {
+            static constexpr std::size_t kWidth = 16;
+            using Mask = BitMask<std::uint32_t, 0>;
+
+            __m128i ctrl;
+
+            explicit Group(const ctrl_t *pos) noexcept
+                : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos))) {}
+
+            Mask match(std::uint8_t h2) const noexcept
+            {
+                auto match = _mm_set1_epi8(static_cast<char>(h2));
+                return Mask(static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(match, ctrl))));
+            }
+
+            Mask matchEmpty() const noexcept
+            {
+                auto match = _mm_set1_epi8(kCtrlEmpty);
+                return Mask(static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(match, ctrl))));
+            }
+
+            // Empty y deleted son los únicos valores negativos
+            Mask matchEmptyOrDeleted() const noexcept
+            {
+                return Mask(static_cast<std::uint32_t>(_mm_movemask_epi8(ctrl)));
+            }
+        };
+#else
+        /**
+         * @brief Portable fallback: 8 control bytes compared with SWAR arithmetic
+         */
+        struct Group
+        {
+            static constexpr std::size_t kWidth = 8;
+            using Mask = BitMask<std::uint64_t, 3>;
+
+            static constexpr std::uint64_t kLsbs = 0x0101010101010101ULL;
+            static constexpr std::uint64_t kMsbs = 0x8080808080808080ULL;
+
+            std::uint64_t ctrl;
+
+            explicit Group(const ctrl_t *pos) noexcept
+            {
+                std::memcpy(&ctrl, pos, sizeof(ctrl));
+                if constexpr (std::endian::native == std::endian::big)
+                {
+                    ctrl = std::byteswap(ctrl);
+                }
+            }
+
+            // Puede dar falsos positivos; el llamador siempre compara la clave
+            Mask match(std::uint8_t h2) const noexcept
+            {
+                auto x = ctrl ^ (kLsbs * h2);
+                return Mask((x - kLsbs) & ~x & kMsbs);
+            }
+
+            Mask matchEmpty() const noexcept
+            {
+                return Mask((ctrl & ~(ctrl << 6)) & kMsbs);
+            }
+
+            Mask matchEmptyOrDeleted() const noexcept
+            {
+                return Mask(ctrl & kMsbs);
+            }
+        };
+#endif
+
+    } // namespace detail
+
+    /**
+     * @brief Swiss-table style open-addressing hash map with the cpp_ex::Map API
+     *
+     * Entries live in a single flat array of slots and a parallel array of one-byte
+     * control words. A lookup hashes the key once, uses 7 bits of the hash (H2) to
+     * filter a whole group of 16 slots with one SIMD compare (8 slots with a portable
+     * SWAR fallback) and only compares keys on candidate matches. Erased slots are
+     * returned to the empty state whenever no probe sequence can have passed through
+     * them, so tombstones only appear in saturated groups.
+     *
+     * Iteration order is unspecified. Inserting may invalidate iterators and references;
+     * erasing only invalidates the erased element.
+     *
+     * @tparam Key Type of the keys
+     * @tparam Value Type of the mapped values
+     * @tparam Hash Hash function object type, defaults to std::hash<Key>
+     * @tparam KeyEqual Equality function object type, defaults to std::equal_to<Key>
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::HashMap<std::string, int> scores = {
+     *     {"Alice", 95},
+     *     {"Bob", 87}
+     * };
+     *
+     * scores["Charlie"] = 92;
+     *
+     * if (scores.contains("Alice")) {
+     *     auto highScores = scores.filterEntries([](const std::string &name, int score) {
+     *         return score >= 90;
+     *     });
+     * }
+     * ```
+     */
+    template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    class HashMap
+    {
+    public:
+        // Tipos (aliases)
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<const Key, Value>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using pointer = value_type *;
+        using const_pointer = const value_type *;
+
+    private:
+        using ctrl_t = detail::ctrl_t;
+        using Group = detail::Group;
+        using SlotAllocator = std::allocator<value_type>;
+        using CtrlAllocator = std::allocator<ctrl_t>;
+
+        static constexpr size_type kMinCapacity = Group::kWidth;
+
+        ctrl_t *ctrl = nullptr;
+        value_type *slots = nullptr;
+        size_type capacity = 0; // Potencia de dos (o cero)
+        size_type size = 0;
+        size_type growthLeft = 0;
+        [[no_unique_address]] Hash hashFn;
+        [[no_unique_address]] KeyEqual eqFn;
+
+        // Declare friendship with all other HashMap instantiations
+        template <typename K, typename V, typename H, typename E>
+        friend class HashMap;
+
+        template <bool IsConst>
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = HashMap::value_type;
+            using difference_type = HashMap::difference_type;
+            using pointer = std::conditional_t<IsConst, const value_type *, value_type *>;
+            using reference = std::conditional_t<IsConst, const value_type &, value_type &>;
+
+        private:
+            friend class HashMap;
+
+            const ctrl_t *ctrlPos = nullptr;
+            const ctrl_t *ctrlEnd = nullptr;
+            value_type *slot = nullptr;
+
+            Iterator(const ctrl_t *c, const ctrl_t *e, value_type *s) noexcept
+                : ctrlPos(c), ctrlEnd(e), slot(s)
+            {
+                skipEmpty();
+            }
+
+            void skipEmpty() noexcept
+            {
+                while (ctrlPos != ctrlEnd && !detail::isFull(*ctrlPos))
+                {
+                    ++ctrlPos;
+                    ++slot;
+                }
+            }
+
+        public:
+            Iterator() = default;
+
+            // Conversión de iterator a const_iterator
+            template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+            Iterator(const Iterator<OtherConst> &other) noexcept
+                : ctrlPos(other.ctrlPos), ctrlEnd(other.ctrlEnd), slot(other.slot) {}
+
+            reference operator*() const noexcept
+            {
+                return *slot;
+            }
+
+            pointer operator->() const noexcept
+            {
+                return slot;
+            }
+
+            Iterator &operator++() noexcept
+            {
+                ++ctrlPos;
+                ++slot;
+                skipEmpty();
+                return *this;
+            }
+
+            Iterator operator++(int) noexcept
+            {
+                Iterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            friend bool operator==(const Iterator &a, const Iterator &b) noexcept
+            {
+                return a.ctrlPos == b.ctrlPos;
+            }
+
+            friend bool operator!=(const Iterator &a, const Iterator &b) noexcept
+            {
+                return a.ctrlPos != b.ctrlPos;
+            }
+
+            template <bool B>
+            friend class Iterator;
+        };
+
+    public:
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        // Constructores
+        HashMap() = default;
+
+        explicit HashMap(size_type bucketCount, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual())
+            : hashFn(hash), eqFn(equal)
+        {
+            reserve(bucketCount);
+        }
+
+        template <typename InputIt>
+        HashMap(InputIt first, InputIt last)
+        {
+            insert(first, last);
+        }
+
+        HashMap(std::initializer_list<value_type> init)
+        {
+            reserve(init.size());
+            insert(init.begin(), init.end());
+        }
+
+        HashMap(const HashMap &other)
+            : hashFn(other.hashFn), eqFn(other.eqFn)
+        {
+            reserve(other.size);
+            for (const auto &pair : other)
+            {
+                insertUnique(hashOf(pair.first), pair);
+            }
+        }
+
+        HashMap(HashMap &&other) noexcept
+            : ctrl(std::exchange(other.ctrl, nullptr)),
+              slots(std::exchange(other.slots, nullptr)),
+              capacity(std::exchange(other.capacity, 0)),
+              size(std::exchange(other.size, 0)),
+              growthLeft(std::exchange(other.growthLeft, 0)),
+              hashFn(std::move(other.hashFn)),
+              eqFn(std::move(other.eqFn)) {}
+
+        ~HashMap()
+        {
+            destroyAndDeallocate();
+        }
+
+        // Operadores de asignación
+        HashMap &operator=(const HashMap &other)
+        {
+            if (this != &other)
+            {
+                HashMap tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        HashMap &operator=(HashMap &&other) noexcept
+        {
+            if (this != &other)
+            {
+                HashMap tmp(std::move(other));
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        HashMap &operator=(std::initializer_list<value_type> ilist)
+        {
+            HashMap tmp(ilist);
+            swap(tmp);
+            return *this;
+        }
+
+        // Iteradores
+        iterator begin() noexcept
+        {
+            return iterator(ctrl, ctrl + capacity, slots);
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return const_iterator(ctrl, ctrl + capacity, slots);
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        iterator end() noexcept
+        {
+            return iterator(ctrl + capacity, ctrl + capacity, slots + capacity);
+        }
+
+        const_iterator end() const noexcept
+        {
+            return const_iterator(ctrl + capacity, ctrl + capacity, slots + capacity);
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        // Capacidad
+        bool isEmpty() const noexcept
+        {
+            return size == 0;
+        }
+
+        size_type getSize() const noexcept
+        {
+            return size;
+        }
+
+        size_type getMaxSize() const noexcept
+        {
+            return SlotAllocator().max_size();
+        }
+
+        size_type getCapacity() const noexcept
+        {
+            return capacity;
+        }
+
+        float getLoadFactor() const noexcept
+        {
+            return capacity == 0 ? 0.0f : static_cast<float>(size) / static_cast<float>(capacity);
+        }
+
+        // Reserva espacio para al menos count elementos sin rehash
+        void reserve(size_type count)
+        {
+            if (count > maxLoad(capacity))
+            {
+                resize(capacityFor(count));
+            }
+        }
+
+        // Reconstruye la tabla (elimina tombstones); nunca reduce por debajo de getSize()
+        void rehash(size_type count)
+        {
+            auto target = capacityFor(std::max(count, size));
+            if (size == 0 && count == 0)
+            {
+                destroyAndDeallocate();
+                return;
+            }
+            resize(target);
+        }
+
+        // Acceso a elementos
+        mapped_type &at(const key_type &key)
+        {
+            auto it = find(key);
+            if (it == end())
+            {
+                throw std::out_of_range("HashMap::at: key not found");
+            }
+            return it->second;
+        }
+
+        const mapped_type &at(const key_type &key) const
+        {
+            auto it = find(key);
+            if (it == end())
+            {
+                throw std::out_of_range("HashMap::at: key not found");
+            }
+            return it->second;
+        }
+
+        // Búsqueda heterogénea: requiere Hash y KeyEqual transparentes (p. ej. std::hash<String>)
+        template <typename K>
+            requires detail::IsTransparent<Hash> && detail::IsTransparent<KeyEqual>
+        mapped_type &at(const K &key)
+        {
+            auto index = findIndex(key, hashOf(key));
+            if (index == capacity)
+            {
+                throw std::out_of_range("HashMap::at: key not found");
+            }
+            return slots[index].second;
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Hash> && detail::IsTransparent<KeyEqual>
+        const mapped_type &at(const K &key) const
+        {
+            auto index = findIndex(key, hashOf(key));
+            if (index == capacity)
+            {
+                throw std::out_of_range("HashMap::at: key not found");
+            }
+            return slots[index].second;
+        }
+
+        mapped_type &operator[](const key_type &key)
+        {
+            return tryEmplace(key).first->second;
+        }
+
+        mapped_type &operator[](key_type &&key)
+        {
+            return tryEmplace(std::move(key)).first->second;
+        }
+
+        // Modificadores
+        void clear() noexcept
+        {
+            if (capacity == 0)
+            {
+                return;
+            }
+            destroySlots();
+            std::memset(ctrl, static_cast<unsigned char>(detail::kCtrlEmpty), capacity + Group::kWidth);
+            size = 0;
+            growthLeft = maxLoad(capacity);
+        }
+
+        std::pair<iterator, bool> insert(const value_type &value)
+        {
+            return tryEmplace(value.first, value.second);
+        }
+
+        std::pair<iterator, bool> insert(value_type &&value)
+        {
+            return tryEmplace(value.first, std::move(value.second));
+        }
+
+        template <typename P, typename = std::enable_if_t<std::is_constructible_v<value_type, P &&>>>
+        std::pair<iterator, bool> insert(P &&value)
+        {
+            return emplace(std::forward<P>(value));
+        }
+
+        template <typename InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+            {
+                insert(*first);
+            }
+        }
+
+        void insert(std::initializer_list<value_type> ilist)
+        {
+            insert(ilist.begin(), ilist.end());
+        }
+
+        template <typename M>
+        std::pair<iterator, bool> insertOrAssign(const key_type &key, M &&value)
+        {
+            auto result = tryEmplace(key, std::forward<M>(value));
+            if (!result.second)
+            {
+                result.first->second = std::forward<M>(value);
+            }
+            return result;
+        }
+
+        template <typename M>
+        std::pair<iterator, bool> insertOrAssign(key_type &&key, M &&value)
+        {
+            auto result = tryEmplace(std::move(key), std::forward<M>(value));
+            if (!result.second)
+            {
+                result.first->second = std::forward<M>(value);
+            }
+            return result;
+        }
+
+        template <typename... Args>
+        std::pair<iterator, bool> emplace(Args &&...args)
+        {
+            std::pair<Key, Value> tmp(std::forward<Args>(args)...);
+            return tryEmplace(std::move(tmp.first), std::move(tmp.second));
+        }
+
+        // Construye el valor solo si la clave no existe (una única sonda)
+        template <typename K, typename... Args>
+        std::pair<iterator, bool> tryEmplace(K &&key, Args &&...args)
+        {
+            auto hash = hashOf(key);
+            auto index = findIndex(key, hash);
+            if (index != capacity)
+            {
+                return {iteratorAt(index), false};
+            }
+            index = prepareInsert(hash);
+            try
+            {
+                std::construct_at(slots + index, std::piecewise_construct,
+                                  std::forward_as_tuple(std::forward<K>(key)),
+                                  std::forward_as_tuple(std::forward<Args>(args)...));
+            }
+            catch (...)
+            {
+                setCtrl(index, detail::kCtrlDeleted);
+                --size;
+                throw;
+            }
+            return {iteratorAt(index), true};
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            auto index = static_cast<size_type>(pos.ctrlPos - ctrl);
+            eraseAt(index);
+            return iterator(ctrl + index + 1, ctrl + capacity, slots + index + 1);
+        }
+
+        iterator erase(iterator pos)
+        {
+            return erase(const_iterator(pos));
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            while (first != last)
+            {
+                first = erase(first);
+            }
+            auto index = static_cast<size_type>(last.ctrlPos - ctrl);
+            return iterator(ctrl + index, ctrl + capacity, slots + index);
+        }
+
+        size_type erase(const key_type &key)
+        {
+            auto index = findIndex(key, hashOf(key));
+            if (index == capacity)
+            {
+                return 0;
+            }
+            eraseAt(index);
+            return 1;
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Hash> && detail::IsTransparent<KeyEqual> &&
+                     (!std::is_convertible_v<K &&, iterator>) && (!std::is_convertible_v<K &&, const_iterator>)
+        size_type erase(K &&key)
+        {
+            auto index = findIndex(key, hashOf(key));
+            if (index == capacity)
+            {
+                return 0;
+            }
+            eraseAt(index);
+            return 1;
+        }
+
+        void swap(HashMap &other) noexcept
+        {
+            using std::swap;
+            swap(ctrl, other.ctrl);
+            swap(slots, other.slots);
+            swap(capacity, other.capacity);
+            swap(size, other.size);
+            swap(growthLeft, other.growthLeft);
+            swap(hashFn, other.hashFn);
+            swap(eqFn, other.eqFn);
+        }
+
+        // Lookup
+        size_type count(const key_type &key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        iterator find(const key_type &key)
+        {
+            auto index = findIndex(key, hashOf(key));
+            return index == capacity ? end() : iteratorAt(index);
+        }
+
+        const_iterator find(const key_type &key) const
+        {
+            auto index = findIndex(key, hashOf(key));
+            return index == capacity ? end() : const_iterator(ctrl + index, ctrl + capacity, slots + index);
+        }
+
+        bool contains(const key_type &key) const
+        {
+            return findIndex(key, hashOf(key)) != capacity;
+        }
+
+        /**
+         * @brief Heterogeneous overloads of the lookup methods
+         *
+         * Enabled only when both Hash and KeyEqual declare `is_transparent`, as the
+         * std::hash/std::equal_to specializations for cpp_ex::String do. The argument
+         * is hashed and compared as is, so `map.find("literal")` or a lookup with a
+         * std::string_view does not build a temporary key. Hash must give the same
+         * value for a key and for every type it is compared equal to.
+         */
+        template <typename K>
+            requires detail::IsTransparent<Hash> && detail::IsTransparent<KeyEqual>
+        size_type count(const K &key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Hash> && detail::IsTransparent<KeyEqual>
+        iterator find(const K &key)
+        {
+            auto index = findIndex(key, hashOf(key));
+            return index == capacity ? end() : iteratorAt(index);
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Hash> && detail::IsTransparent<KeyEqual>
+        const_iterator find(const K &key) const
+        {
+            auto index = findIndex(key, hashOf(key));
+            return index == capacity ? end() : const_iterator(ctrl + index, ctrl + capacity, slots + index);
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Hash> && detail::IsTransparent<KeyEqual>
+        bool contains(const K &key) const
+        {
+            return findIndex(key, hashOf(key)) != capacity;
+        }
+
+        /**
+         * @brief Batched lookups that overlap the cache misses of many keys
+         *
+         * `results[i]` is `find(keys[i])` (end() when the key is absent) and `results`
+         * is resized to `keys.getSize()`; containsMany() fills flags instead and
+         * returns how many keys were found. Keys are probed in groups of
+         * detail::kBatchLookupWidth: every key of the group is hashed and its control
+         * group prefetched, then every control group is filtered and the first
+         * candidate slot prefetched, and only then are keys compared. On tables larger
+         * than the cache the misses of a whole group are in flight at once instead of
+         * one after another.
+         */
+        void findMany(const Vector<Key> &keys, Vector<iterator> &results)
+        {
+            results.resize(keys.getSize());
+            probeMany(keys, [&](size_type i, size_type index)
+                      { results[i] = index == capacity ? end() : iteratorAt(index); });
+        }
+
+        void findMany(const Vector<Key> &keys, Vector<const_iterator> &results) const
+        {
+            results.resize(keys.getSize());
+            probeMany(keys, [&](size_type i, size_type index)
+                      { results[i] = index == capacity ? end() : const_iterator(ctrl + index, ctrl + capacity, slots + index); });
+        }
+
+        size_type containsMany(const Vector<Key> &keys, Vector<bool> &results) const
+        {
+            results.resize(keys.getSize());
+            size_type found = 0;
+            probeMany(keys, [&](size_type i, size_type index)
+                      {
+                          results[i] = index != capacity;
+                          found += index != capacity ? 1 : 0; });
+            return found;
+        }
+
+        // Observadores
+        hasher hashFunction() const
+        {
+            return hashFn;
+        }
+
+        key_equal keyEq() const
+        {
+            return eqFn;
+        }
+
+        // Operadores de comparación (independientes del orden de iteración)
+        bool operator==(const HashMap &other) const
+        {
+            if (size != other.size)
+            {
+                return false;
+            }
+            for (const auto &pair : *this)
+            {
+                auto it = other.find(pair.first);
+                if (it == other.end() || !(it->second == pair.second))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool operator!=(const HashMap &other) const
+        {
+            return !(*this == other);
+        }
+
+        // Métodos adicionales que usan cppex::Vector
+
+        // Obtener todas las claves como un Vector (orden no especificado)
+        Vector<Key> getKeys() const
+        {
+            Vector<Key> keys;
+            keys.reserve(size);
+            for (const auto &pair : *this)
+            {
+                keys.pushBack(pair.first);
+            }
+            return keys;
+        }
+
+        // Obtener todos los valores como un Vector (orden no especificado)
+        Vector<Value> getValues() const
+        {
+            Vector<Value> values;
+            values.reserve(size);
+            for (const auto &pair : *this)
+            {
+                values.pushBack(pair.second);
+            }
+            return values;
+        }
+
+        // Obtener todos los pares como un Vector (orden no especificado)
+        Vector<std::pair<Key, Value>> getEntries() const
+        {
+            Vector<std::pair<Key, Value>> entries;
+            entries.reserve(size);
+            for (const auto &pair : *this)
+            {
+                entries.pushBack(pair);
+            }
+            return entries;
+        }
+
+        // Mapear valores a un nuevo tipo
+        template <typename ResultType, typename UnaryFunc>
+        HashMap<Key, ResultType, Hash, KeyEqual> mapValues(UnaryFunc func) const
+        {
+            HashMap<Key, ResultType, Hash, KeyEqual> result(size, hashFn, eqFn);
+            forEachSlot([&](size_type index)
+                        {
+                            const auto &pair = slots[index];
+                            result.insertUnique(result.hashOf(pair.first),
+                                                typename HashMap<Key, ResultType, Hash, KeyEqual>::value_type(pair.first, func(pair.second))); });
+            return result;
+        }
+
+        // Filtrar entradas según un predicado
+        template <typename BinaryPredicate>
+        HashMap filterEntries(BinaryPredicate pred) const
+        {
+            HashMap result(0, hashFn, eqFn);
+            forEachSlot([&](size_type index)
+                        {
+                            const auto &pair = slots[index];
+                            if (pred(pair.first, pair.second))
+                            {
+                                result.insertUnique(hashOf(pair.first), pair);
+                            } });
+            return result;
+        }
+
+        // Ejecutar una función para cada par clave-valor
+        template <typename BinaryFunc>
+        void forEach(BinaryFunc func)
+        {
+            forEachSlot([&](size_type index)
+                        { func(slots[index].first, slots[index].second); });
+        }
+
+        template <typename BinaryFunc>
+        void forEach(BinaryFunc func) const
+        {
+            forEachSlot([&](size_type index)
+                        {
+                            const auto &pair = slots[index];
+                            func(pair.first, pair.second); });
+        }
+
+        /**
+         * @brief Parallel versions of forEach(), mapValues() and filterEntries()
+         *
+         * The slot array is split into contiguous slot ranges, one per thread
+         * (`threads == 0` uses every hardware thread, but keeps tables of a few
+         * thousand slots sequential). func/pred run concurrently and must be safe to
+         * call in parallel. Per-thread results are inserted in slot order, the order
+         * the sequential versions use, so the output is identical (iteration order
+         * included). If a call throws, every thread finishes its range and the
+         * exception is rethrown.
+         */
+        template <typename BinaryFunc>
+        void parallelForEach(BinaryFunc func, size_type threads = 0)
+        {
+            size_type parts = detail::parallelParts(capacity, threads);
+            detail::parallelFor(parts, [&](std::size_t part)
+                                { forEachSlotIn(detail::partBegin(capacity, parts, part), detail::partBegin(capacity, parts, part + 1), [&](size_type index)
+                                                { func(slots[index].first, slots[index].second); }); });
+        }
+
+        template <typename BinaryFunc>
+        void parallelForEach(BinaryFunc func, size_type threads = 0) const
+        {
+            size_type parts = detail::parallelParts(capacity, threads);
+            detail::parallelFor(parts, [&](std::size_t part)
+                                { forEachSlotIn(detail::partBegin(capacity, parts, part), detail::partBegin(capacity, parts, part + 1), [&](size_type index)
+                                                {
+                                                    const auto &pair = slots[index];
+                                                    func(pair.first, pair.second); }); });
+        }
+
+        template <typename ResultType, typename UnaryFunc>
+        HashMap<Key, ResultType, Hash, KeyEqual> parallelMapValues(UnaryFunc func, size_type threads = 0) const
+        {
+            size_type parts = detail::parallelParts(capacity, threads);
+            Vector<Vector<ResultType>> mapped(parts);
+            detail::parallelFor(parts, [&](std::size_t part)
+                                { forEachSlotIn(detail::partBegin(capacity, parts, part), detail::partBegin(capacity, parts, part + 1), [&](size_type index)
+                                                { mapped[part].pushBack(func(slots[index].second)); }); });
+
+            HashMap<Key, ResultType, Hash, KeyEqual> result(size, hashFn, eqFn);
+            for (size_type part = 0; part < parts; ++part)
+            {
+                size_type next = 0;
+                forEachSlotIn(detail::partBegin(capacity, parts, part), detail::partBegin(capacity, parts, part + 1), [&](size_type index)
+                              {
+                                  const Key &key = slots[index].first;
+                                  result.insertUnique(result.hashOf(key),
+                                                      typename HashMap<Key, ResultType, Hash, KeyEqual>::value_type(key, std::move(mapped[part][next++]))); });
+            }
+            return result;
+        }
+
+        template <typename BinaryPredicate>
+        HashMap parallelFilterEntries(BinaryPredicate pred, size_type threads = 0) const
+        {
+            size_type parts = detail::parallelParts(capacity, threads);
+            Vector<Vector<size_type>> kept(parts);
+            detail::parallelFor(parts, [&](std::size_t part)
+                                { forEachSlotIn(detail::partBegin(capacity, parts, part), detail::partBegin(capacity, parts, part + 1), [&](size_type index)
+                                                {
+                                                    const auto &pair = slots[index];
+                                                    if (pred(pair.first, pair.second))
+                                                    {
+                                                        kept[part].pushBack(index);
+                                                    } }); });
+
+            HashMap result(0, hashFn, eqFn);
+            for (const auto &part : kept)
+            {
+                for (size_type index : part)
+                {
+                    result.insertUnique(hashOf(slots[index].first), slots[index]);
+                }
+            }
+            return result;
+        }
+
+        // Unión de dos mapas (keys en ambos tomará los valores del mapa actual)
+        HashMap merge(const HashMap &other) const
+        {
+            HashMap result = *this;
+            result.reserve(size + other.size);
+            for (const auto &pair : other)
+            {
+                result.insert(pair);
+            }
+            return result;
+        }
+
+        // Diferencia: entradas de este mapa que no están en el otro
+        HashMap difference(const HashMap &other) const
+        {
+            return filterEntries([&other](const Key &key, const Value &)
+                                 { return !other.contains(key); });
+        }
+
+        // Intersección: entradas con claves en ambos mapas (valores del mapa actual)
+        HashMap intersection(const HashMap &other) const
+        {
+            return filterEntries([&other](const Key &key, const Value &)
+                                 { return other.contains(key); });
+        }
+
+    private:
+        // Carga máxima de 7/8
+        static size_type maxLoad(size_type cap) noexcept
+        {
+            return cap - cap / 8;
+        }
+
+        static size_type capacityFor(size_type count) noexcept
+        {
+            size_type cap = kMinCapacity;
+            while (maxLoad(cap) < count)
+            {
+                cap *= 2;
+            }
+            return cap;
+        }
+
+        template <typename K>
+        std::uint64_t hashOf(const K &key) const
+        {
+            return detail::mixHash(static_cast<std::uint64_t>(hashFn(key)));
+        }
+
+        static std::uint8_t h2(std::uint64_t hash) noexcept
+        {
+            return static_cast<std::uint8_t>(hash & 0x7F);
+        }
+
+        static size_type h1(std::uint64_t hash) noexcept
+        {
+            return static_cast<size_type>(hash >> 7);
+        }
+
+        iterator iteratorAt(size_type index) noexcept
+        {
+            return iterator(ctrl + index, ctrl + capacity, slots + index);
+        }
+
+        // Los primeros kWidth - 1 bytes de control se replican tras el final de la tabla
+        void setCtrl(size_type index, ctrl_t value) noexcept
+        {
+            ctrl[index] = value;
+            if (index < Group::kWidth - 1)
+            {
+                ctrl[capacity + index] = value;
+            }
+        }
+
+        // Devuelve capacity si la clave no existe
+        template <typename K>
+        size_type findIndex(const K &key, std::uint64_t hash) const
+        {
+            if (size == 0)
+            {
+                return capacity;
+            }
+            auto mask = capacity - 1;
+            auto offset = h1(hash) & mask;
+            size_type step = 0;
+            while (true)
+            {
+                Group group(ctrl + offset);
+                for (int i : group.match(h2(hash)))
+                {
+                    auto index = (offset + i) & mask;
+                    if (eqFn(slots[index].first, key))
+                    {
+                        return index;
+                    }
+                }
+                if (group.matchEmpty())
+                {
+                    return capacity;
+                }
+                step += Group::kWidth;
+                offset = (offset + step) & mask;
+            }
+        }
+
+        // Llama a func(i, findIndex(keys[i])) sondeando kBatchLookupWidth claves a la vez
+        template <typename Func>
+        void probeMany(const Vector<Key> &keys, Func func) const
+        {
+            constexpr size_type kWidth = detail::kBatchLookupWidth;
+            constexpr size_type kUnresolved = ~size_type{0};
+            size_type n = keys.getSize();
+            if (size == 0)
+            {
+                for (size_type i = 0; i < n; ++i)
+                {
+                    func(i, capacity);
+                }
+                return;
+            }
+
+            auto mask = capacity - 1;
+            std::uint64_t hashes[kWidth];
+            size_type candidates[kWidth];
+            for (size_type first = 0; first < n; first += kWidth)
+            {
+                size_type count = std::min(kWidth, n - first);
+
+                // Etapa 1: hash de cada clave y prefetch de su grupo de control
+                for (size_type j = 0; j < count; ++j)
+                {
+                    hashes[j] = hashOf(keys[first + j]);
+                    detail::prefetch(ctrl + (h1(hashes[j]) & mask));
+                }
+
+                // Etapa 2: filtra el grupo con H2 y prefetch del primer slot candidato;
+                // sin candidatos y con un hueco vacío la clave ya se sabe ausente
+                for (size_type j = 0; j < count; ++j)
+                {
+                    auto offset = h1(hashes[j]) & mask;
+                    Group group(ctrl + offset);
+                    auto match = group.match(h2(hashes[j]));
+                    if (match)
+                    {
+                        candidates[j] = (offset + match.lowestBitSet()) & mask;
+                        detail::prefetch(slots + candidates[j]);
+                    }
+                    else
+                    {
+                        candidates[j] = group.matchEmpty() ? capacity : kUnresolved;
+                    }
+                }
+
+                // Etapa 3: compara claves; otro candidato o un grupo lleno recurre a findIndex()
+                for (size_type j = 0; j < count; ++j)
+                {
+                    const Key &key = keys[first + j];
+                    auto index = candidates[j];
+                    if (index == kUnresolved || (index != capacity && !eqFn(slots[index].first, key)))
+                    {
+                        index = findIndex(key, hashes[j]);
+                    }
+                    func(first + j, index);
+                }
+            }
+        }
+
+        size_type findFirstNonFull(std::uint64_t hash) const noexcept
+        {
+            auto mask = capacity - 1;
+            auto offset = h1(hash) & mask;
+            size_type step = 0;
+            while (true)
+            {
+                Group group(ctrl + offset);
+                auto candidates = group.matchEmptyOrDeleted();
+                if (candidates)
+                {
+                    return (offset + candidates.lowestBitSet()) & mask;
+                }
+                step += Group::kWidth;
+                offset = (offset + step) & mask;
+            }
+        }
+
+        // Reserva un slot para una clave ausente; crece si no queda espacio
+        size_type prepareInsert(std::uint64_t hash)
+        {
+            if (capacity == 0)
+            {
+                resize(kMinCapacity);
+            }
+            auto index = findFirstNonFull(hash);
+            if (growthLeft == 0 && ctrl[index] != detail::kCtrlDeleted)
+            {
+                // Muchos tombstones: basta con reconstruir a la misma capacidad
+                resize(size * 32 <= capacity * 25 ? capacity : capacity * 2);
+                index = findFirstNonFull(hash);
+            }
+            growthLeft -= (ctrl[index] == detail::kCtrlEmpty) ? 1 : 0;
+            setCtrl(index, static_cast<ctrl_t>(h2(hash)));
+            ++size;
+            return index;
+        }
+
+        // Inserta una clave que se sabe ausente, sin comparar claves
+        template <typename P>
+        void insertUnique(std::uint64_t hash, P &&value)
+        {
+            auto index = prepareInsert(hash);
+            try
+            {
+                std::construct_at(slots + index, std::forward<P>(value));
+            }
+            catch (...)
+            {
+                setCtrl(index, detail::kCtrlDeleted);
+                --size;
+                throw;
+            }
+        }
+
+        void eraseAt(size_type index)
+        {
+            std::destroy_at(slots + index);
+            --size;
+
+            // Si ninguna secuencia de sondeo pudo atravesar este slot, vuelve a estar vacío
+            auto mask = capacity - 1;
+            auto indexBefore = (index - Group::kWidth) & mask;
+            auto emptyAfter = Group(ctrl + index).matchEmpty();
+            auto emptyBefore = Group(ctrl + indexBefore).matchEmpty();
+            bool wasNeverFull = emptyBefore && emptyAfter &&
+                                static_cast<size_type>(emptyAfter.trailingZeros() +
+                                                       emptyBefore.leadingZeros(static_cast<int>(Group::kWidth))) < Group::kWidth;
+            setCtrl(index, wasNeverFull ? detail::kCtrlEmpty : detail::kCtrlDeleted);
+            growthLeft += wasNeverFull ? 1 : 0;
+        }
+
+        template <typename Func>
+        void forEachSlot(Func func) const
+        {
+            forEachSlotIn(0, capacity, func);
+        }
+
+        // Slots ocupados de [first, last) en orden (los recorridos paralelos usan un rango por hilo)
+        template <typename Func>
+        void forEachSlotIn(size_type first, size_type last, Func func) const
+        {
+            for (size_type i = first; i < last; ++i)
+            {
+                if (detail::isFull(ctrl[i]))
+                {
+                    func(i);
+                }
+            }
+        }
+
+        void resize(size_type newCapacity)
+        {
+            CtrlAllocator ctrlAlloc;
+            SlotAllocator slotAlloc;
+
+            auto *newCtrl = ctrlAlloc.allocate(newCapacity + Group::kWidth);
+            value_type *newSlots = nullptr;
+            try
+            {
+                newSlots = slotAlloc.allocate(newCapacity);
+            }
+            catch (...)
+            {
+                ctrlAlloc.deallocate(newCtrl, newCapacity + Group::kWidth);
+                throw;
+            }
+            std::memset(newCtrl, static_cast<unsigned char>(detail::kCtrlEmpty), newCapacity + Group::kWidth);
+
+            auto *oldCtrl = ctrl;
+            auto *oldSlots = slots;
+            auto oldCapacity = capacity;
+
+            ctrl = newCtrl;
+            slots = newSlots;
+            capacity = newCapacity;
+            growthLeft = maxLoad(newCapacity) - size;
+
+            for (size_type i = 0; i < oldCapacity; ++i)
+            {
+                if (detail::isFull(oldCtrl[i]))
+                {
+                    auto &src = oldSlots[i];
+                    auto hash = hashOf(src.first);
+                    auto index = findFirstNonFull(hash);
+                    setCtrl(index, static_cast<ctrl_t>(h2(hash)));
+                    // La clave es const en value_type, pero el slot de origen se destruye a continuación
+                    std::construct_at(slots + index, std::move(const_cast<Key &>(src.first)), std::move(src.second));
+                    std::destroy_at(&src);
+                }
+            }
+
+            if (oldCapacity != 0)
+            {
+                ctrlAlloc.deallocate(oldCtrl, oldCapacity + Group::kWidth);
+                slotAlloc.deallocate(oldSlots, oldCapacity);
+            }
+        }
+
+        void destroySlots() noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<value_type>)
+            {
+                for (size_type i = 0; i < capacity; ++i)
+                {
+                    if (detail::isFull(ctrl[i]))
+                    {
+                        std::destroy_at(slots + i);
+                    }
+                }
+            }
+        }
+
+        void destroyAndDeallocate() noexcept
+        {
+            if (capacity == 0)
+            {
+                return;
+            }
+            destroySlots();
+            CtrlAllocator().deallocate(ctrl, capacity + Group::kWidth);
+            SlotAllocator().deallocate(slots, capacity);
+            ctrl = nullptr;
+            slots = nullptr;
+            capacity = 0;
+            size = 0;
+            growthLeft = 0;
+        }
+    };
+
+    // Funciones de utilidad fuera de la clase
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    void swap(HashMap<Key, Value, Hash, KeyEqual> &lhs, HashMap<Key, Value, Hash, KeyEqual> &rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+} // namespace cppex
+
+#endif // CPPEX_HASH_MAP_HPP
@@ -0,0 +1,333 @@
+/**
+ * @file interval_map.hpp
+ * @brief Map from disjoint half-open key ranges to values, with coalescing assignment
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_INTERVAL_MAP_HPP
+#define CPPEX_INTERVAL_MAP_HPP
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include "vector.hpp" // Include Vector class
+#include "map.hpp"    // Include Map class (backend por defecto)
+
+namespace cpp_ex
+{
+
+    /**
+     * @brief Associates values with half-open ranges `[start, end)` of an ordered key type
+     *
+     * The ranges (segments) never overlap: assigning a value to `[from, to)` trims or
+     * splits whatever was there before, and adjacent segments with equal values are
+     * coalesced into one, so the map always holds the minimal number of segments.
+     * Segments are stored in an ordered backend keyed by their start (`Map` by default,
+     * `BTreeMap` or `FlatMap` also work), and every operation is O(log n + k) backend
+     * work, k being the number of segments touched or reported (FlatMap adds the cost
+     * of shifting its columns on insert/erase).
+     *
+     * Value must be equality comparable (for coalescing) and copy constructible.
+     *
+     * @tparam Key Type of the range bounds
+     * @tparam Value Type of the mapped values
+     * @tparam Backend Ordered map template used to store the segments
+     * @tparam Compare Comparison function object type, defaults to std::less<Key>
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::IntervalMap<int64_t, std::string> shifts;
+     * shifts.assign(0, 100, "alice");
+     * shifts.assign(40, 60, "bob");   // [0,40) alice, [40,60) bob, [60,100) alice
+     * shifts.assign(40, 60, "alice"); // coalesced back into [0,100) alice
+     *
+     * const std::string *who = shifts.find(75); // "alice"
+     * shifts.forEachOverlapping(90, 200, [](int64_t start, int64_t end, const std::string &name) {
+     *     // ...
+     * });
+     *
+     * cpp_ex::IntervalMap<int64_t, double, cpp_ex::BTreeMap> series;
+     * ```
+     */
+    template <typename Key, typename Value, template <typename, typename, typename> class Backend = Map, typename Compare = std::less<Key>>
+    class IntervalMap
+    {
+    public:
+        // Tipos (aliases)
+        using key_type = Key;
+        using mapped_type = Value;
+        using size_type = std::size_t;
+        using key_compare = Compare;
+
+        // Tramo [start, end) con su valor
+        struct Segment
+        {
+            Key start;
+            Key end;
+            Value value;
+
+            bool operator==(const Segment &other) const = default;
+        };
+
+    private:
+        // El backend guarda el inicio como clave y el final junto al valor
+        struct Slot
+        {
+            Key end;
+            Value value;
+
+            bool operator==(const Slot &other) const = default;
+        };
+
+        Backend<Key, Slot, Compare> segments;
+        [[no_unique_address]] Compare comp;
+
+    public:
+        // Constructores
+        IntervalMap() = default;
+
+        explicit IntervalMap(const Compare &comp) : segments(comp), comp(comp) {}
+
+        // Asigna los tramos en orden: los posteriores pisan a los anteriores
+        IntervalMap(std::initializer_list<Segment> init, const Compare &comp = Compare()) : IntervalMap(comp)
+        {
+            for (const auto &segment : init)
+            {
+                assign(segment.start, segment.end, segment.value);
+            }
+        }
+
+        // Capacidad
+        bool isEmpty() const noexcept
+        {
+            return segments.isEmpty();
+        }
+
+        // Número de tramos (no de claves cubiertas)
+        size_type getSize() const noexcept
+        {
+            return segments.getSize();
+        }
+
+        // Modificadores
+        void clear() noexcept
+        {
+            segments.clear();
+        }
+
+        /**
+         * @brief Sets the value of every key in `[from, to)`
+         *
+         * Segments overlapping the range are trimmed (or split in two when they cover
+         * it entirely), the ones inside it are erased, and the new segment is merged
+         * with its neighbours when they touch it and hold an equal value.
+         * Does nothing if the range is empty.
+         *
+         * @param from First key of the range
+         * @param to Key one past the end of the range
+         * @param value Value for the whole range
+         */
+        void assign(const Key &from, const Key &to, const Value &value)
+        {
+            if (!comp(from, to))
+            {
+                return;
+            }
+            std::optional<Segment> rest = carve(from, to);
+            Key end = to;
+
+            // Vecino derecho: se absorbe si tiene el mismo valor
+            if (rest.has_value() && rest->value == value)
+            {
+                end = rest->end;
+                rest.reset();
+            }
+            else if (!rest.has_value())
+            {
+                auto next = segments.lowerBound(to);
+                if (next != segments.end() && !comp(to, next->first) && next->second.value == value)
+                {
+                    end = next->second.end;
+                    segments.erase(next);
+                }
+            }
+
+            // Vecino izquierdo: se extiende en lugar de insertar un tramo nuevo
+            auto placed = segments.lowerBound(from);
+            if (placed != segments.begin() && std::prev(placed)->second.value == value && !comp(std::prev(placed)->second.end, from))
+            {
+                --placed;
+                placed->second.end = end;
+            }
+            else
+            {
+                placed = segments.emplaceHint(placed, from, Slot{end, value});
+            }
+
+            if (rest.has_value())
+            {
+                segments.emplaceHint(std::next(placed), to, Slot{rest->end, std::move(rest->value)});
+            }
+        }
+
+        /**
+         * @brief Removes every key in `[from, to)` from the map
+         *
+         * Segments crossing a bound are trimmed; one covering the whole range is split.
+         */
+        void erase(const Key &from, const Key &to)
+        {
+            if (!comp(from, to))
+            {
+                return;
+            }
+            std::optional<Segment> rest = carve(from, to);
+            if (rest.has_value())
+            {
+                segments.emplaceHint(segments.lowerBound(to), to, Slot{rest->end, std::move(rest->value)});
+            }
+        }
+
+        // Lookup
+        const Value *find(const Key &point) const
+        {
+            auto it = findContaining(point);
+            return it == segments.end() ? nullptr : &it->second.value;
+        }
+
+        const Value &at(const Key &point) const
+        {
+            const Value *value = find(point);
+            if (value == nullptr)
+            {
+                throw std::out_of_range("IntervalMap::at: key not covered");
+            }
+            return *value;
+        }
+
+        bool contains(const Key &point) const
+        {
+            return findContaining(point) != segments.end();
+        }
+
+        // Tramo completo que contiene point
+        std::optional<Segment> getSegmentAt(const Key &point) const
+        {
+            auto it = findContaining(point);
+            if (it == segments.end())
+            {
+                return std::nullopt;
+            }
+            return Segment{it->first, it->second.end, it->second.value};
+        }
+
+        /**
+         * @brief Calls `func(start, end, value)` for every segment overlapping `[from, to)`, in order
+         *
+         * Segments are reported whole, not clipped to the range.
+         */
+        template <typename TernaryFunc>
+        void forEachOverlapping(const Key &from, const Key &to, TernaryFunc func) const
+        {
+            if (!comp(from, to))
+            {
+                return;
+            }
+            auto it = segments.upperBound(from);
+            if (it != segments.begin() && comp(from, std::prev(it)->second.end))
+            {
+                --it;
+            }
+            for (; it != segments.end() && comp(it->first, to); ++it)
+            {
+                func(it->first, it->second.end, it->second.value);
+            }
+        }
+
+        Vector<Segment> getOverlapping(const Key &from, const Key &to) const
+        {
+            Vector<Segment> result;
+            forEachOverlapping(from, to, [&result](const Key &start, const Key &end, const Value &value)
+                               { result.pushBack(Segment{start, end, value}); });
+            return result;
+        }
+
+        // Recorrido
+        template <typename TernaryFunc>
+        void forEach(TernaryFunc func) const
+        {
+            for (auto it = segments.begin(); it != segments.end(); ++it)
+            {
+                func(it->first, it->second.end, it->second.value);
+            }
+        }
+
+        Vector<Segment> getSegments() const
+        {
+            Vector<Segment> result;
+            result.reserve(segments.getSize());
+            forEach([&result](const Key &start, const Key &end, const Value &value)
+                    { result.pushBack(Segment{start, end, value}); });
+            return result;
+        }
+
+        // Comparación
+        bool operator==(const IntervalMap &other) const
+        {
+            return segments == other.segments;
+        }
+
+        bool operator!=(const IntervalMap &other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        // Último tramo con inicio <= point, si point cae dentro de él
+        auto findContaining(const Key &point) const
+        {
+            auto it = segments.upperBound(point);
+            if (it == segments.begin())
+            {
+                return segments.end();
+            }
+            --it;
+            return comp(point, it->second.end) ? it : segments.end();
+        }
+
+        // Deja [from, to) vacío: recorta el tramo que entra por la izquierda, borra los
+        // interiores y devuelve la cola del que sobresale por la derecha (sin reinsertarla)
+        std::optional<Segment> carve(const Key &from, const Key &to)
+        {
+            std::optional<Segment> rest;
+            auto first = segments.lowerBound(from);
+            auto last = segments.lowerBound(to);
+            if (last != segments.begin())
+            {
+                auto before = std::prev(last);
+                if (comp(to, before->second.end))
+                {
+                    rest = Segment{to, before->second.end, before->second.value};
+                }
+            }
+            if (first != segments.begin())
+            {
+                auto before = std::prev(first);
+                if (comp(from, before->second.end))
+                {
+                    before->second.end = from;
+                }
+            }
+            segments.erase(first, last);
+            return rest;
+        }
+    };
+
+} // namespace cppex
+
+#endif // CPPEX_INTERVAL_MAP_HPP
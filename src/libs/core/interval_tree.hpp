@@ -0,0 +1,435 @@
+/**
+ * @file interval_tree.hpp
+ * @brief Augmented treap of possibly overlapping intervals for stabbing and overlap queries
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_INTERVAL_TREE_HPP
+#define CPPEX_INTERVAL_TREE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include "vector.hpp" // Include Vector class
+
+namespace cpp_ex
+{
+
+    /**
+     * @brief Multiset of half-open intervals `[start, end)` with attached values
+     *
+     * Unlike IntervalMap, intervals may overlap and repeat. They are kept in a treap
+     * ordered by start where every node also stores the largest end of its subtree
+     * (`maxEnd`), so stabbing ("which intervals contain t?") and overlap queries skip
+     * every subtree that ends too early and every right subtree that starts too late.
+     * Insertion and erasure take expected O(log n); a query takes O(log n + k) for
+     * typical inputs, k being the number of reported intervals. Results come in start
+     * order.
+     *
+     * Empty intervals (`end <= start`) are not stored.
+     *
+     * @tparam Key Type of the interval bounds
+     * @tparam Value Type of the value attached to each interval
+     * @tparam Compare Comparison function object type, defaults to std::less<Key>
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::IntervalTree<int64_t, std::string> meetings;
+     * meetings.insert(900, 1000, "standup");
+     * meetings.insert(930, 1100, "review");
+     *
+     * meetings.forEachStabbing(945, [](int64_t start, int64_t end, const std::string &name) {
+     *     // standup, review
+     * });
+     * auto afternoon = meetings.getOverlapping(1200, 1800);
+     * ```
+     */
+    template <typename Key, typename Value, typename Compare = std::less<Key>>
+    class IntervalTree
+    {
+    public:
+        // Tipos (aliases)
+        using key_type = Key;
+        using mapped_type = Value;
+        using size_type = std::size_t;
+        using key_compare = Compare;
+
+        struct Entry
+        {
+            Key start;
+            Key end;
+            Value value;
+
+            bool operator==(const Entry &other) const = default;
+        };
+
+    private:
+        struct Node;
+        using NodePtr = std::unique_ptr<Node>;
+
+        struct Node
+        {
+            Entry entry;
+            Key maxEnd; // Mayor final del subárbol
+            std::uint32_t priority;
+            NodePtr left;
+            NodePtr right;
+        };
+
+        NodePtr root;
+        size_type size = 0;
+        std::uint64_t seed = 0x9E3779B97F4A7C15ULL; // Estado del generador de prioridades
+        [[no_unique_address]] Compare comp;
+
+    public:
+        // Constructores
+        IntervalTree() = default;
+
+        explicit IntervalTree(const Compare &comp) : comp(comp) {}
+
+        IntervalTree(std::initializer_list<Entry> init, const Compare &comp = Compare()) : comp(comp)
+        {
+            for (const auto &entry : init)
+            {
+                insert(entry.start, entry.end, entry.value);
+            }
+        }
+
+        IntervalTree(const IntervalTree &other)
+            : root(clone(other.root.get())), size(other.size), seed(other.seed), comp(other.comp) {}
+
+        IntervalTree(IntervalTree &&other) noexcept
+            : root(std::move(other.root)), size(std::exchange(other.size, 0)), seed(other.seed), comp(std::move(other.comp)) {}
+
+        // Operadores de asignación
+        IntervalTree &operator=(const IntervalTree &other)
+        {
+            if (this != &other)
+            {
+                IntervalTree tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        IntervalTree &operator=(IntervalTree &&other) noexcept
+        {
+            if (this != &other)
+            {
+                root = std::move(other.root);
+                size = std::exchange(other.size, 0);
+                seed = other.seed;
+                comp = std::move(other.comp);
+            }
+            return *this;
+        }
+
+        // Capacidad
+        bool isEmpty() const noexcept
+        {
+            return size == 0;
+        }
+
+        size_type getSize() const noexcept
+        {
+            return size;
+        }
+
+        // Modificadores
+        void clear() noexcept
+        {
+            root.reset();
+            size = 0;
+        }
+
+        // Añade el intervalo aunque ya exista otro igual; false si está vacío
+        bool insert(const Key &start, const Key &end, const Value &value)
+        {
+            if (!comp(start, end))
+            {
+                return false;
+            }
+            auto node = std::make_unique<Node>(Node{Entry{start, end, value}, end, nextPriority(), nullptr, nullptr});
+            NodePtr left;
+            NodePtr right;
+            split(std::move(root), start, true, left, right);
+            root = merge(merge(std::move(left), std::move(node)), std::move(right));
+            ++size;
+            return true;
+        }
+
+        /**
+         * @brief Removes one interval with exactly these bounds
+         *
+         * @return true if an interval was found and removed
+         */
+        bool erase(const Key &start, const Key &end)
+        {
+            // Aísla los nodos con este inicio, borra uno y vuelve a unir las tres partes
+            NodePtr before;
+            NodePtr rest;
+            NodePtr same;
+            NodePtr after;
+            split(std::move(root), start, false, before, rest);
+            split(std::move(rest), start, true, same, after);
+            bool removed = removeWithEnd(same, end);
+            root = merge(merge(std::move(before), std::move(same)), std::move(after));
+            if (removed)
+            {
+                --size;
+            }
+            return removed;
+        }
+
+        void swap(IntervalTree &other) noexcept
+        {
+            std::swap(root, other.root);
+            std::swap(size, other.size);
+            std::swap(seed, other.seed);
+            std::swap(comp, other.comp);
+        }
+
+        // Consultas
+        /**
+         * @brief Calls `func(start, end, value)` for every interval containing point
+         */
+        template <typename TernaryFunc>
+        void forEachStabbing(const Key &point, TernaryFunc func) const
+        {
+            visitStabbing(root.get(), point, func);
+        }
+
+        Vector<Entry> getStabbing(const Key &point) const
+        {
+            Vector<Entry> result;
+            forEachStabbing(point, [&result](const Key &start, const Key &end, const Value &value)
+                            { result.pushBack(Entry{start, end, value}); });
+            return result;
+        }
+
+        /**
+         * @brief Calls `func(start, end, value)` for every interval overlapping `[from, to)`
+         */
+        template <typename TernaryFunc>
+        void forEachOverlapping(const Key &from, const Key &to, TernaryFunc func) const
+        {
+            if (comp(from, to))
+            {
+                visitOverlapping(root.get(), from, to, func);
+            }
+        }
+
+        Vector<Entry> getOverlapping(const Key &from, const Key &to) const
+        {
+            Vector<Entry> result;
+            forEachOverlapping(from, to, [&result](const Key &start, const Key &end, const Value &value)
+                               { result.pushBack(Entry{start, end, value}); });
+            return result;
+        }
+
+        bool hasOverlap(const Key &from, const Key &to) const
+        {
+            return comp(from, to) && findOverlap(root.get(), from, to);
+        }
+
+        // Recorrido en orden de inicio
+        template <typename TernaryFunc>
+        void forEach(TernaryFunc func) const
+        {
+            visitAll(root.get(), func);
+        }
+
+        Vector<Entry> getEntries() const
+        {
+            Vector<Entry> result;
+            result.reserve(size);
+            forEach([&result](const Key &start, const Key &end, const Value &value)
+                    { result.pushBack(Entry{start, end, value}); });
+            return result;
+        }
+
+    private:
+        std::uint32_t nextPriority() noexcept
+        {
+            // xorshift64*: otro generador que splitmix64, para que claves generadas con
+            // splitmix64 (muy habitual) no salgan correladas con sus prioridades
+            seed ^= seed >> 12;
+            seed ^= seed << 25;
+            seed ^= seed >> 27;
+            return static_cast<std::uint32_t>((seed * 0x2545F4914F6CDD1DULL) >> 32);
+        }
+
+        void update(Node *node) const
+        {
+            node->maxEnd = node->entry.end;
+            if (node->left != nullptr && comp(node->maxEnd, node->left->maxEnd))
+            {
+                node->maxEnd = node->left->maxEnd;
+            }
+            if (node->right != nullptr && comp(node->maxEnd, node->right->maxEnd))
+            {
+                node->maxEnd = node->right->maxEnd;
+            }
+        }
+
+        // Parte el árbol en inicios < key (o <= key si equalGoesLeft) y el resto
+        void split(NodePtr node, const Key &key, bool equalGoesLeft, NodePtr &left, NodePtr &right) const
+        {
+            if (node == nullptr)
+            {
+                left.reset();
+                right.reset();
+                return;
+            }
+            bool goesLeft = equalGoesLeft ? !comp(key, node->entry.start) : comp(node->entry.start, key);
+            NodePtr middle;
+            if (goesLeft)
+            {
+                split(std::move(node->right), key, equalGoesLeft, middle, right);
+                node->right = std::move(middle);
+                update(node.get());
+                left = std::move(node);
+            }
+            else
+            {
+                split(std::move(node->left), key, equalGoesLeft, left, middle);
+                node->left = std::move(middle);
+                update(node.get());
+                right = std::move(node);
+            }
+        }
+
+        // Une dos árboles donde todos los inicios de left van antes que los de right
+        NodePtr merge(NodePtr left, NodePtr right) const
+        {
+            if (left == nullptr)
+            {
+                return right;
+            }
+            if (right == nullptr)
+            {
+                return left;
+            }
+            if (left->priority > right->priority)
+            {
+                left->right = merge(std::move(left->right), std::move(right));
+                update(left.get());
+                return left;
+            }
+            right->left = merge(std::move(left), std::move(right->left));
+            update(right.get());
+            return right;
+        }
+
+        // Todos los nodos del subárbol tienen el mismo inicio
+        bool removeWithEnd(NodePtr &node, const Key &end) const
+        {
+            if (node == nullptr || comp(node->maxEnd, end))
+            {
+                return false;
+            }
+            if (!comp(node->entry.end, end) && !comp(end, node->entry.end))
+            {
+                node = merge(std::move(node->left), std::move(node->right));
+                return true;
+            }
+            bool removed = removeWithEnd(node->left, end) || removeWithEnd(node->right, end);
+            if (removed)
+            {
+                update(node.get());
+            }
+            return removed;
+        }
+
+        template <typename TernaryFunc>
+        void visitStabbing(const Node *node, const Key &point, TernaryFunc &func) const
+        {
+            // Nada en este subárbol llega más allá de point
+            if (node == nullptr || !comp(point, node->maxEnd))
+            {
+                return;
+            }
+            visitStabbing(node->left.get(), point, func);
+            if (comp(point, node->entry.start))
+            {
+                return; // Este nodo y su subárbol derecho empiezan después de point
+            }
+            if (comp(point, node->entry.end))
+            {
+                func(node->entry.start, node->entry.end, node->entry.value);
+            }
+            visitStabbing(node->right.get(), point, func);
+        }
+
+        template <typename TernaryFunc>
+        void visitOverlapping(const Node *node, const Key &from, const Key &to, TernaryFunc &func) const
+        {
+            if (node == nullptr || !comp(from, node->maxEnd))
+            {
+                return;
+            }
+            visitOverlapping(node->left.get(), from, to, func);
+            if (!comp(node->entry.start, to))
+            {
+                return;
+            }
+            if (comp(from, node->entry.end))
+            {
+                func(node->entry.start, node->entry.end, node->entry.value);
+            }
+            visitOverlapping(node->right.get(), from, to, func);
+        }
+
+        bool findOverlap(const Node *node, const Key &from, const Key &to) const
+        {
+            while (node != nullptr && comp(from, node->maxEnd))
+            {
+                if (comp(node->entry.start, to) && comp(from, node->entry.end))
+                {
+                    return true;
+                }
+                // Si el subárbol izquierdo llega hasta from, solapa o nada a la derecha lo hará
+                if (node->left != nullptr && comp(from, node->left->maxEnd))
+                {
+                    node = node->left.get();
+                }
+                else if (comp(node->entry.start, to))
+                {
+                    node = node->right.get();
+                }
+                else
+                {
+                    return false;
+                }
+            }
+            return false;
+        }
+
+        template <typename TernaryFunc>
+        void visitAll(const Node *node, TernaryFunc &func) const
+        {
+            if (node != nullptr)
+            {
+                visitAll(node->left.get(), func);
+                func(node->entry.start, node->entry.end, node->entry.value);
+                visitAll(node->right.get(), func);
+            }
+        }
+
+        static NodePtr clone(const Node *node)
+        {
+            if (node == nullptr)
+            {
+                return nullptr;
+            }
+            return std::make_unique<Node>(Node{node->entry, node->maxEnd, node->priority, clone(node->left.get()), clone(node->right.get())});
+        }
+    };
+
+} // namespace cppex
+
+#endif // CPPEX_INTERVAL_TREE_HPP
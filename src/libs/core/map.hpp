@@ -9,10 +9,25 @@
 #define CPPEX_MAP_HPP
 
 #include <map>
+#include <algorithm>
 #include <functional>
 #include <utility>
+#include <cstdint>
 #include <initializer_list>
-#include "vector.hpp" // Include Vector class
+#include <iterator>
+#include <concepts>
+#include <memory>
+#include <optional>
+#include <numeric>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+#include "common.hpp"         // Include detail::IsTransparent
+#include "vector.hpp"         // Include Vector class
+#include "map_view.hpp"       // Include MapView
+#include "pool_allocator.hpp" // Include PoolAllocator (PooledMap)
+#include "parallel.hpp"       // Include detail::parallelFor
+#include "map_delta.hpp"      // Include MapDelta
 
 namespace cpp_ex
 {
@@ -27,6 +42,8 @@ namespace cpp_ex
      * @tparam Key Type of the keys
      * @tparam Value Type of the mapped values
      * @tparam Compare Comparison function object type, defaults to std::less<Key>
+     * @tparam Allocator Allocator for the tree nodes, defaults to std::allocator
+     *         (see PooledMap for a pool-backed map)
      *
      * @example
      * ```cpp
@@ -46,38 +63,72 @@ namespace cpp_ex
      * });
      * ```
      */
-    template <typename Key, typename Value, typename Compare = std::less<Key>>
+    template <typename Key, typename Value, typename Compare = std::less<Key>,
+              typename Allocator = std::allocator<std::pair<const Key, Value>>>
     class Map
     {
     private:
-        std::map<Key, Value, Compare> data;
+        std::map<Key, Value, Compare, Allocator> data;
+
+        // Diario de cambios desde el último checkpoint(), solo si se activó
+        struct Journal
+        {
+            std::map<Key, bool, Compare> touched; // Clave -> existía en el último checkpoint
+            bool reset = false;                   // Cambio no rastreable: el próximo delta lleva el mapa entero
+
+            explicit Journal(const Compare &comp) : touched(comp) {}
+        };
+
+        // Versión, caché de getKeysSnapshot() y diario: se crean la primera vez que se piden, así
+        // que un Map que no los usa solo paga un puntero nulo y una comprobación por modificación
+        struct Tracking
+        {
+            std::uint64_t version = 0; // Cambia con cada inserción o borrado (no con cambios de valores)
+            Vector<Key> keys;
+            std::uint64_t keysVersion = 0;
+            bool hasKeys = false;
+            std::optional<Journal> journal;
+        };
+        mutable std::unique_ptr<Tracking> tracking;
 
         // Declare friendship with all other Map instantiations
-        template <typename K, typename V, typename C>
+        template <typename K, typename V, typename C, typename A>
         friend class Map;
 
+        // libstdc++ 12 no destruye la copia del allocator que guarda un nodo reinsertado:
+        // con allocators con estado (PoolAllocator) se mueve la entrada en lugar de reenlazar el nodo
+        static constexpr bool kRelinkNodes = std::allocator_traits<Allocator>::is_always_equal::value;
+
+        // Mismo allocator para otro tipo de valor (mapValues())
+        template <typename OtherValue>
+        using RebindAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<const Key, OtherValue>>;
+
     public:
         // Tipos (aliases)
-        using key_type = typename std::map<Key, Value, Compare>::key_type;
-        using mapped_type = typename std::map<Key, Value, Compare>::mapped_type;
-        using value_type = typename std::map<Key, Value, Compare>::value_type;
-        using size_type = typename std::map<Key, Value, Compare>::size_type;
-        using difference_type = typename std::map<Key, Value, Compare>::difference_type;
-        using key_compare = typename std::map<Key, Value, Compare>::key_compare;
-        using allocator_type = typename std::map<Key, Value, Compare>::allocator_type;
-        using reference = typename std::map<Key, Value, Compare>::reference;
-        using const_reference = typename std::map<Key, Value, Compare>::const_reference;
-        using pointer = typename std::map<Key, Value, Compare>::pointer;
-        using const_pointer = typename std::map<Key, Value, Compare>::const_pointer;
-        using iterator = typename std::map<Key, Value, Compare>::iterator;
-        using const_iterator = typename std::map<Key, Value, Compare>::const_iterator;
-        using reverse_iterator = typename std::map<Key, Value, Compare>::reverse_iterator;
-        using const_reverse_iterator = typename std::map<Key, Value, Compare>::const_reverse_iterator;
+        using key_type = typename std::map<Key, Value, Compare, Allocator>::key_type;
+        using mapped_type = typename std::map<Key, Value, Compare, Allocator>::mapped_type;
+        using value_type = typename std::map<Key, Value, Compare, Allocator>::value_type;
+        using size_type = typename std::map<Key, Value, Compare, Allocator>::size_type;
+        using difference_type = typename std::map<Key, Value, Compare, Allocator>::difference_type;
+        using key_compare = typename std::map<Key, Value, Compare, Allocator>::key_compare;
+        using allocator_type = typename std::map<Key, Value, Compare, Allocator>::allocator_type;
+        using reference = typename std::map<Key, Value, Compare, Allocator>::reference;
+        using const_reference = typename std::map<Key, Value, Compare, Allocator>::const_reference;
+        using pointer = typename std::map<Key, Value, Compare, Allocator>::pointer;
+        using const_pointer = typename std::map<Key, Value, Compare, Allocator>::const_pointer;
+        using iterator = typename std::map<Key, Value, Compare, Allocator>::iterator;
+        using const_iterator = typename std::map<Key, Value, Compare, Allocator>::const_iterator;
+        using reverse_iterator = typename std::map<Key, Value, Compare, Allocator>::reverse_iterator;
+        using const_reverse_iterator = typename std::map<Key, Value, Compare, Allocator>::const_reverse_iterator;
+        using node_type = typename std::map<Key, Value, Compare, Allocator>::node_type;
+        using insert_return_type = typename std::map<Key, Value, Compare, Allocator>::insert_return_type;
 
         // Constructores
         Map() = default;
 
-        explicit Map(const Compare &comp) : data(comp) {}
+        explicit Map(const Compare &comp, const Allocator &alloc = Allocator()) : data(comp, alloc) {}
+
+        explicit Map(const Allocator &alloc) : data(alloc) {}
 
         template <typename InputIt>
         Map(InputIt first, InputIt last) : data(first, last) {}
@@ -91,9 +142,52 @@ namespace cpp_ex
 
         Map(const Map &other) : data(other.data) {}
 
-        Map(Map &&other) noexcept : data(std::move(other.data)) {}
+        Map(Map &&other) noexcept : data(std::move(other.data))
+        {
+            other.bumpVersion();
+            other.journalReset();
+        }
+
+        Map(const std::map<Key, Value, Compare, Allocator> &stdMap) : data(stdMap) {}
+
+        Map(std::map<Key, Value, Compare, Allocator> &&stdMap) noexcept : data(std::move(stdMap)) {}
+
+        /**
+         * @brief Builds a map from entries already sorted by key in O(n)
+         *
+         * Each entry is inserted with the position after the previous one as hint,
+         * which std::map handles in amortized constant time. Unsorted input still
+         * gives a correct map, only slower; for duplicate keys the first one wins.
+         *
+         * @param first Beginning of the sorted range of key-value pairs
+         * @param last End of the range
+         * @param comp Comparator of the new map (the range must be sorted with it)
+         * @return A new map with the entries of the range
+         *
+         * @example
+         * ```cpp
+         * cpp_ex::Vector<std::pair<int, std::string>> rows = loadRowsOrderedById();
+         * auto byId = cpp_ex::Map<int, std::string>::fromSorted(rows);
+         * ```
+         */
+        template <typename InputIt>
+        static Map fromSorted(InputIt first, InputIt last, const Compare &comp = Compare())
+        {
+            Map result(comp);
+            result.insertSorted(first, last);
+            return result;
+        }
+
+        template <typename Range>
+        static Map fromSorted(const Range &range, const Compare &comp = Compare())
+        {
+            return fromSorted(std::begin(range), std::end(range), comp);
+        }
 
-        Map(const std::map<Key, Value, Compare> &stdMap) : data(stdMap) {}
+        static Map fromSorted(std::initializer_list<value_type> ilist, const Compare &comp = Compare())
+        {
+            return fromSorted(ilist.begin(), ilist.end(), comp);
+        }
 
         // Operadores de asignación
         Map &operator=(const Map &other)
@@ -101,6 +195,8 @@ namespace cpp_ex
             if (this != &other)
             {
                 data = other.data;
+                bumpVersion();
+                journalReset();
             }
             return *this;
         }
@@ -108,27 +204,63 @@ namespace cpp_ex
         Map &operator=(Map &&other) noexcept
         {
             data = std::move(other.data);
+            bumpVersion();
+            other.bumpVersion();
+            journalReset();
+            other.journalReset();
             return *this;
         }
 
         Map &operator=(std::initializer_list<value_type> ilist)
         {
             data = ilist;
+            bumpVersion();
+            journalReset();
             return *this;
         }
 
-        // Conversión a std::map
-        operator std::map<Key, Value, Compare>() const
+        // Conversión a std::map (los temporales ceden sus nodos)
+        operator std::map<Key, Value, Compare, Allocator>() const &
+        {
+            return data;
+        }
+
+        operator std::map<Key, Value, Compare, Allocator>() &&
+        {
+            bumpVersion();
+            journalReset();
+            return std::move(data);
+        }
+
+        // Copia explícita, o movimiento sin reservar nodos si se llama sobre un rvalue
+        std::map<Key, Value, Compare, Allocator> toStdMap() const &
         {
             return data;
         }
 
-        std::map<Key, Value, Compare> &getStdMap()
+        std::map<Key, Value, Compare, Allocator> toStdMap() &&
+        {
+            bumpVersion();
+            journalReset();
+            return std::move(data);
+        }
+
+        /**
+         * @brief Mutable access to the underlying std::map
+         *
+         * The call itself counts as a change: it moves getVersion(), invalidates the
+         * key snapshot and makes the next checkpoint() a full delta. Changes made later
+         * through the returned reference are not seen by any of them, so call
+         * getStdMap() again (or do not keep the reference) after such changes.
+         */
+        std::map<Key, Value, Compare, Allocator> &getStdMap()
         {
+            bumpVersion();
+            journalReset();
             return data;
         }
 
-        const std::map<Key, Value, Compare> &getStdMap() const
+        const std::map<Key, Value, Compare, Allocator> &getStdMap() const
         {
             return data;
         }
@@ -213,7 +345,9 @@ namespace cpp_ex
         // Acceso a elementos
         mapped_type &at(const key_type &key)
         {
-            return data.at(key);
+            mapped_type &value = data.at(key);
+            journalKey(key, true);
+            return value;
         }
 
         const mapped_type &at(const key_type &key) const
@@ -221,95 +355,366 @@ namespace cpp_ex
             return data.at(key);
         }
 
+        // Búsqueda heterogénea: solo con comparadores transparentes (std::less<>, std::less<String>...)
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        mapped_type &at(const K &key)
+        {
+            auto it = data.find(key);
+            if (it == data.end())
+            {
+                throw std::out_of_range("Map::at: key not found");
+            }
+            journalKey(it->first, true);
+            return it->second;
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        const mapped_type &at(const K &key) const
+        {
+            auto it = data.find(key);
+            if (it == data.end())
+            {
+                throw std::out_of_range("Map::at: key not found");
+            }
+            return it->second;
+        }
+
         mapped_type &operator[](const key_type &key)
         {
-            return data[key];
+            auto it = data.try_emplace(key);
+            bumpVersion(it.second);
+            journalKey(it.first->first, !it.second);
+            return it.first->second;
         }
 
         mapped_type &operator[](key_type &&key)
         {
-            return data[std::move(key)];
+            auto it = data.try_emplace(std::move(key));
+            bumpVersion(it.second);
+            journalKey(it.first->first, !it.second);
+            return it.first->second;
         }
 
         // Modificadores
         void clear() noexcept
         {
             data.clear();
+            bumpVersion();
+            journalReset();
         }
 
         std::pair<iterator, bool> insert(const value_type &value)
         {
-            return data.insert(value);
+            return recordInserted(data.insert(value));
         }
 
         std::pair<iterator, bool> insert(value_type &&value)
         {
-            return data.insert(std::move(value));
+            return recordInserted(data.insert(std::move(value)));
         }
 
         template <typename P>
         std::pair<iterator, bool> insert(P &&value)
         {
-            return data.insert(std::forward<P>(value));
+            return recordInserted(data.insert(std::forward<P>(value)));
         }
 
         iterator insert(const_iterator hint, const value_type &value)
         {
-            return data.insert(hint, value);
+            size_type before = data.size();
+            return recordInserted(data.insert(hint, value), before);
         }
 
         iterator insert(const_iterator hint, value_type &&value)
         {
-            return data.insert(hint, std::move(value));
+            size_type before = data.size();
+            return recordInserted(data.insert(hint, std::move(value)), before);
         }
 
         template <typename P>
         iterator insert(const_iterator hint, P &&value)
         {
-            return data.insert(hint, std::forward<P>(value));
+            size_type before = data.size();
+            return recordInserted(data.insert(hint, std::forward<P>(value)), before);
         }
 
         template <typename InputIt>
         void insert(InputIt first, InputIt last)
         {
-            data.insert(first, last);
+            if (getJournal())
+            {
+                for (; first != last; ++first)
+                {
+                    recordInserted(data.insert(*first));
+                }
+            }
+            else
+            {
+                size_type before = data.size();
+                data.insert(first, last);
+                bumpVersion(data.size() - before);
+            }
         }
 
         void insert(std::initializer_list<value_type> ilist)
         {
-            data.insert(ilist);
+            insert(ilist.begin(), ilist.end());
+        }
+
+        /**
+         * @brief Inserts a batch of entries sorted by key, in O(n) for sorted input
+         *
+         * Like insert(first, last), but every entry uses the successor of the previous
+         * one as hint, so a sorted batch (or one appended after the current keys)
+         * costs amortized O(1) per entry instead of O(log n). Existing keys are kept.
+         *
+         * @return Number of inserted entries
+         */
+        template <typename InputIt>
+        size_type insertSorted(InputIt first, InputIt last)
+        {
+            size_type before = data.size();
+            auto hint = data.begin();
+            for (; first != last; ++first)
+            {
+                size_type size = data.size();
+                hint = std::next(recordInserted(data.emplace_hint(hint, *first), size));
+            }
+            return data.size() - before;
+        }
+
+        template <typename Range>
+        size_type insertSorted(const Range &range)
+        {
+            return insertSorted(std::begin(range), std::end(range));
+        }
+
+        size_type insertSorted(std::initializer_list<value_type> ilist)
+        {
+            return insertSorted(ilist.begin(), ilist.end());
         }
 
         template <typename... Args>
         std::pair<iterator, bool> emplace(Args &&...args)
         {
-            return data.emplace(std::forward<Args>(args)...);
+            return recordInserted(data.emplace(std::forward<Args>(args)...));
         }
 
         template <typename... Args>
         iterator emplaceHint(const_iterator hint, Args &&...args)
         {
-            return data.emplace_hint(hint, std::forward<Args>(args)...);
+            size_type before = data.size();
+            return recordInserted(data.emplace_hint(hint, std::forward<Args>(args)...), before);
         }
 
         iterator erase(const_iterator pos)
         {
+            bumpVersion();
+            journalKey(pos->first, true);
             return data.erase(pos);
         }
 
         iterator erase(const_iterator first, const_iterator last)
         {
+            bumpVersion(first != last ? 1 : 0);
+            journalErased(first, last);
             return data.erase(first, last);
         }
 
         size_type erase(const key_type &key)
         {
-            return data.erase(key);
+            auto it = data.find(key);
+            if (it == data.end())
+            {
+                return 0;
+            }
+            if (getJournal())
+            {
+                journalErased(it, std::next(it));
+            }
+            data.erase(it);
+            bumpVersion();
+            return 1;
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare> &&
+                     (!std::is_convertible_v<K &&, iterator>) && (!std::is_convertible_v<K &&, const_iterator>)
+        size_type erase(K &&key)
+        {
+            auto range = data.equal_range(key);
+            size_type erased = static_cast<size_type>(std::distance(range.first, range.second));
+            journalErased(range.first, range.second);
+            data.erase(range.first, range.second);
+            bumpVersion(erased);
+            return erased;
         }
 
         void swap(Map &other)
         {
             data.swap(other.data);
+            bumpVersion();
+            other.bumpVersion();
+            journalReset();
+            other.journalReset();
+        }
+
+        // Nodos: mueven entradas entre mapas reenlazando el nodo, sin reservar memoria
+
+        /**
+         * @brief Unlinks an entry and returns it as a node handle
+         *
+         * The entry is not copied nor freed: the node can be inserted into another
+         * Map (or std::map) with the same key and value types, and its key can even be
+         * changed through `node.key()` before reinserting it. With allocators that are
+         * not always equal (PooledMap), reinserting moves the key and value into a new
+         * node instead of relinking this one.
+         *
+         * @param key Key of the entry to extract
+         * @return Node owning the entry, or an empty node if the key is not present
+         *
+         * @example
+         * ```cpp
+         * auto node = pending.extract(id);
+         * if (!node.empty())
+         * {
+         *     done.insert(std::move(node)); // No allocation
+         * }
+         * ```
+         */
+        node_type extract(const key_type &key)
+        {
+            node_type node = data.extract(key);
+            bumpVersion(!node.empty());
+            if (!node.empty())
+            {
+                journalKey(node.key(), true);
+            }
+            return node;
+        }
+
+        node_type extract(const_iterator pos)
+        {
+            bumpVersion();
+            journalKey(pos->first, true);
+            return data.extract(pos);
+        }
+
+        // Inserta un nodo extraído; si la clave ya existe el nodo se devuelve en el resultado
+        insert_return_type insert(node_type &&node)
+        {
+            if constexpr (!kRelinkNodes)
+            {
+                if (node.empty())
+                {
+                    return {data.end(), false, node_type()};
+                }
+                // try_emplace no mueve la clave ni el valor si la clave ya existe
+                auto [it, inserted] = data.try_emplace(std::move(node.key()), std::move(node.mapped()));
+                if (!inserted)
+                {
+                    return {it, false, std::move(node)};
+                }
+                node = node_type(); // Libera el nodo (y su copia del allocator) aquí
+                bumpVersion();
+                journalKey(it->first, false);
+                return {it, true, node_type()};
+            }
+            else
+            {
+                insert_return_type result = data.insert(std::move(node));
+                bumpVersion(result.inserted);
+                if (result.inserted)
+                {
+                    journalKey(result.position->first, false);
+                }
+                return result;
+            }
+        }
+
+        iterator insert(const_iterator hint, node_type &&node)
+        {
+            if constexpr (!kRelinkNodes)
+            {
+                if (node.empty())
+                {
+                    return data.end();
+                }
+                size_type before = data.size();
+                auto it = data.try_emplace(hint, std::move(node.key()), std::move(node.mapped()));
+                if (data.size() != before)
+                {
+                    node = node_type();
+                    bumpVersion();
+                    journalKey(it->first, false);
+                }
+                return it;
+            }
+            else
+            {
+                size_type before = data.size();
+                return recordInserted(data.insert(hint, std::move(node)), before);
+            }
+        }
+
+        /**
+         * @brief Moves into this map every node of other whose key is missing here
+         *
+         * Same as std::map::merge(): nodes are relinked, so neither keys nor values are
+         * copied or reallocated. Entries whose key already exists stay in other.
+         * If the allocators are not equal (e.g. two PooledMap), nodes cannot change
+         * owner, so the entries are moved one by one instead. The same happens for
+         * stateful allocators when a journal is enabled.
+         *
+         * @param other Source map (may use a different comparator)
+         * @return Number of entries moved
+         */
+        template <typename OtherCompare>
+        size_type splice(Map<Key, Value, OtherCompare, Allocator> &other)
+        {
+            size_type before = data.size();
+            bool sameAllocator = std::allocator_traits<Allocator>::is_always_equal::value || data.get_allocator() == other.data.get_allocator();
+            if (sameAllocator && !getJournal() && !other.getJournal())
+            {
+                data.merge(other.data);
+            }
+            else
+            {
+                // Nodo a nodo: otro allocator (se mueven los valores) o algún diario que anotar
+                for (auto it = other.data.begin(); it != other.data.end();)
+                {
+                    if (data.contains(it->first))
+                    {
+                        ++it;
+                        continue;
+                    }
+                    journalKey(it->first, false);
+                    other.journalKey(it->first, true);
+                    if (sameAllocator && kRelinkNodes)
+                    {
+                        auto next = std::next(it);
+                        data.insert(other.data.extract(it));
+                        it = next;
+                    }
+                    else
+                    {
+                        data.try_emplace(it->first, std::move(it->second));
+                        it = other.data.erase(it);
+                    }
+                }
+            }
+            size_type moved = data.size() - before;
+            bumpVersion(moved);
+            other.bumpVersion(moved);
+            return moved;
+        }
+
+        template <typename OtherCompare>
+        size_type splice(Map<Key, Value, OtherCompare, Allocator> &&other)
+        {
+            return splice(other);
         }
 
         // Lookup
@@ -363,17 +768,136 @@ namespace cpp_ex
             return data.upper_bound(key);
         }
 
+        /**
+         * @brief Heterogeneous overloads of the lookup methods
+         *
+         * Enabled only when Compare declares `is_transparent` (for example
+         * `std::less<>` or `std::less<cpp_ex::String>`): the argument is compared with
+         * the stored keys as is, so `map.find("literal")` on a `Map<String, V>`
+         * does not build (nor allocate) a temporary String.
+         */
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        size_type count(const K &key) const
+        {
+            return data.count(key);
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        iterator find(const K &key)
+        {
+            return data.find(key);
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        const_iterator find(const K &key) const
+        {
+            return data.find(key);
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        bool contains(const K &key) const
+        {
+            return data.find(key) != data.end();
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        std::pair<iterator, iterator> equalRange(const K &key)
+        {
+            return data.equal_range(key);
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        std::pair<const_iterator, const_iterator> equalRange(const K &key) const
+        {
+            return data.equal_range(key);
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        iterator lowerBound(const K &key)
+        {
+            return data.lower_bound(key);
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        const_iterator lowerBound(const K &key) const
+        {
+            return data.lower_bound(key);
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        iterator upperBound(const K &key)
+        {
+            return data.upper_bound(key);
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        const_iterator upperBound(const K &key) const
+        {
+            return data.upper_bound(key);
+        }
+
+        /**
+         * @brief Batched lookups: one call for many keys
+         *
+         * `results[i]` is `find(keys[i])` (end() when the key is absent) and `results`
+         * is resized to `keys.getSize()`; containsMany() fills flags instead and
+         * returns how many keys were found. Batches of a few keys or more are looked
+         * up in key order: consecutive descents share the upper levels of the tree in
+         * cache, and a key a few entries after the previous one is reached by stepping
+         * forward instead of descending again. Duplicate keys are allowed.
+         */
+        void findMany(const Vector<Key> &keys, Vector<iterator> &results)
+        {
+            results.resize(keys.getSize());
+            lookupMany(data, keys, [&](size_type index, iterator it)
+                       { results[index] = it; });
+        }
+
+        void findMany(const Vector<Key> &keys, Vector<const_iterator> &results) const
+        {
+            results.resize(keys.getSize());
+            lookupMany(data, keys, [&](size_type index, const_iterator it)
+                       { results[index] = it; });
+        }
+
+        size_type containsMany(const Vector<Key> &keys, Vector<bool> &results) const
+        {
+            results.resize(keys.getSize());
+            size_type found = 0;
+            lookupMany(data, keys, [&](size_type index, const_iterator it)
+                       {
+                           bool present = it != data.end();
+                           results[index] = present;
+                           found += present ? 1 : 0; });
+            return found;
+        }
+
         // Observadores
         key_compare keyComp() const
         {
             return data.key_comp();
         }
 
-        typename std::map<Key, Value, Compare>::value_compare valueComp() const
+        typename std::map<Key, Value, Compare, Allocator>::value_compare valueComp() const
         {
             return data.value_comp();
         }
 
+        allocator_type getAllocator() const
+        {
+            return data.get_allocator();
+        }
+
         // Operadores de comparación
         bool operator==(const Map &other) const
         {
@@ -405,6 +929,70 @@ namespace cpp_ex
             return data >= other.data;
         }
 
+        // Vistas sin copia sobre el mapa vivo
+
+        // Claves (const Key&), sin copiar
+        KeysView<const Map> keysView() const noexcept
+        {
+            return KeysView<const Map>(*this);
+        }
+
+        // Valores (Value& en un mapa no const), sin copiar
+        ValuesView<Map> valuesView() noexcept
+        {
+            return ValuesView<Map>(*this);
+        }
+
+        ValuesView<const Map> valuesView() const noexcept
+        {
+            return ValuesView<const Map>(*this);
+        }
+
+        // Pares (std::pair<const Key, Value>&), sin copiar
+        EntriesView<Map> entriesView() noexcept
+        {
+            return EntriesView<Map>(*this);
+        }
+
+        EntriesView<const Map> entriesView() const noexcept
+        {
+            return EntriesView<const Map>(*this);
+        }
+
+        /**
+         * @brief Number that changes every time a key is inserted or erased
+         *
+         * Counting starts with the first call to getVersion() or getKeysSnapshot(), which
+         * allocate the state behind them; a map that never calls them does not pay for it.
+         * Changing values does not change the version.
+         */
+        std::uint64_t getVersion() const
+        {
+            return getTracking().version;
+        }
+
+        /**
+         * @brief Returns the keys as a Vector cached between calls
+         *
+         * The Vector is rebuilt only when keys were inserted or erased since the last
+         * call (changing values does not invalidate it). The reference stays valid
+         * until the next call after such a mutation. Not safe to call concurrently,
+         * even on a const map.
+         *
+         * @return Cached, sorted keys of the map
+         */
+        const Vector<Key> &getKeysSnapshot() const
+        {
+            Tracking &state = getTracking();
+            if (!state.hasKeys || state.keysVersion != state.version)
+            {
+                state.keys = getKeys();
+                state.keysVersion = state.version;
+                state.hasKeys = true;
+            }
+            return state.keys;
+        }
+
         // Métodos adicionales que usan cppex::Vector
 
         // Obtener todas las claves como un Vector
@@ -445,12 +1033,13 @@ namespace cpp_ex
 
         // Mapear valores a un nuevo tipo
         template <typename ResultType, typename UnaryFunc>
-        Map<Key, ResultType, Compare> mapValues(UnaryFunc func) const
+        Map<Key, ResultType, Compare, RebindAllocator<ResultType>> mapValues(UnaryFunc func) const
         {
-            Map<Key, ResultType, Compare> result;
+            // La salida tiene el mismo orden: cada entrada va al final (hint O(1))
+            Map<Key, ResultType, Compare, RebindAllocator<ResultType>> result(data.key_comp());
             for (const auto &pair : data)
             {
-                result.insert({pair.first, func(pair.second)});
+                result.data.emplace_hint(result.data.end(), pair.first, func(pair.second));
             }
             return result;
         }
@@ -459,12 +1048,12 @@ namespace cpp_ex
         template <typename BinaryPredicate>
         Map filterEntries(BinaryPredicate pred) const
         {
-            Map result;
+            Map result(data.key_comp());
             for (const auto &pair : data)
             {
                 if (pred(pair.first, pair.second))
                 {
-                    result.insert(pair);
+                    result.data.emplace_hint(result.data.end(), pair);
                 }
             }
             return result;
@@ -489,43 +1078,783 @@ namespace cpp_ex
             }
         }
 
+        /**
+         * @brief Parallel versions of forEach(), mapValues() and filterEntries()
+         *
+         * The map is split into contiguous key ranges of about the same size, one per
+         * thread (`threads == 0` uses every hardware thread, but keeps maps of a few
+         * thousand entries sequential). func/pred are called concurrently on different
+         * entries, so they must be safe to run in parallel. Each thread collects its own
+         * results, and they are appended to the output in key order: the result is the
+         * same as the sequential version. If a call throws, every thread finishes its
+         * range and the exception is rethrown.
+         */
+        template <typename BinaryFunc>
+        void parallelForEach(BinaryFunc func, size_type threads = 0)
+        {
+            auto bounds = splitRanges(data, threads);
+            detail::parallelFor(bounds.size() - 1, [&](std::size_t part)
+                                {
+                                    for (auto it = bounds[part]; it != bounds[part + 1]; ++it)
+                                    {
+                                        func(it->first, it->second);
+                                    } });
+        }
+
+        template <typename BinaryFunc>
+        void parallelForEach(BinaryFunc func, size_type threads = 0) const
+        {
+            auto bounds = splitRanges(data, threads);
+            detail::parallelFor(bounds.size() - 1, [&](std::size_t part)
+                                {
+                                    for (auto it = bounds[part]; it != bounds[part + 1]; ++it)
+                                    {
+                                        func(it->first, it->second);
+                                    } });
+        }
+
+        template <typename ResultType, typename UnaryFunc>
+        Map<Key, ResultType, Compare, RebindAllocator<ResultType>> parallelMapValues(UnaryFunc func, size_type threads = 0) const
+        {
+            auto bounds = splitRanges(data, threads);
+            Vector<Vector<ResultType>> mapped(bounds.size() - 1);
+            detail::parallelFor(bounds.size() - 1, [&](std::size_t part)
+                                {
+                                    for (auto it = bounds[part]; it != bounds[part + 1]; ++it)
+                                    {
+                                        mapped[part].pushBack(func(it->second));
+                                    } });
+
+            // Las partes siguen el orden de las claves: cada entrada va al final (hint O(1))
+            Map<Key, ResultType, Compare, RebindAllocator<ResultType>> result(data.key_comp());
+            auto it = data.begin();
+            for (auto &part : mapped)
+            {
+                for (auto &value : part)
+                {
+                    result.data.emplace_hint(result.data.end(), it->first, std::move(value));
+                    ++it;
+                }
+            }
+            return result;
+        }
+
+        template <typename BinaryPredicate>
+        Map parallelFilterEntries(BinaryPredicate pred, size_type threads = 0) const
+        {
+            auto bounds = splitRanges(data, threads);
+            Vector<Vector<const_iterator>> kept(bounds.size() - 1);
+            detail::parallelFor(bounds.size() - 1, [&](std::size_t part)
+                                {
+                                    for (auto it = bounds[part]; it != bounds[part + 1]; ++it)
+                                    {
+                                        if (pred(it->first, it->second))
+                                        {
+                                            kept[part].pushBack(it);
+                                        }
+                                    } });
+
+            Map result(data.key_comp());
+            for (const auto &part : kept)
+            {
+                for (auto it : part)
+                {
+                    result.data.emplace_hint(result.data.end(), *it);
+                }
+            }
+            return result;
+        }
+
         // Unión de dos mapas (keys en ambos tomará los valores del mapa actual)
+        // Ambos están ordenados con el mismo comparador: fusión lineal con inserción al final
         Map merge(const Map &other) const
         {
-            Map result = *this;
-            for (const auto &pair : other.data)
+            Map result(data.key_comp());
+            auto comp = data.key_comp();
+            auto a = data.begin();
+            auto b = other.data.begin();
+            while (a != data.end() && b != other.data.end())
             {
-                if (!result.contains(pair.first))
+                if (comp(b->first, a->first))
                 {
-                    result.insert(pair);
+                    result.data.emplace_hint(result.data.end(), *b++);
+                }
+                else
+                {
+                    if (!comp(a->first, b->first))
+                    {
+                        ++b;
+                    }
+                    result.data.emplace_hint(result.data.end(), *a++);
                 }
             }
+            result.appendRange(a, data.end());
+            result.appendRange(b, other.data.end());
             return result;
         }
 
-        // Diferencia: entradas de este mapa que no están en el otro
+        // Diferencia: entradas de este mapa que no están en el otro (fusión lineal)
         Map difference(const Map &other) const
         {
-            Map result;
+            return difference<Value, Allocator>(other);
+        }
+
+        // Diferencia con un mapa de otro tipo de valor (solo cuentan las claves)
+        template <typename OtherValue, typename OtherAllocator>
+        Map difference(const Map<Key, OtherValue, Compare, OtherAllocator> &other) const
+        {
+            Map result(data.key_comp());
+            auto comp = data.key_comp();
+            auto b = other.data.begin();
             for (const auto &pair : data)
             {
-                if (!other.contains(pair.first))
+                while (b != other.data.end() && comp(b->first, pair.first))
+                {
+                    ++b;
+                }
+                if (b == other.data.end() || comp(pair.first, b->first))
                 {
-                    result.insert(pair);
+                    result.data.emplace_hint(result.data.end(), pair);
                 }
             }
             return result;
         }
 
-        // Intersección: entradas con claves en ambos mapas (valores del mapa actual)
+        // Intersección: entradas con claves en ambos mapas (valores del mapa actual, fusión lineal)
         Map intersection(const Map &other) const
         {
-            Map result;
-            for (const auto &pair : data)
+            return intersection<Value, Allocator>(other);
+        }
+
+        // Intersección con un mapa de otro tipo de valor (solo cuentan las claves)
+        template <typename OtherValue, typename OtherAllocator>
+        Map intersection(const Map<Key, OtherValue, Compare, OtherAllocator> &other) const
+        {
+            Map result(data.key_comp());
+            auto comp = data.key_comp();
+            auto b = other.data.begin();
+            for (auto a = data.begin(); a != data.end() && b != other.data.end(); ++a)
             {
-                if (other.contains(pair.first))
+                while (b != other.data.end() && comp(b->first, a->first))
+                {
+                    ++b;
+                }
+                if (b != other.data.end() && !comp(a->first, b->first))
                 {
-                    result.insert(pair);
+                    result.data.emplace_hint(result.data.end(), *a);
+                }
+            }
+            return result;
+        }
+
+        // Variantes in-place
+
+        /**
+         * @brief Adds the entries of other whose keys are missing here (in place merge())
+         *
+         * Walks both maps once and inserts each new entry with the position of its
+         * successor as hint, so the cost is O(n + m) instead of O(m log n).
+         *
+         * @return Number of inserted entries
+         */
+        size_type mergeInto(const Map &other)
+        {
+            return mergeIntoImpl(other.data, [](const value_type &pair) -> const value_type &
+                                 { return pair; });
+        }
+
+        // Igual que mergeInto(const Map&), pero mueve los valores de other (que queda vacío)
+        size_type mergeInto(Map &&other)
+        {
+            auto inserted = mergeIntoImpl(other.data, [](value_type &pair)
+                                          { return std::pair<Key, Value>(pair.first, std::move(pair.second)); });
+            other.data.clear();
+            other.bumpVersion();
+            other.journalReset();
+            return inserted;
+        }
+
+        // Conserva solo las claves presentes en other (in place intersection()); devuelve cuántas se borraron
+        template <typename OtherValue, typename OtherAllocator>
+        size_type retainKeys(const Map<Key, OtherValue, Compare, OtherAllocator> &other)
+        {
+            return eraseByPresence(other.data.begin(), other.data.end(), [](const auto &pair) -> const Key &
+                                   { return pair.first; },
+                                   false);
+        }
+
+        // Conserva solo las claves del Vector (en cualquier orden)
+        size_type retainKeys(const Vector<Key> &keys)
+        {
+            auto sorted = sortedKeys(keys);
+            return eraseByPresence(sorted.begin(), sorted.end(), [](const Key &key) -> const Key &
+                                   { return key; },
+                                   false);
+        }
+
+        // Borra las claves presentes en other (in place difference()); devuelve cuántas se borraron
+        template <typename OtherValue, typename OtherAllocator>
+        size_type removeKeys(const Map<Key, OtherValue, Compare, OtherAllocator> &other)
+        {
+            return eraseByPresence(other.data.begin(), other.data.end(), [](const auto &pair) -> const Key &
+                                   { return pair.first; },
+                                   true);
+        }
+
+        // Borra las claves del Vector (en cualquier orden)
+        size_type removeKeys(const Vector<Key> &keys)
+        {
+            auto sorted = sortedKeys(keys);
+            return eraseByPresence(sorted.begin(), sorted.end(), [](const Key &key) -> const Key &
+                                   { return key; },
+                                   true);
+        }
+
+        // Cambios entre versiones
+
+        /**
+         * @brief Entries to add, change and remove to turn this map into other
+         *
+         * Both maps are walked once in key order, so the cost is O(n + m) and the lists
+         * of the delta come out sorted. Values are compared with operator==.
+         *
+         * @param other Newer version of the map
+         * @return Delta such that `copy.applyDelta(diff(other))` makes a copy of this map equal to other
+         */
+        template <typename OtherAllocator>
+        MapDelta<Key, Value> diff(const Map<Key, Value, Compare, OtherAllocator> &other) const
+            requires std::equality_comparable<Value>
+        {
+            MapDelta<Key, Value> delta;
+            auto comp = data.key_comp();
+            auto a = data.begin();
+            auto b = other.data.begin();
+            while (a != data.end() || b != other.data.end())
+            {
+                if (b == other.data.end() || (a != data.end() && comp(a->first, b->first)))
+                {
+                    delta.removed.pushBack(a->first);
+                    ++a;
+                }
+                else if (a == data.end() || comp(b->first, a->first))
+                {
+                    delta.added.emplaceBack(b->first, b->second);
+                    ++b;
+                }
+                else
+                {
+                    if (!(a->second == b->second))
+                    {
+                        delta.changed.emplaceBack(b->first, b->second);
+                    }
+                    ++a;
+                    ++b;
+                }
+            }
+            return delta;
+        }
+
+        /**
+         * @brief Applies a delta from diff() or checkpoint()
+         *
+         * Removed keys are erased, added and changed entries are inserted or assigned
+         * (so applying the same delta twice is harmless). Each sorted list is applied
+         * in one pass that starts every search a few steps from the previous position,
+         * so a delta of d entries costs about O(d) plus one O(log n) descent per jump.
+         * Unsorted lists are still applied correctly, only slower.
+         */
+        void applyDelta(const MapDelta<Key, Value> &delta)
+        {
+            applyDeltaImpl(delta, [](const std::pair<Key, Value> &pair) -> const Value &
+                           { return pair.second; });
+        }
+
+        // Igual, pero mueve los valores del delta
+        void applyDelta(MapDelta<Key, Value> &&delta)
+        {
+            applyDeltaImpl(delta, [](std::pair<Key, Value> &pair) -> Value &&
+                           { return std::move(pair.second); });
+        }
+
+        /**
+         * @brief Starts a mutation journal: checkpoint() then returns the changes in O(changes)
+         *
+         * While enabled, every modifier of the map notes the key it touches (and whether
+         * it existed at the last checkpoint) in a side tree, at O(log c) per change for c
+         * changed keys. Operations that replace the whole contents (assignment, swap,
+         * clear, getStdMap()) make the next delta a full reset instead. Values modified
+         * in place through iterators, find() or the views are not seen: report them
+         * with markChanged(). Keys reached with operator[] or at() are noted as changed
+         * even if the value is only read. Copies of the map do not inherit the journal.
+         *
+         * @example
+         * ```cpp
+         * sessions.enableJournal();
+         * sessions["alice"] = session;
+         * sessions.erase("bob");
+         * replica.applyDelta(sessions.checkpoint()); // 2 changes, not the whole map
+         * ```
+         */
+        void enableJournal()
+        {
+            Tracking &state = getTracking();
+            if (!state.journal)
+            {
+                state.journal.emplace(data.key_comp());
+            }
+        }
+
+        void disableJournal() noexcept
+        {
+            if (tracking)
+            {
+                tracking->journal.reset();
+            }
+        }
+
+        bool isJournalEnabled() const noexcept
+        {
+            return getJournal() != nullptr;
+        }
+
+        // Claves anotadas desde el último checkpoint
+        size_type getJournalSize() const noexcept
+        {
+            const Journal *journal = getJournal();
+            return journal ? journal->touched.size() : 0;
+        }
+
+        // Anota un valor modificado sin pasar por el mapa (iteradores, find(), vistas)
+        void markChanged(const key_type &key)
+        {
+            if (getJournal() && data.contains(key))
+            {
+                journalKey(key, true);
+            }
+        }
+
+        /**
+         * @brief Returns the changes since the previous checkpoint and starts a new one
+         *
+         * Looks up each noted key once, in key order, to classify it as added, changed
+         * or removed; keys added and erased again in between are dropped.
+         *
+         * @throws std::logic_error If the journal is not enabled
+         */
+        MapDelta<Key, Value> checkpoint()
+        {
+            Journal *journal = getJournal();
+            if (!journal)
+            {
+                throw std::logic_error("Map::checkpoint: journal not enabled");
+            }
+            MapDelta<Key, Value> delta;
+            if (journal->reset)
+            {
+                delta.reset = true;
+                delta.added.reserve(data.size());
+                for (const auto &pair : data)
+                {
+                    delta.added.emplaceBack(pair.first, pair.second);
+                }
+            }
+            else
+            {
+                auto comp = data.key_comp();
+                auto it = data.begin();
+                for (const auto &[key, existed] : journal->touched)
+                {
+                    it = seekFrom(it, key);
+                    if (it != data.end() && !comp(key, it->first))
+                    {
+                        (existed ? delta.changed : delta.added).emplaceBack(it->first, it->second);
+                    }
+                    else if (existed)
+                    {
+                        delta.removed.pushBack(key);
+                    }
+                }
+            }
+            journal->touched.clear();
+            journal->reset = false;
+            return delta;
+        }
+
+        /**
+         * @brief Combines many maps with a k-way heap merge in O(N log k)
+         *
+         * When several maps contain the same key, the value of the map that comes first
+         * wins, as with repeated merge() calls. The result uses the comparator of the
+         * first map.
+         *
+         * @param maps Maps to combine
+         * @return Union of all the maps
+         *
+         * @example
+         * ```cpp
+         * cpp_ex::Vector<cpp_ex::Map<std::string, int>> partials = computePartials();
+         * auto combined = cpp_ex::Map<std::string, int>::mergeAll(partials);
+         * ```
+         */
+        static Map mergeAll(const Vector<Map> &maps)
+        {
+            std::vector<const std::map<Key, Value, Compare, Allocator> *> sources;
+            sources.reserve(maps.getSize());
+            for (const auto &map : maps)
+            {
+                sources.push_back(&map.data);
+            }
+            return mergeAllImpl(sources);
+        }
+
+        static Map mergeAll(std::initializer_list<std::reference_wrapper<const Map>> maps)
+        {
+            std::vector<const std::map<Key, Value, Compare, Allocator> *> sources;
+            sources.reserve(maps.size());
+            for (const auto &map : maps)
+            {
+                sources.push_back(&map.get().data);
+            }
+            return mergeAllImpl(sources);
+        }
+
+    private:
+        // Lotes más pequeños se buscan uno a uno: ordenar no compensa
+        static constexpr size_type kSortedLookupThreshold = 8;
+
+        // Pasos hacia delante desde el resultado anterior antes de volver a descender
+        static constexpr size_type kSortedLookupSteps = 4;
+
+        // Llama a func(i, find(keys[i])) recorriendo las claves en orden
+        template <typename Tree, typename Func>
+        static void lookupMany(Tree &tree, const Vector<Key> &keys, Func func)
+        {
+            size_type n = keys.getSize();
+            if (n < kSortedLookupThreshold)
+            {
+                for (size_type i = 0; i < n; ++i)
+                {
+                    func(i, tree.find(keys[i]));
+                }
+                return;
+            }
+
+            auto comp = tree.key_comp();
+            Vector<size_type> order(n);
+            std::iota(order.begin(), order.end(), size_type{0});
+            std::sort(order.begin(), order.end(), [&](size_type a, size_type b)
+                      { return comp(keys[a], keys[b]); });
+
+            // it es el lowerBound de la clave anterior, nunca mayor que el de la actual
+            auto it = tree.begin();
+            for (size_type index : order)
+            {
+                const Key &key = keys[index];
+                for (size_type step = 0; step < kSortedLookupSteps && it != tree.end() && comp(it->first, key); ++step)
+                {
+                    ++it;
+                }
+                if (it != tree.end() && comp(it->first, key))
+                {
+                    it = tree.lower_bound(key);
+                }
+                func(index, it != tree.end() && !comp(key, it->first) ? it : tree.end());
+            }
+        }
+
+        /**
+         * @brief Boundaries of the contiguous ranges that the parallel walks split the tree into
+         *
+         * Range i is [bounds[i], bounds[i + 1]). When the key snapshot is current its
+         * keys give the pivots, found with one lower_bound() each; otherwise one pass
+         * of iterator increments places them (no key or value is touched).
+         */
+        template <typename Tree>
+        auto splitRanges(Tree &tree, size_type threads) const
+        {
+            size_type n = tree.size();
+            size_type parts = detail::parallelParts(n, threads);
+            std::vector<decltype(tree.begin())> bounds;
+            bounds.reserve(parts + 1);
+            bounds.push_back(tree.begin());
+            bool pivots = tracking && tracking->hasKeys && tracking->keysVersion == tracking->version;
+            auto it = tree.begin();
+            for (size_type part = 1; part < parts; ++part)
+            {
+                size_type first = detail::partBegin(n, parts, part);
+                if (pivots)
+                {
+                    it = tree.lower_bound(tracking->keys[first]);
+                }
+                else
+                {
+                    std::advance(it, first - detail::partBegin(n, parts, part - 1));
+                }
+                bounds.push_back(it);
+            }
+            bounds.push_back(tree.end());
+            return bounds;
+        }
+
+        // Añade al final un rango ya ordenado y mayor que todo lo existente
+        template <typename InputIt>
+        void appendRange(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+            {
+                data.emplace_hint(data.end(), *first);
+            }
+        }
+
+        template <typename Source, typename Project>
+        size_type mergeIntoImpl(Source &source, Project project)
+        {
+            auto comp = data.key_comp();
+            size_type inserted = 0;
+            auto a = data.begin();
+            for (auto &pair : source)
+            {
+                while (a != data.end() && comp(a->first, pair.first))
+                {
+                    ++a;
+                }
+                if (a == data.end() || comp(pair.first, a->first))
+                {
+                    // a es el sucesor: hint exacto, inserción O(1) amortizada
+                    journalKey(pair.first, false);
+                    data.emplace_hint(a, project(pair));
+                    ++inserted;
+                    bumpVersion();
+                }
+            }
+            return inserted;
+        }
+
+        // Recorre ambos rangos ordenados y borra las claves presentes (o ausentes) en el otro
+        template <typename InputIt, typename KeyOf>
+        size_type eraseByPresence(InputIt first, InputIt last, KeyOf keyOf, bool eraseIfPresent)
+        {
+            auto comp = data.key_comp();
+            size_type erased = 0;
+            for (auto a = data.begin(); a != data.end();)
+            {
+                while (first != last && comp(keyOf(*first), a->first))
+                {
+                    ++first;
+                }
+                bool present = first != last && !comp(a->first, keyOf(*first));
+                if (present == eraseIfPresent)
+                {
+                    journalKey(a->first, true);
+                    a = data.erase(a);
+                    ++erased;
+                    bumpVersion();
+                }
+                else
+                {
+                    ++a;
+                }
+            }
+            return erased;
+        }
+
+        std::vector<Key> sortedKeys(const Vector<Key> &keys) const
+        {
+            std::vector<Key> sorted(keys.begin(), keys.end());
+            std::sort(sorted.begin(), sorted.end(), data.key_comp());
+            return sorted;
+        }
+
+        // lowerBound(key) dando antes unos pasos desde it: O(1) si las claves llegan en orden
+        iterator seekFrom(iterator it, const Key &key)
+        {
+            auto comp = data.key_comp();
+            if (it != data.begin() && !comp(std::prev(it)->first, key))
+            {
+                return data.lower_bound(key); // Clave fuera de orden
+            }
+            for (size_type step = 0; step < kSortedLookupSteps && it != data.end() && comp(it->first, key); ++step)
+            {
+                ++it;
+            }
+            if (it != data.end() && comp(it->first, key))
+            {
+                it = data.lower_bound(key);
+            }
+            return it;
+        }
+
+        template <typename Delta, typename Project>
+        void applyDeltaImpl(Delta &delta, Project valueOf)
+        {
+            if (delta.reset)
+            {
+                clear();
+            }
+            auto comp = data.key_comp();
+            auto it = data.begin();
+            for (const auto &key : delta.removed)
+            {
+                it = seekFrom(it, key);
+                if (it != data.end() && !comp(key, it->first))
+                {
+                    journalKey(it->first, true);
+                    it = data.erase(it);
+                    bumpVersion();
+                }
+            }
+            upsertSorted(delta.changed, valueOf);
+            upsertSorted(delta.added, valueOf);
+        }
+
+        // Inserta o asigna cada entrada usando la posición de la anterior como punto de partida
+        template <typename Entries, typename Project>
+        void upsertSorted(Entries &entries, Project valueOf)
+        {
+            auto comp = data.key_comp();
+            auto it = data.begin();
+            for (auto &pair : entries)
+            {
+                it = seekFrom(it, pair.first);
+                if (it != data.end() && !comp(pair.first, it->first))
+                {
+                    journalKey(it->first, true);
+                    it->second = valueOf(pair);
+                }
+                else
+                {
+                    journalKey(pair.first, false);
+                    it = data.emplace_hint(it, pair.first, valueOf(pair));
+                    bumpVersion();
+                }
+            }
+        }
+
+        // Anota en el diario que key cambia; existed: si estaba en el mapa antes del cambio
+        void journalKey(const Key &key, bool existed)
+        {
+            Journal *journal = getJournal();
+            if (journal && !journal->reset)
+            {
+                journal->touched.try_emplace(key, existed);
+            }
+        }
+
+        Journal *getJournal() const noexcept
+        {
+            return tracking && tracking->journal ? &*tracking->journal : nullptr;
+        }
+
+        Tracking &getTracking() const
+        {
+            if (!tracking)
+            {
+                tracking = std::make_unique<Tracking>();
+            }
+            return *tracking;
+        }
+
+        void bumpVersion(std::uint64_t changes = 1) noexcept
+        {
+            if (tracking)
+            {
+                tracking->version += changes;
+            }
+        }
+
+        // Cuenta (versión y diario) una inserción que puede no haber ocurrido
+        std::pair<iterator, bool> recordInserted(std::pair<iterator, bool> result)
+        {
+            if (result.second)
+            {
+                bumpVersion();
+                journalKey(result.first->first, false);
+            }
+            return result;
+        }
+
+        // Inserción con hint: solo cuenta si el mapa creció desde before entradas
+        iterator recordInserted(iterator it, size_type before)
+        {
+            if (data.size() != before)
+            {
+                bumpVersion();
+                journalKey(it->first, false);
+            }
+            return it;
+        }
+
+        template <typename It>
+        void journalErased(It first, It last)
+        {
+            for (; getJournal() && first != last; ++first)
+            {
+                journalKey(first->first, true);
+            }
+        }
+
+        // El contenido cambió entero: el próximo checkpoint() devolverá el mapa completo
+        void journalReset() noexcept
+        {
+            if (Journal *journal = getJournal())
+            {
+                journal->touched.clear();
+                journal->reset = true;
+            }
+        }
+
+        static Map mergeAllImpl(const std::vector<const std::map<Key, Value, Compare, Allocator> *> &sources)
+        {
+            using SourceIterator = typename std::map<Key, Value, Compare, Allocator>::const_iterator;
+            struct Cursor
+            {
+                SourceIterator current;
+                SourceIterator end;
+                std::size_t source;
+            };
+
+            Map result(sources.empty() ? Compare() : sources.front()->key_comp());
+            auto comp = result.data.key_comp();
+            // Min-heap por clave; con claves iguales sale primero el mapa de menor índice
+            auto later = [&comp](const Cursor &x, const Cursor &y)
+            {
+                if (comp(x.current->first, y.current->first))
+                {
+                    return false;
+                }
+                if (comp(y.current->first, x.current->first))
+                {
+                    return true;
+                }
+                return x.source > y.source;
+            };
+
+            std::vector<Cursor> heap;
+            heap.reserve(sources.size());
+            for (std::size_t i = 0; i < sources.size(); ++i)
+            {
+                if (!sources[i]->empty())
+                {
+                    heap.push_back({sources[i]->begin(), sources[i]->end(), i});
+                }
+            }
+            std::make_heap(heap.begin(), heap.end(), later);
+
+            while (!heap.empty())
+            {
+                std::pop_heap(heap.begin(), heap.end(), later);
+                Cursor &cursor = heap.back();
+                if (result.data.empty() || comp(std::prev(result.data.end())->first, cursor.current->first))
+                {
+                    result.data.emplace_hint(result.data.end(), *cursor.current);
+                }
+                if (++cursor.current == cursor.end)
+                {
+                    heap.pop_back();
+                }
+                else
+                {
+                    std::push_heap(heap.begin(), heap.end(), later);
                 }
             }
             return result;
@@ -533,12 +1862,29 @@ namespace cpp_ex
     };
 
     // Funciones de utilidad fuera de la clase
-    template <typename Key, typename Value, typename Compare>
-    void swap(Map<Key, Value, Compare> &lhs, Map<Key, Value, Compare> &rhs)
+    template <typename Key, typename Value, typename Compare, typename Allocator>
+    void swap(Map<Key, Value, Compare, Allocator> &lhs, Map<Key, Value, Compare, Allocator> &rhs)
     {
         lhs.swap(rhs);
     }
 
+    /**
+     * @brief Map whose nodes come from a private slab pool instead of one malloc each
+     *
+     * Inserting and erasing reuse blocks of the pool, nodes inserted together are
+     * contiguous in memory, and destroying the map frees the pool pages in O(pages).
+     * Best for maps that are built, queried and dropped often (per request, per
+     * frame...). Copies get their own pool.
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::PooledMap<std::string, int> headers;
+     * headers["Content-Length"] = 42; // no malloc for the node once the page exists
+     * ```
+     */
+    template <typename Key, typename Value, typename Compare = std::less<Key>>
+    using PooledMap = Map<Key, Value, Compare, PoolAllocator<std::pair<const Key, Value>>>;
+
 } // namespace cppex
 
 #endif // CPPEX_MAP_HPP
@@ -0,0 +1,66 @@
+/**
+ * @file map_delta.hpp
+ * @brief Change set between two versions of a Map (see Map::diff and Map::applyDelta)
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_MAP_DELTA_HPP
+#define CPPEX_MAP_DELTA_HPP
+
+#include <cstddef>
+#include <utility>
+#include "vector.hpp" // Include Vector class
+
+namespace cpp_ex
+{
+
+    /**
+     * @brief Entries added, changed and removed between two versions of a map
+     *
+     * Produced by Map::diff() and Map::checkpoint(), consumed by Map::applyDelta().
+     * Every list is sorted by the comparator of the map that produced it, which lets
+     * applyDelta() walk the target once with hinted inserts and erases. With reset set,
+     * the target is emptied first and added holds its whole new contents.
+     *
+     * A Serializer is provided in serialization.hpp; it front-codes sorted string keys
+     * and stores sorted integer keys as varint gaps.
+     *
+     * @tparam Key Type of the keys
+     * @tparam Value Type of the mapped values
+     *
+     * @example
+     * ```cpp
+     * auto delta = before.diff(after);
+     * replica.applyDelta(delta); // replica == after if it was equal to before
+     * ```
+     */
+    template <typename Key, typename Value>
+    struct MapDelta
+    {
+        // Tipos (aliases)
+        using key_type = Key;
+        using mapped_type = Value;
+        using size_type = std::size_t;
+
+        Vector<std::pair<Key, Value>> added;   // Claves nuevas con su valor
+        Vector<std::pair<Key, Value>> changed; // Claves existentes con su valor nuevo
+        Vector<Key> removed;
+        bool reset = false; // El destino se vacía antes de aplicar el delta
+
+        bool isEmpty() const noexcept
+        {
+            return !reset && added.isEmpty() && changed.isEmpty() && removed.isEmpty();
+        }
+
+        size_type getChangeCount() const noexcept
+        {
+            return added.getSize() + changed.getSize() + removed.getSize();
+        }
+
+        bool operator==(const MapDelta &other) const = default;
+    };
+
+} // namespace cppex
+
+#endif // CPPEX_MAP_DELTA_HPP
@@ -0,0 +1,239 @@
+/**
+ * @file map_entry.hpp
+ * @brief Reference proxy for maps that do not store std::pair nodes
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_MAP_ENTRY_HPP
+#define CPPEX_MAP_ENTRY_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace cpp_ex
+{
+
+    /**
+     * @brief Pair-like reference to a key and its mapped value
+     *
+     * Containers that keep keys and values in separate storage (FlatMap, BTreeMap,
+     * SmallMap...) cannot hand out a `std::pair<const Key, Value>&`. Their iterators
+     * return this proxy instead, so `it->first`, `it->second` and structured bindings
+     * keep working like with cpp_ex::Map.
+     *
+     * @tparam Key Type of the key
+     * @tparam Value Type of the mapped value (const-qualified for const iterators)
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::FlatMap<int, std::string> map = {{1, "one"}};
+     * for (auto [key, value] : map) {
+     *     value += "!"; // modifies the element stored in the map
+     * }
+     * ```
+     */
+    template <typename Key, typename Value>
+    struct MapEntryRef
+    {
+        const Key &first;
+        Value &second;
+
+        MapEntryRef(const Key &key, Value &value) noexcept : first(key), second(value) {}
+
+        // Copia el par referenciado
+        operator std::pair<Key, std::remove_const_t<Value>>() const
+        {
+            return {first, second};
+        }
+
+        template <typename OtherValue>
+        bool operator==(const MapEntryRef<Key, OtherValue> &other) const
+        {
+            return first == other.first && second == other.second;
+        }
+
+        bool operator==(const std::pair<Key, std::remove_const_t<Value>> &other) const
+        {
+            return first == other.first && second == other.second;
+        }
+
+        // Soporte para structured bindings
+        template <std::size_t I>
+        decltype(auto) get() const noexcept
+        {
+            if constexpr (I == 0)
+            {
+                return (first);
+            }
+            else
+            {
+                return (second);
+            }
+        }
+    };
+
+    /**
+     * @brief Holder returned by `operator->` of proxy iterators
+     */
+    template <typename Reference>
+    struct MapEntryArrow
+    {
+        Reference ref;
+
+        Reference *operator->() noexcept
+        {
+            return &ref;
+        }
+    };
+
+    /**
+     * @brief Random-access iterator over a key column and a parallel value column
+     *
+     * Used by containers that keep keys and values in two contiguous arrays. Both
+     * pointers advance together; dereferencing yields a MapEntryRef.
+     *
+     * @tparam Key Type of the keys
+     * @tparam Value Type of the mapped values (const-qualified for const iterators)
+     */
+    template <typename Key, typename Value>
+    class MapColumnIterator
+    {
+    private:
+        const Key *key = nullptr;
+        Value *value = nullptr;
+
+        template <typename K, typename V>
+        friend class MapColumnIterator;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::pair<Key, std::remove_const_t<Value>>;
+        using difference_type = std::ptrdiff_t;
+        using reference = MapEntryRef<Key, Value>;
+        using pointer = MapEntryArrow<reference>;
+
+        MapColumnIterator() = default;
+
+        MapColumnIterator(const Key *k, Value *v) noexcept : key(k), value(v) {}
+
+        // Conversión de iterator a const_iterator
+        template <typename OtherValue, typename = std::enable_if_t<std::is_same_v<const OtherValue, Value> && !std::is_same_v<OtherValue, Value>>>
+        MapColumnIterator(const MapColumnIterator<Key, OtherValue> &other) noexcept : key(other.key), value(other.value) {}
+
+        const Key *keyPointer() const noexcept
+        {
+            return key;
+        }
+
+        reference operator*() const noexcept
+        {
+            return reference(*key, *value);
+        }
+
+        pointer operator->() const noexcept
+        {
+            return pointer{reference(*key, *value)};
+        }
+
+        reference operator[](difference_type n) const noexcept
+        {
+            return reference(key[n], value[n]);
+        }
+
+        MapColumnIterator &operator++() noexcept
+        {
+            ++key;
+            ++value;
+            return *this;
+        }
+
+        MapColumnIterator operator++(int) noexcept
+        {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        MapColumnIterator &operator--() noexcept
+        {
+            --key;
+            --value;
+            return *this;
+        }
+
+        MapColumnIterator operator--(int) noexcept
+        {
+            auto tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        MapColumnIterator &operator+=(difference_type n) noexcept
+        {
+            key += n;
+            value += n;
+            return *this;
+        }
+
+        MapColumnIterator &operator-=(difference_type n) noexcept
+        {
+            key -= n;
+            value -= n;
+            return *this;
+        }
+
+        friend MapColumnIterator operator+(MapColumnIterator it, difference_type n) noexcept
+        {
+            return it += n;
+        }
+
+        friend MapColumnIterator operator+(difference_type n, MapColumnIterator it) noexcept
+        {
+            return it += n;
+        }
+
+        friend MapColumnIterator operator-(MapColumnIterator it, difference_type n) noexcept
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const MapColumnIterator &a, const MapColumnIterator &b) noexcept
+        {
+            return a.key - b.key;
+        }
+
+        friend bool operator==(const MapColumnIterator &a, const MapColumnIterator &b) noexcept
+        {
+            return a.key == b.key;
+        }
+
+        friend auto operator<=>(const MapColumnIterator &a, const MapColumnIterator &b) noexcept
+        {
+            return a.key <=> b.key;
+        }
+    };
+
+} // namespace cppex
+
+template <typename Key, typename Value>
+struct std::tuple_size<cpp_ex::MapEntryRef<Key, Value>> : std::integral_constant<std::size_t, 2>
+{
+};
+
+template <typename Key, typename Value>
+struct std::tuple_element<0, cpp_ex::MapEntryRef<Key, Value>>
+{
+    using type = const Key &;
+};
+
+template <typename Key, typename Value>
+struct std::tuple_element<1, cpp_ex::MapEntryRef<Key, Value>>
+{
+    using type = Value &;
+};
+
+#endif // CPPEX_MAP_ENTRY_HPP
@@ -0,0 +1,301 @@
+/**
+ * @file map_view.hpp
+ * @brief Lazy, non-owning key/value/entry views over the cpp_ex maps
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_MAP_VIEW_HPP
+#define CPPEX_MAP_VIEW_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "vector.hpp"    // Include Vector class
+#include "map_entry.hpp" // Include MapEntryRef
+
+namespace cpp_ex
+{
+    namespace detail
+    {
+        // Proyecciones aplicadas a cada elemento del mapa (std::pair o MapEntryRef)
+        struct KeyProjection
+        {
+            template <typename Entry>
+            decltype(auto) operator()(Entry &&entry) const noexcept
+            {
+                return (entry.first);
+            }
+        };
+
+        struct ValueProjection
+        {
+            template <typename Entry>
+            decltype(auto) operator()(Entry &&entry) const noexcept
+            {
+                return (entry.second);
+            }
+        };
+
+        // Tipo de los elementos copiados: los pares se copian con la clave no const
+        template <typename T>
+        struct ViewValue
+        {
+            using type = T;
+        };
+
+        template <typename Key, typename Value>
+        struct ViewValue<std::pair<const Key, Value>>
+        {
+            using type = std::pair<Key, Value>;
+        };
+
+        template <typename Key, typename Value>
+        struct ViewValue<MapEntryRef<Key, Value>>
+        {
+            using type = std::pair<Key, std::remove_const_t<Value>>;
+        };
+
+        // Devuelve referencias a los pares y copia los proxies (MapEntryRef)
+        struct EntryProjection
+        {
+            template <typename Entry>
+            Entry operator()(Entry &&entry) const noexcept
+            {
+                return std::forward<Entry>(entry);
+            }
+        };
+    }
+
+    /**
+     * @brief Non-owning view that projects every entry of a map on the fly
+     *
+     * Returned by `Map::keysView()`, `valuesView()` and `entriesView()`. Nothing is
+     * copied: iterating a keys view yields `const Key&` straight from the map, and a
+     * values view of a non-const map yields `Value&`. The view always reflects the
+     * current contents of the map (it calls `begin()`/`end()` on every iteration), so
+     * it must not outlive the map.
+     *
+     * It offers the same algorithm vocabulary as Vector (`filter`, `map`, `reduce`,
+     * `countIf`, `forEach`, `contains`); the algorithms that produce a sequence return
+     * a Vector, and `toVector()` materializes the view.
+     *
+     * @tparam Container Map type (const-qualified for read-only views)
+     * @tparam Projection Function object applied to every entry
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::Map<cpp_ex::String, int> scores = {{"Alice", 95}, {"Bob", 87}};
+     *
+     * for (const auto &name : scores.keysView()) { ... }            // no copies
+     * int total = scores.valuesView().reduce(0, std::plus<int>());
+     * auto high = scores.valuesView().countIf([](int s) { return s >= 90; });
+     * ```
+     */
+    template <typename Container, typename Projection>
+    class MapView
+    {
+    private:
+        using base_iterator = decltype(std::declval<Container &>().begin());
+
+        Container *container;
+
+    public:
+        // Tipos (aliases)
+        using reference = decltype(std::declval<Projection>()(*std::declval<base_iterator>()));
+        using value_type = typename detail::ViewValue<std::remove_cvref_t<reference>>::type;
+        using size_type = std::size_t;
+
+        class iterator
+        {
+        private:
+            base_iterator current;
+
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = MapView::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = MapView::reference;
+            using pointer = std::conditional_t<std::is_reference_v<reference>, std::remove_reference_t<reference> *, void>;
+
+            iterator() = default;
+
+            explicit iterator(base_iterator it) : current(it) {}
+
+            reference operator*() const
+            {
+                return Projection()(*current);
+            }
+
+            pointer operator->() const
+                requires std::is_reference_v<reference>
+            {
+                return std::addressof(**this);
+            }
+
+            iterator &operator++()
+            {
+                ++current;
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                iterator tmp = *this;
+                ++current;
+                return tmp;
+            }
+
+            iterator &operator--()
+            {
+                --current;
+                return *this;
+            }
+
+            iterator operator--(int)
+            {
+                iterator tmp = *this;
+                --current;
+                return tmp;
+            }
+
+            friend bool operator==(const iterator &a, const iterator &b)
+            {
+                return a.current == b.current;
+            }
+
+            friend bool operator!=(const iterator &a, const iterator &b)
+            {
+                return !(a == b);
+            }
+        };
+
+        explicit MapView(Container &container) noexcept : container(&container) {}
+
+        // Iteradores
+        iterator begin() const
+        {
+            return iterator(container->begin());
+        }
+
+        iterator end() const
+        {
+            return iterator(container->end());
+        }
+
+        // Capacidad
+        bool isEmpty() const
+        {
+            return container->isEmpty();
+        }
+
+        size_type getSize() const
+        {
+            return container->getSize();
+        }
+
+        // Operaciones (mismo vocabulario que Vector)
+        bool contains(const value_type &value) const
+        {
+            for (auto &&element : *this)
+            {
+                if constexpr (requires { element.first; element.second; })
+                {
+                    if (element.first == value.first && element.second == value.second)
+                    {
+                        return true;
+                    }
+                }
+                else if (element == value)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        template <typename Predicate>
+        size_type countIf(Predicate pred) const
+        {
+            size_type count = 0;
+            for (auto &&element : *this)
+            {
+                if (pred(element))
+                {
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        template <typename UnaryFunc>
+        auto map(UnaryFunc func) const
+        {
+            Vector<std::remove_cvref_t<std::invoke_result_t<UnaryFunc &, reference>>> result;
+            result.reserve(getSize());
+            for (auto &&element : *this)
+            {
+                result.pushBack(func(element));
+            }
+            return result;
+        }
+
+        template <typename Predicate>
+        Vector<value_type> filter(Predicate pred) const
+        {
+            Vector<value_type> result;
+            for (auto &&element : *this)
+            {
+                if (pred(element))
+                {
+                    result.pushBack(element);
+                }
+            }
+            return result;
+        }
+
+        template <typename Accumulator, typename BinaryOp>
+        Accumulator reduce(Accumulator init, BinaryOp op) const
+        {
+            for (auto &&element : *this)
+            {
+                init = op(std::move(init), element);
+            }
+            return init;
+        }
+
+        template <typename UnaryFunc>
+        void forEach(UnaryFunc func) const
+        {
+            for (auto &&element : *this)
+            {
+                func(element);
+            }
+        }
+
+        // Copia los elementos (equivalente a getKeys()/getValues()/getEntries())
+        Vector<value_type> toVector() const
+        {
+            Vector<value_type> result;
+            result.reserve(getSize());
+            for (auto &&element : *this)
+            {
+                result.pushBack(element);
+            }
+            return result;
+        }
+    };
+
+    template <typename Container>
+    using KeysView = MapView<Container, detail::KeyProjection>;
+
+    template <typename Container>
+    using ValuesView = MapView<Container, detail::ValueProjection>;
+
+    template <typename Container>
+    using EntriesView = MapView<Container, detail::EntryProjection>;
+
+} // namespace cppex
+
+#endif // CPPEX_MAP_VIEW_HPP
@@ -0,0 +1,941 @@
+/**
+ * @file order_statistic_map.hpp
+ * @brief Ordered map with O(log n) rank, select-by-index, range counts and percentiles
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_ORDER_STATISTIC_MAP_HPP
+#define CPPEX_ORDER_STATISTIC_MAP_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "common.hpp" // Include detail::IsTransparent
+
+namespace cpp_ex
+{
+
+    /**
+     * @brief Ordered map that also knows the position of every key
+     *
+     * A treap (randomized balanced binary search tree) in which every node stores the
+     * size of its subtree. Besides the usual ordered API of Map (bidirectional
+     * iteration in key order, find, lowerBound, upperBound...), that size answers in
+     * expected O(log n):
+     * - `rankOf(key)`: how many keys are smaller than key (its index if present)
+     * - `atIndex(i)` / `findByIndex(i)`: the i-th entry in key order
+     * - `indexOf(it)`: the index of the entry an iterator points to
+     * - `countInRange(from, to)`: how many keys are in `[from, to)`
+     * - `percentile(p)`: the entry at the p-th percentile (nearest rank)
+     *
+     * With std::map the same questions need `std::distance` / `std::next`, which walk
+     * the tree entry by entry in O(n).
+     *
+     * Entries are `std::pair<const Key, Value>` and are never moved once inserted, so
+     * iterators and references stay valid until their entry is erased.
+     *
+     * @tparam Key Type of the keys
+     * @tparam Value Type of the mapped values
+     * @tparam Compare Comparison function object type, defaults to std::less<Key>
+     *
+     * @example
+     * ```cpp
+     * // Leaderboard: (score, player) in descending score order
+     * cpp_ex::OrderStatisticMap<std::pair<int, std::string>, Player, std::greater<>> board;
+     * board.insert({{1200, "ana"}, ana});
+     *
+     * auto position = board.rankOf({1200, "ana"}) + 1; // 1-based rank
+     * const auto &tenth = board.atIndex(9);
+     * auto median = board.percentile(50).first;
+     * ```
+     */
+    template <typename Key, typename Value, typename Compare = std::less<Key>>
+    class OrderStatisticMap
+    {
+    public:
+        // Tipos (aliases)
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<const Key, Value>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using key_compare = Compare;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+
+    private:
+        struct Node
+        {
+            value_type entry;
+            Node *left = nullptr;
+            Node *right = nullptr;
+            Node *parent = nullptr;
+            size_type size = 1; // Nodos del subárbol, incluido este
+            std::uint32_t priority = 0;
+
+            template <typename... Args>
+            explicit Node(Args &&...args) : entry(std::forward<Args>(args)...) {}
+        };
+
+        Node *root = nullptr;
+        std::uint64_t seed = 0x9E3779B97F4A7C15ULL; // Estado del generador de prioridades
+        [[no_unique_address]] Compare comp;
+
+        template <bool IsConst>
+        class Iterator
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = std::pair<const Key, Value>;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<IsConst, const value_type &, value_type &>;
+            using pointer = std::conditional_t<IsConst, const value_type *, value_type *>;
+
+        private:
+            friend class OrderStatisticMap;
+
+            Node *node = nullptr; // nullptr es end()
+            const OrderStatisticMap *tree = nullptr;
+
+            Iterator(Node *n, const OrderStatisticMap *t) noexcept : node(n), tree(t) {}
+
+        public:
+            Iterator() = default;
+
+            // Conversión de iterator a const_iterator
+            template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+            Iterator(const Iterator<OtherConst> &other) noexcept : node(other.node), tree(other.tree) {}
+
+            reference operator*() const noexcept
+            {
+                return node->entry;
+            }
+
+            pointer operator->() const noexcept
+            {
+                return &node->entry;
+            }
+
+            Iterator &operator++() noexcept
+            {
+                node = successor(node);
+                return *this;
+            }
+
+            Iterator operator++(int) noexcept
+            {
+                Iterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            Iterator &operator--() noexcept
+            {
+                node = node == nullptr ? rightmost(tree->root) : predecessor(node);
+                return *this;
+            }
+
+            Iterator operator--(int) noexcept
+            {
+                Iterator tmp = *this;
+                --(*this);
+                return tmp;
+            }
+
+            friend bool operator==(const Iterator &a, const Iterator &b) noexcept
+            {
+                return a.node == b.node;
+            }
+
+            friend bool operator!=(const Iterator &a, const Iterator &b) noexcept
+            {
+                return !(a == b);
+            }
+
+            template <bool B>
+            friend class Iterator;
+        };
+
+    public:
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        // Constructores
+        OrderStatisticMap() = default;
+
+        explicit OrderStatisticMap(const Compare &comp) : comp(comp) {}
+
+        template <typename InputIt>
+        OrderStatisticMap(InputIt first, InputIt last, const Compare &comp = Compare()) : comp(comp)
+        {
+            insert(first, last);
+        }
+
+        OrderStatisticMap(std::initializer_list<value_type> init, const Compare &comp = Compare())
+            : OrderStatisticMap(init.begin(), init.end(), comp) {}
+
+        OrderStatisticMap(const OrderStatisticMap &other) : seed(other.seed), comp(other.comp)
+        {
+            root = clone(other.root, nullptr);
+        }
+
+        OrderStatisticMap(OrderStatisticMap &&other) noexcept
+            : root(std::exchange(other.root, nullptr)), seed(other.seed), comp(std::move(other.comp)) {}
+
+        ~OrderStatisticMap()
+        {
+            destroy(root);
+        }
+
+        // Operadores de asignación
+        OrderStatisticMap &operator=(const OrderStatisticMap &other)
+        {
+            if (this != &other)
+            {
+                OrderStatisticMap tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        OrderStatisticMap &operator=(OrderStatisticMap &&other) noexcept
+        {
+            if (this != &other)
+            {
+                destroy(root);
+                root = std::exchange(other.root, nullptr);
+                seed = other.seed;
+                comp = std::move(other.comp);
+            }
+            return *this;
+        }
+
+        // Iteradores
+        iterator begin() noexcept
+        {
+            return iterator(leftmost(root), this);
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return const_iterator(leftmost(root), this);
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        iterator end() noexcept
+        {
+            return iterator(nullptr, this);
+        }
+
+        const_iterator end() const noexcept
+        {
+            return const_iterator(nullptr, this);
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        // Capacidad
+        bool isEmpty() const noexcept
+        {
+            return root == nullptr;
+        }
+
+        size_type getSize() const noexcept
+        {
+            return sizeOf(root);
+        }
+
+        // Acceso a elementos
+        mapped_type &at(const key_type &key)
+        {
+            return const_cast<mapped_type &>(std::as_const(*this).at(key));
+        }
+
+        const mapped_type &at(const key_type &key) const
+        {
+            Node *node = findNode(key);
+            if (node == nullptr)
+            {
+                throw std::out_of_range("OrderStatisticMap::at: key not found");
+            }
+            return node->entry.second;
+        }
+
+        mapped_type &operator[](const key_type &key)
+        {
+            return tryEmplace(key).first->second;
+        }
+
+        mapped_type &operator[](key_type &&key)
+        {
+            return tryEmplace(std::move(key)).first->second;
+        }
+
+        // Modificadores
+        void clear() noexcept
+        {
+            destroy(root);
+            root = nullptr;
+        }
+
+        std::pair<iterator, bool> insert(const value_type &value)
+        {
+            return tryEmplace(value.first, value.second);
+        }
+
+        std::pair<iterator, bool> insert(value_type &&value)
+        {
+            return insertNode(std::make_unique<Node>(std::move(value)));
+        }
+
+        template <typename InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+            {
+                insert(*first);
+            }
+        }
+
+        void insert(std::initializer_list<value_type> ilist)
+        {
+            insert(ilist.begin(), ilist.end());
+        }
+
+        template <typename... Args>
+        std::pair<iterator, bool> emplace(Args &&...args)
+        {
+            return insertNode(std::make_unique<Node>(std::forward<Args>(args)...));
+        }
+
+        // Construye el valor sólo si la clave no existe
+        template <typename K, typename... Args>
+        std::pair<iterator, bool> tryEmplace(K &&key, Args &&...args)
+        {
+            Node *parent = nullptr;
+            Node **link = &root;
+            while (*link != nullptr)
+            {
+                parent = *link;
+                if (comp(key, parent->entry.first))
+                {
+                    link = &parent->left;
+                }
+                else if (comp(parent->entry.first, key))
+                {
+                    link = &parent->right;
+                }
+                else
+                {
+                    return {iterator(parent, this), false};
+                }
+            }
+            Node *node = new Node(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                                  std::forward_as_tuple(std::forward<Args>(args)...));
+            attach(node, parent, link);
+            return {iterator(node, this), true};
+        }
+
+        template <typename K, typename V>
+        std::pair<iterator, bool> insertOrAssign(K &&key, V &&value)
+        {
+            auto result = tryEmplace(std::forward<K>(key), std::forward<V>(value));
+            if (!result.second)
+            {
+                result.first->second = std::forward<V>(value);
+            }
+            return result;
+        }
+
+        // Devuelve el iterador al siguiente elemento
+        iterator erase(const_iterator pos)
+        {
+            Node *next = successor(pos.node);
+            eraseNode(pos.node);
+            return iterator(next, this);
+        }
+
+        size_type erase(const key_type &key)
+        {
+            Node *node = findNode(key);
+            if (node == nullptr)
+            {
+                return 0;
+            }
+            eraseNode(node);
+            return 1;
+        }
+
+        void swap(OrderStatisticMap &other) noexcept
+        {
+            std::swap(root, other.root);
+            std::swap(seed, other.seed);
+            std::swap(comp, other.comp);
+        }
+
+        // Lookup
+        iterator find(const key_type &key)
+        {
+            return iterator(findNode(key), this);
+        }
+
+        const_iterator find(const key_type &key) const
+        {
+            return const_iterator(findNode(key), this);
+        }
+
+        bool contains(const key_type &key) const
+        {
+            return findNode(key) != nullptr;
+        }
+
+        size_type count(const key_type &key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        iterator lowerBound(const key_type &key)
+        {
+            return iterator(lowerBoundNode(key), this);
+        }
+
+        const_iterator lowerBound(const key_type &key) const
+        {
+            return const_iterator(lowerBoundNode(key), this);
+        }
+
+        iterator upperBound(const key_type &key)
+        {
+            return iterator(upperBoundNode(key), this);
+        }
+
+        const_iterator upperBound(const key_type &key) const
+        {
+            return const_iterator(upperBoundNode(key), this);
+        }
+
+        std::pair<iterator, iterator> equalRange(const key_type &key)
+        {
+            return {lowerBound(key), upperBound(key)};
+        }
+
+        std::pair<const_iterator, const_iterator> equalRange(const key_type &key) const
+        {
+            return {lowerBound(key), upperBound(key)};
+        }
+
+        // Overloads heterogéneos (sólo con comparadores transparentes, como en Map)
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        iterator find(const K &key)
+        {
+            return iterator(findNode(key), this);
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        const_iterator find(const K &key) const
+        {
+            return const_iterator(findNode(key), this);
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        bool contains(const K &key) const
+        {
+            return findNode(key) != nullptr;
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        const_iterator lowerBound(const K &key) const
+        {
+            return const_iterator(lowerBoundNode(key), this);
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        const_iterator upperBound(const K &key) const
+        {
+            return const_iterator(upperBoundNode(key), this);
+        }
+
+        // Estadísticos de orden
+        /**
+         * @brief Number of keys strictly smaller than key (its index when present)
+         */
+        size_type rankOf(const key_type &key) const
+        {
+            return rankOfImpl(key);
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        size_type rankOf(const K &key) const
+        {
+            return rankOfImpl(key);
+        }
+
+        /**
+         * @brief Index in key order of the entry pos points to (getSize() for end())
+         */
+        size_type indexOf(const_iterator pos) const noexcept
+        {
+            Node *node = pos.node;
+            if (node == nullptr)
+            {
+                return getSize();
+            }
+            size_type index = sizeOf(node->left);
+            for (; node->parent != nullptr; node = node->parent)
+            {
+                if (node == node->parent->right)
+                {
+                    index += sizeOf(node->parent->left) + 1;
+                }
+            }
+            return index;
+        }
+
+        // i-ésima entrada en orden de clave, o end() si i >= getSize()
+        iterator findByIndex(size_type index)
+        {
+            return iterator(selectNode(index), this);
+        }
+
+        const_iterator findByIndex(size_type index) const
+        {
+            return const_iterator(selectNode(index), this);
+        }
+
+        reference atIndex(size_type index)
+        {
+            return const_cast<reference>(std::as_const(*this).atIndex(index));
+        }
+
+        const_reference atIndex(size_type index) const
+        {
+            Node *node = selectNode(index);
+            if (node == nullptr)
+            {
+                throw std::out_of_range("OrderStatisticMap::atIndex: index out of range");
+            }
+            return node->entry;
+        }
+
+        /**
+         * @brief Number of keys in the half-open range [from, to)
+         */
+        size_type countInRange(const key_type &from, const key_type &to) const
+        {
+            if (!comp(from, to))
+            {
+                return 0;
+            }
+            return rankOf(to) - rankOf(from);
+        }
+
+        /**
+         * @brief Entry at the p-th percentile by the nearest-rank method, p in [0, 100]
+         *
+         * `percentile(50)` is the (lower) median, `percentile(0)` the first entry and
+         * `percentile(100)` the last one.
+         *
+         * @throws std::out_of_range if the map is empty or p is outside [0, 100]
+         */
+        const_reference percentile(double p) const
+        {
+            if (isEmpty() || !(p >= 0.0 && p <= 100.0))
+            {
+                throw std::out_of_range("OrderStatisticMap::percentile: empty map or p outside [0, 100]");
+            }
+            auto rank = static_cast<size_type>(std::ceil(p / 100.0 * static_cast<double>(getSize())));
+            return atIndex(rank == 0 ? 0 : std::min(rank, getSize()) - 1);
+        }
+
+        // Recorrido
+        template <typename BinaryFunc>
+        void forEach(BinaryFunc func) const
+        {
+            for (const auto &[key, value] : *this)
+            {
+                func(key, value);
+            }
+        }
+
+        // Observadores
+        key_compare keyComp() const
+        {
+            return comp;
+        }
+
+        // Comparación
+        bool operator==(const OrderStatisticMap &other) const
+        {
+            return getSize() == other.getSize() && std::equal(begin(), end(), other.begin());
+        }
+
+        bool operator!=(const OrderStatisticMap &other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        static size_type sizeOf(const Node *node) noexcept
+        {
+            return node == nullptr ? 0 : node->size;
+        }
+
+        static Node *leftmost(Node *node) noexcept
+        {
+            while (node != nullptr && node->left != nullptr)
+            {
+                node = node->left;
+            }
+            return node;
+        }
+
+        static Node *rightmost(Node *node) noexcept
+        {
+            while (node != nullptr && node->right != nullptr)
+            {
+                node = node->right;
+            }
+            return node;
+        }
+
+        static Node *successor(Node *node) noexcept
+        {
+            if (node->right != nullptr)
+            {
+                return leftmost(node->right);
+            }
+            while (node->parent != nullptr && node == node->parent->right)
+            {
+                node = node->parent;
+            }
+            return node->parent;
+        }
+
+        static Node *predecessor(Node *node) noexcept
+        {
+            if (node->left != nullptr)
+            {
+                return rightmost(node->left);
+            }
+            while (node->parent != nullptr && node == node->parent->left)
+            {
+                node = node->parent;
+            }
+            return node->parent;
+        }
+
+        std::uint32_t nextPriority() noexcept
+        {
+            // xorshift64*: otro generador que splitmix64, para que claves generadas con
+            // splitmix64 (muy habitual) no salgan correladas con sus prioridades
+            seed ^= seed >> 12;
+            seed ^= seed << 25;
+            seed ^= seed >> 27;
+            return static_cast<std::uint32_t>((seed * 0x2545F4914F6CDD1DULL) >> 32);
+        }
+
+        static void update(Node *node) noexcept
+        {
+            node->size = 1 + sizeOf(node->left) + sizeOf(node->right);
+        }
+
+        // Sube node un nivel por encima de su padre manteniendo el orden
+        void rotateUp(Node *node) noexcept
+        {
+            Node *parent = node->parent;
+            Node *grandparent = parent->parent;
+            if (node == parent->left)
+            {
+                parent->left = node->right;
+                if (node->right != nullptr)
+                {
+                    node->right->parent = parent;
+                }
+                node->right = parent;
+            }
+            else
+            {
+                parent->right = node->left;
+                if (node->left != nullptr)
+                {
+                    node->left->parent = parent;
+                }
+                node->left = parent;
+            }
+            parent->parent = node;
+            node->parent = grandparent;
+            if (grandparent == nullptr)
+            {
+                root = node;
+            }
+            else if (grandparent->left == parent)
+            {
+                grandparent->left = node;
+            }
+            else
+            {
+                grandparent->right = node;
+            }
+            update(parent);
+            update(node);
+        }
+
+        // Cuelga node como hoja en link y lo sube según su prioridad
+        void attach(Node *node, Node *parent, Node **link) noexcept
+        {
+            node->parent = parent;
+            node->priority = nextPriority();
+            *link = node;
+            for (Node *ancestor = parent; ancestor != nullptr; ancestor = ancestor->parent)
+            {
+                ++ancestor->size;
+            }
+            while (node->parent != nullptr && node->priority > node->parent->priority)
+            {
+                rotateUp(node);
+            }
+        }
+
+        std::pair<iterator, bool> insertNode(std::unique_ptr<Node> node)
+        {
+            Node *parent = nullptr;
+            Node **link = &root;
+            const Key &key = node->entry.first;
+            while (*link != nullptr)
+            {
+                parent = *link;
+                if (comp(key, parent->entry.first))
+                {
+                    link = &parent->left;
+                }
+                else if (comp(parent->entry.first, key))
+                {
+                    link = &parent->right;
+                }
+                else
+                {
+                    return {iterator(parent, this), false};
+                }
+            }
+            Node *raw = node.release();
+            attach(raw, parent, link);
+            return {iterator(raw, this), true};
+        }
+
+        // Baja el nodo rotando hasta que sea hoja y entonces lo suelta
+        void eraseNode(Node *node) noexcept
+        {
+            while (node->left != nullptr || node->right != nullptr)
+            {
+                bool useLeft = node->right == nullptr || (node->left != nullptr && node->left->priority > node->right->priority);
+                rotateUp(useLeft ? node->left : node->right);
+            }
+            Node *parent = node->parent;
+            if (parent == nullptr)
+            {
+                root = nullptr;
+            }
+            else if (parent->left == node)
+            {
+                parent->left = nullptr;
+            }
+            else
+            {
+                parent->right = nullptr;
+            }
+            for (Node *ancestor = parent; ancestor != nullptr; ancestor = ancestor->parent)
+            {
+                --ancestor->size;
+            }
+            delete node;
+        }
+
+        template <typename K>
+        Node *findNode(const K &key) const
+        {
+            Node *node = root;
+            while (node != nullptr)
+            {
+                if (comp(key, node->entry.first))
+                {
+                    node = node->left;
+                }
+                else if (comp(node->entry.first, key))
+                {
+                    node = node->right;
+                }
+                else
+                {
+                    return node;
+                }
+            }
+            return nullptr;
+        }
+
+        // Primer nodo con clave >= key
+        template <typename K>
+        Node *lowerBoundNode(const K &key) const
+        {
+            Node *node = root;
+            Node *result = nullptr;
+            while (node != nullptr)
+            {
+                if (comp(node->entry.first, key))
+                {
+                    node = node->right;
+                }
+                else
+                {
+                    result = node;
+                    node = node->left;
+                }
+            }
+            return result;
+        }
+
+        // Primer nodo con clave > key
+        template <typename K>
+        Node *upperBoundNode(const K &key) const
+        {
+            Node *node = root;
+            Node *result = nullptr;
+            while (node != nullptr)
+            {
+                if (comp(key, node->entry.first))
+                {
+                    result = node;
+                    node = node->left;
+                }
+                else
+                {
+                    node = node->right;
+                }
+            }
+            return result;
+        }
+
+        template <typename K>
+        size_type rankOfImpl(const K &key) const
+        {
+            size_type rank = 0;
+            Node *node = root;
+            while (node != nullptr)
+            {
+                if (comp(node->entry.first, key))
+                {
+                    rank += sizeOf(node->left) + 1;
+                    node = node->right;
+                }
+                else
+                {
+                    node = node->left;
+                }
+            }
+            return rank;
+        }
+
+        Node *selectNode(size_type index) const noexcept
+        {
+            Node *node = root;
+            while (node != nullptr)
+            {
+                size_type leftSize = sizeOf(node->left);
+                if (index < leftSize)
+                {
+                    node = node->left;
+                }
+                else if (index == leftSize)
+                {
+                    return node;
+                }
+                else
+                {
+                    index -= leftSize + 1;
+                    node = node->right;
+                }
+            }
+            return nullptr;
+        }
+
+        static Node *clone(const Node *node, Node *parent)
+        {
+            if (node == nullptr)
+            {
+                return nullptr;
+            }
+            auto copy = std::make_unique<Node>(node->entry);
+            copy->parent = parent;
+            copy->size = node->size;
+            copy->priority = node->priority;
+            try
+            {
+                copy->left = clone(node->left, copy.get());
+                copy->right = clone(node->right, copy.get());
+            }
+            catch (...)
+            {
+                destroy(copy->left);
+                throw;
+            }
+            return copy.release();
+        }
+
+        static void destroy(Node *node) noexcept
+        {
+            if (node != nullptr)
+            {
+                destroy(node->left);
+                destroy(node->right);
+                delete node;
+            }
+        }
+    };
+
+} // namespace cppex
+
+#endif // CPPEX_ORDER_STATISTIC_MAP_HPP
@@ -0,0 +1,112 @@
+/**
+ * @file parallel.hpp
+ * @brief Fork/join helpers for the parallel walks of the cpp_ex maps
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_PARALLEL_HPP
+#define CPPEX_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace cpp_ex
+{
+    namespace detail
+    {
+        // Entradas mínimas por parte cuando el número de hilos se elige automáticamente
+        constexpr std::size_t kParallelGrain = 4096;
+
+        /**
+         * @brief Number of parts a walk over items entries is split into
+         *
+         * threads == 0 picks one part per hardware thread, but never less than
+         * kParallelGrain entries per part (small maps stay sequential). An explicit
+         * thread count is honoured up to one entry per part.
+         */
+        inline std::size_t parallelParts(std::size_t items, std::size_t threads)
+        {
+            if (threads == 0)
+            {
+                threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+                threads = std::min(threads, std::max<std::size_t>(items / kParallelGrain, 1));
+            }
+            return std::max<std::size_t>(std::min(threads, items), 1);
+        }
+
+        // Primer índice de la parte part al dividir [0, items) en parts trozos casi iguales
+        constexpr std::size_t partBegin(std::size_t items, std::size_t parts, std::size_t part) noexcept
+        {
+            return items / parts * part + std::min(part, items % parts);
+        }
+
+        /**
+         * @brief Calls func(part) for every part in [0, parts), each on its own thread
+         *
+         * Part 0 runs on the calling thread. All threads are joined before returning;
+         * if any call throws, the exception of the lowest part is rethrown afterwards.
+         */
+        template <typename Func>
+        void parallelFor(std::size_t parts, Func func)
+        {
+            if (parts <= 1)
+            {
+                if (parts == 1)
+                {
+                    func(std::size_t{0});
+                }
+                return;
+            }
+
+            std::vector<std::exception_ptr> errors(parts);
+            auto run = [&](std::size_t part)
+            {
+                try
+                {
+                    func(part);
+                }
+                catch (...)
+                {
+                    errors[part] = std::current_exception();
+                }
+            };
+
+            std::vector<std::thread> workers;
+            workers.reserve(parts - 1);
+            try
+            {
+                for (std::size_t part = 1; part < parts; ++part)
+                {
+                    workers.emplace_back(run, part);
+                }
+            }
+            catch (...)
+            {
+                // No se pudo crear un hilo: espera a los ya lanzados y propaga el error
+                for (auto &worker : workers)
+                {
+                    worker.join();
+                }
+                throw;
+            }
+            run(0);
+            for (auto &worker : workers)
+            {
+                worker.join();
+            }
+            for (auto &error : errors)
+            {
+                if (error)
+                {
+                    std::rethrow_exception(error);
+                }
+            }
+        }
+    }
+} // namespace cppex
+
+#endif // CPPEX_PARALLEL_HPP
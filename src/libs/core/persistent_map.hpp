@@ -0,0 +1,693 @@
+/**
+ * @file persistent_map.hpp
+ * @brief Immutable hash map (HAMT) whose versions share structure
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_PERSISTENT_MAP_HPP
+#define CPPEX_PERSISTENT_MAP_HPP
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "vector.hpp"   // Include Vector class
+#include "map.hpp"      // Include Map class
+#include "hash_map.hpp" // Include detail::mixHash
+
+namespace cpp_ex
+{
+
+    /**
+     * @brief Immutable map where every update returns a new version sharing structure with the old one
+     *
+     * Implemented as a hash array mapped trie (CHAMP layout): each node consumes 5 bits
+     * of the (mixed) 64-bit hash and keeps two 32-bit bitmaps, one for the entries stored
+     * inline and one for the child nodes, so a lookup follows at most 13 nodes. Keys whose
+     * hashes are fully equal end up in a collision node searched linearly.
+     *
+     * `with()` and `without()` copy only the nodes on the path to the key (O(log n) time
+     * and memory) and return a new map; everything else is shared with the previous
+     * version through `std::shared_ptr`. Copying a PersistentMap is O(1), which makes it
+     * cheap to hand a snapshot to other threads: nodes are never modified after they are
+     * built, so any number of threads can read any versions concurrently. Replacing a
+     * PersistentMap variable that other threads read still needs synchronization (a
+     * mutex or `std::atomic<std::shared_ptr<...>>`), exactly like a shared_ptr.
+     *
+     * Iteration order is unspecified (it follows the hash bits) but stable for a given
+     * version. Iterators stay valid while any version that shares their nodes is alive.
+     *
+     * @tparam Key Type of the keys
+     * @tparam Value Type of the mapped values
+     * @tparam Hash Hash function object type, defaults to std::hash<Key>
+     * @tparam KeyEqual Equality function object type, defaults to std::equal_to<Key>
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::PersistentMap<std::string, int> v1 = {{"a", 1}, {"b", 2}};
+     * auto v2 = v1.with("c", 3);     // v1 is unchanged
+     * auto v3 = v2.without("a");
+     *
+     * std::cout << v1.getSize() << v2.getSize() << v3.getSize(); // 232
+     * cpp_ex::Map<std::string, int> ordered = v3.toMap();
+     * ```
+     */
+    template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    class PersistentMap
+    {
+    public:
+        // Tipos (aliases)
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<const Key, Value>;
+        using size_type = std::size_t;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+
+    private:
+        static constexpr int kBitsPerLevel = 5;
+        static constexpr std::uint64_t kLevelMask = (1u << kBitsPerLevel) - 1;
+        static constexpr int kHashBits = 64;
+        // 13 niveles con bitmap (desplazamientos 0..60) + 1 nodo de colisiones
+        static constexpr int kMaxDepth = (kHashBits + kBitsPerLevel - 1) / kBitsPerLevel + 1;
+
+        struct Node;
+        using NodePtr = std::shared_ptr<const Node>;
+
+        // Nodo inmutable una vez publicado. Con shift >= kHashBits es un nodo de colisiones:
+        // los bitmaps no se usan y las entradas se recorren linealmente
+        struct Node
+        {
+            std::uint32_t dataMap = 0;
+            std::uint32_t nodeMap = 0;
+            std::vector<value_type> entries;
+            std::vector<NodePtr> children;
+        };
+
+        NodePtr root;
+        size_type size = 0;
+        Hash hashFn;
+        KeyEqual eqFn;
+
+    public:
+        /**
+         * @brief Forward iterator over the entries of one version
+         *
+         * Walks the trie depth first with a fixed-size stack. Entries are never
+         * modified in place, so `iterator` and `const_iterator` are the same type.
+         */
+        class Iterator
+        {
+        private:
+            friend class PersistentMap;
+
+            struct Frame
+            {
+                const Node *node;
+                std::size_t nextChild;
+            };
+
+            std::array<Frame, kMaxDepth> stack{};
+            int depth = 0; // 0 = end()
+            std::size_t entryIndex = 0;
+
+            explicit Iterator(const Node *root)
+            {
+                if (root != nullptr)
+                {
+                    stack[0] = {root, 0};
+                    depth = 1;
+                    settle();
+                }
+            }
+
+            // Avanza hasta el siguiente nodo con entradas (preorden: entradas y luego hijos)
+            void settle()
+            {
+                while (depth > 0 && entryIndex >= stack[depth - 1].node->entries.size())
+                {
+                    Frame &top = stack[depth - 1];
+                    if (top.nextChild < top.node->children.size())
+                    {
+                        stack[depth] = {top.node->children[top.nextChild++].get(), 0};
+                        ++depth;
+                        entryIndex = 0;
+                    }
+                    else if (--depth > 0)
+                    {
+                        // Las entradas del padre ya se visitaron antes que sus hijos
+                        entryIndex = stack[depth - 1].node->entries.size();
+                    }
+                }
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = PersistentMap::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type *;
+            using reference = const value_type &;
+
+            Iterator() = default;
+
+            reference operator*() const
+            {
+                return stack[depth - 1].node->entries[entryIndex];
+            }
+
+            pointer operator->() const
+            {
+                return &**this;
+            }
+
+            Iterator &operator++()
+            {
+                ++entryIndex;
+                settle();
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            friend bool operator==(const Iterator &a, const Iterator &b)
+            {
+                if (a.depth == 0 || b.depth == 0)
+                {
+                    return a.depth == b.depth;
+                }
+                return a.stack[a.depth - 1].node == b.stack[b.depth - 1].node && a.entryIndex == b.entryIndex;
+            }
+
+            friend bool operator!=(const Iterator &a, const Iterator &b)
+            {
+                return !(a == b);
+            }
+        };
+
+        using iterator = Iterator;
+        using const_iterator = Iterator;
+
+        // Constructores
+        PersistentMap() = default;
+
+        explicit PersistentMap(const Hash &hash, const KeyEqual &equal = KeyEqual())
+            : hashFn(hash), eqFn(equal) {}
+
+        PersistentMap(std::initializer_list<value_type> init)
+        {
+            for (const auto &pair : init)
+            {
+                assignInPlace(pair.first, pair.second);
+            }
+        }
+
+        template <typename InputIt>
+        PersistentMap(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+            {
+                assignInPlace(first->first, first->second);
+            }
+        }
+
+        // Desde un Map (sin orden: la iteración sigue el hash)
+        template <typename Compare, typename Allocator>
+        explicit PersistentMap(const Map<Key, Value, Compare, Allocator> &map) : PersistentMap(map.begin(), map.end()) {}
+
+        // Iteradores
+        const_iterator begin() const
+        {
+            return const_iterator(root.get());
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator();
+        }
+
+        const_iterator cbegin() const
+        {
+            return begin();
+        }
+
+        const_iterator cend() const
+        {
+            return end();
+        }
+
+        // Capacidad
+        bool isEmpty() const noexcept
+        {
+            return size == 0;
+        }
+
+        size_type getSize() const noexcept
+        {
+            return size;
+        }
+
+        // Versiones nuevas
+
+        /**
+         * @brief Returns a new version where key maps to value
+         *
+         * Copies the O(log n) nodes on the path to the key; the rest is shared with
+         * this version, which is left unchanged.
+         *
+         * @param key Key to insert or update
+         * @param value Value to store
+         * @return The new version
+         */
+        PersistentMap with(const Key &key, const Value &value) const
+        {
+            PersistentMap result(*this);
+            bool added = false;
+            result.root = assoc(root, hashOf(key), 0, key, value, added);
+            result.size += added;
+            return result;
+        }
+
+        // Nueva versión con func(valor actual) o con defaultValue si la clave no existe
+        template <typename UnaryFunc>
+        PersistentMap withUpdated(const Key &key, const Value &defaultValue, UnaryFunc func) const
+        {
+            const Value *current = find(key);
+            return with(key, current ? func(*current) : defaultValue);
+        }
+
+        /**
+         * @brief Returns a new version without key
+         *
+         * @param key Key to remove
+         * @return The new version (sharing every node with this one if key is not present)
+         */
+        PersistentMap without(const Key &key) const
+        {
+            if (root == nullptr)
+            {
+                return *this;
+            }
+            PersistentMap result(*this);
+            bool removed = false;
+            result.root = dissoc(root, hashOf(key), 0, key, removed);
+            result.size -= removed;
+            if (result.size == 0)
+            {
+                result.root.reset();
+            }
+            return result;
+        }
+
+        // Lookup
+
+        // Puntero al valor (nullptr si no existe); válido mientras viva una versión que lo comparta
+        const Value *find(const Key &key) const
+        {
+            const Node *node = root.get();
+            auto hash = hashOf(key);
+            for (int shift = 0; node != nullptr; shift += kBitsPerLevel)
+            {
+                if (shift >= kHashBits)
+                {
+                    for (const auto &entry : node->entries)
+                    {
+                        if (eqFn(entry.first, key))
+                        {
+                            return &entry.second;
+                        }
+                    }
+                    return nullptr;
+                }
+                auto bit = bitFor(hash, shift);
+                if (node->dataMap & bit)
+                {
+                    const auto &entry = node->entries[indexOf(node->dataMap, bit)];
+                    return eqFn(entry.first, key) ? &entry.second : nullptr;
+                }
+                if (!(node->nodeMap & bit))
+                {
+                    return nullptr;
+                }
+                node = node->children[indexOf(node->nodeMap, bit)].get();
+            }
+            return nullptr;
+        }
+
+        const Value &at(const Key &key) const
+        {
+            const Value *value = find(key);
+            if (value == nullptr)
+            {
+                throw std::out_of_range("PersistentMap::at: key not found");
+            }
+            return *value;
+        }
+
+        Value getOrDefault(const Key &key, const Value &defaultValue) const
+        {
+            const Value *value = find(key);
+            return value ? *value : defaultValue;
+        }
+
+        bool contains(const Key &key) const
+        {
+            return find(key) != nullptr;
+        }
+
+        size_type count(const Key &key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        // true si ambas versiones son la misma estructura (comprobación O(1) de "no ha cambiado")
+        bool sharesRootWith(const PersistentMap &other) const noexcept
+        {
+            return root == other.root;
+        }
+
+        // Conversiones y métodos que usan cpp_ex::Vector
+        template <typename Compare = std::less<Key>>
+        Map<Key, Value, Compare> toMap() const
+        {
+            Map<Key, Value, Compare> result;
+            for (const auto &pair : *this)
+            {
+                result.insert(pair);
+            }
+            return result;
+        }
+
+        Vector<Key> getKeys() const
+        {
+            Vector<Key> keys;
+            keys.reserve(size);
+            for (const auto &pair : *this)
+            {
+                keys.pushBack(pair.first);
+            }
+            return keys;
+        }
+
+        Vector<Value> getValues() const
+        {
+            Vector<Value> values;
+            values.reserve(size);
+            for (const auto &pair : *this)
+            {
+                values.pushBack(pair.second);
+            }
+            return values;
+        }
+
+        Vector<std::pair<Key, Value>> getEntries() const
+        {
+            Vector<std::pair<Key, Value>> entries;
+            entries.reserve(size);
+            for (const auto &pair : *this)
+            {
+                entries.emplaceBack(pair.first, pair.second);
+            }
+            return entries;
+        }
+
+        template <typename BinaryFunc>
+        void forEach(BinaryFunc func) const
+        {
+            for (const auto &pair : *this)
+            {
+                func(pair.first, pair.second);
+            }
+        }
+
+        // Operadores de comparación (mismo contenido, sin importar la estructura)
+        bool operator==(const PersistentMap &other) const
+        {
+            if (size != other.size)
+            {
+                return false;
+            }
+            if (root == other.root)
+            {
+                return true;
+            }
+            for (const auto &pair : *this)
+            {
+                const Value *value = other.find(pair.first);
+                if (value == nullptr || !(*value == pair.second))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool operator!=(const PersistentMap &other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        std::uint64_t hashOf(const Key &key) const
+        {
+            return detail::mixHash(static_cast<std::uint64_t>(hashFn(key)));
+        }
+
+        static std::uint32_t bitFor(std::uint64_t hash, int shift) noexcept
+        {
+            return std::uint32_t{1} << ((hash >> shift) & kLevelMask);
+        }
+
+        // Posición compacta de bit entre los bits activos del bitmap
+        static std::size_t indexOf(std::uint32_t bitmap, std::uint32_t bit) noexcept
+        {
+            return static_cast<std::size_t>(std::popcount(bitmap & (bit - 1)));
+        }
+
+        // Construcción inicial: la versión aún no es visible, así que no hace falta compartir
+        void assignInPlace(const Key &key, const Value &value)
+        {
+            bool added = false;
+            root = assoc(root, hashOf(key), 0, key, value, added);
+            size += added;
+        }
+
+        // Copia de un nodo con entries[index] sustituida, insertada o quitada
+        static std::vector<value_type> entriesWith(const std::vector<value_type> &entries, std::size_t index,
+                                                   const value_type *replacement, bool insert)
+        {
+            std::vector<value_type> result;
+            result.reserve(entries.size() + (insert ? 1 : 0));
+            for (std::size_t i = 0; i < entries.size(); ++i)
+            {
+                if (i == index && replacement != nullptr)
+                {
+                    result.push_back(*replacement);
+                    if (!insert)
+                    {
+                        continue;
+                    }
+                }
+                else if (i == index)
+                {
+                    continue; // Borrado
+                }
+                result.push_back(entries[i]);
+            }
+            if (index == entries.size() && replacement != nullptr)
+            {
+                result.push_back(*replacement);
+            }
+            return result;
+        }
+
+        // Nodo mínimo que separa dos entradas con hashes distintos a partir de shift
+        NodePtr mergeTwo(int shift, const value_type &a, std::uint64_t hashA, const value_type &b, std::uint64_t hashB) const
+        {
+            auto node = std::make_shared<Node>();
+            if (shift >= kHashBits)
+            {
+                node->entries.reserve(2);
+                node->entries.push_back(a);
+                node->entries.push_back(b);
+                return node;
+            }
+            auto bitA = bitFor(hashA, shift);
+            auto bitB = bitFor(hashB, shift);
+            if (bitA == bitB)
+            {
+                node->nodeMap = bitA;
+                node->children.push_back(mergeTwo(shift + kBitsPerLevel, a, hashA, b, hashB));
+                return node;
+            }
+            node->dataMap = bitA | bitB;
+            node->entries.reserve(2);
+            if (bitA < bitB)
+            {
+                node->entries.push_back(a);
+                node->entries.push_back(b);
+            }
+            else
+            {
+                node->entries.push_back(b);
+                node->entries.push_back(a);
+            }
+            return node;
+        }
+
+        NodePtr assoc(const NodePtr &node, std::uint64_t hash, int shift, const Key &key, const Value &value, bool &added) const
+        {
+            value_type entry(key, value);
+            if (node == nullptr)
+            {
+                auto leaf = std::make_shared<Node>();
+                leaf->dataMap = bitFor(hash, shift);
+                leaf->entries.push_back(std::move(entry));
+                added = true;
+                return leaf;
+            }
+
+            auto copy = std::make_shared<Node>();
+            copy->dataMap = node->dataMap;
+            copy->nodeMap = node->nodeMap;
+
+            if (shift >= kHashBits)
+            {
+                for (std::size_t i = 0; i < node->entries.size(); ++i)
+                {
+                    if (eqFn(node->entries[i].first, key))
+                    {
+                        copy->entries = entriesWith(node->entries, i, &entry, false);
+                        copy->children = node->children;
+                        return copy;
+                    }
+                }
+                copy->entries = entriesWith(node->entries, node->entries.size(), &entry, true);
+                added = true;
+                return copy;
+            }
+
+            auto bit = bitFor(hash, shift);
+            if (node->dataMap & bit)
+            {
+                auto index = indexOf(node->dataMap, bit);
+                const auto &existing = node->entries[index];
+                copy->children = node->children;
+                if (eqFn(existing.first, key))
+                {
+                    copy->entries = entriesWith(node->entries, index, &entry, false);
+                    return copy;
+                }
+                // Dos claves en la misma posición: bajan juntas a un nodo hijo
+                auto child = mergeTwo(shift + kBitsPerLevel, existing, hashOf(existing.first), entry, hash);
+                copy->entries = entriesWith(node->entries, index, nullptr, false);
+                copy->dataMap &= ~bit;
+                copy->nodeMap |= bit;
+                copy->children.insert(copy->children.begin() + static_cast<std::ptrdiff_t>(indexOf(copy->nodeMap, bit)), std::move(child));
+                added = true;
+                return copy;
+            }
+
+            copy->children = node->children;
+            if (node->nodeMap & bit)
+            {
+                auto index = indexOf(node->nodeMap, bit);
+                copy->entries = std::vector<value_type>(node->entries);
+                copy->children[index] = assoc(node->children[index], hash, shift + kBitsPerLevel, key, value, added);
+                return copy;
+            }
+
+            copy->dataMap |= bit;
+            copy->entries = entriesWith(node->entries, indexOf(copy->dataMap, bit), &entry, true);
+            added = true;
+            return copy;
+        }
+
+        NodePtr dissoc(const NodePtr &node, std::uint64_t hash, int shift, const Key &key, bool &removed) const
+        {
+            if (shift >= kHashBits)
+            {
+                for (std::size_t i = 0; i < node->entries.size(); ++i)
+                {
+                    if (eqFn(node->entries[i].first, key))
+                    {
+                        auto copy = std::make_shared<Node>();
+                        copy->entries = entriesWith(node->entries, i, nullptr, false);
+                        removed = true;
+                        return copy;
+                    }
+                }
+                return node;
+            }
+
+            auto bit = bitFor(hash, shift);
+            if (node->dataMap & bit)
+            {
+                auto index = indexOf(node->dataMap, bit);
+                if (!eqFn(node->entries[index].first, key))
+                {
+                    return node;
+                }
+                auto copy = std::make_shared<Node>();
+                copy->dataMap = node->dataMap & ~bit;
+                copy->nodeMap = node->nodeMap;
+                copy->entries = entriesWith(node->entries, index, nullptr, false);
+                copy->children = node->children;
+                removed = true;
+                return copy;
+            }
+
+            if (!(node->nodeMap & bit))
+            {
+                return node;
+            }
+
+            auto childIndex = indexOf(node->nodeMap, bit);
+            auto child = dissoc(node->children[childIndex], hash, shift + kBitsPerLevel, key, removed);
+            if (!removed)
+            {
+                return node;
+            }
+
+            auto copy = std::make_shared<Node>();
+            copy->dataMap = node->dataMap;
+            copy->nodeMap = node->nodeMap;
+            if (child->children.empty() && child->entries.size() == 1)
+            {
+                // Forma canónica: un hijo con una sola entrada sube al padre
+                copy->nodeMap &= ~bit;
+                copy->dataMap |= bit;
+                copy->entries = entriesWith(node->entries, indexOf(copy->dataMap, bit), &child->entries[0], true);
+                copy->children.reserve(node->children.size() - 1);
+                for (std::size_t i = 0; i < node->children.size(); ++i)
+                {
+                    if (i != childIndex)
+                    {
+                        copy->children.push_back(node->children[i]);
+                    }
+                }
+            }
+            else
+            {
+                copy->entries = std::vector<value_type>(node->entries);
+                copy->children = node->children;
+                copy->children[childIndex] = std::move(child);
+            }
+            return copy;
+        }
+    };
+
+} // namespace cppex
+
+#endif // CPPEX_PERSISTENT_MAP_HPP
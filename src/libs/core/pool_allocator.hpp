@@ -0,0 +1,337 @@
+/**
+ * @file pool_allocator.hpp
+ * @brief Slab pool for fixed-size nodes and an allocator for node-based containers
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_POOL_ALLOCATOR_HPP
+#define CPPEX_POOL_ALLOCATOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cpp_ex
+{
+
+    /**
+     * @brief Hands out blocks of one fixed size carved from large pages
+     *
+     * Blocks are taken from the current page with a bump pointer, so blocks allocated
+     * one after another are contiguous in memory. Freed blocks go to an intrusive free
+     * list (LIFO) and are reused before touching a new page. Pages start small and
+     * double up to `kMaxPageBytes`, so tiny containers do not reserve much memory.
+     * Pages are only returned to the system by `release()` or the destructor, in
+     * O(pages) regardless of the number of blocks.
+     *
+     * Not thread-safe: a pool belongs to one container (or one thread).
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::NodePool pool(sizeof(Node), alignof(Node));
+     * void *block = pool.allocate();
+     * pool.deallocate(block);
+     * pool.release(); // frees every page at once
+     * ```
+     */
+    class NodePool
+    {
+    public:
+        static constexpr std::size_t kFirstPageBlocks = 16;
+        static constexpr std::size_t kMaxPageBytes = 64 * 1024;
+
+    private:
+        // Cabecera de cada página: enlaza las páginas para liberarlas todas juntas
+        struct Page
+        {
+            Page *next;
+            std::size_t bytes;
+        };
+
+        struct FreeBlock
+        {
+            FreeBlock *next;
+        };
+
+        std::size_t blockSize;
+        std::size_t alignment;
+        std::size_t headerBytes;
+        std::size_t nextPageBlocks = kFirstPageBlocks;
+        Page *pages = nullptr;
+        FreeBlock *freeList = nullptr;
+        std::byte *cursor = nullptr; // Siguiente bloque sin usar de la página actual
+        std::byte *pageEnd = nullptr;
+        std::size_t pageCount = 0;
+        std::size_t inUse = 0;
+
+    public:
+        // Constructores
+        NodePool(std::size_t blockSize, std::size_t alignment = alignof(std::max_align_t))
+            : alignment(std::max(alignment, alignof(FreeBlock)))
+        {
+            // Cada bloque debe poder guardar el puntero de la lista libre y respetar la alineación
+            this->blockSize = (std::max(blockSize, sizeof(FreeBlock)) + this->alignment - 1) / this->alignment * this->alignment;
+            headerBytes = (sizeof(Page) + this->alignment - 1) / this->alignment * this->alignment;
+        }
+
+        NodePool(const NodePool &) = delete;
+        NodePool &operator=(const NodePool &) = delete;
+
+        NodePool(NodePool &&other) noexcept
+            : blockSize(other.blockSize), alignment(other.alignment), headerBytes(other.headerBytes),
+              nextPageBlocks(std::exchange(other.nextPageBlocks, kFirstPageBlocks)),
+              pages(std::exchange(other.pages, nullptr)), freeList(std::exchange(other.freeList, nullptr)),
+              cursor(std::exchange(other.cursor, nullptr)), pageEnd(std::exchange(other.pageEnd, nullptr)),
+              pageCount(std::exchange(other.pageCount, 0)), inUse(std::exchange(other.inUse, 0)) {}
+
+        ~NodePool()
+        {
+            release();
+        }
+
+        // Asignación de bloques
+        void *allocate()
+        {
+            ++inUse;
+            if (freeList != nullptr)
+            {
+                return std::exchange(freeList, freeList->next);
+            }
+            if (cursor == pageEnd)
+            {
+                addPage();
+            }
+            return std::exchange(cursor, cursor + blockSize);
+        }
+
+        void deallocate(void *block) noexcept
+        {
+            --inUse;
+            freeList = ::new (block) FreeBlock{freeList};
+        }
+
+        /**
+         * @brief Returns every page to the system in O(pages)
+         *
+         * All blocks handed out by this pool become invalid; objects living in them
+         * must have been destroyed (or be trivially destructible).
+         */
+        void release() noexcept
+        {
+            while (pages != nullptr)
+            {
+                Page *next = pages->next;
+                ::operator delete(static_cast<void *>(pages), pages->bytes, std::align_val_t(alignment));
+                pages = next;
+            }
+            freeList = nullptr;
+            cursor = pageEnd = nullptr;
+            nextPageBlocks = kFirstPageBlocks;
+            pageCount = 0;
+            inUse = 0;
+        }
+
+        // Estadísticas
+        std::size_t getBlockSize() const noexcept
+        {
+            return blockSize;
+        }
+
+        std::size_t getPageCount() const noexcept
+        {
+            return pageCount;
+        }
+
+        std::size_t getAllocatedCount() const noexcept
+        {
+            return inUse;
+        }
+
+        // Bytes reservados en páginas (incluye bloques libres y cabeceras)
+        std::size_t getMemoryUsage() const noexcept
+        {
+            std::size_t bytes = 0;
+            for (const Page *page = pages; page != nullptr; page = page->next)
+            {
+                bytes += page->bytes;
+            }
+            return bytes;
+        }
+
+        bool owns(const void *block) const noexcept
+        {
+            auto *address = static_cast<const std::byte *>(block);
+            for (const Page *page = pages; page != nullptr; page = page->next)
+            {
+                auto *first = reinterpret_cast<const std::byte *>(page);
+                if (address >= first + headerBytes && address < first + page->bytes)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        void addPage()
+        {
+            std::size_t maxBlocks = std::max<std::size_t>(1, (kMaxPageBytes - headerBytes) / blockSize);
+            std::size_t blocks = std::min(nextPageBlocks, maxBlocks);
+            std::size_t bytes = headerBytes + blocks * blockSize;
+
+            void *memory = ::operator new(bytes, std::align_val_t(alignment));
+            pages = ::new (memory) Page{pages, bytes};
+            cursor = static_cast<std::byte *>(memory) + headerBytes;
+            pageEnd = cursor + blocks * blockSize;
+            nextPageBlocks = std::min(blocks * 2, maxBlocks);
+            ++pageCount;
+        }
+    };
+
+    namespace detail
+    {
+        // Estado compartido por todas las copias (y rebinds) de un PoolAllocator
+        struct PoolAllocatorState
+        {
+            std::unique_ptr<NodePool> pool;
+            std::size_t objectSize = 0; // Tipo servido por el pool (el del primer allocate(1))
+            std::size_t objectAlignment = 0;
+        };
+    }
+
+    /**
+     * @brief Allocator that serves single-object allocations from a private NodePool
+     *
+     * Meant for node-based containers (`std::map`, cpp_ex::Map, `std::list`...): every
+     * node is one `allocate(1)` of the same type, so all nodes come from one pool and
+     * inserting or erasing never calls malloc once the pages exist. Array allocations
+     * and objects of a different size fall back to `operator new`.
+     *
+     * Each default-constructed allocator owns a new pool, shared by its copies and
+     * rebinds; copying a container gives the copy its own pool (a moved-from container
+     * keeps sharing the pool of the one it was moved into). When the container
+     * (and so the last allocator copy) is destroyed, the pages are freed in O(pages).
+     * There is no locking: like the container itself, a pool must not be used from
+     * several threads at once, but a container can still be built in one thread and
+     * destroyed in another.
+     *
+     * Note: libstdc++ 12 never destroys the allocator copy held by a node handle that
+     * is reinserted into a `std::map`, which leaks the pool of any stateful allocator.
+     * cpp_ex::Map never relinks nodes for allocators like this one: `insert(node)` and
+     * `splice()` move the key and value into a new node and free the old one.
+     *
+     * @tparam T Type of the allocated objects
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::Map<int, int, std::less<int>, cpp_ex::PoolAllocator<std::pair<const int, int>>> map;
+     * // or simply
+     * cpp_ex::PooledMap<int, int> pooled;
+     * ```
+     */
+    template <typename T>
+    class PoolAllocator
+    {
+    private:
+        template <typename U>
+        friend class PoolAllocator;
+
+        std::shared_ptr<detail::PoolAllocatorState> state;
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using propagate_on_container_copy_assignment = std::false_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+        using is_always_equal = std::false_type;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = PoolAllocator<U>;
+        };
+
+        // Constructores
+        PoolAllocator() : state(std::make_shared<detail::PoolAllocatorState>()) {}
+
+        PoolAllocator(const PoolAllocator &other) noexcept = default;
+
+        template <typename U>
+        PoolAllocator(const PoolAllocator<U> &other) noexcept : state(other.state) {}
+
+        PoolAllocator &operator=(const PoolAllocator &other) noexcept = default;
+
+        // Una copia del contenedor recibe un pool propio
+        PoolAllocator select_on_container_copy_construction() const
+        {
+            return PoolAllocator();
+        }
+
+        // Asignación
+        T *allocate(size_type n)
+        {
+            if (n == 1)
+            {
+                if (state->pool == nullptr)
+                {
+                    state->pool = std::make_unique<NodePool>(sizeof(T), alignof(T));
+                    state->objectSize = sizeof(T);
+                    state->objectAlignment = alignof(T);
+                }
+                if (isPooledType())
+                {
+                    return static_cast<T *>(state->pool->allocate());
+                }
+            }
+            if (n > static_cast<size_type>(-1) / sizeof(T))
+            {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+        }
+
+        void deallocate(T *ptr, size_type n) noexcept
+        {
+            if (n == 1 && isPooledType())
+            {
+                state->pool->deallocate(ptr);
+                return;
+            }
+            ::operator delete(static_cast<void *>(ptr), n * sizeof(T), std::align_val_t(alignof(T)));
+        }
+
+        // Pool de este allocator (nullptr hasta la primera asignación)
+        const NodePool *getPool() const noexcept
+        {
+            return state->pool.get();
+        }
+
+        template <typename U>
+        bool operator==(const PoolAllocator<U> &other) const noexcept
+        {
+            return state == other.state;
+        }
+
+        template <typename U>
+        bool operator!=(const PoolAllocator<U> &other) const noexcept
+        {
+            return state != other.state;
+        }
+
+    private:
+        // El pool se crea para el primer tipo asignado de uno en uno (el nodo del contenedor)
+        bool isPooledType() const noexcept
+        {
+            return state->objectSize == sizeof(T) && state->objectAlignment == alignof(T);
+        }
+    };
+
+} // namespace cppex
+
+#endif // CPPEX_POOL_ALLOCATOR_HPP
@@ -0,0 +1,969 @@
+/**
+ * @file radix_map.hpp
+ * @brief Compressed trie (radix tree) keyed by strings, with prefix queries
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_RADIX_MAP_HPP
+#define CPPEX_RADIX_MAP_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "vector.hpp"    // Include Vector class
+#include "string.hpp"    // Include String class y detail::stringKeyView
+#include "map_entry.hpp" // Include MapEntryRef
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CPPEX_RADIX_MAP_SSE2 1
+#endif
+
+namespace cpp_ex
+{
+
+    /**
+     * @brief Result of RadixMap::findLongestPrefix(): length of the matched key and its value
+     */
+    template <typename Value>
+    struct PrefixMatch
+    {
+        std::size_t length = 0;
+        Value *value = nullptr;
+
+        explicit operator bool() const noexcept
+        {
+            return value != nullptr;
+        }
+    };
+
+    /**
+     * @brief Ordered map from strings to values stored as a compressed trie
+     *
+     * Every edge carries a whole key fragment, so keys sharing a long prefix (URL paths,
+     * dotted names...) store that prefix once, and chains of single-child nodes are
+     * collapsed. A lookup costs O(key length) whatever the number of keys, and "all keys
+     * starting with P" walks only the subtree under P.
+     *
+     * Children are indexed by the first byte of their fragment. Nodes with up to 16
+     * children keep those bytes in a sorted 16-byte array searched with one SSE2
+     * compare (a scalar loop without SSE2); bigger nodes switch to a 256-entry table
+     * indexed directly by the byte, as in an adaptive radix tree.
+     *
+     * Keys can be given as String, std::string, std::string_view or C strings. Iteration
+     * and the forEach family visit keys in lexicographic (byte) order; keys are rebuilt
+     * while walking, so they are handed out as `std::string_view` / `const std::string&`
+     * valid only until the next step. Any insertion or erasure invalidates iterators;
+     * value pointers stay valid until their own key is erased.
+     *
+     * @tparam Value Type of the mapped values
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::RadixMap<int> routes = {{"/api/users", 1}, {"/api/users/admin", 2}, {"/static", 3}};
+     *
+     * auto match = routes.findLongestPrefix("/api/users/42/profile"); // length 10, value 1
+     * routes.forEachWithPrefix("/api/", [](std::string_view key, int &handler) {
+     *     // "/api/users", "/api/users/admin"
+     * });
+     * ```
+     */
+    template <typename Value>
+    class RadixMap
+    {
+    public:
+        // Tipos (aliases)
+        using key_type = String;
+        using mapped_type = Value;
+        using size_type = std::size_t;
+
+        static constexpr std::size_t kSmallFanout = 16;
+
+    private:
+        struct Node;
+        using NodePtr = std::unique_ptr<Node>;
+
+        struct Node
+        {
+            std::string label; // Fragmento de clave de la arista que llega a este nodo
+            // Pequeños: childCount entradas paralelas a childKeys. Grandes: 256 entradas indexadas por byte
+            std::unique_ptr<NodePtr[]> children;
+            std::optional<Value> value;
+            std::uint16_t childCount = 0;
+            bool large = false;
+            // Primer byte de cada hijo, ordenado (sólo en nodos pequeños)
+            unsigned char childKeys[kSmallFanout] = {};
+
+            bool isLarge() const noexcept
+            {
+                return large;
+            }
+
+            std::size_t getSlotCount() const noexcept
+            {
+                return large ? 256 : childCount;
+            }
+        };
+
+        NodePtr root; // Se crea con la primera inserción: mover o vaciar el mapa no reserva memoria
+        size_type size = 0;
+
+        template <bool IsConst>
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::pair<std::string, Value>;
+            using difference_type = std::ptrdiff_t;
+            using reference = MapEntryRef<std::string, std::conditional_t<IsConst, const Value, Value>>;
+            using pointer = MapEntryArrow<reference>;
+
+        private:
+            friend class RadixMap;
+            using NodePointer = std::conditional_t<IsConst, const Node *, Node *>;
+
+            struct Frame
+            {
+                NodePointer node;
+                std::size_t nextChild;
+            };
+
+            std::vector<Frame> stack; // Vacía = end()
+            std::string key;
+
+            explicit Iterator(NodePointer root)
+            {
+                if (root == nullptr)
+                {
+                    return;
+                }
+                stack.push_back({root, 0});
+                if (!root->value.has_value())
+                {
+                    advance();
+                }
+            }
+
+            // Recorrido en preorden: el valor de un nodo va antes que los de sus hijos
+            void advance()
+            {
+                while (!stack.empty())
+                {
+                    Frame &top = stack.back();
+                    NodePointer child = RadixMap::nextChild(top.node, top.nextChild);
+                    if (child != nullptr)
+                    {
+                        key.append(child->label);
+                        stack.push_back({child, 0});
+                        if (child->value.has_value())
+                        {
+                            return;
+                        }
+                    }
+                    else
+                    {
+                        key.resize(key.size() - top.node->label.size());
+                        stack.pop_back();
+                    }
+                }
+            }
+
+        public:
+            Iterator() = default;
+
+            // Conversión de iterator a const_iterator
+            template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+            Iterator(const Iterator<OtherConst> &other) : key(other.key)
+            {
+                for (const auto &frame : other.stack)
+                {
+                    stack.push_back({frame.node, frame.nextChild});
+                }
+            }
+
+            reference operator*() const noexcept
+            {
+                return reference(key, *stack.back().node->value);
+            }
+
+            pointer operator->() const noexcept
+            {
+                return pointer{**this};
+            }
+
+            Iterator &operator++()
+            {
+                advance();
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator tmp = *this;
+                advance();
+                return tmp;
+            }
+
+            friend bool operator==(const Iterator &a, const Iterator &b) noexcept
+            {
+                if (a.stack.empty() || b.stack.empty())
+                {
+                    return a.stack.empty() == b.stack.empty();
+                }
+                return a.stack.back().node == b.stack.back().node;
+            }
+
+            friend bool operator!=(const Iterator &a, const Iterator &b) noexcept
+            {
+                return !(a == b);
+            }
+
+            template <bool B>
+            friend class Iterator;
+        };
+
+    public:
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        // Constructores
+        RadixMap() = default;
+
+        RadixMap(std::initializer_list<std::pair<std::string_view, Value>> init)
+        {
+            for (const auto &[key, value] : init)
+            {
+                insert(key, value);
+            }
+        }
+
+        RadixMap(const RadixMap &other) : root(other.root ? clone(*other.root) : nullptr), size(other.size) {}
+
+        RadixMap(RadixMap &&other) noexcept
+            : root(std::move(other.root)), size(std::exchange(other.size, 0)) {}
+
+        // Operadores de asignación
+        RadixMap &operator=(const RadixMap &other)
+        {
+            if (this != &other)
+            {
+                RadixMap tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        RadixMap &operator=(RadixMap &&other) noexcept
+        {
+            if (this != &other)
+            {
+                RadixMap tmp(std::move(other));
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        // Iteradores
+        iterator begin()
+        {
+            return iterator(root.get());
+        }
+
+        const_iterator begin() const
+        {
+            return const_iterator(root.get());
+        }
+
+        const_iterator cbegin() const
+        {
+            return begin();
+        }
+
+        iterator end() noexcept
+        {
+            return iterator();
+        }
+
+        const_iterator end() const noexcept
+        {
+            return const_iterator();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        // Capacidad
+        bool isEmpty() const noexcept
+        {
+            return size == 0;
+        }
+
+        size_type getSize() const noexcept
+        {
+            return size;
+        }
+
+        // Número de nodos del trie (incluida la raíz, que no existe hasta la primera inserción)
+        size_type getNodeCount() const noexcept
+        {
+            size_type count = 0;
+            if (root == nullptr)
+            {
+                return 0;
+            }
+            visitNodes(*root, [&count](const Node &)
+                       { ++count; });
+            return count;
+        }
+
+        // Bytes en nodos, etiquetas largas y tablas de hijos
+        size_type getMemoryUsage() const noexcept
+        {
+            size_type bytes = 0;
+            if (root == nullptr)
+            {
+                return 0;
+            }
+            visitNodes(*root, [&bytes](const Node &node)
+                       {
+                           bytes += sizeof(Node) + node.getSlotCount() * sizeof(NodePtr);
+                           // Etiquetas que no caben en el buffer interno de std::string
+                           auto *inlineBegin = reinterpret_cast<const char *>(&node.label);
+                           if (node.label.data() < inlineBegin || node.label.data() >= inlineBegin + sizeof(node.label))
+                           {
+                               bytes += node.label.capacity() + 1;
+                           } });
+            return bytes;
+        }
+
+        // Modificadores
+        void clear() noexcept
+        {
+            root.reset();
+            size = 0;
+        }
+
+        // Inserta si la clave no existe; devuelve si se insertó
+        template <typename K>
+        bool insert(const K &key, const Value &value)
+        {
+            Node *node = findOrCreate(detail::stringKeyView(key));
+            if (node->value.has_value())
+            {
+                return false;
+            }
+            node->value.emplace(value);
+            ++size;
+            return true;
+        }
+
+        template <typename K>
+        bool insert(const K &key, Value &&value)
+        {
+            Node *node = findOrCreate(detail::stringKeyView(key));
+            if (node->value.has_value())
+            {
+                return false;
+            }
+            node->value.emplace(std::move(value));
+            ++size;
+            return true;
+        }
+
+        // Inserta o sobrescribe; devuelve true si la clave era nueva
+        template <typename K, typename M>
+        bool insertOrAssign(const K &key, M &&value)
+        {
+            Node *node = findOrCreate(detail::stringKeyView(key));
+            if (node->value.has_value())
+            {
+                *node->value = std::forward<M>(value);
+                return false;
+            }
+            node->value.emplace(std::forward<M>(value));
+            ++size;
+            return true;
+        }
+
+        template <typename K>
+        Value &operator[](const K &key)
+        {
+            Node *node = findOrCreate(detail::stringKeyView(key));
+            if (!node->value.has_value())
+            {
+                node->value.emplace();
+                ++size;
+            }
+            return *node->value;
+        }
+
+        /**
+         * @brief Removes a key, re-compressing the path it leaves behind
+         *
+         * @return Number of removed entries (0 or 1)
+         */
+        template <typename K>
+        size_type erase(const K &key)
+        {
+            std::string_view view = detail::stringKeyView(key);
+            Node *parent = nullptr;
+            Node *node = root.get();
+            if (node == nullptr)
+            {
+                return 0;
+            }
+            std::size_t pos = 0;
+            while (pos < view.size())
+            {
+                Node *child = findChild(node, static_cast<unsigned char>(view[pos]));
+                if (child == nullptr || !matchesLabel(child->label, view, pos))
+                {
+                    return 0;
+                }
+                pos += child->label.size();
+                parent = node;
+                node = child;
+            }
+            if (!node->value.has_value())
+            {
+                return 0;
+            }
+            node->value.reset();
+            --size;
+
+            if (parent == nullptr)
+            {
+                return 1; // La raíz (clave vacía) nunca se elimina
+            }
+            if (node->childCount == 0)
+            {
+                removeChild(parent, static_cast<unsigned char>(node->label[0]));
+                if (parent != root.get() && !parent->value.has_value() && parent->childCount == 1)
+                {
+                    absorbOnlyChild(parent);
+                }
+            }
+            else if (node->childCount == 1)
+            {
+                absorbOnlyChild(node);
+            }
+            return 1;
+        }
+
+        void swap(RadixMap &other) noexcept
+        {
+            std::swap(root, other.root);
+            std::swap(size, other.size);
+        }
+
+        // Lookup
+        template <typename K>
+        Value *find(const K &key)
+        {
+            Node *node = findNode(root.get(), detail::stringKeyView(key));
+            return node != nullptr && node->value.has_value() ? &*node->value : nullptr;
+        }
+
+        template <typename K>
+        const Value *find(const K &key) const
+        {
+            const Node *node = findNode(static_cast<const Node *>(root.get()), detail::stringKeyView(key));
+            return node != nullptr && node->value.has_value() ? &*node->value : nullptr;
+        }
+
+        template <typename K>
+        Value &at(const K &key)
+        {
+            Value *value = find(key);
+            if (value == nullptr)
+            {
+                throw std::out_of_range("RadixMap::at: key not found");
+            }
+            return *value;
+        }
+
+        template <typename K>
+        const Value &at(const K &key) const
+        {
+            const Value *value = find(key);
+            if (value == nullptr)
+            {
+                throw std::out_of_range("RadixMap::at: key not found");
+            }
+            return *value;
+        }
+
+        template <typename K>
+        bool contains(const K &key) const
+        {
+            return find(key) != nullptr;
+        }
+
+        template <typename K>
+        size_type count(const K &key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        /**
+         * @brief Finds the longest key that is a prefix of text
+         *
+         * Useful for routing tables: `findLongestPrefix("/api/users/42")` matches the
+         * entry for "/api/users" if there is no longer one.
+         *
+         * @return The matched key length and its value (null value if no key matches)
+         */
+        template <typename K>
+        PrefixMatch<Value> findLongestPrefix(const K &text)
+        {
+            return longestPrefix<Value>(root.get(), detail::stringKeyView(text));
+        }
+
+        template <typename K>
+        PrefixMatch<const Value> findLongestPrefix(const K &text) const
+        {
+            return longestPrefix<const Value>(static_cast<const Node *>(root.get()), detail::stringKeyView(text));
+        }
+
+        // Consultas por prefijo
+        /**
+         * @brief Calls `func(key, value)` for every key starting with prefix, in order
+         */
+        template <typename K, typename BinaryFunc>
+        void forEachWithPrefix(const K &prefix, BinaryFunc func)
+        {
+            std::string path;
+            Node *node = findPrefixNode(root.get(), detail::stringKeyView(prefix), path);
+            if (node != nullptr)
+            {
+                visitEntries(node, path, func);
+            }
+        }
+
+        template <typename K, typename BinaryFunc>
+        void forEachWithPrefix(const K &prefix, BinaryFunc func) const
+        {
+            std::string path;
+            const Node *node = findPrefixNode(static_cast<const Node *>(root.get()), detail::stringKeyView(prefix), path);
+            if (node != nullptr)
+            {
+                visitEntries(node, path, func);
+            }
+        }
+
+        template <typename K>
+        Vector<String> getKeysWithPrefix(const K &prefix) const
+        {
+            Vector<String> keys;
+            forEachWithPrefix(prefix, [&keys](std::string_view key, const Value &)
+                              { keys.pushBack(String(std::string(key))); });
+            return keys;
+        }
+
+        template <typename K>
+        size_type countWithPrefix(const K &prefix) const
+        {
+            size_type count = 0;
+            forEachWithPrefix(prefix, [&count](std::string_view, const Value &)
+                              { ++count; });
+            return count;
+        }
+
+        // Recorrido en orden lexicográfico
+        template <typename BinaryFunc>
+        void forEach(BinaryFunc func)
+        {
+            std::string path;
+            if (root != nullptr)
+            {
+                visitEntries(root.get(), path, func);
+            }
+        }
+
+        template <typename BinaryFunc>
+        void forEach(BinaryFunc func) const
+        {
+            std::string path;
+            if (root != nullptr)
+            {
+                visitEntries(static_cast<const Node *>(root.get()), path, func);
+            }
+        }
+
+        Vector<String> getKeys() const
+        {
+            Vector<String> keys;
+            keys.reserve(size);
+            forEach([&keys](std::string_view key, const Value &)
+                    { keys.pushBack(String(std::string(key))); });
+            return keys;
+        }
+
+        Vector<Value> getValues() const
+        {
+            Vector<Value> values;
+            values.reserve(size);
+            forEach([&values](std::string_view, const Value &value)
+                    { values.pushBack(value); });
+            return values;
+        }
+
+        // Comparación
+        bool operator==(const RadixMap &other) const
+        {
+            if (size != other.size)
+            {
+                return false;
+            }
+            auto it = other.begin();
+            for (const auto &[key, value] : *this)
+            {
+                if (key != it->first || !(value == it->second))
+                {
+                    return false;
+                }
+                ++it;
+            }
+            return true;
+        }
+
+        bool operator!=(const RadixMap &other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        // Hijo cuyo fragmento empieza por byte, o nullptr (con la misma constancia que node)
+        template <typename NodePointer>
+        static NodePointer findChild(NodePointer node, unsigned char byte) noexcept
+        {
+            if (node->isLarge())
+            {
+                return node->children[byte].get();
+            }
+#ifdef CPPEX_RADIX_MAP_SSE2
+            __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i *>(node->childKeys));
+            __m128i match = _mm_cmpeq_epi8(keys, _mm_set1_epi8(static_cast<char>(byte)));
+            auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(match)) & ((1u << node->childCount) - 1);
+            return mask != 0 ? node->children[std::countr_zero(mask)].get() : nullptr;
+#else
+            for (std::size_t i = 0; i < node->childCount; ++i)
+            {
+                if (node->childKeys[i] == byte)
+                {
+                    return node->children[i].get();
+                }
+            }
+            return nullptr;
+#endif
+        }
+
+        // Siguiente hijo en orden a partir de cursor (que avanza), o nullptr
+        template <typename NodePointer>
+        static NodePointer nextChild(NodePointer node, std::size_t &cursor) noexcept
+        {
+            if (node->isLarge())
+            {
+                while (cursor < 256)
+                {
+                    if (auto *child = node->children[cursor++].get())
+                    {
+                        return child;
+                    }
+                }
+                return nullptr;
+            }
+            return cursor < node->childCount ? node->children[cursor++].get() : nullptr;
+        }
+
+        // ¿Empieza key[pos..] por label?
+        static bool matchesLabel(const std::string &label, std::string_view key, std::size_t pos) noexcept
+        {
+            return key.size() - pos >= label.size() && std::memcmp(label.data(), key.data() + pos, label.size()) == 0;
+        }
+
+        void addChild(Node *node, NodePtr child)
+        {
+            auto byte = static_cast<unsigned char>(child->label[0]);
+            if (!node->isLarge() && node->childCount == kSmallFanout)
+            {
+                // Pasa a tabla de 256 entradas
+                auto table = std::make_unique<NodePtr[]>(256);
+                for (std::size_t i = 0; i < node->childCount; ++i)
+                {
+                    table[node->childKeys[i]] = std::move(node->children[i]);
+                }
+                node->children = std::move(table);
+                node->large = true;
+            }
+            if (node->isLarge())
+            {
+                node->children[byte] = std::move(child);
+            }
+            else
+            {
+                auto index = static_cast<std::size_t>(std::lower_bound(node->childKeys, node->childKeys + node->childCount, byte) - node->childKeys);
+                // El array de hijos se mantiene del tamaño exacto: los nodos pequeños son la mayoría
+                auto slots = std::make_unique<NodePtr[]>(node->childCount + 1);
+                std::move(node->children.get(), node->children.get() + index, slots.get());
+                std::move(node->children.get() + index, node->children.get() + node->childCount, slots.get() + index + 1);
+                slots[index] = std::move(child);
+                node->children = std::move(slots);
+                std::copy_backward(node->childKeys + index, node->childKeys + node->childCount, node->childKeys + node->childCount + 1);
+                node->childKeys[index] = byte;
+            }
+            ++node->childCount;
+        }
+
+        void removeChild(Node *node, unsigned char byte)
+        {
+            --node->childCount;
+            if (node->isLarge())
+            {
+                node->children[byte].reset();
+                if (node->childCount <= kSmallFanout / 2)
+                {
+                    // Vuelve a nodo pequeño (con margen para no oscilar)
+                    auto small = std::make_unique<NodePtr[]>(node->childCount);
+                    std::size_t count = 0;
+                    for (std::size_t b = 0; b < 256; ++b)
+                    {
+                        if (node->children[b] != nullptr)
+                        {
+                            node->childKeys[count] = static_cast<unsigned char>(b);
+                            small[count++] = std::move(node->children[b]);
+                        }
+                    }
+                    node->children = std::move(small);
+                    node->large = false;
+                }
+                return;
+            }
+            auto index = static_cast<std::size_t>(std::find(node->childKeys, node->childKeys + node->childCount + 1, byte) - node->childKeys);
+            std::copy(node->childKeys + index + 1, node->childKeys + node->childCount + 1, node->childKeys + index);
+            if (node->childCount == 0)
+            {
+                node->children.reset();
+                return;
+            }
+            auto slots = std::make_unique<NodePtr[]>(node->childCount);
+            std::move(node->children.get(), node->children.get() + index, slots.get());
+            std::move(node->children.get() + index + 1, node->children.get() + node->childCount + 1, slots.get() + index);
+            node->children = std::move(slots);
+        }
+
+        // Fusiona un nodo sin valor con su único hijo (mantiene la compresión de caminos)
+        void absorbOnlyChild(Node *node)
+        {
+            std::size_t cursor = 0;
+            Node *onlyChild = nextChild(node, cursor);
+            NodePtr child = std::move(node->isLarge() ? node->children[static_cast<unsigned char>(onlyChild->label[0])] : node->children[0]);
+            node->label += child->label;
+            node->value = std::move(child->value);
+            node->childCount = child->childCount;
+            node->large = child->large;
+            std::copy(child->childKeys, child->childKeys + kSmallFanout, node->childKeys);
+            node->children = std::move(child->children);
+        }
+
+        // Nodo de la clave, creando el camino (y partiendo etiquetas) si hace falta
+        Node *findOrCreate(std::string_view key)
+        {
+            if (root == nullptr)
+            {
+                root = std::make_unique<Node>();
+            }
+            Node *node = root.get();
+            std::size_t pos = 0;
+            while (pos < key.size())
+            {
+                auto byte = static_cast<unsigned char>(key[pos]);
+                Node *child = findChild(node, byte);
+                if (child == nullptr)
+                {
+                    auto leaf = std::make_unique<Node>();
+                    leaf->label.assign(key.substr(pos));
+                    Node *result = leaf.get();
+                    addChild(node, std::move(leaf));
+                    return result;
+                }
+
+                std::size_t limit = std::min(child->label.size(), key.size() - pos);
+                std::size_t common = 1;
+                while (common < limit && child->label[common] == key[pos + common])
+                {
+                    ++common;
+                }
+                if (common < child->label.size())
+                {
+                    // Parte la arista: el nuevo nodo intermedio se queda con el prefijo común
+                    auto middle = std::make_unique<Node>();
+                    middle->label.assign(child->label, 0, common);
+                    NodePtr &slot = childSlot(node, byte);
+                    NodePtr old = std::move(slot);
+                    old->label.erase(0, common);
+                    addChild(middle.get(), std::move(old));
+                    slot = std::move(middle);
+                    child = slot.get();
+                }
+                pos += common;
+                node = child;
+            }
+            return node;
+        }
+
+        NodePtr &childSlot(Node *node, unsigned char byte) noexcept
+        {
+            if (node->isLarge())
+            {
+                return node->children[byte];
+            }
+            auto index = std::find(node->childKeys, node->childKeys + node->childCount, byte) - node->childKeys;
+            return node->children[static_cast<std::size_t>(index)];
+        }
+
+        template <typename NodePointer>
+        static NodePointer findNode(NodePointer node, std::string_view key) noexcept
+        {
+            if (node == nullptr)
+            {
+                return nullptr;
+            }
+            std::size_t pos = 0;
+            while (pos < key.size())
+            {
+                NodePointer child = findChild(node, static_cast<unsigned char>(key[pos]));
+                if (child == nullptr || !matchesLabel(child->label, key, pos))
+                {
+                    return nullptr;
+                }
+                pos += child->label.size();
+                node = child;
+            }
+            return node;
+        }
+
+        // Clave más larga con valor que es prefijo de text, bajando desde node
+        template <typename MatchValue, typename NodePointer>
+        static PrefixMatch<MatchValue> longestPrefix(NodePointer node, std::string_view text) noexcept
+        {
+            PrefixMatch<MatchValue> best;
+            std::size_t pos = 0;
+            while (node != nullptr)
+            {
+                if (node->value.has_value())
+                {
+                    best = {pos, &*node->value};
+                }
+                if (pos == text.size())
+                {
+                    break;
+                }
+                NodePointer child = findChild(node, static_cast<unsigned char>(text[pos]));
+                if (child == nullptr || !matchesLabel(child->label, text, pos))
+                {
+                    break;
+                }
+                pos += child->label.size();
+                node = child;
+            }
+            return best;
+        }
+
+        // Primer nodo cuyo camino completo empieza por prefix; deja ese camino en path
+        template <typename NodePointer>
+        static NodePointer findPrefixNode(NodePointer node, std::string_view prefix, std::string &path)
+        {
+            if (node == nullptr)
+            {
+                return nullptr;
+            }
+            std::size_t pos = 0;
+            while (pos < prefix.size())
+            {
+                NodePointer child = findChild(node, static_cast<unsigned char>(prefix[pos]));
+                if (child == nullptr)
+                {
+                    return nullptr;
+                }
+                std::size_t length = std::min(child->label.size(), prefix.size() - pos);
+                if (std::memcmp(child->label.data(), prefix.data() + pos, length) != 0)
+                {
+                    return nullptr;
+                }
+                pos += child->label.size();
+                node = child;
+            }
+            path.assign(prefix.substr(0, std::min(pos, prefix.size())));
+            path.append(node->label, node->label.size() - (pos - path.size()));
+            return node;
+        }
+
+        template <typename NodePointer, typename BinaryFunc>
+        static void visitEntries(NodePointer node, std::string &path, BinaryFunc &func)
+        {
+            if (node->value.has_value())
+            {
+                func(std::string_view(path), *node->value);
+            }
+            std::size_t cursor = 0;
+            while (NodePointer child = nextChild(node, cursor))
+            {
+                path.append(child->label);
+                visitEntries(child, path, func);
+                path.resize(path.size() - child->label.size());
+            }
+        }
+
+        template <typename Func>
+        static void visitNodes(const Node &node, Func &&func)
+        {
+            func(node);
+            std::size_t cursor = 0;
+            while (const Node *child = nextChild(&node, cursor))
+            {
+                visitNodes(*child, func);
+            }
+        }
+
+        static NodePtr clone(const Node &node)
+        {
+            auto copy = std::make_unique<Node>();
+            copy->label = node.label;
+            copy->value = node.value;
+            copy->childCount = node.childCount;
+            copy->large = node.large;
+            std::copy(node.childKeys, node.childKeys + kSmallFanout, copy->childKeys);
+            if (node.getSlotCount() != 0)
+            {
+                copy->children = std::make_unique<NodePtr[]>(node.getSlotCount());
+            }
+            for (std::size_t i = 0; i < node.getSlotCount(); ++i)
+            {
+                if (node.children[i] != nullptr)
+                {
+                    copy->children[i] = clone(*node.children[i]);
+                }
+            }
+            return copy;
+        }
+    };
+
+} // namespace cppex
+
+#endif // CPPEX_RADIX_MAP_HPP
@@ -0,0 +1,679 @@
+/**
+ * @file serialization.hpp
+ * @brief Compact little-endian binary encoding, CRC-32C and a Serializer customization point
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_SERIALIZATION_HPP
+#define CPPEX_SERIALIZATION_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "common.hpp"    // Include exceptions::SerializationError
+#include "string.hpp"    // Include String class
+#include "vector.hpp"    // Include Vector class
+#include "map_delta.hpp" // Include MapDelta
+
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#define CPPEX_SERIALIZATION_CRC32C_HW 1
+#endif
+
+namespace cpp_ex
+{
+    namespace detail
+    {
+        // Tabla del CRC-32C (polinomio de Castagnoli reflejado), generada en compilación
+        constexpr std::array<std::uint32_t, 256> makeCrc32cTable() noexcept
+        {
+            std::array<std::uint32_t, 256> table{};
+            for (std::uint32_t i = 0; i < 256; ++i)
+            {
+                std::uint32_t crc = i;
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    crc = (crc >> 1) ^ ((crc & 1) ? 0x82F63B78u : 0u);
+                }
+                table[i] = crc;
+            }
+            return table;
+        }
+
+        inline constexpr std::array<std::uint32_t, 256> kCrc32cTable = makeCrc32cTable();
+    }
+
+    /**
+     * @brief CRC-32C (Castagnoli) of a byte range, as used by iSCSI, ext4 and most WALs
+     *
+     * Uses the SSE4.2 `crc32` instruction when the build enables it and a table
+     * otherwise; both give the same result. Pass a previous result as `crc` to
+     * checksum data in pieces.
+     */
+    inline std::uint32_t crc32c(const void *data, std::size_t size, std::uint32_t crc = 0) noexcept
+    {
+        const auto *bytes = static_cast<const unsigned char *>(data);
+        crc = ~crc;
+#ifdef CPPEX_SERIALIZATION_CRC32C_HW
+        std::uint64_t wide = crc;
+        for (; size >= 8; size -= 8, bytes += 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, bytes, 8);
+            wide = _mm_crc32_u64(wide, word);
+        }
+        crc = static_cast<std::uint32_t>(wide);
+        for (; size > 0; --size, ++bytes)
+        {
+            crc = _mm_crc32_u8(crc, *bytes);
+        }
+#else
+        for (; size > 0; --size, ++bytes)
+        {
+            crc = detail::kCrc32cTable[(crc ^ *bytes) & 0xFF] ^ (crc >> 8);
+        }
+#endif
+        return ~crc;
+    }
+
+    inline std::uint32_t crc32c(std::string_view data, std::uint32_t crc = 0) noexcept
+    {
+        return crc32c(data.data(), data.size(), crc);
+    }
+
+    class BinaryWriter;
+    class BinaryReader;
+
+    /**
+     * @brief Customization point: how a type is written to and read from binary data
+     *
+     * Specialize it for your own types with two static members:
+     *
+     * ```cpp
+     * template <>
+     * struct cpp_ex::Serializer<Point> {
+     *     static void write(cpp_ex::BinaryWriter &out, const Point &p) { out.write(p.x); out.write(p.y); }
+     *     static Point read(cpp_ex::BinaryReader &in) { return {in.read<int>(), in.read<int>()}; }
+     * };
+     * ```
+     *
+     * Provided for integers, floating point, bool, enums, std::string, String,
+     * std::pair and Vector.
+     */
+    template <typename T, typename Enable = void>
+    struct Serializer;
+
+    template <typename T>
+    concept Serializable = requires(BinaryWriter &out, BinaryReader &in, const T &value) {
+        Serializer<T>::write(out, value);
+        { Serializer<T>::read(in) } -> std::convertible_to<T>;
+    };
+
+    /**
+     * @brief Appends values to a byte buffer in a portable little-endian format
+     *
+     * Fixed-width integers are stored little-endian, lengths as LEB128 varints and
+     * everything else through Serializer<T>.
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::BinaryWriter out;
+     * out.write(std::uint32_t{7});
+     * out.write(cpp_ex::String("hello"));
+     * sendToDisk(out.getBuffer());
+     * ```
+     */
+    class BinaryWriter
+    {
+    private:
+        std::string buffer;
+
+    public:
+        // Constructores
+        BinaryWriter() = default;
+
+        explicit BinaryWriter(std::size_t capacity)
+        {
+            buffer.reserve(capacity);
+        }
+
+        // Escritura de bajo nivel
+        void writeU8(std::uint8_t value)
+        {
+            buffer.push_back(static_cast<char>(value));
+        }
+
+        void writeU32(std::uint32_t value)
+        {
+            writeLittleEndian(value);
+        }
+
+        void writeU64(std::uint64_t value)
+        {
+            writeLittleEndian(value);
+        }
+
+        // Entero sin signo en LEB128: 1 byte por cada 7 bits significativos
+        void writeVarint(std::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+            buffer.push_back(static_cast<char>(value));
+        }
+
+        void writeBytes(const void *data, std::size_t size)
+        {
+            buffer.append(static_cast<const char *>(data), size);
+        }
+
+        // Longitud (varint) seguida de los bytes
+        void writeString(std::string_view text)
+        {
+            writeVarint(text.size());
+            buffer.append(text);
+        }
+
+        // Sobrescribe 4 bytes ya escritos (p. ej. una longitud conocida al final)
+        void patchU32(std::size_t offset, std::uint32_t value)
+        {
+            for (int b = 0; b < 4; ++b)
+            {
+                buffer[offset + b] = static_cast<char>((value >> (8 * b)) & 0xFF);
+            }
+        }
+
+        template <typename T>
+        void write(const T &value)
+        {
+            Serializer<T>::write(*this, value);
+        }
+
+        // Capacidad
+        std::size_t getSize() const noexcept
+        {
+            return buffer.size();
+        }
+
+        void reserve(std::size_t capacity)
+        {
+            buffer.reserve(capacity);
+        }
+
+        void clear() noexcept
+        {
+            buffer.clear();
+        }
+
+        // Acceso al resultado
+        std::string_view getBuffer() const noexcept
+        {
+            return buffer;
+        }
+
+        std::string takeBuffer() noexcept
+        {
+            return std::exchange(buffer, std::string());
+        }
+
+    private:
+        template <typename U>
+        void writeLittleEndian(U value)
+        {
+            char bytes[sizeof(U)];
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                std::memcpy(bytes, &value, sizeof(U));
+            }
+            else
+            {
+                for (std::size_t b = 0; b < sizeof(U); ++b)
+                {
+                    bytes[b] = static_cast<char>((value >> (8 * b)) & 0xFF);
+                }
+            }
+            buffer.append(bytes, sizeof(U));
+        }
+    };
+
+    /**
+     * @brief Reads values written by BinaryWriter from a byte range it does not own
+     *
+     * Every read checks the remaining size and throws exceptions::SerializationError
+     * instead of reading past the end, so truncated or corrupt input is safe to parse.
+     */
+    class BinaryReader
+    {
+    private:
+        std::string_view data;
+        std::size_t position = 0;
+
+    public:
+        // Constructores
+        explicit BinaryReader(std::string_view data) noexcept : data(data) {}
+
+        BinaryReader(const void *data, std::size_t size) noexcept
+            : data(static_cast<const char *>(data), size) {}
+
+        // Lectura de bajo nivel
+        std::uint8_t readU8()
+        {
+            require(1);
+            return static_cast<std::uint8_t>(data[position++]);
+        }
+
+        std::uint32_t readU32()
+        {
+            return readLittleEndian<std::uint32_t>();
+        }
+
+        std::uint64_t readU64()
+        {
+            return readLittleEndian<std::uint64_t>();
+        }
+
+        std::uint64_t readVarint()
+        {
+            std::uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                std::uint8_t byte = readU8();
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    return value;
+                }
+            }
+            throw exceptions::SerializationError("BinaryReader: varint too long");
+        }
+
+        // Vista de los próximos size bytes (válida mientras lo sea la entrada)
+        std::string_view readBytes(std::size_t size)
+        {
+            require(size);
+            std::string_view bytes = data.substr(position, size);
+            position += size;
+            return bytes;
+        }
+
+        std::string_view readStringView()
+        {
+            return readBytes(readLength());
+        }
+
+        std::string readString()
+        {
+            return std::string(readStringView());
+        }
+
+        template <typename T>
+        T read()
+        {
+            return Serializer<T>::read(*this);
+        }
+
+        // Longitud en varint, descartando las que no caben en lo que queda
+        std::size_t readLength()
+        {
+            std::uint64_t length = readVarint();
+            if (length > getRemaining())
+            {
+                throw exceptions::SerializationError("BinaryReader: length exceeds the input");
+            }
+            return static_cast<std::size_t>(length);
+        }
+
+        // Posición
+        std::size_t getPosition() const noexcept
+        {
+            return position;
+        }
+
+        std::size_t getRemaining() const noexcept
+        {
+            return data.size() - position;
+        }
+
+        bool isAtEnd() const noexcept
+        {
+            return position == data.size();
+        }
+
+        void skip(std::size_t size)
+        {
+            require(size);
+            position += size;
+        }
+
+    private:
+        void require(std::size_t size) const
+        {
+            if (size > data.size() - position)
+            {
+                throw exceptions::SerializationError("BinaryReader: unexpected end of input");
+            }
+        }
+
+        template <typename U>
+        U readLittleEndian()
+        {
+            require(sizeof(U));
+            U value = 0;
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                std::memcpy(&value, data.data() + position, sizeof(U));
+            }
+            else
+            {
+                for (std::size_t b = 0; b < sizeof(U); ++b)
+                {
+                    value |= static_cast<U>(static_cast<unsigned char>(data[position + b])) << (8 * b);
+                }
+            }
+            position += sizeof(U);
+            return value;
+        }
+    };
+
+    // Enteros, coma flotante y enumerados: ancho fijo, little-endian
+    template <typename T>
+    struct Serializer<T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>>>
+    {
+        static void write(BinaryWriter &out, const T &value)
+        {
+            if constexpr (sizeof(T) == 1)
+            {
+                out.writeU8(std::bit_cast<std::uint8_t>(value));
+            }
+            else
+            {
+                using Bits = std::conditional_t<sizeof(T) <= 4, std::uint32_t, std::uint64_t>;
+                static_assert(sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "Serializer: unsupported scalar size");
+                if constexpr (sizeof(T) == 2)
+                {
+                    auto bits = std::bit_cast<std::uint16_t>(value);
+                    out.writeU8(static_cast<std::uint8_t>(bits & 0xFF));
+                    out.writeU8(static_cast<std::uint8_t>(bits >> 8));
+                }
+                else if constexpr (sizeof(T) == 4)
+                {
+                    out.writeU32(std::bit_cast<Bits>(value));
+                }
+                else
+                {
+                    out.writeU64(std::bit_cast<Bits>(value));
+                }
+            }
+        }
+
+        static T read(BinaryReader &in)
+        {
+            if constexpr (sizeof(T) == 1)
+            {
+                return std::bit_cast<T>(in.readU8());
+            }
+            else if constexpr (sizeof(T) == 2)
+            {
+                std::uint16_t low = in.readU8();
+                std::uint16_t high = in.readU8();
+                return std::bit_cast<T>(static_cast<std::uint16_t>(low | (high << 8)));
+            }
+            else if constexpr (sizeof(T) == 4)
+            {
+                return std::bit_cast<T>(in.readU32());
+            }
+            else
+            {
+                return std::bit_cast<T>(in.readU64());
+            }
+        }
+    };
+
+    template <>
+    struct Serializer<bool>
+    {
+        static void write(BinaryWriter &out, bool value)
+        {
+            out.writeU8(value ? 1 : 0);
+        }
+
+        static bool read(BinaryReader &in)
+        {
+            std::uint8_t byte = in.readU8();
+            if (byte > 1)
+            {
+                throw exceptions::SerializationError("BinaryReader: invalid bool");
+            }
+            return byte == 1;
+        }
+    };
+
+    template <>
+    struct Serializer<std::string>
+    {
+        static void write(BinaryWriter &out, const std::string &value)
+        {
+            out.writeString(value);
+        }
+
+        static std::string read(BinaryReader &in)
+        {
+            return in.readString();
+        }
+    };
+
+    template <>
+    struct Serializer<String>
+    {
+        static void write(BinaryWriter &out, const String &value)
+        {
+            out.writeString(value.getStringView());
+        }
+
+        static String read(BinaryReader &in)
+        {
+            return String(in.readString());
+        }
+    };
+
+    template <typename First, typename Second>
+    struct Serializer<std::pair<First, Second>>
+    {
+        static void write(BinaryWriter &out, const std::pair<First, Second> &value)
+        {
+            out.write(value.first);
+            out.write(value.second);
+        }
+
+        static std::pair<First, Second> read(BinaryReader &in)
+        {
+            // Dos sentencias: fijan el orden de lectura
+            First first = in.read<First>();
+            Second second = in.read<Second>();
+            return {std::move(first), std::move(second)};
+        }
+    };
+
+    // Número de elementos (varint) y los elementos
+    template <typename T>
+    struct Serializer<Vector<T>>
+    {
+        static void write(BinaryWriter &out, const Vector<T> &values)
+        {
+            out.writeVarint(values.getSize());
+            for (const auto &value : values)
+            {
+                out.write(value);
+            }
+        }
+
+        static Vector<T> read(BinaryReader &in)
+        {
+            // Cada elemento ocupa al menos un byte: acota la reserva con datos corruptos
+            std::size_t count = in.readLength();
+            Vector<T> values;
+            values.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                values.pushBack(in.read<T>());
+            }
+            return values;
+        }
+    };
+
+    namespace detail
+    {
+        template <typename Key>
+        constexpr bool kIsDeltaIntegerKey = std::is_integral_v<Key> && !std::is_same_v<Key, bool>;
+
+        template <typename Key>
+        constexpr bool kIsDeltaStringKey = std::is_same_v<Key, String> || std::is_same_v<Key, std::string>;
+
+        inline std::string_view deltaKeyView(const String &key) noexcept
+        {
+            return key.getStringView();
+        }
+
+        inline std::string_view deltaKeyView(const std::string &key) noexcept
+        {
+            return key;
+        }
+
+        /**
+         * @brief Writes a key of a sorted MapDelta list relative to the previous one
+         *
+         * Integers are stored as the zigzag varint of the gap to the previous key, and
+         * strings as the length of the prefix shared with the previous key plus the rest.
+         * Other types go through their Serializer.
+         */
+        template <typename Key>
+        void writeDeltaKey(BinaryWriter &out, const Key *previous, const Key &key)
+        {
+            if constexpr (kIsDeltaIntegerKey<Key>)
+            {
+                auto gap = static_cast<std::uint64_t>(key) - (previous ? static_cast<std::uint64_t>(*previous) : 0);
+                out.writeVarint((gap << 1) ^ (std::uint64_t{0} - (gap >> 63)));
+            }
+            else if constexpr (kIsDeltaStringKey<Key>)
+            {
+                std::string_view text = deltaKeyView(key);
+                std::string_view before = previous ? deltaKeyView(*previous) : std::string_view();
+                auto shared = static_cast<std::size_t>(std::mismatch(text.begin(), text.end(), before.begin(), before.end()).first - text.begin());
+                out.writeVarint(shared);
+                out.writeString(text.substr(shared));
+            }
+            else
+            {
+                out.write(key);
+            }
+        }
+
+        template <typename Key>
+        Key readDeltaKey(BinaryReader &in, const Key *previous)
+        {
+            if constexpr (kIsDeltaIntegerKey<Key>)
+            {
+                std::uint64_t zigzag = in.readVarint();
+                auto gap = (zigzag >> 1) ^ (std::uint64_t{0} - (zigzag & 1));
+                return static_cast<Key>((previous ? static_cast<std::uint64_t>(*previous) : 0) + gap);
+            }
+            else if constexpr (kIsDeltaStringKey<Key>)
+            {
+                std::string_view before = previous ? deltaKeyView(*previous) : std::string_view();
+                std::uint64_t shared = in.readVarint();
+                if (shared > before.size())
+                {
+                    throw exceptions::SerializationError("MapDelta: shared key prefix longer than the previous key");
+                }
+                std::string text(before.substr(0, static_cast<std::size_t>(shared)));
+                text += in.readStringView();
+                return Key(std::move(text));
+            }
+            else
+            {
+                return in.read<Key>();
+            }
+        }
+    }
+
+    // Indicador de reset y las listas removed, changed y added: número de entradas
+    // (varint) y cada clave codificada respecto a la anterior de su lista
+    template <typename Key, typename Value>
+    struct Serializer<MapDelta<Key, Value>>
+    {
+        static void write(BinaryWriter &out, const MapDelta<Key, Value> &delta)
+        {
+            out.writeU8(delta.reset ? 1 : 0);
+            out.writeVarint(delta.removed.getSize());
+            const Key *previous = nullptr;
+            for (const auto &key : delta.removed)
+            {
+                detail::writeDeltaKey(out, previous, key);
+                previous = &key;
+            }
+            writeEntries(out, delta.changed);
+            writeEntries(out, delta.added);
+        }
+
+        static MapDelta<Key, Value> read(BinaryReader &in)
+        {
+            MapDelta<Key, Value> delta;
+            std::uint8_t flags = in.readU8();
+            if (flags > 1)
+            {
+                throw exceptions::SerializationError("MapDelta: unknown flags");
+            }
+            delta.reset = flags == 1;
+            std::size_t count = in.readLength();
+            delta.removed.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                delta.removed.pushBack(detail::readDeltaKey<Key>(in, i == 0 ? nullptr : &delta.removed[i - 1]));
+            }
+            delta.changed = readEntries(in);
+            delta.added = readEntries(in);
+            return delta;
+        }
+
+    private:
+        static void writeEntries(BinaryWriter &out, const Vector<std::pair<Key, Value>> &entries)
+        {
+            out.writeVarint(entries.getSize());
+            const Key *previous = nullptr;
+            for (const auto &[key, value] : entries)
+            {
+                detail::writeDeltaKey(out, previous, key);
+                out.write(value);
+                previous = &key;
+            }
+        }
+
+        static Vector<std::pair<Key, Value>> readEntries(BinaryReader &in)
+        {
+            std::size_t count = in.readLength();
+            Vector<std::pair<Key, Value>> entries;
+            entries.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                Key key = detail::readDeltaKey<Key>(in, i == 0 ? nullptr : &entries[i - 1].first);
+                Value value = in.read<Value>();
+                entries.emplaceBack(std::move(key), std::move(value));
+            }
+            return entries;
+        }
+    };
+
+} // namespace cppex
+
+#endif // CPPEX_SERIALIZATION_HPP
@@ -0,0 +1,1074 @@
+/**
+ * @file small_map.hpp
+ * @brief Ordered map that keeps up to N entries inline and spills to cpp_ex::Map
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_SMALL_MAP_HPP
+#define CPPEX_SMALL_MAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "common.hpp"    // Include detail::IsTransparent
+#include "vector.hpp"    // Include Vector class
+#include "map.hpp"       // Include Map class
+#include "map_entry.hpp" // Include MapEntryRef
+
+namespace cpp_ex
+{
+
+    /**
+     * @brief Ordered map that stores up to N entries inside the object itself
+     *
+     * Most maps in a request path are tiny (headers, short query strings, flags), yet
+     * cpp_ex::Map allocates one tree node per entry. SmallMap keeps its first N entries
+     * in two sorted arrays embedded in the object, so building, copying and destroying
+     * a small map does not touch the heap at all. Lookups scan the key array linearly:
+     * for arithmetic keys the scan counts smaller keys without branches, which the
+     * compiler vectorizes.
+     *
+     * Inserting entry N + 1 moves everything into a heap-allocated cpp_ex::Map, and
+     * the map keeps working unchanged (same order, same API). It stays there until
+     * `clear()` or `shrinkToFit()` brings it back inline.
+     *
+     * Any insertion or erasure may invalidate iterators and references: inline entries
+     * shift inside the arrays and migration moves them to the tree. Iterators
+     * dereference to a MapEntryRef (`first`/`second`) instead of `std::pair&`.
+     *
+     * @tparam Key Type of the keys
+     * @tparam Value Type of the mapped values
+     * @tparam N Number of entries stored inline
+     * @tparam Compare Comparison function object type, defaults to std::less<Key>
+     *
+     * @example
+     * ```cpp
+     * cpp_ex::SmallMap<cpp_ex::String, cpp_ex::String, 8> headers;
+     * headers["Host"] = "example.com";          // No allocation for the map itself
+     * headers["Accept"] = "text/html";
+     *
+     * if (auto it = headers.find("Host"); it != headers.end()) {
+     *     route(it->second);
+     * }
+     * ```
+     */
+    template <typename Key, typename Value, std::size_t N = 8, typename Compare = std::less<Key>>
+    class SmallMap
+    {
+        static_assert(N > 0, "SmallMap needs room for at least one inline entry");
+
+    private:
+        using LargeMap = Map<Key, Value, Compare>;
+
+        // Claves aritméticas con comparador estándar: búsqueda sin saltos
+        static constexpr bool kBranchlessSearch =
+            std::is_arithmetic_v<Key> &&
+            (std::is_same_v<Compare, std::less<Key>> || std::is_same_v<Compare, std::greater<Key>> ||
+             std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::greater<>>);
+
+        alignas(Key) unsigned char keyStorage[sizeof(Key) * N];
+        alignas(Value) unsigned char valueStorage[sizeof(Value) * N];
+        std::size_t used = 0;            // Entradas inline (0 cuando large está activo)
+        std::unique_ptr<LargeMap> large; // Backend tras superar N entradas
+        [[no_unique_address]] Compare comp;
+
+        template <bool IsConst>
+        class Iterator
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = std::pair<Key, Value>;
+            using difference_type = std::ptrdiff_t;
+            using reference = MapEntryRef<Key, std::conditional_t<IsConst, const Value, Value>>;
+            using pointer = MapEntryArrow<reference>;
+
+        private:
+            friend class SmallMap;
+
+            using ValuePointer = std::conditional_t<IsConst, const Value *, Value *>;
+            using NodeIterator = std::conditional_t<IsConst, typename LargeMap::const_iterator, typename LargeMap::iterator>;
+
+            // key != nullptr: posición inline; si no, posición en el Map
+            const Key *key = nullptr;
+            ValuePointer value = nullptr;
+            NodeIterator node{};
+
+            Iterator(const Key *k, ValuePointer v) noexcept : key(k), value(v) {}
+
+            explicit Iterator(NodeIterator n) noexcept : node(n) {}
+
+        public:
+            Iterator() = default;
+
+            // Conversión de iterator a const_iterator
+            template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+            Iterator(const Iterator<OtherConst> &other) noexcept : key(other.key), value(other.value), node(other.node) {}
+
+            reference operator*() const noexcept
+            {
+                if (key != nullptr)
+                {
+                    return reference(*key, *value);
+                }
+                return reference(node->first, node->second);
+            }
+
+            pointer operator->() const noexcept
+            {
+                return pointer{**this};
+            }
+
+            Iterator &operator++() noexcept
+            {
+                if (key != nullptr)
+                {
+                    ++key;
+                    ++value;
+                }
+                else
+                {
+                    ++node;
+                }
+                return *this;
+            }
+
+            Iterator operator++(int) noexcept
+            {
+                Iterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            Iterator &operator--() noexcept
+            {
+                if (key != nullptr)
+                {
+                    --key;
+                    --value;
+                }
+                else
+                {
+                    --node;
+                }
+                return *this;
+            }
+
+            Iterator operator--(int) noexcept
+            {
+                Iterator tmp = *this;
+                --(*this);
+                return tmp;
+            }
+
+            friend bool operator==(const Iterator &a, const Iterator &b) noexcept
+            {
+                return a.key == b.key && (a.key != nullptr || a.node == b.node);
+            }
+
+            friend bool operator!=(const Iterator &a, const Iterator &b) noexcept
+            {
+                return !(a == b);
+            }
+
+            template <bool B>
+            friend class Iterator;
+        };
+
+    public:
+        // Tipos (aliases)
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<Key, Value>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using key_compare = Compare;
+        using reference = MapEntryRef<Key, Value>;
+        using const_reference = MapEntryRef<Key, const Value>;
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        // Constructores
+        SmallMap() = default;
+
+        explicit SmallMap(const Compare &comp) : comp(comp) {}
+
+        template <typename InputIt>
+        SmallMap(InputIt first, InputIt last, const Compare &comp = Compare()) : comp(comp)
+        {
+            insert(first, last);
+        }
+
+        SmallMap(std::initializer_list<value_type> init, const Compare &comp = Compare())
+            : SmallMap(init.begin(), init.end(), comp) {}
+
+        // Desde un Map: las entradas ya llegan ordenadas
+        explicit SmallMap(const LargeMap &map) : comp(map.keyComp())
+        {
+            if (map.getSize() > N)
+            {
+                large = std::make_unique<LargeMap>(map);
+                return;
+            }
+            for (const auto &[key, value] : map)
+            {
+                appendInline(key, value);
+            }
+        }
+
+        SmallMap(const SmallMap &other) : comp(other.comp)
+        {
+            if (other.large)
+            {
+                large = std::make_unique<LargeMap>(*other.large);
+                return;
+            }
+            for (size_type i = 0; i < other.used; ++i)
+            {
+                appendInline(other.keys()[i], other.values()[i]);
+            }
+        }
+
+        SmallMap(SmallMap &&other) noexcept(std::is_nothrow_move_constructible_v<Key> && std::is_nothrow_move_constructible_v<Value>)
+            : comp(other.comp)
+        {
+            stealFrom(other);
+        }
+
+        ~SmallMap()
+        {
+            destroyInline();
+        }
+
+        // Operadores de asignación
+        SmallMap &operator=(const SmallMap &other)
+        {
+            if (this != &other)
+            {
+                SmallMap tmp(other);
+                *this = std::move(tmp);
+            }
+            return *this;
+        }
+
+        SmallMap &operator=(SmallMap &&other) noexcept(std::is_nothrow_move_constructible_v<Key> && std::is_nothrow_move_constructible_v<Value>)
+        {
+            if (this != &other)
+            {
+                clear();
+                comp = other.comp;
+                stealFrom(other);
+            }
+            return *this;
+        }
+
+        SmallMap &operator=(std::initializer_list<value_type> ilist)
+        {
+            SmallMap tmp(ilist, comp);
+            *this = std::move(tmp);
+            return *this;
+        }
+
+        // Iteradores
+        iterator begin() noexcept
+        {
+            if (large)
+            {
+                return iterator(large->begin());
+            }
+            return iterator(keys(), values());
+        }
+
+        const_iterator begin() const noexcept
+        {
+            if (large)
+            {
+                return const_iterator(std::as_const(*large).begin());
+            }
+            return const_iterator(keys(), values());
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        iterator end() noexcept
+        {
+            if (large)
+            {
+                return iterator(large->end());
+            }
+            return iterator(keys() + used, values() + used);
+        }
+
+        const_iterator end() const noexcept
+        {
+            if (large)
+            {
+                return const_iterator(std::as_const(*large).end());
+            }
+            return const_iterator(keys() + used, values() + used);
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return rbegin();
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        const_reverse_iterator crend() const noexcept
+        {
+            return rend();
+        }
+
+        // Capacidad
+        bool isEmpty() const noexcept
+        {
+            return getSize() == 0;
+        }
+
+        size_type getSize() const noexcept
+        {
+            return large ? large->getSize() : used;
+        }
+
+        size_type getMaxSize() const noexcept
+        {
+            return LargeMap().getMaxSize();
+        }
+
+        // true mientras las entradas viven dentro del objeto (sin memoria dinámica)
+        bool isInline() const noexcept
+        {
+            return !large;
+        }
+
+        // Número de entradas que caben sin reservar memoria
+        static constexpr size_type getInlineCapacity() noexcept
+        {
+            return N;
+        }
+
+        // Vuelve al almacenamiento inline si las entradas caben
+        void shrinkToFit()
+        {
+            if (!large || large->getSize() > N)
+            {
+                return;
+            }
+            std::unique_ptr<LargeMap> source = std::move(large);
+            for (auto &[key, value] : source->getStdMap())
+            {
+                appendInline(key, std::move(value));
+            }
+        }
+
+        // Acceso a elementos
+        mapped_type &at(const key_type &key)
+        {
+            auto it = find(key);
+            if (it == end())
+            {
+                throw std::out_of_range("SmallMap::at: key not found");
+            }
+            return it->second;
+        }
+
+        const mapped_type &at(const key_type &key) const
+        {
+            auto it = find(key);
+            if (it == end())
+            {
+                throw std::out_of_range("SmallMap::at: key not found");
+            }
+            return it->second;
+        }
+
+        mapped_type &operator[](const key_type &key)
+        {
+            return tryEmplace(key).first->second;
+        }
+
+        mapped_type &operator[](key_type &&key)
+        {
+            return tryEmplace(std::move(key)).first->second;
+        }
+
+        // Modificadores
+        // Libera el Map de respaldo: el mapa vuelve a ser inline
+        void clear() noexcept
+        {
+            destroyInline();
+            large.reset();
+        }
+
+        std::pair<iterator, bool> insert(const value_type &value)
+        {
+            return tryEmplace(value.first, value.second);
+        }
+
+        std::pair<iterator, bool> insert(value_type &&value)
+        {
+            return tryEmplace(std::move(value.first), std::move(value.second));
+        }
+
+        template <typename P, typename = std::enable_if_t<std::is_constructible_v<value_type, P &&>>>
+        std::pair<iterator, bool> insert(P &&value)
+        {
+            return emplace(std::forward<P>(value));
+        }
+
+        template <typename InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+            {
+                const auto &entry = *first;
+                tryEmplace(entry.first, entry.second);
+            }
+        }
+
+        void insert(std::initializer_list<value_type> ilist)
+        {
+            insert(ilist.begin(), ilist.end());
+        }
+
+        template <typename M>
+        std::pair<iterator, bool> insertOrAssign(const key_type &key, M &&value)
+        {
+            auto result = tryEmplace(key, std::forward<M>(value));
+            if (!result.second)
+            {
+                result.first->second = std::forward<M>(value);
+            }
+            return result;
+        }
+
+        template <typename M>
+        std::pair<iterator, bool> insertOrAssign(key_type &&key, M &&value)
+        {
+            auto result = tryEmplace(std::move(key), std::forward<M>(value));
+            if (!result.second)
+            {
+                result.first->second = std::forward<M>(value);
+            }
+            return result;
+        }
+
+        template <typename... Args>
+        std::pair<iterator, bool> emplace(Args &&...args)
+        {
+            value_type tmp(std::forward<Args>(args)...);
+            return tryEmplace(std::move(tmp.first), std::move(tmp.second));
+        }
+
+        // Inserción con hint: O(1) si la clave va justo antes de hint (p. ej. cargas ordenadas con end())
+        template <typename K, typename... Args>
+        iterator emplaceHint(const_iterator hint, K &&key, Args &&...args)
+        {
+            if (large)
+            {
+                return iterator(large->getStdMap().emplace_hint(hint.node, std::forward<K>(key), std::forward<Args>(args)...));
+            }
+            size_type index = indexOf(hint);
+            bool fits = used < N &&
+                        (index == 0 || comp(keys()[index - 1], key)) &&
+                        (index == used || comp(key, keys()[index]));
+            if (fits)
+            {
+                return insertInline(index, Key(std::forward<K>(key)), Value(std::forward<Args>(args)...));
+            }
+            return tryEmplace(Key(std::forward<K>(key)), std::forward<Args>(args)...).first;
+        }
+
+        // Construye el valor solo si la clave no existe
+        template <typename... Args>
+        std::pair<iterator, bool> tryEmplace(const key_type &key, Args &&...args)
+        {
+            return tryEmplaceImpl(key, std::forward<Args>(args)...);
+        }
+
+        template <typename... Args>
+        std::pair<iterator, bool> tryEmplace(key_type &&key, Args &&...args)
+        {
+            return tryEmplaceImpl(std::move(key), std::forward<Args>(args)...);
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            if (large)
+            {
+                return iterator(large->erase(pos.node));
+            }
+            return eraseInline(indexOf(pos), indexOf(pos) + 1);
+        }
+
+        iterator erase(iterator pos)
+        {
+            return erase(const_iterator(pos));
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            if (large)
+            {
+                return iterator(large->erase(first.node, last.node));
+            }
+            return eraseInline(indexOf(first), indexOf(last));
+        }
+
+        size_type erase(const key_type &key)
+        {
+            if (large)
+            {
+                return large->erase(key);
+            }
+            size_type index = findIndex(key);
+            if (index == used)
+            {
+                return 0;
+            }
+            eraseInline(index, index + 1);
+            return 1;
+        }
+
+        void swap(SmallMap &other) noexcept(std::is_nothrow_move_constructible_v<Key> && std::is_nothrow_move_constructible_v<Value>)
+        {
+            SmallMap tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+
+        // Lookup
+        size_type count(const key_type &key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        iterator find(const key_type &key)
+        {
+            return findImpl(key);
+        }
+
+        const_iterator find(const key_type &key) const
+        {
+            return const_cast<SmallMap *>(this)->findImpl(key);
+        }
+
+        bool contains(const key_type &key) const
+        {
+            return find(key) != end();
+        }
+
+        std::pair<iterator, iterator> equalRange(const key_type &key)
+        {
+            auto first = lowerBound(key);
+            auto last = first;
+            if (last != end() && !comp(key, last->first))
+            {
+                ++last;
+            }
+            return {first, last};
+        }
+
+        std::pair<const_iterator, const_iterator> equalRange(const key_type &key) const
+        {
+            return const_cast<SmallMap *>(this)->equalRange(key);
+        }
+
+        iterator lowerBound(const key_type &key)
+        {
+            return lowerBoundImpl(key);
+        }
+
+        const_iterator lowerBound(const key_type &key) const
+        {
+            return const_cast<SmallMap *>(this)->lowerBoundImpl(key);
+        }
+
+        iterator upperBound(const key_type &key)
+        {
+            return upperBoundImpl(key);
+        }
+
+        const_iterator upperBound(const key_type &key) const
+        {
+            return const_cast<SmallMap *>(this)->upperBoundImpl(key);
+        }
+
+        // Lookup heterogéneo (requiere un comparador transparente)
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        size_type count(const K &key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        iterator find(const K &key)
+        {
+            return findImpl(key);
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        const_iterator find(const K &key) const
+        {
+            return const_cast<SmallMap *>(this)->findImpl(key);
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        bool contains(const K &key) const
+        {
+            return find(key) != end();
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        iterator lowerBound(const K &key)
+        {
+            return lowerBoundImpl(key);
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        const_iterator lowerBound(const K &key) const
+        {
+            return const_cast<SmallMap *>(this)->lowerBoundImpl(key);
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        iterator upperBound(const K &key)
+        {
+            return upperBoundImpl(key);
+        }
+
+        template <typename K>
+            requires detail::IsTransparent<Compare>
+        const_iterator upperBound(const K &key) const
+        {
+            return const_cast<SmallMap *>(this)->upperBoundImpl(key);
+        }
+
+        // Observadores
+        key_compare keyComp() const
+        {
+            return comp;
+        }
+
+        // Operadores de comparación
+        bool operator==(const SmallMap &other) const
+        {
+            return getSize() == other.getSize() && std::equal(begin(), end(), other.begin(), other.end(),
+                                                              [](const const_reference &a, const const_reference &b)
+                                                              { return a.first == b.first && a.second == b.second; });
+        }
+
+        bool operator!=(const SmallMap &other) const
+        {
+            return !(*this == other);
+        }
+
+        bool operator<(const SmallMap &other) const
+        {
+            return std::lexicographical_compare(begin(), end(), other.begin(), other.end(),
+                                                [](const const_reference &a, const const_reference &b)
+                                                {
+                                                    return a.first < b.first || (!(b.first < a.first) && a.second < b.second);
+                                                });
+        }
+
+        bool operator<=(const SmallMap &other) const
+        {
+            return !(other < *this);
+        }
+
+        bool operator>(const SmallMap &other) const
+        {
+            return other < *this;
+        }
+
+        bool operator>=(const SmallMap &other) const
+        {
+            return !(*this < other);
+        }
+
+        // Métodos adicionales que usan cppex::Vector
+
+        // Obtener todas las claves como un Vector
+        Vector<Key> getKeys() const
+        {
+            Vector<Key> result;
+            result.reserve(getSize());
+            forEach([&result](const Key &key, const Value &)
+                    { result.pushBack(key); });
+            return result;
+        }
+
+        // Obtener todos los valores como un Vector
+        Vector<Value> getValues() const
+        {
+            Vector<Value> result;
+            result.reserve(getSize());
+            forEach([&result](const Key &, const Value &value)
+                    { result.pushBack(value); });
+            return result;
+        }
+
+        // Obtener todos los pares como un Vector
+        Vector<std::pair<Key, Value>> getEntries() const
+        {
+            Vector<std::pair<Key, Value>> entries;
+            entries.reserve(getSize());
+            forEach([&entries](const Key &key, const Value &value)
+                    { entries.emplaceBack(key, value); });
+            return entries;
+        }
+
+        // Copia las entradas a un cpp_ex::Map
+        LargeMap toMap() const
+        {
+            if (large)
+            {
+                return *large;
+            }
+            LargeMap result(comp);
+            auto &data = result.getStdMap();
+            for (size_type i = 0; i < used; ++i)
+            {
+                data.emplace_hint(data.end(), keys()[i], values()[i]);
+            }
+            return result;
+        }
+
+        // Mapear valores a un nuevo tipo
+        template <typename ResultType, typename UnaryFunc>
+        SmallMap<Key, ResultType, N, Compare> mapValues(UnaryFunc func) const
+        {
+            SmallMap<Key, ResultType, N, Compare> result(comp);
+            forEach([&](const Key &key, const Value &value)
+                    { result.emplaceHint(result.end(), key, func(value)); });
+            return result;
+        }
+
+        // Filtrar entradas según un predicado
+        template <typename BinaryPredicate>
+        SmallMap filterEntries(BinaryPredicate pred) const
+        {
+            SmallMap result(comp);
+            forEach([&](const Key &key, const Value &value)
+                    {
+                        if (pred(key, value))
+                        {
+                            result.emplaceHint(result.end(), key, value);
+                        } });
+            return result;
+        }
+
+        // Ejecutar una función para cada par clave-valor
+        template <typename BinaryFunc>
+        void forEach(BinaryFunc func)
+        {
+            if (large)
+            {
+                large->forEach(func);
+                return;
+            }
+            for (size_type i = 0; i < used; ++i)
+            {
+                func(static_cast<const Key &>(keys()[i]), values()[i]);
+            }
+        }
+
+        template <typename BinaryFunc>
+        void forEach(BinaryFunc func) const
+        {
+            if (large)
+            {
+                std::as_const(*large).forEach(func);
+                return;
+            }
+            for (size_type i = 0; i < used; ++i)
+            {
+                func(static_cast<const Key &>(keys()[i]), static_cast<const Value &>(values()[i]));
+            }
+        }
+
+    private:
+        Key *keys() noexcept
+        {
+            return reinterpret_cast<Key *>(keyStorage);
+        }
+
+        const Key *keys() const noexcept
+        {
+            return reinterpret_cast<const Key *>(keyStorage);
+        }
+
+        Value *values() noexcept
+        {
+            return reinterpret_cast<Value *>(valueStorage);
+        }
+
+        const Value *values() const noexcept
+        {
+            return reinterpret_cast<const Value *>(valueStorage);
+        }
+
+        size_type indexOf(const_iterator it) const noexcept
+        {
+            return static_cast<size_type>(it.key - keys());
+        }
+
+        iterator iteratorAt(size_type index) noexcept
+        {
+            return iterator(keys() + index, values() + index);
+        }
+
+        // Número de claves menores que key (= lower bound en el array ordenado)
+        template <typename K>
+        size_type lowerBoundIndex(const K &key) const
+        {
+            const Key *k = keys();
+            if constexpr (kBranchlessSearch)
+            {
+                size_type pos = 0;
+                for (size_type i = 0; i < used; ++i)
+                {
+                    pos += static_cast<size_type>(comp(k[i], key));
+                }
+                return pos;
+            }
+            else
+            {
+                size_type pos = 0;
+                while (pos < used && comp(k[pos], key))
+                {
+                    ++pos;
+                }
+                return pos;
+            }
+        }
+
+        // Número de claves que no son mayores que key (= upper bound)
+        template <typename K>
+        size_type upperBoundIndex(const K &key) const
+        {
+            const Key *k = keys();
+            if constexpr (kBranchlessSearch)
+            {
+                size_type pos = 0;
+                for (size_type i = 0; i < used; ++i)
+                {
+                    pos += static_cast<size_type>(!comp(key, k[i]));
+                }
+                return pos;
+            }
+            else
+            {
+                size_type pos = 0;
+                while (pos < used && !comp(key, k[pos]))
+                {
+                    ++pos;
+                }
+                return pos;
+            }
+        }
+
+        // Índice de key, o used si no está
+        template <typename K>
+        size_type findIndex(const K &key) const
+        {
+            size_type pos = lowerBoundIndex(key);
+            if (pos < used && !comp(key, keys()[pos]))
+            {
+                return pos;
+            }
+            return used;
+        }
+
+        template <typename K>
+        iterator findImpl(const K &key)
+        {
+            if (large)
+            {
+                return iterator(large->find(key));
+            }
+            return iteratorAt(findIndex(key));
+        }
+
+        template <typename K>
+        iterator lowerBoundImpl(const K &key)
+        {
+            if (large)
+            {
+                return iterator(large->lowerBound(key));
+            }
+            return iteratorAt(lowerBoundIndex(key));
+        }
+
+        template <typename K>
+        iterator upperBoundImpl(const K &key)
+        {
+            if (large)
+            {
+                return iterator(large->upperBound(key));
+            }
+            return iteratorAt(upperBoundIndex(key));
+        }
+
+        // K es siempre key_type (const& o &&)
+        template <typename K, typename... Args>
+        std::pair<iterator, bool> tryEmplaceImpl(K &&key, Args &&...args)
+        {
+            if (!large)
+            {
+                size_type pos = lowerBoundIndex(key);
+                if (pos < used && !comp(key, keys()[pos]))
+                {
+                    return {iteratorAt(pos), false};
+                }
+                if (used < N)
+                {
+                    return {insertInline(pos, Key(std::forward<K>(key)), Value(std::forward<Args>(args)...)), true};
+                }
+                migrate();
+            }
+            auto result = large->getStdMap().try_emplace(std::forward<K>(key), std::forward<Args>(args)...);
+            return {iterator(result.first), result.second};
+        }
+
+        // Mueve la entrada construida a la posición index (used < N)
+        iterator insertInline(size_type index, Key &&key, Value &&value)
+        {
+            openGap(keys(), index, used);
+            openGap(values(), index, used);
+            std::construct_at(keys() + index, std::move(key));
+            std::construct_at(values() + index, std::move(value));
+            ++used;
+            return iteratorAt(index);
+        }
+
+        iterator eraseInline(size_type first, size_type last)
+        {
+            if (first == last)
+            {
+                return iteratorAt(first);
+            }
+            std::move(keys() + last, keys() + used, keys() + first);
+            std::move(values() + last, values() + used, values() + first);
+            size_type newCount = used - (last - first);
+            std::destroy(keys() + newCount, keys() + used);
+            std::destroy(values() + newCount, values() + used);
+            used = newCount;
+            return iteratorAt(first);
+        }
+
+        // Añade al final sin buscar (la entrada es mayor que todas las existentes)
+        template <typename K, typename V>
+        void appendInline(K &&key, V &&value)
+        {
+            std::construct_at(keys() + used, std::forward<K>(key));
+            std::construct_at(values() + used, std::forward<V>(value));
+            ++used;
+        }
+
+        // Pasa las entradas inline a un Map en el heap
+        void migrate()
+        {
+            auto map = std::make_unique<LargeMap>(comp);
+            auto &data = map->getStdMap();
+            for (size_type i = 0; i < used; ++i)
+            {
+                data.emplace_hint(data.end(), std::move(keys()[i]), std::move(values()[i]));
+            }
+            destroyInline();
+            large = std::move(map);
+        }
+
+        // this está vacío; other queda vacío e inline
+        void stealFrom(SmallMap &other)
+        {
+            if (other.large)
+            {
+                large = std::move(other.large);
+                return;
+            }
+            for (size_type i = 0; i < other.used; ++i)
+            {
+                appendInline(std::move(other.keys()[i]), std::move(other.values()[i]));
+            }
+            other.destroyInline();
+        }
+
+        void destroyInline() noexcept
+        {
+            std::destroy(keys(), keys() + used);
+            std::destroy(values(), values() + used);
+            used = 0;
+        }
+
+        template <typename T>
+        static void relocate(T *dst, T *src)
+        {
+            std::construct_at(dst, std::move(*src));
+            std::destroy_at(src);
+        }
+
+        // Desplaza [pos, count) una posición a la derecha; deja pos sin construir
+        template <typename T>
+        static void openGap(T *items, size_type pos, size_type count)
+        {
+            for (size_type i = count; i > pos; --i)
+            {
+                relocate(items + i, items + i - 1);
+            }
+        }
+    };
+
+    // Funciones de utilidad fuera de la clase
+    template <typename Key, typename Value, std::size_t N, typename Compare>
+    void swap(SmallMap<Key, Value, N, Compare> &lhs, SmallMap<Key, Value, N, Compare> &rhs) noexcept(noexcept(lhs.swap(rhs)))
+    {
+        lhs.swap(rhs);
+    }
+
+} // namespace cppex
+
+#endif // CPPEX_SMALL_MAP_HPP
@@ -0,0 +1,399 @@
+/**
+ * @file static_map.hpp
+ * @brief Compile-time map over a fixed key set, using a minimal perfect hash
+ * @author cpp_ex team
+ * @date 2025-05-18
+ */
+
+#ifndef CPPEX_STATIC_MAP_HPP
+#define CPPEX_STATIC_MAP_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "string.hpp" // Include String class y detail::stringKeyView
+
+namespace cpp_ex
+{
+    namespace detail
+    {
+        // Finalizador de splitmix64: se evalúa igual en compilación y en ejecución
+        constexpr std::uint64_t staticMix(std::uint64_t h) noexcept
+        {
+            h ^= h >> 30;
+            h *= 0xBF58476D1CE4E5B9ULL;
+            h ^= h >> 27;
+            h *= 0x94D049BB133111EBULL;
+            h ^= h >> 31;
+            return h;
+        }
+
+        // Entero little-endian de Count bytes: en compilación se monta byte a byte, en
+        // ejecución (little-endian) es una sola lectura con el mismo resultado
+        template <std::size_t Count>
+        constexpr std::uint64_t loadStaticWord(const char *bytes) noexcept
+        {
+            if !consteval
+            {
+                if constexpr (std::endian::native == std::endian::little)
+                {
+                    std::uint64_t word = 0;
+                    std::memcpy(&word, bytes, Count);
+                    return word;
+                }
+            }
+            std::uint64_t word = 0;
+            for (std::size_t b = 0; b < Count; ++b)
+            {
+                word |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[b])) << (8 * b);
+            }
+            return word;
+        }
+
+        // Hash de texto por palabras de 8 bytes; el resto se lee con lecturas solapadas
+        constexpr std::uint64_t staticHash(std::string_view key, std::uint64_t seed) noexcept
+        {
+            constexpr std::uint64_t kMultiplier = 0x9E3779B97F4A7C15ULL;
+            const char *data = key.data();
+            std::size_t size = key.size();
+            std::uint64_t h = seed ^ (size * kMultiplier);
+            std::size_t i = 0;
+            for (; i + 8 < size; i += 8)
+            {
+                h = (h ^ loadStaticWord<8>(data + i)) * kMultiplier;
+                h ^= h >> 29;
+            }
+            std::uint64_t tail = 0;
+            if (size >= 8)
+            {
+                tail = loadStaticWord<8>(data + size - 8);
+            }
+            else if (size >= 4)
+            {
+                tail = loadStaticWord<4>(data) | (loadStaticWord<4>(data + size - 4) << 32);
+            }
+            else if (size > 0)
+            {
+                tail = loadStaticWord<1>(data) | (loadStaticWord<1>(data + size / 2) << 8) | (loadStaticWord<1>(data + size - 1) << 16);
+            }
+            return staticMix((h ^ tail) * kMultiplier);
+        }
+
+        template <typename T>
+            requires std::is_integral_v<T>
+        constexpr std::uint64_t staticHash(T key, std::uint64_t seed) noexcept
+        {
+            return staticMix(static_cast<std::uint64_t>(key) ^ seed);
+        }
+    }
+
+    /**
+     * @brief Immutable map over a key set known at compile time, with O(1) lookups
+     *
+     * The constructor builds a minimal perfect hash (PTHash style): keys are spread
+     * over about N/2 buckets, and each bucket gets the smallest "pilot" that sends all
+     * its keys to free slots of an N-slot table. A lookup is therefore one hash, one
+     * xor with the bucket's pilot, one table access and a single key comparison, with
+     * no probing and no branches on the table contents. Everything lives in
+     * `std::array`s: no heap and, when the map is declared `constexpr`, no work at
+     * startup. Duplicate keys are an error (a compile-time error for a constexpr map).
+     *
+     * Keys are integers or `std::string_view` (String owns heap memory, so it cannot be
+     * stored in a constant expression); string-keyed maps can be queried with String,
+     * std::string, std::string_view or C strings. Key and Value must be literal types
+     * with a default constructor, like function pointers, enums or string_views.
+     *
+     * Iteration visits the entries in table order, which is unspecified.
+     *
+     * @tparam Key Integer type or std::string_view
+     * @tparam Value Type of the mapped values
+     * @tparam N Number of entries
+     *
+     * @example
+     * ```cpp
+     * constexpr auto methods = cpp_ex::makeStaticMap<std::string_view, int>({
+     *     {"GET", 1}, {"POST", 2}, {"PUT", 3}, {"DELETE", 4}});
+     *
+     * static_assert(methods.at("POST") == 2);
+     * const int *id = methods.find(request.getMethod()); // String, at runtime
+     * ```
+     */
+    template <typename Key, typename Value, std::size_t N>
+    class StaticMap
+    {
+        static_assert(std::is_integral_v<Key> || std::is_same_v<Key, std::string_view>,
+                      "StaticMap keys must be integers or std::string_view");
+
+    public:
+        // Tipos (aliases)
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<Key, Value>;
+        using size_type = std::size_t;
+        using const_iterator = const value_type *;
+
+        // Unas dos claves por cubo: construcción rápida y tabla de pilotos pequeña
+        static constexpr std::size_t kBucketCount = N / 2 + 1;
+
+    private:
+        // Pilotos a probar por cubo antes de cambiar de semilla
+        static constexpr std::uint32_t kMaxPilot = static_cast<std::uint32_t>(64 * N + 1024);
+        static constexpr int kMaxSeeds = 32;
+
+        std::array<value_type, N> entries{};
+        std::array<std::uint64_t, kBucketCount> pilots{}; // Ya mezclados con staticMix()
+        std::uint64_t seed = 0;
+
+    public:
+        // Constructores
+        constexpr explicit StaticMap(const std::array<value_type, N> &input)
+        {
+            for (int attempt = 0; attempt < kMaxSeeds; ++attempt)
+            {
+                seed = detail::staticMix(0x5EED0000ULL + static_cast<std::uint64_t>(attempt));
+                if (tryBuild(input))
+                {
+                    return;
+                }
+            }
+            throw std::logic_error("StaticMap: could not build a perfect hash");
+        }
+
+        // Iteradores (orden de la tabla)
+        constexpr const_iterator begin() const noexcept
+        {
+            return entries.data();
+        }
+
+        constexpr const_iterator end() const noexcept
+        {
+            return entries.data() + N;
+        }
+
+        // Capacidad
+        constexpr bool isEmpty() const noexcept
+        {
+            return N == 0;
+        }
+
+        constexpr size_type getSize() const noexcept
+        {
+            return N;
+        }
+
+        // Lookup
+        template <typename K>
+        constexpr const Value *find(const K &key) const noexcept
+        {
+            if constexpr (N == 0)
+            {
+                return nullptr;
+            }
+            else if constexpr (std::is_integral_v<Key>)
+            {
+                static_assert(std::is_integral_v<K>, "StaticMap: integer-keyed map queried with a non-integer key");
+                // Una clave fuera del rango de Key no puede estar en el mapa
+                if constexpr (!std::is_same_v<K, Key>)
+                {
+                    if (!std::in_range<Key>(key))
+                    {
+                        return nullptr;
+                    }
+                }
+                return lookup(static_cast<Key>(key));
+            }
+            else
+            {
+                return lookup(detail::stringKeyView(key));
+            }
+        }
+
+        template <typename K>
+        constexpr const Value &at(const K &key) const
+        {
+            const Value *value = find(key);
+            if (value == nullptr)
+            {
+                throw std::out_of_range("StaticMap::at: key not found");
+            }
+            return *value;
+        }
+
+        template <typename K>
+        constexpr Value getOrDefault(const K &key, const Value &defaultValue) const
+        {
+            const Value *value = find(key);
+            return value != nullptr ? *value : defaultValue;
+        }
+
+        template <typename K>
+        constexpr bool contains(const K &key) const noexcept
+        {
+            return find(key) != nullptr;
+        }
+
+        template <typename K>
+        constexpr size_type count(const K &key) const noexcept
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        // Recorrido
+        template <typename BinaryFunc>
+        constexpr void forEach(BinaryFunc func) const
+        {
+            for (const auto &[key, value] : entries)
+            {
+                func(key, value);
+            }
+        }
+
+    private:
+        static constexpr std::size_t bucketOf(std::uint64_t hash) noexcept
+        {
+            return static_cast<std::size_t>((hash >> 32) % kBucketCount);
+        }
+
+        static constexpr std::size_t slotOf(std::uint64_t hash, std::uint64_t pilot) noexcept
+        {
+            return static_cast<std::size_t>((hash ^ pilot) % N);
+        }
+
+        constexpr const Value *lookup(const Key &key) const noexcept
+        {
+            std::uint64_t hash = detail::staticHash(key, seed);
+            const value_type &entry = entries[slotOf(hash, pilots[bucketOf(hash)])];
+            return entry.first == key ? &entry.second : nullptr;
+        }
+
+        // Un intento con la semilla actual; false si algún cubo no encuentra piloto
+        constexpr bool tryBuild(const std::array<value_type, N> &input)
+        {
+            if constexpr (N == 0)
+            {
+                return true;
+            }
+            else
+            {
+                // Claves agrupadas por cubo (ordenación por conteo)
+                std::array<std::uint64_t, N> hashes{};
+                std::array<std::size_t, kBucketCount + 1> offsets{};
+                for (std::size_t i = 0; i < N; ++i)
+                {
+                    hashes[i] = detail::staticHash(input[i].first, seed);
+                    ++offsets[bucketOf(hashes[i]) + 1];
+                }
+                for (std::size_t b = 0; b < kBucketCount; ++b)
+                {
+                    offsets[b + 1] += offsets[b];
+                }
+                std::array<std::size_t, N> members{};
+                std::array<std::size_t, kBucketCount + 1> cursor = offsets;
+                for (std::size_t i = 0; i < N; ++i)
+                {
+                    members[cursor[bucketOf(hashes[i])]++] = i;
+                }
+
+                // Los cubos grandes primero, cuando aún hay muchos huecos libres
+                std::array<std::size_t, kBucketCount> order{};
+                for (std::size_t b = 0; b < kBucketCount; ++b)
+                {
+                    order[b] = b;
+                }
+                std::sort(order.begin(), order.end(), [&offsets](std::size_t a, std::size_t b)
+                          { return offsets[a + 1] - offsets[a] > offsets[b + 1] - offsets[b]; });
+
+                std::array<bool, N> taken{};
+                std::array<std::size_t, N> slots{};
+                pilots = {};
+                for (std::size_t bucket : order)
+                {
+                    std::size_t first = offsets[bucket];
+                    std::size_t last = offsets[bucket + 1];
+                    if (first == last)
+                    {
+                        break;
+                    }
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        for (std::size_t j = i + 1; j < last; ++j)
+                        {
+                            if (hashes[members[i]] == hashes[members[j]])
+                            {
+                                if (input[members[i]].first == input[members[j]].first)
+                                {
+                                    throw std::invalid_argument("StaticMap: duplicate key");
+                                }
+                                return false; // Colisión completa de 64 bits: otra semilla
+                            }
+                        }
+                    }
+
+                    bool placed = false;
+                    for (std::uint32_t pilot = 0; pilot < kMaxPilot && !placed; ++pilot)
+                    {
+                        std::uint64_t mixedPilot = detail::staticMix(pilot);
+                        std::size_t k = first;
+                        for (; k < last; ++k)
+                        {
+                            std::size_t slot = slotOf(hashes[members[k]], mixedPilot);
+                            if (taken[slot])
+                            {
+                                break;
+                            }
+                            taken[slot] = true;
+                            slots[k] = slot;
+                        }
+                        if (k == last)
+                        {
+                            pilots[bucket] = mixedPilot;
+                            placed = true;
+                        }
+                        else
+                        {
+                            // Deshace las marcas de este intento
+                            for (std::size_t undo = first; undo < k; ++undo)
+                            {
+                                taken[slots[undo]] = false;
+                            }
+                        }
+                    }
+                    if (!placed)
+                    {
+                        return false;
+                    }
+                }
+
+                for (std::size_t k = 0; k < N; ++k)
+                {
+                    entries[slots[k]] = input[members[k]];
+                }
+                return true;
+            }
+        }
+    };
+
+    /**
+     * @brief Builds a StaticMap from a braced list, deducing its size
+     *
+     * @example
+     * ```cpp
+     * constexpr auto codes = cpp_ex::makeStaticMap<int, std::string_view>({{200, "OK"}, {404, "Not Found"}});
+     * ```
+     */
+    template <typename Key, typename Value, std::size_t N>
+    constexpr StaticMap<Key, Value, N> makeStaticMap(const std::pair<Key, Value> (&entries)[N])
+    {
+        return StaticMap<Key, Value, N>(std::to_array(entries));
+    }
+
+} // namespace cppex
+
+#endif // CPPEX_STATIC_MAP_HPP
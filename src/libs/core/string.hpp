@@ -8,12 +8,85 @@
 #ifndef CPPEX_STRING_H
 #define CPPEX_STRING_H
 
+#include <array>
+#include <climits>
 #include <string>
+#include <string_view>
+#include <functional>
 #include <algorithm>
 #include <cctype>
+#include <type_traits>
 #include "vector.hpp" // Include cpp_ex::Vector
 #include "map.hpp"    // Include cpp_ex::Map
 
+namespace cpp_ex
+{
+    class String;
+
+    namespace detail
+    {
+        // Vista de cualquier clave de texto: String, std::string, std::string_view o const char*
+        template <typename S>
+        constexpr std::string_view stringKeyView(const S &key) noexcept
+        {
+            if constexpr (std::is_same_v<S, String>)
+            {
+                return key.getStringView();
+            }
+            else
+            {
+                return std::string_view(key);
+            }
+        }
+    }
+} // namespace cppex
+
+/**
+ * Transparent comparison and hashing for String keys
+ *
+ * With `is_transparent`, `Map<String, V>` (std::less) and `HashMap<String, V>`
+ * (std::hash + std::equal_to) accept String, std::string, std::string_view and
+ * string literals as lookup keys, and compare them as string views without
+ * building a temporary String. They are defined before the class because String
+ * itself instantiates `Map<String, int>` (getWordFrequencies()).
+ */
+template <>
+struct std::less<cpp_ex::String>
+{
+    using is_transparent = void;
+
+    template <typename L, typename R>
+    bool operator()(const L &lhs, const R &rhs) const noexcept
+    {
+        return cpp_ex::detail::stringKeyView(lhs) < cpp_ex::detail::stringKeyView(rhs);
+    }
+};
+
+template <>
+struct std::equal_to<cpp_ex::String>
+{
+    using is_transparent = void;
+
+    template <typename L, typename R>
+    bool operator()(const L &lhs, const R &rhs) const noexcept
+    {
+        return cpp_ex::detail::stringKeyView(lhs) == cpp_ex::detail::stringKeyView(rhs);
+    }
+};
+
+// Hash support so String can be used as a key of unordered containers (HashMap, std::unordered_map)
+template <>
+struct std::hash<cpp_ex::String>
+{
+    using is_transparent = void;
+
+    template <typename S>
+    std::size_t operator()(const S &key) const noexcept
+    {
+        return std::hash<std::string_view>{}(cpp_ex::detail::stringKeyView(key));
+    }
+};
+
 namespace cpp_ex
 {
 
@@ -54,8 +127,10 @@ namespace cpp_ex
         // Constructors
         String() : data("") {}
         String(const std::string &str) : data(str) {}
+        String(std::string &&str) noexcept : data(std::move(str)) {}
         String(const char *str) : data(str) {}
         String(const String &other) : data(other.data) {}
+        String(String &&other) noexcept : data(std::move(other.data)) {}
         // Changed parameter order to match std::string constructor (count, c)
         String(size_t count, char c) : data(std::string(count, c)) {}
 
@@ -81,12 +156,34 @@ namespace cpp_ex
             return *this;
         }
 
-        // Implicit conversion to std::string
-        operator std::string() const
+        String &operator=(String &&other) noexcept
+        {
+            data = std::move(other.data);
+            return *this;
+        }
+
+        // Implicit conversion to std::string (moves the buffer out of temporaries)
+        operator std::string() const &
+        {
+            return data;
+        }
+
+        operator std::string() &&
+        {
+            return std::move(data);
+        }
+
+        // Explicit conversion: copies, or steals the buffer when called on an rvalue
+        std::string toStdString() const &
         {
             return data;
         }
 
+        std::string toStdString() &&
+        {
+            return std::move(data);
+        }
+
         // Basic methods
         const char *getCString() const
         {
@@ -98,6 +195,11 @@ namespace cpp_ex
             return data;
         }
 
+        std::string_view getStringView() const noexcept
+        {
+            return data;
+        }
+
         size_t getLength() const
         {
             return data.length();
@@ -324,16 +426,19 @@ namespace cpp_ex
         // Method to count character occurrences using a Map
         Map<char, size_t> countCharacters() const
         {
-            Map<char, size_t> charCount;
+            // Conteo en una tabla plana y volcado al Map en orden, siempre al final
+            std::array<size_t, 256> counts{};
             for (char c : data)
             {
-                if (charCount.contains(c))
-                {
-                    charCount[c] += 1;
-                }
-                else
+                ++counts[static_cast<unsigned char>(c)];
+            }
+            Map<char, size_t> charCount;
+            for (int c = CHAR_MIN; c <= CHAR_MAX; ++c)
+            {
+                size_t count = counts[static_cast<unsigned char>(c)];
+                if (count != 0)
                 {
-                    charCount[c] = 1;
+                    charCount.emplaceHint(charCount.end(), static_cast<char>(c), count);
                 }
             }
             return charCount;
@@ -352,14 +457,8 @@ namespace cpp_ex
                 String cleanWord = word.trim();
                 if (!cleanWord.isEmpty())
                 {
-                    if (wordFreq.contains(cleanWord))
-                    {
-                        wordFreq[cleanWord] += 1;
-                    }
-                    else
-                    {
-                        wordFreq[cleanWord] = 1;
-                    }
+                    // Una sola búsqueda: operator[] crea la entrada a 0 si no existe
+                    wordFreq[std::move(cleanWord)] += 1;
                 }
             }
 
@@ -84,6 +84,8 @@ namespace cpp_ex
 
         Vector(const std::vector<T> &stdVector) : data(stdVector) {}
 
+        Vector(std::vector<T> &&stdVector) noexcept : data(std::move(stdVector)) {}
+
         // Operadores de asignación
         Vector &operator=(const Vector &other)
         {
@@ -106,12 +108,28 @@ namespace cpp_ex
             return *this;
         }
 
-        // Conversión a std::vector
-        operator std::vector<T>() const
+        // Conversión a std::vector (los temporales ceden su buffer)
+        operator std::vector<T>() const &
         {
             return data;
         }
 
+        operator std::vector<T>() &&
+        {
+            return std::move(data);
+        }
+
+        // Copia explícita, o movimiento sin reservar memoria si se llama sobre un rvalue
+        std::vector<T> toStdVector() const &
+        {
+            return data;
+        }
+
+        std::vector<T> toStdVector() &&
+        {
+            return std::move(data);
+        }
+
         std::vector<T> &getStdVector()
         {
             return data;
@@ -0,0 +1,15 @@
+// Allocation counter for the transparent lookup tests
+// Replaces the global operator new/delete, so it is linked only into its own test executable.
+
+#ifndef CPPEX_TESTS_ALLOCATION_COUNTER_HPP
+#define CPPEX_TESTS_ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+namespace cpp_ex::test
+{
+    // Number of calls to the global operator new since the program started
+    std::size_t allocations();
+}
+
+#endif // CPPEX_TESTS_ALLOCATION_COUNTER_HPP
@@ -0,0 +1,420 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/libs/core/btree_map.hpp"
+#include <string>
+#include <map>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+namespace
+{
+    // Small nodes: deep trees with few entries
+    using SmallNodeMap = cpp_ex::BTreeMap<int, int, std::less<int>, 64>;
+
+    template <typename TreeType>
+    bool sameContents(const TreeType &tree, const std::map<int, int> &reference)
+    {
+        if (tree.getSize() != reference.size())
+        {
+            return false;
+        }
+        auto expected = reference.begin();
+        for (auto it = tree.begin(); it != tree.end(); ++it, ++expected)
+        {
+            if (it->first != expected->first || it->second != expected->second)
+            {
+                return false;
+            }
+        }
+        return expected == reference.end();
+    }
+}
+
+TEST_CASE("BTreeMap constructors", "[btree_map]")
+{
+    SECTION("Default constructor")
+    {
+        cpp_ex::BTreeMap<int, std::string> map;
+        REQUIRE(map.isEmpty());
+        REQUIRE(map.getSize() == 0);
+        REQUIRE(map.begin() == map.end());
+        REQUIRE(map.getHeight() == 0);
+    }
+
+    SECTION("Initializer list keeps the first duplicate")
+    {
+        cpp_ex::BTreeMap<int, std::string> map = {
+            {3, "three"},
+            {1, "one"},
+            {2, "two"},
+            {1, "uno"}};
+
+        REQUIRE(map.getSize() == 3);
+        REQUIRE(map.getKeys() == cpp_ex::Vector<int>{1, 2, 3});
+        REQUIRE(map[1] == "one");
+    }
+
+    SECTION("Constructor with custom comparator")
+    {
+        cpp_ex::BTreeMap<int, int, std::greater<int>> map = {{1, 1}, {3, 3}, {2, 2}};
+        REQUIRE(map.getKeys() == cpp_ex::Vector<int>{3, 2, 1});
+        REQUIRE(map.lowerBound(2)->first == 2);
+    }
+
+    SECTION("Copy, move and assignment")
+    {
+        cpp_ex::BTreeMap<int, std::string> map1;
+        for (int i = 0; i < 500; ++i)
+        {
+            map1[i] = std::to_string(i);
+        }
+        cpp_ex::BTreeMap<int, std::string> map2(map1);
+        map2[2] = "TWO";
+        REQUIRE(map1[2] == "2");
+        REQUIRE(map2.getSize() == 500);
+
+        cpp_ex::BTreeMap<int, std::string> map3(std::move(map2));
+        REQUIRE(map3[2] == "TWO");
+        REQUIRE(map2.isEmpty());
+
+        map2 = map3;
+        REQUIRE(map2 == map3);
+        map2 = {{1, "one"}};
+        REQUIRE(map2.getSize() == 1);
+    }
+}
+
+TEST_CASE("BTreeMap modifiers", "[btree_map]")
+{
+    cpp_ex::BTreeMap<int, std::string> map;
+
+    SECTION("insert(), emplace(), tryEmplace() and insertOrAssign()")
+    {
+        REQUIRE(map.insert({2, "two"}).second);
+        REQUIRE_FALSE(map.insert({2, "dos"}).second);
+        REQUIRE(map.emplace(1, "one").second);
+        REQUIRE(map.tryEmplace(3, 5, 'x').first->second == "xxxxx");
+        REQUIRE_FALSE(map.insertOrAssign(2, "dos").second);
+        REQUIRE(map[2] == "dos");
+        REQUIRE(map.getKeys() == cpp_ex::Vector<int>{1, 2, 3});
+    }
+
+    SECTION("Hinted insert with correct and wrong hints")
+    {
+        auto it = map.insert(map.end(), {1, "one"});
+        it = map.insert(map.end(), {2, "two"});
+        REQUIRE(it->first == 2);
+
+        // Wrong hint falls back to a normal search
+        map.insert(map.begin(), {3, "three"});
+        map.emplaceHint(map.end(), 0, "zero");
+        REQUIRE(map.getKeys() == cpp_ex::Vector<int>{0, 1, 2, 3});
+    }
+
+    SECTION("End-hinted sorted load packs leaves")
+    {
+        cpp_ex::BTreeMap<int, int> sorted;
+        cpp_ex::BTreeMap<int, int> shuffled;
+        std::vector<int> keys;
+        for (int i = 0; i < 10000; ++i)
+        {
+            sorted.emplaceHint(sorted.end(), i, i);
+            keys.push_back(i);
+        }
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+        for (int key : keys)
+        {
+            shuffled[key] = key;
+        }
+        REQUIRE(sorted == shuffled);
+        REQUIRE(sorted.getNodeCount() < shuffled.getNodeCount());
+        REQUIRE(sorted.getMemoryUsage() < 10000 * (sizeof(int) * 2 + 8));
+    }
+
+    SECTION("erase() methods")
+    {
+        map = {{1, "one"}, {2, "two"}, {3, "three"}, {4, "four"}};
+        REQUIRE(map.erase(2) == 1);
+        REQUIRE(map.erase(2) == 0);
+
+        auto it = map.erase(map.find(3));
+        REQUIRE(it->first == 4);
+
+        map.erase(map.begin(), map.end());
+        REQUIRE(map.isEmpty());
+        REQUIRE(map.getNodeCount() == 0);
+    }
+
+    SECTION("Range erase across many nodes returns the next entry")
+    {
+        SmallNodeMap big;
+        for (int i = 0; i < 1000; ++i)
+        {
+            big[i] = i;
+        }
+        auto it = big.erase(big.lowerBound(100), big.lowerBound(900));
+        REQUIRE(it->first == 900);
+        REQUIRE(big.getSize() == 200);
+        REQUIRE(big.getKeys()[99] == 99);
+        REQUIRE(big.getKeys()[100] == 900);
+    }
+}
+
+TEST_CASE("BTreeMap lookup methods", "[btree_map]")
+{
+    cpp_ex::BTreeMap<int, std::string> map = {{10, "ten"}, {20, "twenty"}, {30, "thirty"}};
+
+    SECTION("find(), contains() and at()")
+    {
+        REQUIRE(map.find(20)->second == "twenty");
+        REQUIRE(map.find(25) == map.end());
+        REQUIRE(map.contains(30));
+        REQUIRE_FALSE(map.contains(5));
+        REQUIRE(map.count(10) == 1);
+        REQUIRE_THROWS_AS(map.at(11), std::out_of_range);
+    }
+
+    SECTION("lowerBound(), upperBound() and equalRange()")
+    {
+        REQUIRE(map.lowerBound(5)->first == 10);
+        REQUIRE(map.lowerBound(15)->first == 20);
+        REQUIRE(map.lowerBound(35) == map.end());
+        REQUIRE(map.upperBound(10)->first == 20);
+        REQUIRE(map.upperBound(30) == map.end());
+
+        auto range = map.equalRange(20);
+        REQUIRE(range.first->first == 20);
+        REQUIRE(range.second->first == 30);
+    }
+
+    SECTION("Bounds agree with std::map in a deep tree")
+    {
+        SmallNodeMap big;
+        std::map<int, int> reference;
+        for (int i = 0; i < 2000; ++i)
+        {
+            big[i * 3] = i;
+            reference[i * 3] = i;
+        }
+        REQUIRE(big.getHeight() > 3);
+        for (int probe = -2; probe < 6005; ++probe)
+        {
+            auto lower = big.lowerBound(probe);
+            auto expectedLower = reference.lower_bound(probe);
+            REQUIRE((lower == big.end()) == (expectedLower == reference.end()));
+            if (lower != big.end())
+            {
+                REQUIRE(lower->first == expectedLower->first);
+            }
+
+            auto upper = big.upperBound(probe);
+            auto expectedUpper = reference.upper_bound(probe);
+            REQUIRE((upper == big.end()) == (expectedUpper == reference.end()));
+            if (upper != big.end())
+            {
+                REQUIRE(upper->first == expectedUpper->first);
+            }
+        }
+    }
+}
+
+TEST_CASE("BTreeMap iteration", "[btree_map]")
+{
+    cpp_ex::BTreeMap<int, std::string> map = {{2, "b"}, {1, "a"}, {3, "c"}};
+
+    SECTION("Ordered forward and reverse iteration")
+    {
+        std::string forward;
+        for (const auto &entry : map)
+        {
+            forward += entry.second;
+        }
+        REQUIRE(forward == "abc");
+
+        std::string backward;
+        for (auto it = map.rbegin(); it != map.rend(); ++it)
+        {
+            backward += (*it).second;
+        }
+        REQUIRE(backward == "cba");
+    }
+
+    SECTION("Structured bindings modify values in place")
+    {
+        for (auto [key, value] : map)
+        {
+            value += std::to_string(key);
+        }
+        REQUIRE(map[1] == "a1");
+        REQUIRE(map[3] == "c3");
+    }
+
+    SECTION("Reverse iteration crosses leaves")
+    {
+        SmallNodeMap big;
+        for (int i = 0; i < 300; ++i)
+        {
+            big[i] = i;
+        }
+        int expected = 299;
+        for (auto it = big.rbegin(); it != big.rend(); ++it)
+        {
+            REQUIRE((*it).first == expected--);
+        }
+        REQUIRE(expected == -1);
+    }
+}
+
+TEST_CASE("BTreeMap randomized operations match std::map", "[btree_map]")
+{
+    SmallNodeMap tree;
+    std::map<int, int> reference;
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> keys(0, 3000);
+
+    for (int round = 0; round < 20000; ++round)
+    {
+        int key = keys(random);
+        switch (random() % 4)
+        {
+        case 0:
+        case 1:
+            tree.insertOrAssign(key, round);
+            reference[key] = round;
+            break;
+        case 2:
+            REQUIRE(tree.erase(key) == reference.erase(key));
+            break;
+        default:
+        {
+            auto it = tree.lowerBound(key);
+            auto next = tree.erase(tree.lowerBound(key), it == tree.end() ? it : std::next(it));
+            auto expected = reference.erase(reference.lower_bound(key), it == tree.end() ? reference.end() : std::next(reference.lower_bound(key)));
+            REQUIRE((next == tree.end()) == (expected == reference.end()));
+            if (next != tree.end())
+            {
+                REQUIRE(next->first == expected->first);
+            }
+        }
+        }
+    }
+    REQUIRE(sameContents(tree, reference));
+
+    // Emptying the map merges every node away
+    while (!tree.isEmpty())
+    {
+        tree.erase(tree.begin());
+    }
+    REQUIRE(tree.getNodeCount() == 0);
+}
+
+TEST_CASE("BTreeMap additional methods", "[btree_map]")
+{
+    cpp_ex::BTreeMap<int, std::string> map = {{1, "one"}, {2, "two"}, {3, "three"}};
+
+    SECTION("getEntries() method")
+    {
+        auto entries = map.getEntries();
+        REQUIRE(entries.getSize() == 3);
+        REQUIRE(entries[0] == std::make_pair(1, std::string("one")));
+    }
+
+    SECTION("mapValues() and filterEntries()")
+    {
+        auto lengths = map.mapValues<size_t>([](const std::string &value)
+                                             { return value.length(); });
+        REQUIRE(lengths.getValues() == cpp_ex::Vector<size_t>{3, 3, 5});
+
+        auto odd = map.filterEntries([](int key, const std::string &)
+                                     { return key % 2 == 1; });
+        REQUIRE(odd.getKeys() == cpp_ex::Vector<int>{1, 3});
+    }
+
+    SECTION("forEach() method")
+    {
+        int sum = 0;
+        map.forEach([&sum](const int &key, std::string &value)
+                    {
+                        sum += key;
+                        value += "!"; });
+        REQUIRE(sum == 6);
+        REQUIRE(map[2] == "two!");
+    }
+
+    SECTION("Linear merge(), difference() and intersection()")
+    {
+        cpp_ex::BTreeMap<int, std::string> other = {{0, "zero"}, {3, "THREE"}, {4, "four"}};
+
+        auto merged = map.merge(other);
+        REQUIRE(merged.getKeys() == cpp_ex::Vector<int>{0, 1, 2, 3, 4});
+        REQUIRE(merged[3] == "three");
+
+        auto diff = map.difference(other);
+        REQUIRE(diff.getKeys() == cpp_ex::Vector<int>{1, 2});
+
+        auto common = map.intersection(other);
+        REQUIRE(common.getKeys() == cpp_ex::Vector<int>{3});
+        REQUIRE(common[3] == "three");
+    }
+
+    SECTION("Comparison operators")
+    {
+        cpp_ex::BTreeMap<int, std::string> same = {{3, "three"}, {2, "two"}, {1, "one"}};
+        cpp_ex::BTreeMap<int, std::string> bigger = {{1, "one"}, {2, "two"}, {4, "four"}};
+        REQUIRE(map == same);
+        REQUIRE(map != bigger);
+        REQUIRE(map < bigger);
+        REQUIRE(bigger > map);
+        REQUIRE(map <= same);
+        REQUIRE(map >= same);
+    }
+}
+
+TEST_CASE("BTreeMap batched lookups in a multi-level tree", "[btree_map]")
+{
+    SmallNodeMap big;
+    for (int i = 0; i < 6000; ++i)
+    {
+        big[i * 3] = i;
+    }
+    REQUIRE(big.getHeight() > 3);
+
+    // Stored keys (separators included), gaps between leaves and keys out of range
+    cpp_ex::Vector<int> keys;
+    for (int probe = -5; probe < 18010; ++probe)
+    {
+        keys.pushBack(probe);
+    }
+    auto check = [&keys](SmallNodeMap &tree)
+    {
+        cpp_ex::Vector<SmallNodeMap::iterator> results;
+        tree.findMany(keys, results);
+        REQUIRE(results.getSize() == keys.getSize());
+        std::size_t hits = 0;
+        for (std::size_t i = 0; i < keys.getSize(); ++i)
+        {
+            REQUIRE(results[i] == tree.find(keys[i]));
+            hits += results[i] != tree.end() ? 1 : 0;
+        }
+        REQUIRE(hits == tree.getSize());
+
+        cpp_ex::Vector<bool> found;
+        REQUIRE(tree.containsMany(keys, found) == tree.getSize());
+    };
+
+    check(big);
+
+    // Erasing most keys merges leaves and the tree loses levels
+    auto height = big.getHeight();
+    for (int i = 0; i < 6000; ++i)
+    {
+        if (i % 10 != 0)
+        {
+            REQUIRE(big.erase(i * 3) == 1);
+        }
+    }
+    REQUIRE(big.getHeight() < height);
+    check(big);
+}
+
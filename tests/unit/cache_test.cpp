@@ -0,0 +1,296 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/libs/core/cache.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Weight = length of the value (capacity in bytes)
+    struct ValueLength
+    {
+        std::size_t operator()(const int &, const std::string &value) const
+        {
+            return value.size();
+        }
+    };
+}
+
+TEST_CASE("LruCache eviction order", "[cache]")
+{
+    cpp_ex::LruCache<int, std::string> cache(3);
+
+    SECTION("Evicts the least recently used entry")
+    {
+        cache.put(1, "one");
+        cache.put(2, "two");
+        cache.put(3, "three");
+        REQUIRE(cache.get(1) == "one"); // 2 becomes the least recently used
+        cache.put(4, "four");
+
+        REQUIRE_FALSE(cache.contains(2));
+        REQUIRE(cache.contains(1));
+        REQUIRE(cache.getSize() == 3);
+        REQUIRE(cache.getStats().evictions == 1);
+    }
+
+    SECTION("put() on an existing key updates and refreshes it")
+    {
+        cache.put(1, "one");
+        cache.put(2, "two");
+        cache.put(3, "three");
+        cache.put(1, "uno");
+        cache.put(4, "four");
+        REQUIRE(*cache.peek(1) == "uno");
+        REQUIRE_FALSE(cache.contains(2));
+
+        std::vector<int> order;
+        cache.forEachByRecency([&order](const int &key, const std::string &)
+                               { order.push_back(key); });
+        REQUIRE(order == std::vector<int>{4, 1, 3});
+    }
+
+    SECTION("Statistics, peek() and erase()")
+    {
+        cache.put(1, "one");
+        REQUIRE(cache.find(1) != nullptr);
+        REQUIRE(cache.find(2) == nullptr);
+        REQUIRE_FALSE(cache.get(3).has_value());
+        REQUIRE(cache.peek(1) != nullptr); // peek() is not counted
+        REQUIRE(cache.getStats().hits == 1);
+        REQUIRE(cache.getStats().misses == 2);
+        REQUIRE(cache.getStats().getHitRatio() == 1.0 / 3.0);
+
+        REQUIRE(cache.erase(1));
+        REQUIRE_FALSE(cache.erase(1));
+        REQUIRE(cache.isEmpty());
+
+        cache.resetStats();
+        REQUIRE(cache.getStats().hits == 0);
+    }
+
+    SECTION("setCapacity() shrinks and clear() empties")
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            cache.put(i, std::to_string(i));
+        }
+        cache.setCapacity(1);
+        REQUIRE(cache.getSize() == 1);
+        REQUIRE(cache.contains(2));
+
+        cache.clear();
+        REQUIRE(cache.isEmpty());
+        cache.put(7, "seven");
+        REQUIRE(cache.getKeys() == cpp_ex::Vector<int>{7});
+    }
+
+    SECTION("Slots are reused after evictions")
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            cache.put(i, std::to_string(i));
+        }
+        REQUIRE(cache.getSize() == 3);
+        REQUIRE(cache.getKeys().getSize() == 3);
+    }
+}
+
+TEST_CASE("Cache capacity by weight", "[cache]")
+{
+    cpp_ex::Cache<int, std::string, ValueLength> cache(10);
+
+    cache.put(1, "aaaa");
+    cache.put(2, "bbbb");
+    REQUIRE(cache.getWeight() == 8);
+
+    cache.put(3, "cccc"); // 12 > 10: evicts 1
+    REQUIRE_FALSE(cache.contains(1));
+    REQUIRE(cache.getWeight() == 8);
+
+    cache.put(2, "bbbbbbbb"); // Grows: evicts 3
+    REQUIRE_FALSE(cache.contains(3));
+    REQUIRE(cache.getWeight() == 8);
+
+    // An entry larger than the whole capacity is not stored (and drops the old one)
+    cache.put(2, "this value is far too long");
+    REQUIRE_FALSE(cache.contains(2));
+    REQUIRE(cache.getStats().rejections == 1);
+    REQUIRE(cache.getWeight() == 0);
+}
+
+TEST_CASE("LfuCache eviction order", "[cache]")
+{
+    cpp_ex::LfuCache<int, int> cache(3);
+
+    SECTION("Evicts the least frequently used entry")
+    {
+        cache.put(1, 1);
+        cache.put(2, 2);
+        cache.put(3, 3);
+        cache.get(1);
+        cache.get(1);
+        cache.get(2);
+        cache.put(4, 4); // 3 has frequency 1
+
+        REQUIRE_FALSE(cache.contains(3));
+        REQUIRE(cache.getFrequency(1) == 3);
+        REQUIRE(cache.getFrequency(2) == 2);
+        REQUIRE(cache.getFrequency(4) == 1);
+
+        cache.put(5, 5); // 4 is the only entry with frequency 1
+        REQUIRE_FALSE(cache.contains(4));
+    }
+
+    SECTION("Ties are broken by recency")
+    {
+        cache.put(1, 1);
+        cache.put(2, 2);
+        cache.put(3, 3);
+        cache.put(4, 4);
+        REQUIRE_FALSE(cache.contains(1));
+        REQUIRE(cache.contains(2));
+    }
+
+    SECTION("Updating the only entry of the lowest bucket keeps it")
+    {
+        cpp_ex::LfuCache<int, std::string, ValueLength> weighted(6);
+        weighted.put(1, "aa");
+        weighted.put(2, "aa");
+        weighted.get(1);
+        weighted.get(1);
+        weighted.put(2, "aaaaa"); // 2 moves to frequency 2 and grows: evicts 1
+        REQUIRE(weighted.contains(2));
+        REQUIRE_FALSE(weighted.contains(1));
+        REQUIRE(weighted.getWeight() == 5);
+    }
+
+    SECTION("erase() and clear()")
+    {
+        cache.put(1, 1);
+        cache.get(1);
+        REQUIRE(cache.erase(1));
+        REQUIRE(cache.getFrequency(1) == 0);
+        cache.put(2, 2);
+        cache.clear();
+        REQUIRE(cache.isEmpty());
+        cache.put(3, 3);
+        REQUIRE(cache.get(3) == 3);
+    }
+}
+
+TEST_CASE("ArcCache adapts between recency and frequency", "[cache]")
+{
+    cpp_ex::ArcCache<int, int> cache(4);
+
+    SECTION("Behaves like LRU for one-off keys")
+    {
+        for (int i = 0; i < 6; ++i)
+        {
+            cache.put(i, i);
+        }
+        REQUIRE(cache.getSize() == 4);
+        REQUIRE_FALSE(cache.contains(0));
+        REQUIRE(cache.contains(5));
+        // |T1| + |B1| <= c: with T1 full there is no room for history
+        REQUIRE(cache.getGhostCount() == 0);
+    }
+
+    SECTION("A scan does not flush frequently used entries")
+    {
+        cache.put(1, 1);
+        cache.put(2, 2);
+        cache.get(1);
+        cache.get(2); // 1 and 2 are in T2
+        for (int i = 100; i < 200; ++i)
+        {
+            cache.put(i, i);
+        }
+        REQUIRE(cache.contains(1));
+        REQUIRE(cache.contains(2));
+        REQUIRE(cache.getSize() == 4);
+    }
+
+    SECTION("A ghost hit grows the recency target")
+    {
+        cache.put(1, 1);
+        cache.put(2, 2);
+        cache.get(1);
+        cache.get(2); // T2 = {2, 1}
+        cache.put(3, 3);
+        cache.put(4, 4);
+        cache.put(5, 5); // 3 moves to B1
+        REQUIRE_FALSE(cache.contains(3));
+        REQUIRE(cache.getGhostCount() == 1);
+
+        auto before = cache.getRecencyTarget();
+        cache.put(3, 3);
+        REQUIRE(cache.getRecencyTarget() > before);
+        REQUIRE(cache.get(3) == 3);
+        REQUIRE(cache.getSize() == 4);
+    }
+
+    SECTION("Bounded history under random traffic")
+    {
+        std::uint64_t state = 1;
+        for (int i = 0; i < 20000; ++i)
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            int key = static_cast<int>((state >> 33) % 64);
+            if (!cache.get(key))
+            {
+                cache.put(key, key);
+            }
+            REQUIRE(cache.getSize() <= 4);
+            REQUIRE(cache.getGhostCount() <= 8);
+        }
+        cache.forEach([](const int &key, const int &value)
+                      { REQUIRE(key == value); });
+        REQUIRE(cache.erase(cache.getKeys()[0]));
+        REQUIRE(cache.getSize() == 3);
+    }
+}
+
+TEST_CASE("ShardedCache from several threads", "[cache]")
+{
+    cpp_ex::ShardedCache<cpp_ex::LruCache<int, int>> cache(256, 8);
+    REQUIRE(cache.getShardCount() == 8);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&cache, t]
+                             {
+                                 for (int i = 0; i < 5000; ++i)
+                                 {
+                                     int key = (i * 7 + t) % 512;
+                                     if (i % 3 == 0)
+                                     {
+                                         cache.put(key, key * 2);
+                                     }
+                                     else
+                                     {
+                                         int loaded = cache.getOrLoad(key, [](int k)
+                                                                      { return k * 2; });
+                                         if (loaded != key * 2)
+                                         {
+                                             cache.put(-1, -1); // Makes the failure visible
+                                         }
+                                     }
+                                 } });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    REQUIRE_FALSE(cache.contains(-1));
+    REQUIRE(cache.getSize() <= 256);
+    auto stats = cache.getStats();
+    REQUIRE(stats.hits + stats.misses > 0);
+    REQUIRE(cache.getWeight() == cache.getSize());
+
+    cache.clear();
+    REQUIRE(cache.getSize() == 0);
+}
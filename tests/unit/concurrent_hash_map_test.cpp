@@ -0,0 +1,257 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/libs/core/concurrent_hash_map.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("ConcurrentHashMap basic operations", "[concurrent_hash_map]")
+{
+    cpp_ex::ConcurrentHashMap<int, std::string> map(8);
+
+    SECTION("Shard count is rounded to a power of two")
+    {
+        REQUIRE(map.getShardCount() == 8);
+        REQUIRE(cpp_ex::ConcurrentHashMap<int, int>(5).getShardCount() == 8);
+        REQUIRE(cpp_ex::ConcurrentHashMap<int, int>(0).getShardCount() == 1);
+        REQUIRE(cpp_ex::ConcurrentHashMap<int, int>().getShardCount() >= 4);
+    }
+
+    SECTION("insert(), insertOrAssign() and find()")
+    {
+        REQUIRE(map.isEmpty());
+        REQUIRE(map.insert(1, "one"));
+        REQUIRE_FALSE(map.insert(1, "uno"));
+        REQUIRE(*map.find(1) == "one");
+
+        REQUIRE_FALSE(map.insertOrAssign(1, "uno"));
+        REQUIRE(map.insertOrAssign(2, "two"));
+        REQUIRE(*map.find(1) == "uno");
+        REQUIRE_FALSE(map.find(3).has_value());
+        REQUIRE(map.getOrDefault(3, "none") == "none");
+        REQUIRE(map.getSize() == 2);
+    }
+
+    SECTION("computeIfAbsent() only calls the factory on a miss")
+    {
+        int calls = 0;
+        auto factory = [&calls]
+        {
+            ++calls;
+            return std::string("created");
+        };
+        REQUIRE(map.computeIfAbsent(7, factory) == "created");
+        REQUIRE(map.computeIfAbsent(7, factory) == "created");
+        REQUIRE(calls == 1);
+    }
+
+    SECTION("updateWith(), upsert() and erase()")
+    {
+        map.insert(1, "a");
+        REQUIRE(map.updateWith(1, [](std::string &value)
+                               { value += "b"; }));
+        REQUIRE_FALSE(map.updateWith(2, [](std::string &value)
+                                     { value += "b"; }));
+        REQUIRE(*map.find(1) == "ab");
+
+        map.upsert(2, "x", [](std::string &value)
+                   { value += "y"; });
+        map.upsert(2, "x", [](std::string &value)
+                   { value += "y"; });
+        REQUIRE(*map.find(2) == "xy");
+
+        REQUIRE(map.erase(1));
+        REQUIRE_FALSE(map.erase(1));
+        REQUIRE_FALSE(map.contains(1));
+        REQUIRE(map.count(2) == 1);
+    }
+
+    SECTION("Snapshots, eraseIf() and clear()")
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            map.insert(i, std::to_string(i));
+        }
+        REQUIRE(map.getKeys().getSize() == 100);
+        REQUIRE(map.getEntries().getSize() == 100);
+        REQUIRE(map.toHashMap().at(42) == "42");
+
+        REQUIRE(map.eraseIf([](int key, const std::string &)
+                            { return key % 2 == 0; }) == 50);
+        REQUIRE(map.getSize() == 50);
+
+        int sum = 0;
+        map.forEach([&sum](const int &key, const std::string &)
+                    { sum += key; });
+        REQUIRE(sum == 2500);
+
+        map.clear();
+        REQUIRE(map.isEmpty());
+    }
+}
+
+namespace
+{
+    // Hash y comparación sin distinguir mayúsculas, con estado (semilla y contador de llamadas)
+    struct CaseInsensitiveHash
+    {
+        std::size_t seed = 0;
+        std::shared_ptr<std::atomic<int>> calls = std::make_shared<std::atomic<int>>(0);
+
+        std::size_t operator()(const std::string &key) const
+        {
+            ++*calls;
+            std::size_t hash = seed;
+            for (char c : key)
+            {
+                hash = hash * 31 + static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+            return hash;
+        }
+    };
+
+    struct CaseInsensitiveEqual
+    {
+        bool operator()(const std::string &a, const std::string &b) const
+        {
+            return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](char x, char y)
+                              { return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y)); });
+        }
+    };
+}
+
+TEST_CASE("ConcurrentHashMap with stateful hash and equality", "[concurrent_hash_map]")
+{
+    CaseInsensitiveHash hash{12345};
+    cpp_ex::ConcurrentHashMap<std::string, int, CaseInsensitiveHash, CaseInsensitiveEqual> map(4, hash, CaseInsensitiveEqual());
+    REQUIRE(map.hashFunction().seed == 12345);
+
+    for (int i = 0; i < 200; ++i)
+    {
+        REQUIRE(map.insert("Key" + std::to_string(i), i));
+    }
+    REQUIRE_FALSE(map.insert("KEY7", 0));
+    REQUIRE(map.find("kEy7") == 7);
+    REQUIRE(map.contains("KEY199"));
+    REQUIRE(map.erase("key0"));
+    REQUIRE(map.getSize() == 199);
+
+    // Las tablas de cada shard comparten el hasher del llamador (y su semilla)
+    auto before = hash.calls->load();
+    REQUIRE(map.find("key42") == 42);
+    REQUIRE(hash.calls->load() > before);
+
+    auto copy = map.toHashMap();
+    REQUIRE(copy.hashFunction().seed == 12345);
+    REQUIRE(copy.contains("KEY100"));
+}
+
+TEST_CASE("ConcurrentHashMap under concurrent access", "[concurrent_hash_map]")
+{
+    constexpr int kThreads = 8;
+    constexpr int kKeys = 64;
+    constexpr int kRounds = 2000;
+
+    SECTION("upsert() and updateWith() never lose increments")
+    {
+        cpp_ex::ConcurrentHashMap<int, long> counters(4);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t)
+        {
+            threads.emplace_back([&counters, t]
+                                 {
+                                     for (int i = 0; i < kRounds; ++i)
+                                     {
+                                         int key = (i + t) % kKeys;
+                                         if (i % 2 == 0)
+                                         {
+                                             counters.upsert(key, 1, [](long &value)
+                                                             { ++value; });
+                                         }
+                                         else if (!counters.updateWith(key, [](long &value)
+                                                                       { ++value; }))
+                                         {
+                                             counters.upsert(key, 1, [](long &value)
+                                                             { ++value; });
+                                         }
+                                     } });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        long total = 0;
+        counters.forEach([&total](const int &, const long &value)
+                         { total += value; });
+        REQUIRE(total == static_cast<long>(kThreads) * kRounds);
+        REQUIRE(counters.getSize() == kKeys);
+    }
+
+    SECTION("computeIfAbsent() creates each key exactly once")
+    {
+        cpp_ex::ConcurrentHashMap<int, int> map;
+        std::atomic<int> created{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t)
+        {
+            threads.emplace_back([&map, &created]
+                                 {
+                                     for (int i = 0; i < kRounds; ++i)
+                                     {
+                                         int key = i % kKeys;
+                                         int value = map.computeIfAbsent(key, [&created, key]
+                                                                         {
+                                                                             ++created;
+                                                                             return key * 10; });
+                                         if (value != key * 10)
+                                         {
+                                             ++created; // Makes the failure visible
+                                         }
+                                     } });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+        REQUIRE(created.load() == kKeys);
+    }
+
+    SECTION("Readers and writers on the same keys")
+    {
+        cpp_ex::ConcurrentHashMap<int, int> map(2);
+        std::atomic<bool> inconsistent{false};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t)
+        {
+            threads.emplace_back([&map, &inconsistent, t]
+                                 {
+                                     for (int i = 0; i < kRounds; ++i)
+                                     {
+                                         int key = i % kKeys;
+                                         if (t % 2 == 0)
+                                         {
+                                             map.insertOrAssign(key, key);
+                                             if (i % 3 == 0)
+                                             {
+                                                 map.erase(key);
+                                             }
+                                         }
+                                         else if (auto value = map.find(key); value && *value != key)
+                                         {
+                                             inconsistent = true;
+                                         }
+                                     } });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+        REQUIRE_FALSE(inconsistent.load());
+        REQUIRE(map.getSize() <= kKeys);
+    }
+}
@@ -0,0 +1,262 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/libs/core/counter.hpp"
+#include "../../src/libs/core/string.hpp"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Counter increments and decrements", "[counter]")
+{
+    cpp_ex::Counter<std::string> counter;
+
+    SECTION("increment() returns the new count")
+    {
+        REQUIRE(counter.isEmpty());
+        REQUIRE(counter.increment("a") == 1);
+        REQUIRE(counter.increment("a") == 2);
+        REQUIRE(counter.increment("b", 5) == 5);
+        REQUIRE(counter.getSize() == 2);
+        REQUIRE(counter.getTotal() == 7);
+        REQUIRE(counter.getCount("a") == 2);
+        REQUIRE(counter.getCount("missing") == 0);
+        REQUIRE_FALSE(counter.contains("missing"));
+    }
+
+    SECTION("Entries that drop to zero or below are erased")
+    {
+        counter.increment("a", 3);
+        REQUIRE(counter.decrement("a") == 2);
+        REQUIRE(counter.decrement("a", 5) == 0);
+        REQUIRE_FALSE(counter.contains("a"));
+        REQUIRE(counter.decrement("never") == 0);
+        REQUIRE(counter.isEmpty());
+
+        // A non-positive increment is a decrement
+        counter.increment("b", 2);
+        REQUIRE(counter.increment("b", -1) == 1);
+        REQUIRE(counter.increment("b", 0) == 1);
+        REQUIRE(counter.increment("b", -1) == 0);
+        REQUIRE(counter.isEmpty());
+    }
+
+    SECTION("erase() and clear()")
+    {
+        counter.increment("a");
+        counter.increment("b");
+        REQUIRE(counter.erase("a") == 1);
+        REQUIRE(counter.erase("a") == 0);
+        counter.clear();
+        REQUIRE(counter.isEmpty());
+    }
+}
+
+TEST_CASE("Counter construction and arithmetic", "[counter]")
+{
+    SECTION("Counting a range and an initializer list")
+    {
+        std::vector<int> values = {3, 1, 3, 2, 3, 1};
+        cpp_ex::Counter<int> fromRange(values.begin(), values.end());
+        REQUIRE(fromRange.getCount(3) == 3);
+        REQUIRE(fromRange.getCount(1) == 2);
+        REQUIRE(fromRange.getCount(2) == 1);
+
+        cpp_ex::Counter<int> fromList = {3, 1, 3, 2, 3, 1};
+        REQUIRE(fromList == fromRange);
+    }
+
+    SECTION("add() and subtract() across backends")
+    {
+        cpp_ex::Counter<char, cpp_ex::Map> letters = {'a', 'b', 'a', 'c'};
+        cpp_ex::Counter<char> more = {'a', 'c', 'c', 'd'};
+        letters.add(more);
+        REQUIRE(letters.getCount('a') == 3);
+        REQUIRE(letters.getCount('c') == 3);
+        REQUIRE(letters.getCount('d') == 1);
+
+        cpp_ex::Counter<char> remove = {'a', 'a', 'a', 'b', 'z'};
+        letters.subtract(remove);
+        REQUIRE_FALSE(letters.contains('a'));
+        REQUIRE_FALSE(letters.contains('b'));
+        REQUIRE_FALSE(letters.contains('z'));
+        REQUIRE(letters.getTotal() == 4);
+
+        // Map backend iterates in key order
+        std::string keys;
+        letters.forEach([&keys](char key, std::int64_t)
+                        { keys += key; });
+        REQUIRE(keys == "cd");
+    }
+
+    SECTION("operator+ and operator- leave the operands untouched")
+    {
+        cpp_ex::Counter<int> a = {1, 1, 2};
+        cpp_ex::Counter<int> b = {1, 3};
+        auto sum = a + b;
+        auto difference = a - b;
+        REQUIRE(sum.getCount(1) == 3);
+        REQUIRE(sum.getCount(3) == 1);
+        REQUIRE(difference.getCount(1) == 1);
+        REQUIRE(difference.getCount(2) == 1);
+        REQUIRE_FALSE(difference.contains(3));
+        REQUIRE(a.getTotal() == 3);
+        REQUIRE(a != sum);
+    }
+}
+
+TEST_CASE("Counter mostCommon", "[counter]")
+{
+    SECTION("Highest counts first, ties in key order with a Map backend")
+    {
+        cpp_ex::Counter<std::string, cpp_ex::Map> words;
+        for (const char *word : {"b", "a", "c", "a", "d", "c", "a", "e"})
+        {
+            words.increment(word);
+        }
+        auto top = words.mostCommon(3);
+        REQUIRE(top.getSize() == 3);
+        REQUIRE(top[0] == std::pair<std::string, std::int64_t>{"a", 3});
+        REQUIRE(top[1] == std::pair<std::string, std::int64_t>{"c", 2});
+        REQUIRE(top[2] == std::pair<std::string, std::int64_t>{"b", 1});
+    }
+
+    SECTION("k larger than the number of keys returns everything")
+    {
+        cpp_ex::Counter<int> counter = {5, 5, 6};
+        auto all = counter.mostCommon(10);
+        REQUIRE(all.getSize() == 2);
+        REQUIRE(all[0].first == 5);
+        REQUIRE(counter.mostCommon(0).isEmpty());
+        REQUIRE(cpp_ex::Counter<int>().mostCommon(3).isEmpty());
+    }
+}
+
+TEST_CASE("String counting helpers", "[counter]")
+{
+    cpp_ex::String text("the cat and the hat and the bat");
+
+    auto words = text.getWordFrequencies();
+    REQUIRE(words.getSize() == 5);
+    REQUIRE(words.at("the") == 3);
+    REQUIRE(words.at("and") == 2);
+    REQUIRE(words.at("bat") == 1);
+
+    auto characters = cpp_ex::String("abca\x80 b").countCharacters();
+    REQUIRE(characters.at('a') == 2);
+    REQUIRE(characters.at(' ') == 1);
+    REQUIRE(characters.at('\x80') == 1);
+    REQUIRE(characters.getSize() == 5);
+    // Same ordering as std::map<char, ...>
+    REQUIRE(characters.begin()->first == std::min('\x80', ' '));
+}
+
+TEST_CASE("ConcurrentCounter", "[counter]")
+{
+    constexpr int kThreads = 4;
+    constexpr int kRounds = 20000;
+    constexpr int kKeys = 37;
+
+    cpp_ex::ConcurrentCounter<int> counter;
+
+    SECTION("No increment is lost and counts survive their threads")
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t)
+        {
+            threads.emplace_back([&counter, t]
+                                 {
+                                     for (int i = 0; i < kRounds; ++i)
+                                     {
+                                         counter.increment((i + t) % kKeys);
+                                     } });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        REQUIRE(counter.getShardCount() == kThreads);
+        REQUIRE(counter.getTotal() == kThreads * kRounds);
+        auto snapshot = counter.snapshot<cpp_ex::Map>();
+        REQUIRE(snapshot.getSize() == kKeys);
+        std::int64_t sum = 0;
+        for (const auto &[key, count] : snapshot)
+        {
+            REQUIRE(counter.getCount(key) == count);
+            sum += count;
+        }
+        REQUIRE(sum == kThreads * kRounds);
+    }
+
+    SECTION("The same thread reuses its shard, and clear() resets the counts")
+    {
+        counter.increment(1);
+        counter.increment(1, 4);
+        counter.increment(2, 2);
+        REQUIRE(counter.getShardCount() == 1);
+        REQUIRE(counter.getCount(1) == 5);
+
+        auto top = counter.mostCommon(1);
+        REQUIRE(top.getSize() == 1);
+        REQUIRE(top[0].first == 1);
+
+        counter.clear();
+        REQUIRE(counter.getCount(1) == 0);
+        REQUIRE(counter.getTotal() == 0);
+    }
+
+    SECTION("Negative increments are merged before dropping empty keys")
+    {
+        std::thread other([&counter]
+                          { counter.increment(7, -2); });
+        other.join();
+        counter.increment(7, 3);
+        REQUIRE(counter.getCount(7) == 1);
+        REQUIRE(counter.snapshot().getSize() == 1);
+    }
+
+    SECTION("Independent counters do not share shards")
+    {
+        cpp_ex::ConcurrentCounter<int> other;
+        counter.increment(1);
+        other.increment(1, 10);
+        REQUIRE(counter.getCount(1) == 1);
+        REQUIRE(other.getCount(1) == 10);
+    }
+
+    SECTION("Destroyed counters leave the thread caches")
+    {
+        using Cache = cpp_ex::ConcurrentCounter<int>;
+        counter.increment(1);
+        auto base = Cache::getThreadCacheSize();
+        for (int i = 0; i < 1000; ++i)
+        {
+            Cache temporary;
+            temporary.increment(i);
+        }
+        REQUIRE(Cache::getThreadCacheSize() == base);
+
+        // Otro hilo destruye los contadores: este hilo solo se entera al purgar su caché
+        std::vector<std::unique_ptr<Cache>> live(1000);
+        std::size_t peak = 0;
+        for (int round = 0; round < 5; ++round)
+        {
+            std::thread replacer([&live]
+                                 {
+                                     for (auto &c : live)
+                                     {
+                                         c = std::make_unique<Cache>();
+                                     } });
+            replacer.join();
+            for (auto &c : live)
+            {
+                c->increment(1);
+                peak = std::max(peak, Cache::getThreadCacheSize());
+            }
+        }
+        REQUIRE(peak <= 2 * (live.size() + base));
+        REQUIRE(counter.getCount(1) == 1);
+    }
+}
@@ -0,0 +1,172 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/libs/core/cow.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Counts deep copies of the wrapped value
+    struct CopyCounter
+    {
+        static inline int copies = 0;
+        int value = 0;
+
+        CopyCounter() = default;
+        explicit CopyCounter(int v) : value(v) {}
+        CopyCounter(const CopyCounter &other) : value(other.value)
+        {
+            ++copies;
+        }
+        CopyCounter(CopyCounter &&) noexcept = default;
+        CopyCounter &operator=(const CopyCounter &) = default;
+        CopyCounter &operator=(CopyCounter &&) noexcept = default;
+
+        bool operator==(const CopyCounter &other) const
+        {
+            return value == other.value;
+        }
+    };
+
+    std::size_t sizeOf(const cpp_ex::Vector<int> &values)
+    {
+        return values.getSize();
+    }
+}
+
+TEST_CASE("Cow shares until the first write", "[cow]")
+{
+    CopyCounter::copies = 0;
+    cpp_ex::Cow<CopyCounter> original(std::in_place, 1);
+
+    SECTION("Copies share the buffer and never deep-copy")
+    {
+        auto a = original;
+        cpp_ex::Cow<CopyCounter> b;
+        b = a;
+        REQUIRE(CopyCounter::copies == 0);
+        REQUIRE(original.isShared());
+        REQUIRE(original.getUseCount() == 3);
+        REQUIRE(b.sharesWith(original));
+        REQUIRE(b.read().value == 1);
+        REQUIRE(b->value == 1);
+        REQUIRE((*b).value == 1);
+    }
+
+    SECTION("write() on a shared handle copies once")
+    {
+        auto copy = original;
+        copy.write().value = 2;
+        REQUIRE(CopyCounter::copies == 1);
+        REQUIRE(original.read().value == 1);
+        REQUIRE(copy.read().value == 2);
+        REQUIRE_FALSE(copy.sharesWith(original));
+        REQUIRE_FALSE(original.isShared());
+
+        // Both handles are unique now: further writes do not copy
+        copy.write().value = 3;
+        original.mutate([](CopyCounter &c)
+                        { c.value = 10; });
+        REQUIRE(CopyCounter::copies == 1);
+    }
+
+    SECTION("A unique handle is written in place")
+    {
+        REQUIRE_FALSE(original.isShared());
+        int previous = original.mutate([](CopyCounter &c)
+                                       { return std::exchange(c.value, 5); });
+        REQUIRE(previous == 1);
+        REQUIRE(original.read().value == 5);
+        REQUIRE(CopyCounter::copies == 0);
+    }
+
+    SECTION("take() moves out of a unique handle and copies a shared one")
+    {
+        auto shared = original;
+        CopyCounter fromShared = std::move(shared).take();
+        REQUIRE(CopyCounter::copies == 1);
+        CopyCounter fromUnique = std::move(original).take();
+        REQUIRE(CopyCounter::copies == 1);
+        REQUIRE(fromShared.value == 1);
+        REQUIRE(fromUnique.value == 1);
+    }
+
+    SECTION("Equality compares values")
+    {
+        auto same = original;
+        cpp_ex::Cow<CopyCounter> equal(std::in_place, 1);
+        cpp_ex::Cow<CopyCounter> different(std::in_place, 2);
+        REQUIRE(same == original);
+        REQUIRE(equal == original);
+        REQUIRE(different != original);
+    }
+}
+
+TEST_CASE("Cow with library containers", "[cow]")
+{
+    SECTION("CowMap")
+    {
+        cpp_ex::CowMap<std::string, int> config(cpp_ex::Map<std::string, int>{{"retries", 3}, {"timeout", 30}});
+        auto snapshot = config;
+        config.write()["retries"] = 5;
+        config.mutate([](auto &map)
+                      { map.erase("timeout"); });
+        REQUIRE(snapshot.read().at("retries") == 3);
+        REQUIRE(snapshot->getSize() == 2);
+        REQUIRE(config.read().at("retries") == 5);
+        REQUIRE(config->getSize() == 1);
+    }
+
+    SECTION("CowVector converts to const Vector&")
+    {
+        cpp_ex::CowVector<int> values(cpp_ex::Vector<int>{1, 2, 3});
+        auto copy = values;
+        REQUIRE(sizeOf(copy) == 3);
+        copy.write().pushBack(4);
+        REQUIRE(sizeOf(values) == 3);
+        REQUIRE(sizeOf(copy) == 4);
+    }
+
+    SECTION("CowString")
+    {
+        cpp_ex::CowString text(cpp_ex::String("hello"));
+        auto copy = text;
+        copy.write().append(" world");
+        REQUIRE(text.read() == "hello");
+        REQUIRE(copy.read() == "hello world");
+    }
+}
+
+TEST_CASE("Cow copies shared across threads", "[cow]")
+{
+    cpp_ex::CowVector<int> shared(cpp_ex::Vector<int>(1000, 1));
+    std::vector<std::thread> threads;
+    std::vector<long> sums(4, 0);
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([copy = shared, &sums, t]() mutable
+                             {
+                                 for (int round = 0; round < 100; ++round)
+                                 {
+                                     auto local = copy;
+                                     for (int value : local.read())
+                                     {
+                                         sums[t] += value;
+                                     }
+                                 }
+                                 // Each thread diverges from the shared buffer
+                                 copy.write()[0] = t;
+                                 sums[t] += copy.read()[0]; });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    for (int t = 0; t < 4; ++t)
+    {
+        REQUIRE(sums[t] == 100 * 1000 + t);
+    }
+    REQUIRE(shared.read()[0] == 1);
+    REQUIRE_FALSE(shared.isShared());
+}
@@ -0,0 +1,317 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/libs/core/durable_map.hpp"
+#include "../../src/libs/core/string.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace
+{
+    // Directorio temporal que se borra al salir del test
+    class TempDirectory
+    {
+    private:
+        std::filesystem::path path;
+
+    public:
+        TempDirectory()
+        {
+            static std::atomic<int> counter{0};
+            path = std::filesystem::temp_directory_path() /
+                   ("cpp_ex_durable_map_" + std::to_string(::getpid()) + "_" + std::to_string(counter++));
+            std::filesystem::remove_all(path);
+        }
+
+        ~TempDirectory()
+        {
+            std::filesystem::remove_all(path);
+        }
+
+        const std::filesystem::path &get() const
+        {
+            return path;
+        }
+    };
+
+    using StringMap = cpp_ex::DurableMap<cpp_ex::String, cpp_ex::String>;
+
+    cpp_ex::DurabilityOptions everyWrite()
+    {
+        cpp_ex::DurabilityOptions options;
+        options.syncMode = cpp_ex::SyncMode::EveryWrite;
+        return options;
+    }
+}
+
+TEST_CASE("DurableMap survives reopening", "[durable_map]")
+{
+    TempDirectory dir;
+
+    SECTION("insert, insertOrAssign, erase and clear are replayed")
+    {
+        {
+            StringMap map(dir.get());
+            REQUIRE(map.isEmpty());
+            REQUIRE(map.insert("a", "1"));
+            REQUIRE_FALSE(map.insert("a", "ignored"));
+            REQUIRE(map.insertOrAssign("b", "2"));
+            REQUIRE_FALSE(map.insertOrAssign("b", "two"));
+            REQUIRE(map.insert("c", "3"));
+            REQUIRE(map.erase("c") == 1);
+            REQUIRE(map.erase("missing") == 0);
+            REQUIRE(map.getSequence() == 5); // Only the calls that changed the map
+        }
+
+        {
+            StringMap map(dir.get());
+            REQUIRE(map.getSize() == 2);
+            REQUIRE(map.at("a") == "1");
+            REQUIRE(map.at("b") == "two");
+            REQUIRE_FALSE(map.contains("c"));
+            REQUIRE(map.getRecovery().replayedRecords == 5);
+            REQUIRE(map.getSequence() == 5);
+
+            map.clear();
+            map.insert("d", "4");
+        }
+
+        StringMap map(dir.get());
+        REQUIRE(map.getSize() == 1);
+        REQUIRE(map.at("d") == "4");
+        REQUIRE(map.getSequence() == 7);
+    }
+
+    SECTION("Group commit keeps records in memory until a group is full or flush()")
+    {
+        cpp_ex::DurabilityOptions options;
+        options.groupCommitRecords = 4;
+        options.groupCommitDelay = std::chrono::hours(1);
+        StringMap map(dir.get(), options);
+
+        map.insert("a", "1");
+        map.insert("b", "2");
+        map.insert("c", "3");
+        REQUIRE(map.getPendingRecords() == 3);
+        REQUIRE(map.getLogBytes() == 0);
+        REQUIRE(std::filesystem::file_size(dir.get() / "wal") == 0);
+
+        map.insert("d", "4");
+        REQUIRE(map.getPendingRecords() == 0);
+        REQUIRE(map.getLogBytes() == std::filesystem::file_size(dir.get() / "wal"));
+
+        map.insert("e", "5");
+        map.flush();
+        REQUIRE(map.getPendingRecords() == 0);
+
+        StringMap reopened(dir.get());
+        REQUIRE(reopened.getSize() == 5);
+    }
+
+    SECTION("Integer keys and values")
+    {
+        {
+            cpp_ex::DurableMap<std::int64_t, double> map(dir.get(), everyWrite());
+            for (std::int64_t i = -50; i < 50; ++i)
+            {
+                map.insertOrAssign(i, static_cast<double>(i) / 2);
+            }
+        }
+        cpp_ex::DurableMap<std::int64_t, double> map(dir.get());
+        REQUIRE(map.getSize() == 100);
+        REQUIRE(map.at(-50) == -25.0);
+        REQUIRE(map.begin()->first == -50);
+    }
+}
+
+TEST_CASE("DurableMap recovery from damaged logs", "[durable_map]")
+{
+    TempDirectory dir;
+    {
+        StringMap map(dir.get(), everyWrite());
+        map.insert("a", "1");
+        map.insert("b", "2");
+        map.insert("c", "3");
+    }
+    auto logPath = dir.get() / "wal";
+    auto fullSize = std::filesystem::file_size(logPath);
+
+    SECTION("A torn last record is discarded and overwritten")
+    {
+        std::filesystem::resize_file(logPath, fullSize - 3);
+        {
+            StringMap map(dir.get(), everyWrite());
+            REQUIRE(map.getSize() == 2);
+            REQUIRE_FALSE(map.contains("c"));
+            REQUIRE(map.getRecovery().discardedBytes > 0);
+            map.insert("d", "4");
+        }
+        StringMap map(dir.get());
+        REQUIRE(map.getSize() == 3);
+        REQUIRE(map.contains("d"));
+        REQUIRE(map.getRecovery().discardedBytes == 0);
+    }
+
+    SECTION("A checksum mismatch ends the log")
+    {
+        {
+            std::fstream file(logPath, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(static_cast<std::streamoff>(fullSize / 2));
+            file.put('\x7F');
+        }
+        StringMap map(dir.get());
+        REQUIRE(map.getSize() < 3);
+        REQUIRE(map.getRecovery().discardedBytes > 0);
+    }
+
+    SECTION("Trailing garbage is ignored")
+    {
+        {
+            std::ofstream file(logPath, std::ios::app | std::ios::binary);
+            file << "garbage";
+        }
+        StringMap map(dir.get());
+        REQUIRE(map.getSize() == 3);
+        REQUIRE(map.getRecovery().discardedBytes == 7);
+    }
+}
+
+TEST_CASE("DurableMap after a failed log write", "[durable_map]")
+{
+    TempDirectory dir;
+    cpp_ex::DurabilityOptions options;
+    options.groupCommitRecords = 100000;
+    options.groupCommitBytes = 1 << 30;
+    options.groupCommitDelay = std::chrono::hours(1);
+    {
+        StringMap map(dir.get(), options);
+        map.insert("first", "1");
+        map.flush();
+        auto goodBytes = map.getLogBytes();
+        for (int i = 0; i < 200; ++i)
+        {
+            map.insert(cpp_ex::String(std::to_string(i)), cpp_ex::String(std::string(100, 'x')));
+        }
+
+        // Un límite de tamaño de fichero hace que write() escriba sólo una parte del grupo y luego falle
+        rlimit saved{};
+        REQUIRE(::getrlimit(RLIMIT_FSIZE, &saved) == 0);
+        auto savedHandler = std::signal(SIGXFSZ, SIG_IGN);
+        rlimit limited = saved;
+        limited.rlim_cur = static_cast<rlim_t>(goodBytes + 1000);
+        REQUIRE(::setrlimit(RLIMIT_FSIZE, &limited) == 0);
+        REQUIRE_THROWS_AS(map.flush(), std::system_error);
+        REQUIRE(::setrlimit(RLIMIT_FSIZE, &saved) == 0);
+        std::signal(SIGXFSZ, savedHandler);
+
+        // El prefijo escrito se ha quitado y el grupo sigue pendiente
+        REQUIRE(std::filesystem::file_size(dir.get() / "wal") == goodBytes);
+        REQUIRE(map.getLogBytes() == goodBytes);
+        map.insert("last", "2");
+        map.flush();
+    }
+    StringMap map(dir.get());
+    REQUIRE(map.getRecovery().discardedBytes == 0);
+    REQUIRE(map.getSize() == 202);
+    REQUIRE(map.contains("199"));
+    REQUIRE(map.contains("last"));
+}
+
+TEST_CASE("DurableMap compaction", "[durable_map]")
+{
+    TempDirectory dir;
+
+    SECTION("compact() writes a snapshot and empties the log")
+    {
+        {
+            StringMap map(dir.get());
+            for (int i = 0; i < 100; ++i)
+            {
+                map.insertOrAssign(cpp_ex::String(std::to_string(i)), cpp_ex::String("v" + std::to_string(i)));
+            }
+            map.erase("50");
+            map.compact();
+            REQUIRE(map.getLogBytes() == 0);
+            REQUIRE(std::filesystem::exists(dir.get() / "snapshot"));
+            REQUIRE_FALSE(std::filesystem::exists(dir.get() / "snapshot.tmp"));
+            map.insertOrAssign("0", "changed after the snapshot");
+        }
+
+        StringMap map(dir.get());
+        REQUIRE(map.getSize() == 99);
+        REQUIRE(map.getRecovery().snapshotEntries == 99);
+        REQUIRE(map.getRecovery().replayedRecords == 1);
+        REQUIRE(map.at("0") == "changed after the snapshot");
+        REQUIRE(map.at("99") == "v99");
+        REQUIRE(map.getSequence() == 102);
+    }
+
+    SECTION("Records already in the snapshot are skipped")
+    {
+        // Simulates a crash between publishing the snapshot and truncating the log
+        std::string oldLog;
+        {
+            StringMap map(dir.get(), everyWrite());
+            map.insert("a", "1");
+            map.insert("b", "2");
+            map.erase("a");
+            std::ifstream file(dir.get() / "wal", std::ios::binary);
+            oldLog.assign(std::istreambuf_iterator<char>(file), {});
+            map.compact();
+        }
+        {
+            std::ofstream file(dir.get() / "wal", std::ios::binary | std::ios::trunc);
+            file << oldLog;
+        }
+        StringMap map(dir.get());
+        REQUIRE(map.getSize() == 1);
+        REQUIRE(map.at("b") == "2");
+        REQUIRE(map.getRecovery().skippedRecords == 3);
+        REQUIRE(map.getRecovery().replayedRecords == 0);
+    }
+
+    SECTION("The log is compacted automatically past compactLogBytes")
+    {
+        cpp_ex::DurabilityOptions options;
+        options.syncMode = cpp_ex::SyncMode::OsBuffered;
+        options.groupCommitRecords = 16;
+        options.compactLogBytes = 4096;
+        {
+            StringMap map(dir.get(), options);
+            for (int round = 0; round < 50; ++round)
+            {
+                for (int i = 0; i < 20; ++i)
+                {
+                    map.insertOrAssign(cpp_ex::String(std::to_string(i)), cpp_ex::String(std::to_string(round)));
+                }
+            }
+            REQUIRE(map.getLogBytes() < options.compactLogBytes);
+        }
+        REQUIRE(std::filesystem::exists(dir.get() / "snapshot"));
+
+        StringMap map(dir.get());
+        REQUIRE(map.getSize() == 20);
+        REQUIRE(map.at("7") == "49");
+    }
+
+    SECTION("A corrupt snapshot is an error, not an empty map")
+    {
+        {
+            StringMap map(dir.get());
+            map.insert("a", "1");
+            map.compact();
+        }
+        {
+            std::fstream file(dir.get() / "snapshot", std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(25); // First key byte
+            file.put('X');
+        }
+        REQUIRE_THROWS_AS(StringMap(dir.get()), cpp_ex::exceptions::SerializationError);
+    }
+}
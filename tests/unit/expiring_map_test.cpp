@@ -0,0 +1,230 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/libs/core/expiring_map.hpp"
+#include "../../src/libs/core/map.hpp"
+#include "../../src/libs/core/string.hpp"
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    using ManualMap = cpp_ex::ExpiringMap<int, int, cpp_ex::ManualClock>;
+}
+
+TEST_CASE("ExpiringMap basic operations", "[expiring_map]")
+{
+    cpp_ex::ManualClock clock;
+    ManualMap map(10s, 1s, clock);
+
+    SECTION("Entries disappear at their deadline, lazily and through expire()")
+    {
+        map.put(1, 100);
+        map.put(2, 200, 5s);
+        REQUIRE(map.getSize() == 2);
+        REQUIRE(*map.find(1) == 100);
+        REQUIRE(map.getDeadline(2) == clock.now() + 5s);
+
+        clock.advance(5s);
+        REQUIRE_FALSE(map.contains(2));
+        REQUIRE(map.get(2) == std::nullopt);
+        REQUIRE(map.find(2) == nullptr);
+        REQUIRE(map.getSize() == 2); // Aún no se ha recogido
+        REQUIRE(map.expire() == 1);
+        REQUIRE(map.getSize() == 1);
+
+        clock.advance(4999ms);
+        REQUIRE(map.contains(1));
+        REQUIRE(map.expire() == 0);
+        clock.advance(1ms);
+        REQUIRE_FALSE(map.contains(1));
+        REQUIRE(map.expire() == 1);
+        REQUIRE(map.isEmpty());
+    }
+
+    SECTION("touch and put renew the deadline")
+    {
+        map.put(1, 100);
+        clock.advance(8s);
+        REQUIRE(map.touch(1));
+        map.put(2, 200);
+        clock.advance(8s);
+        map.put(2, 201);
+        REQUIRE(map.expire() == 0);
+        REQUIRE(map.get(1) == 100);
+
+        clock.advance(2s);
+        REQUIRE(map.expire() == 1);
+        REQUIRE_FALSE(map.touch(1));
+        REQUIRE(map.get(2) == 201);
+        REQUIRE(map.touch(2, 1h));
+        clock.advance(59min);
+        REQUIRE(map.expire() == 0);
+        REQUIRE(map.contains(2));
+    }
+
+    SECTION("erase, non-positive TTLs and clear")
+    {
+        map.put(1, 100);
+        map.put(2, 200, 1s);
+        REQUIRE(map.erase(1));
+        REQUIRE_FALSE(map.erase(1));
+        clock.advance(1s);
+        REQUIRE_FALSE(map.erase(2)); // Vencida: se borra pero no cuenta
+        REQUIRE(map.isEmpty());
+
+        map.put(3, 300);
+        map.put(3, 301, 0s);
+        REQUIRE_FALSE(map.contains(3));
+        map.put(4, 400);
+        REQUIRE(map.touch(4, -1s));
+        REQUIRE(map.isEmpty());
+
+        map.put(5, 500);
+        map.clear();
+        REQUIRE(map.isEmpty());
+        REQUIRE(map.expire() == 0);
+        REQUIRE_THROWS_AS(ManualMap(0s, 1s, clock), std::invalid_argument);
+        REQUIRE_THROWS_AS(ManualMap(1s, 0s, clock), std::invalid_argument);
+    }
+
+    SECTION("expire(func) hands out the expired entries")
+    {
+        cpp_ex::ExpiringMap<cpp_ex::String, cpp_ex::String, cpp_ex::ManualClock> sessions(30min, 1s, clock);
+        sessions.put("alice", "token-a");
+        sessions.put("bob", "token-b", 1h);
+        clock.advance(30min);
+
+        cpp_ex::Map<cpp_ex::String, cpp_ex::String> expired;
+        auto count = sessions.expire([&expired](const cpp_ex::String &key, cpp_ex::String &value)
+                                     { expired[key] = std::move(value); });
+        REQUIRE(count == 1);
+        REQUIRE(expired.getSize() == 1);
+        REQUIRE(expired.at("alice") == "token-a");
+        REQUIRE(sessions.contains("bob"));
+
+        int live = 0;
+        sessions.forEach([&live](const cpp_ex::String &, const cpp_ex::String &)
+                         { ++live; });
+        REQUIRE(live == 1);
+    }
+}
+
+TEST_CASE("ExpiringMap timing wheel matches a full scan", "[expiring_map]")
+{
+    cpp_ex::ManualClock clock;
+    // Tick de 1 ms con TTLs de hasta ~2 h: las entradas recorren cuatro niveles de la rueda
+    ManualMap map(1s, 1ms, clock);
+    cpp_ex::Map<int, std::int64_t> deadlines; // Modelo: clave -> vencimiento en ms
+
+    std::uint64_t state = 12345;
+    auto next = [&state]
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return state >> 33;
+    };
+    std::int64_t now = 0;
+
+    for (int round = 0; round < 3000; ++round)
+    {
+        for (int i = 0; i < 5; ++i)
+        {
+            int key = static_cast<int>(next() % 2000);
+            auto choice = next() % 10;
+            std::int64_t ttl = choice < 6 ? static_cast<std::int64_t>(next() % 500 + 1)
+                               : choice < 9 ? static_cast<std::int64_t>(next() % 300000 + 1)
+                                            : static_cast<std::int64_t>(next() % 7200000 + 1);
+            if (next() % 4 == 0)
+            {
+                if (map.touch(key, std::chrono::milliseconds(ttl)))
+                {
+                    deadlines[key] = now + ttl;
+                }
+            }
+            else
+            {
+                map.put(key, round, std::chrono::milliseconds(ttl));
+                deadlines[key] = now + ttl;
+            }
+        }
+
+        auto step = next() % 20 == 0 ? static_cast<std::int64_t>(next() % 3000000) : static_cast<std::int64_t>(next() % 200);
+        now += step;
+        clock.advance(std::chrono::milliseconds(step));
+
+        std::size_t expected = 0;
+        cpp_ex::Vector<int> due;
+        for (const auto &[key, deadline] : deadlines)
+        {
+            if (deadline <= now)
+            {
+                due.pushBack(key);
+            }
+        }
+        for (auto key : due)
+        {
+            deadlines.erase(key);
+            ++expected;
+        }
+        REQUIRE(map.expire() == expected);
+        REQUIRE(map.getSize() == deadlines.getSize());
+        for (const auto &[key, deadline] : deadlines)
+        {
+            REQUIRE(map.contains(key));
+        }
+    }
+}
+
+TEST_CASE("ExpiringMap with the steady clock", "[expiring_map]")
+{
+    cpp_ex::ExpiringMap<int, int> map(1h);
+    map.put(1, 1);
+    map.put(2, 2, 1ns);
+    std::this_thread::sleep_for(2ms);
+    REQUIRE(map.contains(1));
+    REQUIRE_FALSE(map.contains(2));
+    REQUIRE(map.expire() == 1);
+}
+
+TEST_CASE("ShardedExpiringMap from several threads", "[expiring_map]")
+{
+    cpp_ex::ManualClock clock;
+    cpp_ex::ShardedExpiringMap<int, int, cpp_ex::ManualClock> map(10s, 8, 1s, clock);
+    REQUIRE(map.getShardCount() == 8);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&map, t]
+                             {
+                                 for (int i = 0; i < 1000; ++i)
+                                 {
+                                     int key = t * 1000 + i;
+                                     map.put(key, key, i % 2 == 0 ? std::chrono::seconds(5) : std::chrono::seconds(20));
+                                     if (map.get(key) != key)
+                                     {
+                                         throw std::logic_error("lost write");
+                                     }
+                                 } });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    REQUIRE(map.getSize() == 4000);
+
+    clock.advance(5s);
+    REQUIRE_FALSE(map.contains(0));
+    REQUIRE(map.contains(1));
+    REQUIRE(map.touch(1, 30s));
+    REQUIRE(map.expire() == 2000);
+
+    clock.advance(15s);
+    REQUIRE(map.expire() == 1999);
+    REQUIRE(map.getDeadline(1).has_value());
+    REQUIRE(map.erase(1));
+    REQUIRE(map.getSize() == 0);
+}
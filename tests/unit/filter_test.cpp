@@ -0,0 +1,283 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/libs/core/filter.hpp"
+#include "../../src/libs/core/flat_map.hpp"
+#include "../../src/libs/core/hash_map.hpp"
+#include "../../src/libs/core/map.hpp"
+#include "../../src/libs/core/string.hpp"
+#include <cstdint>
+#include <string>
+
+namespace
+{
+    // Fracción de claves ajenas (a partir de 10^9) que el filtro deja pasar
+    template <typename Filter>
+    double measuredFalsePositiveRate(const Filter &filter, std::uint64_t probes)
+    {
+        std::uint64_t positives = 0;
+        for (std::uint64_t i = 0; i < probes; ++i)
+        {
+            positives += filter.mayContain(1000000000 + i) ? 1 : 0;
+        }
+        return static_cast<double>(positives) / static_cast<double>(probes);
+    }
+
+    cpp_ex::Vector<std::uint64_t> sampleKeys(std::uint64_t count)
+    {
+        cpp_ex::Vector<std::uint64_t> keys;
+        for (std::uint64_t i = 0; i < count; ++i)
+        {
+            keys.pushBack(i * 7 + 3);
+        }
+        return keys;
+    }
+}
+
+TEST_CASE("BloomFilter", "[filter]")
+{
+    auto keys = sampleKeys(50000);
+
+    SECTION("No false negatives and about the requested false positive rate")
+    {
+        auto filter = cpp_ex::BloomFilter<std::uint64_t>::fromKeys(keys, 0.01);
+        for (auto key : keys)
+        {
+            REQUIRE(filter.mayContain(key));
+        }
+        REQUIRE(measuredFalsePositiveRate(filter, 200000) < 0.02);
+        REQUIRE(filter.getFalsePositiveRate() <= 0.0101);
+        REQUIRE(filter.getInsertedCount() == keys.getSize());
+        REQUIRE(filter.getByteSize() == filter.getBlockCount() * 32);
+    }
+
+    SECTION("A lower rate uses more memory")
+    {
+        cpp_ex::BloomFilter<std::uint64_t> loose(10000, 0.05);
+        cpp_ex::BloomFilter<std::uint64_t> tight(10000, 0.001);
+        REQUIRE(tight.getByteSize() > loose.getByteSize());
+        REQUIRE_THROWS_AS(cpp_ex::BloomFilter<std::uint64_t>(10, 0.0), std::invalid_argument);
+        REQUIRE_THROWS_AS(cpp_ex::BloomFilter<std::uint64_t>(10, 1.0), std::invalid_argument);
+    }
+
+    SECTION("Empty filter, clear and merge")
+    {
+        cpp_ex::BloomFilter<cpp_ex::String> filter;
+        REQUIRE_FALSE(filter.mayContain("alice"));
+        filter.insert("alice");
+        REQUIRE(filter.mayContain("alice"));
+        filter.clear();
+        REQUIRE_FALSE(filter.mayContain("alice"));
+
+        cpp_ex::BloomFilter<std::uint64_t> left(1000), right(1000);
+        left.insert(1);
+        right.insert(2);
+        left.merge(right);
+        REQUIRE(left.mayContain(1));
+        REQUIRE(left.mayContain(2));
+        REQUIRE(left.getInsertedCount() == 2);
+        REQUIRE_THROWS_AS(left.merge(cpp_ex::BloomFilter<std::uint64_t>(100000)), std::invalid_argument);
+    }
+
+    SECTION("Serialization round trip and corruption")
+    {
+        auto filter = cpp_ex::BloomFilter<std::uint64_t>::fromKeys(keys);
+        cpp_ex::BinaryWriter out;
+        out.write(filter);
+        std::string bytes(out.getBuffer());
+
+        cpp_ex::BinaryReader in(bytes);
+        auto copy = in.read<cpp_ex::BloomFilter<std::uint64_t>>();
+        REQUIRE(in.isAtEnd());
+        REQUIRE(copy == filter);
+        REQUIRE(copy.getInsertedCount() == filter.getInsertedCount());
+
+        bytes[bytes.size() / 2] ^= 0x10;
+        cpp_ex::BinaryReader corrupt(bytes);
+        REQUIRE_THROWS_AS(corrupt.read<cpp_ex::BloomFilter<std::uint64_t>>(), cpp_ex::exceptions::SerializationError);
+        cpp_ex::BinaryReader truncated(std::string_view(bytes).substr(0, 20));
+        REQUIRE_THROWS_AS(truncated.read<cpp_ex::BloomFilter<std::uint64_t>>(), cpp_ex::exceptions::SerializationError);
+    }
+}
+
+TEST_CASE("BinaryFuseFilter", "[filter]")
+{
+    SECTION("No false negatives and a false positive rate near 1/256")
+    {
+        for (std::uint64_t count : {1, 2, 3, 10, 1000, 100000})
+        {
+            auto keys = sampleKeys(count);
+            auto filter = cpp_ex::BinaryFuseFilter<std::uint64_t>::fromKeys(keys, 4);
+            REQUIRE(filter.getKeyCount() == count);
+            for (auto key : keys)
+            {
+                REQUIRE(filter.mayContain(key));
+            }
+            if (count >= 1000)
+            {
+                REQUIRE(measuredFalsePositiveRate(filter, 200000) < 0.008);
+                REQUIRE(filter.getByteSize() < count * 3 / 2);
+            }
+        }
+    }
+
+    SECTION("Parallel and sequential builds give the same filter")
+    {
+        auto keys = sampleKeys(100000);
+        auto sequential = cpp_ex::BinaryFuseFilter<std::uint64_t>::fromKeys(keys, 1);
+        REQUIRE(cpp_ex::BinaryFuseFilter<std::uint64_t>::fromKeys(keys, 3) == sequential);
+        REQUIRE(cpp_ex::BinaryFuseFilter<std::uint64_t>::fromKeys(keys, 8) == sequential);
+    }
+
+    SECTION("Duplicate keys and the empty filter")
+    {
+        cpp_ex::Vector<std::uint64_t> keys = {5, 9, 5, 9, 5};
+        auto filter = cpp_ex::BinaryFuseFilter<std::uint64_t>::fromKeys(keys);
+        REQUIRE(filter.getKeyCount() == 2);
+        REQUIRE(filter.mayContain(5));
+        REQUIRE(filter.mayContain(9));
+
+        // Muchas repeticiones, también de más de dos copias
+        for (std::uint64_t distinct : {200, 1000, 20000})
+        {
+            cpp_ex::Vector<std::uint64_t> repeated;
+            std::uint64_t state = distinct;
+            for (std::uint64_t i = 0; i < distinct * 5; ++i)
+            {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                repeated.pushBack(i < distinct ? i * 7919 : (state >> 33) % distinct * 7919);
+            }
+            auto dedupe = cpp_ex::BinaryFuseFilter<std::uint64_t>::fromKeys(repeated, 2);
+            REQUIRE(dedupe.getKeyCount() == distinct);
+            for (auto key : repeated)
+            {
+                REQUIRE(dedupe.mayContain(key));
+            }
+            REQUIRE(cpp_ex::BinaryFuseFilter<std::uint64_t>::fromKeys(repeated, 1) == dedupe);
+        }
+
+        cpp_ex::BinaryFuseFilter<std::uint64_t> empty;
+        REQUIRE(empty.isEmpty());
+        REQUIRE_FALSE(empty.mayContain(5));
+        REQUIRE(cpp_ex::BinaryFuseFilter<std::uint64_t>::fromKeys({}).getByteSize() == 0);
+    }
+
+    SECTION("Serialization round trip and corruption")
+    {
+        auto filter = cpp_ex::BinaryFuseFilter<std::uint64_t>::fromKeys(sampleKeys(5000));
+        cpp_ex::BinaryWriter out;
+        out.write(filter);
+        out.write(cpp_ex::BinaryFuseFilter<std::uint64_t>());
+        std::string bytes(out.getBuffer());
+
+        cpp_ex::BinaryReader in(bytes);
+        REQUIRE(in.read<cpp_ex::BinaryFuseFilter<std::uint64_t>>() == filter);
+        REQUIRE(in.read<cpp_ex::BinaryFuseFilter<std::uint64_t>>().isEmpty());
+        REQUIRE(in.isAtEnd());
+
+        bytes[100] ^= 0x01;
+        cpp_ex::BinaryReader corrupt(bytes);
+        REQUIRE_THROWS_AS(corrupt.read<cpp_ex::BinaryFuseFilter<std::uint64_t>>(), cpp_ex::exceptions::SerializationError);
+    }
+}
+
+TEST_CASE("FilteredMap", "[filter]")
+{
+    SECTION("Bloom front over a Map: lookups, insert and erase")
+    {
+        cpp_ex::Map<cpp_ex::String, int> source = {{"alice", 1}, {"bob", 2}};
+        cpp_ex::FilteredMap<cpp_ex::Map<cpp_ex::String, int>> map(source);
+        REQUIRE(map.contains("alice"));
+        REQUIRE_FALSE(map.contains("carol"));
+        REQUIRE(map.count("bob") == 1);
+        REQUIRE(map.find("bob")->second == 2);
+        REQUIRE(map.find("carol") == map.end());
+        REQUIRE(map.at("alice") == 1);
+        REQUIRE_THROWS_AS(map.at("carol"), std::out_of_range);
+
+        map["carol"] = 3;
+        REQUIRE(map.insert({"dave", 4}).second);
+        REQUIRE(map.contains("carol"));
+        REQUIRE(map.contains("dave"));
+        REQUIRE(map.getSize() == 4);
+
+        REQUIRE(map.erase("alice") == 1);
+        REQUIRE_FALSE(map.contains("alice"));
+        REQUIRE(map.erase("zed") == 0);
+        map.rebuildFilter();
+        REQUIRE(map.getFilter().getInsertedCount() == 3);
+    }
+
+    SECTION("The Bloom filter grows with the keys inserted through the map")
+    {
+        using FilteredType = cpp_ex::FilteredMap<cpp_ex::HashMap<int, int>>;
+        FilteredType grown;
+        FilteredType reserved(10000);
+        auto reservedBlocks = reserved.getFilter().getBlockCount();
+        for (int i = 0; i < 10000; ++i)
+        {
+            grown[i * 2] = i;
+            grown[i * 2] += 1; // Clave repetida: no se vuelve a añadir al filtro
+            REQUIRE(reserved.insert({i * 2, i}).second);
+        }
+        REQUIRE(grown.getSize() == 10000);
+        REQUIRE(grown.getFilter().getInsertedCount() <= 2 * grown.getSize());
+        REQUIRE(grown.getFilter().getBlockCount() > 1);
+        REQUIRE(reserved.getFilter().getBlockCount() == reservedBlocks);
+
+        // Claves impares: ninguna está, cada "quizá" del filtro es un falso positivo
+        int grownFalsePositives = 0;
+        int reservedFalsePositives = 0;
+        for (int i = 0; i < 100000; ++i)
+        {
+            int key = i * 2 + 1;
+            REQUIRE_FALSE(grown.contains(key));
+            grownFalsePositives += grown.getFilter().mayContain(key) ? 1 : 0;
+            reservedFalsePositives += reserved.getFilter().mayContain(key) ? 1 : 0;
+        }
+        REQUIRE(grownFalsePositives < 2000);
+        REQUIRE(reservedFalsePositives < 2000);
+        for (int i = 0; i < 10000; ++i)
+        {
+            REQUIRE(grown.at(i * 2) == i + 1);
+        }
+    }
+
+    SECTION("Binary fuse front over a HashMap: immutable except through update()")
+    {
+        cpp_ex::HashMap<std::uint64_t, int> source;
+        for (std::uint64_t i = 0; i < 10000; ++i)
+        {
+            source[i * 3] = static_cast<int>(i);
+        }
+        using FilteredType = cpp_ex::FilteredMap<cpp_ex::HashMap<std::uint64_t, int>, cpp_ex::BinaryFuseFilter<std::uint64_t>>;
+        FilteredType map(std::move(source));
+        static_assert(!cpp_ex::detail::InsertableFilter<FilteredType::filter_type, std::uint64_t>);
+        for (std::uint64_t i = 0; i < 30000; ++i)
+        {
+            REQUIRE(map.contains(i) == (i % 3 == 0));
+        }
+
+        map.update([](auto &inner)
+                   { inner[1] = -1; });
+        REQUIRE(map.contains(1));
+        REQUIRE(map.getFilter().getKeyCount() == 10001);
+    }
+
+    SECTION("Prebuilt filter over a FlatMap")
+    {
+        cpp_ex::FlatMap<int, int> source = {{1, 10}, {2, 20}, {3, 30}};
+        auto filter = cpp_ex::BloomFilter<int>::fromMap(source);
+        cpp_ex::FilteredMap<cpp_ex::FlatMap<int, int>> map(source, filter);
+        REQUIRE(map.find(2)->second == 20);
+        REQUIRE_FALSE(map.contains(4));
+        map.insert({4, 40});
+        REQUIRE(map.at(4) == 40);
+
+        int sum = 0;
+        for (const auto &[key, value] : map)
+        {
+            sum += value;
+        }
+        REQUIRE(sum == 100);
+    }
+}
@@ -0,0 +1,324 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/libs/core/flat_map.hpp"
+#include <string>
+#include <map>
+#include <atomic>
+#include <stdexcept>
+
+TEST_CASE("FlatMap constructors", "[flat_map]")
+{
+    SECTION("Default constructor")
+    {
+        cpp_ex::FlatMap<int, std::string> map;
+        REQUIRE(map.isEmpty());
+        REQUIRE(map.getSize() == 0);
+        REQUIRE(map.begin() == map.end());
+    }
+
+    SECTION("Bulk construction sorts and removes duplicates")
+    {
+        cpp_ex::FlatMap<int, std::string> map = {
+            {3, "three"},
+            {1, "one"},
+            {2, "two"},
+            {1, "uno"}};
+
+        REQUIRE(map.getSize() == 3);
+        REQUIRE(map.getKeys() == cpp_ex::Vector<int>{1, 2, 3});
+        // The first occurrence wins, as with repeated Map::insert
+        REQUIRE(map[1] == "one");
+    }
+
+    SECTION("Constructor with custom comparator")
+    {
+        cpp_ex::FlatMap<int, int, std::greater<int>> map = {{1, 1}, {3, 3}, {2, 2}};
+        REQUIRE(map.getKeys() == cpp_ex::Vector<int>{3, 2, 1});
+        REQUIRE(map.lowerBound(2)->first == 2);
+    }
+
+    SECTION("fromSorted() adopts the columns")
+    {
+        auto map = cpp_ex::FlatMap<int, std::string>::fromSorted({1, 5, 9}, {"a", "b", "c"});
+        REQUIRE(map.getSize() == 3);
+        REQUIRE(map.at(5) == "b");
+        REQUIRE_THROWS_AS((cpp_ex::FlatMap<int, int>::fromSorted({1, 2}, {1})), std::invalid_argument);
+    }
+
+    SECTION("Copy and move constructors")
+    {
+        cpp_ex::FlatMap<int, std::string> map1 = {{1, "one"}, {2, "two"}};
+        cpp_ex::FlatMap<int, std::string> map2(map1);
+        map2[2] = "TWO";
+        REQUIRE(map1[2] == "two");
+
+        cpp_ex::FlatMap<int, std::string> map3(std::move(map2));
+        REQUIRE(map3[2] == "TWO");
+    }
+}
+
+TEST_CASE("FlatMap modifiers", "[flat_map]")
+{
+    cpp_ex::FlatMap<int, std::string> map;
+
+    SECTION("operator[] keeps keys sorted")
+    {
+        map[5] = "five";
+        map[1] = "one";
+        map[3] = "three";
+        REQUIRE(map.getKeys() == cpp_ex::Vector<int>{1, 3, 5});
+        REQUIRE(map.getValues() == cpp_ex::Vector<std::string>{"one", "three", "five"});
+    }
+
+    SECTION("insert(), emplace() and insertOrAssign()")
+    {
+        REQUIRE(map.insert({2, "two"}).second);
+        REQUIRE_FALSE(map.insert({2, "dos"}).second);
+        REQUIRE(map.emplace(1, "one").second);
+        REQUIRE_FALSE(map.insertOrAssign(2, "dos").second);
+        REQUIRE(map[2] == "dos");
+        REQUIRE(map.getKeys() == cpp_ex::Vector<int>{1, 2});
+    }
+
+    SECTION("Hinted insert with correct and wrong hints")
+    {
+        auto it = map.insert(map.end(), {1, "one"});
+        it = map.insert(map.end(), {2, "two"});
+        REQUIRE(it->first == 2);
+
+        // Wrong hint falls back to a normal search
+        map.insert(map.begin(), {3, "three"});
+        REQUIRE(map.getKeys() == cpp_ex::Vector<int>{1, 2, 3});
+    }
+
+    SECTION("Range insert merges without overwriting")
+    {
+        map = {{1, "one"}, {4, "four"}};
+        std::map<int, std::string> more = {{4, "FOUR"}, {2, "two"}, {3, "three"}};
+        map.insert(more.begin(), more.end());
+        REQUIRE(map.getKeys() == cpp_ex::Vector<int>{1, 2, 3, 4});
+        REQUIRE(map[4] == "four");
+    }
+
+    SECTION("erase() methods")
+    {
+        map = {{1, "one"}, {2, "two"}, {3, "three"}, {4, "four"}};
+        REQUIRE(map.erase(2) == 1);
+        REQUIRE(map.erase(2) == 0);
+
+        auto it = map.erase(map.find(3));
+        REQUIRE(it->first == 4);
+
+        map.erase(map.begin(), map.end());
+        REQUIRE(map.isEmpty());
+    }
+}
+
+TEST_CASE("FlatMap lookup methods", "[flat_map]")
+{
+    cpp_ex::FlatMap<int, std::string> map = {{10, "ten"}, {20, "twenty"}, {30, "thirty"}};
+
+    SECTION("find() and contains()")
+    {
+        REQUIRE(map.find(20)->second == "twenty");
+        REQUIRE(map.find(25) == map.end());
+        REQUIRE(map.contains(30));
+        REQUIRE_FALSE(map.contains(5));
+        REQUIRE(map.count(10) == 1);
+        REQUIRE_THROWS_AS(map.at(11), std::out_of_range);
+    }
+
+    SECTION("lowerBound() and upperBound()")
+    {
+        REQUIRE(map.lowerBound(5)->first == 10);
+        REQUIRE(map.lowerBound(10)->first == 10);
+        REQUIRE(map.lowerBound(15)->first == 20);
+        REQUIRE(map.lowerBound(35) == map.end());
+
+        REQUIRE(map.upperBound(5)->first == 10);
+        REQUIRE(map.upperBound(10)->first == 20);
+        REQUIRE(map.upperBound(30) == map.end());
+    }
+
+    SECTION("equalRange() method")
+    {
+        auto range = map.equalRange(20);
+        REQUIRE(range.first->first == 20);
+        REQUIRE(range.second->first == 30);
+
+        auto missing = map.equalRange(25);
+        REQUIRE(missing.first == missing.second);
+    }
+
+    SECTION("Branchless search agrees with std::map on every probe")
+    {
+        cpp_ex::FlatMap<int, int> big;
+        std::map<int, int> reference;
+        for (int i = 0; i < 1000; ++i)
+        {
+            big[i * 3] = i;
+            reference[i * 3] = i;
+        }
+        for (int probe = -2; probe < 3005; ++probe)
+        {
+            auto lower = big.lowerBound(probe);
+            auto expectedLower = reference.lower_bound(probe);
+            REQUIRE((lower == big.end()) == (expectedLower == reference.end()));
+            if (lower != big.end())
+            {
+                REQUIRE(lower->first == expectedLower->first);
+            }
+
+            auto upper = big.upperBound(probe);
+            auto expectedUpper = reference.upper_bound(probe);
+            REQUIRE((upper == big.end()) == (expectedUpper == reference.end()));
+            if (upper != big.end())
+            {
+                REQUIRE(upper->first == expectedUpper->first);
+            }
+        }
+    }
+}
+
+TEST_CASE("FlatMap iteration", "[flat_map]")
+{
+    cpp_ex::FlatMap<int, std::string> map = {{2, "b"}, {1, "a"}, {3, "c"}};
+
+    SECTION("Ordered forward and reverse iteration")
+    {
+        std::string forward;
+        for (const auto &entry : map)
+        {
+            forward += entry.second;
+        }
+        REQUIRE(forward == "abc");
+
+        std::string backward;
+        for (auto it = map.rbegin(); it != map.rend(); ++it)
+        {
+            backward += (*it).second;
+        }
+        REQUIRE(backward == "cba");
+    }
+
+    SECTION("Structured bindings modify values in place")
+    {
+        for (auto [key, value] : map)
+        {
+            value += std::to_string(key);
+        }
+        REQUIRE(map[1] == "a1");
+        REQUIRE(map[3] == "c3");
+    }
+}
+
+TEST_CASE("FlatMap additional methods", "[flat_map]")
+{
+    cpp_ex::FlatMap<int, std::string> map = {{1, "one"}, {2, "two"}, {3, "three"}};
+
+    SECTION("getEntries() method")
+    {
+        auto entries = map.getEntries();
+        REQUIRE(entries.getSize() == 3);
+        REQUIRE(entries[0] == std::make_pair(1, std::string("one")));
+    }
+
+    SECTION("mapValues() and filterEntries()")
+    {
+        auto lengths = map.mapValues<size_t>([](const std::string &value)
+                                             { return value.length(); });
+        REQUIRE(lengths.getValues() == cpp_ex::Vector<size_t>{3, 3, 5});
+
+        auto odd = map.filterEntries([](int key, const std::string &)
+                                     { return key % 2 == 1; });
+        REQUIRE(odd.getKeys() == cpp_ex::Vector<int>{1, 3});
+    }
+
+    SECTION("forEach() method")
+    {
+        int sum = 0;
+        map.forEach([&sum](const int &key, std::string &value)
+                    {
+                        sum += key;
+                        value += "!"; });
+        REQUIRE(sum == 6);
+        REQUIRE(map[2] == "two!");
+    }
+
+    SECTION("Linear merge(), difference() and intersection()")
+    {
+        cpp_ex::FlatMap<int, std::string> other = {{0, "zero"}, {3, "THREE"}, {4, "four"}};
+
+        auto merged = map.merge(other);
+        REQUIRE(merged.getKeys() == cpp_ex::Vector<int>{0, 1, 2, 3, 4});
+        REQUIRE(merged[3] == "three");
+
+        auto diff = map.difference(other);
+        REQUIRE(diff.getKeys() == cpp_ex::Vector<int>{1, 2});
+
+        auto common = map.intersection(other);
+        REQUIRE(common.getKeys() == cpp_ex::Vector<int>{3});
+        REQUIRE(common[3] == "three");
+    }
+
+    SECTION("Comparison operators")
+    {
+        cpp_ex::FlatMap<int, std::string> same = {{3, "three"}, {2, "two"}, {1, "one"}};
+        cpp_ex::FlatMap<int, std::string> bigger = {{1, "one"}, {2, "two"}, {4, "four"}};
+        REQUIRE(map == same);
+        REQUIRE(map != bigger);
+        REQUIRE(map < bigger);
+        REQUIRE(bigger > map);
+        REQUIRE(map <= same);
+        REQUIRE(map >= same);
+    }
+}
+
+TEST_CASE("FlatMap with bool values", "[flat_map]")
+{
+    // Vector<bool> está empaquetado: la columna de bool guarda un byte por valor
+    cpp_ex::FlatMap<int, bool> flags = {{3, true}, {1, false}, {2, true}};
+    REQUIRE(flags.getSize() == 3);
+    REQUIRE(flags.at(3));
+    REQUIRE_FALSE(flags.at(1));
+
+    flags[1] = true;
+    flags[0] = false;
+    bool &flag = flags.at(2);
+    flag = false;
+    REQUIRE(flags.getValues() == cpp_ex::Vector<bool>{false, true, false, true});
+    REQUIRE(flags.getValueColumn().getSize() == 4);
+
+    int set = 0;
+    for (auto [key, value] : flags)
+    {
+        set += value ? key : 0;
+    }
+    REQUIRE(set == 4);
+    flags.begin()->second = true;
+    REQUIRE(flags.at(0));
+    flags.forEach([](int, bool &value)
+                  { value = !value; });
+    flags.forEach([](int, bool &value)
+                  { value = !value; });
+    REQUIRE(flags.getValues() == cpp_ex::Vector<bool>{true, true, false, true});
+
+    REQUIRE(flags.erase(3) == 1);
+    REQUIRE(flags.filterEntries([](int, bool value)
+                                { return value; })
+                .getSize() == 2);
+    auto negated = flags.mapValues<bool>([](bool value)
+                                         { return !value; });
+    REQUIRE(negated.getValues() == cpp_ex::Vector<bool>{false, false, true});
+    REQUIRE(flags.parallelMapValues<bool>([](bool value)
+                                          { return !value; }, 2) == negated);
+
+    auto copy = flags;
+    REQUIRE(copy == flags);
+    copy.clear();
+    REQUIRE(copy.isEmpty());
+    auto adopted = cpp_ex::FlatMap<int, bool>::fromSorted({1, 2}, {true, false});
+    REQUIRE(adopted.at(1));
+    REQUIRE_FALSE(adopted.at(2));
+}
+
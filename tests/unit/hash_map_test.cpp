@@ -0,0 +1,384 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/libs/core/hash_map.hpp"
+#include "../../src/libs/core/string.hpp"
+#include <string>
+#include <map>
+#include <atomic>
+#include <stdexcept>
+
+TEST_CASE("HashMap constructors", "[hash_map]")
+{
+    SECTION("Default constructor")
+    {
+        cpp_ex::HashMap<int, std::string> map;
+        REQUIRE(map.isEmpty());
+        REQUIRE(map.getSize() == 0);
+        REQUIRE(map.getCapacity() == 0);
+        REQUIRE(map.begin() == map.end());
+        REQUIRE_FALSE(map.contains(1));
+    }
+
+    SECTION("Constructor with initializer list")
+    {
+        cpp_ex::HashMap<int, std::string> map = {
+            {1, "one"},
+            {2, "two"},
+            {3, "three"}};
+
+        REQUIRE(map.getSize() == 3);
+        REQUIRE(map[1] == "one");
+        REQUIRE(map[2] == "two");
+        REQUIRE(map[3] == "three");
+    }
+
+    SECTION("Copy constructor")
+    {
+        cpp_ex::HashMap<int, std::string> map1 = {{1, "one"}, {2, "two"}};
+        cpp_ex::HashMap<int, std::string> map2(map1);
+
+        REQUIRE(map2 == map1);
+
+        // Modifying map2 should not affect map1
+        map2[2] = "TWO";
+        REQUIRE(map2[2] == "TWO");
+        REQUIRE(map1[2] == "two");
+    }
+
+    SECTION("Move constructor")
+    {
+        cpp_ex::HashMap<int, std::string> map1 = {{1, "one"}, {2, "two"}};
+        cpp_ex::HashMap<int, std::string> map2(std::move(map1));
+
+        REQUIRE(map2.getSize() == 2);
+        REQUIRE(map2[1] == "one");
+        REQUIRE(map1.isEmpty());
+    }
+
+    SECTION("Constructor from iterator range")
+    {
+        std::map<int, int> source = {{1, 10}, {2, 20}, {3, 30}};
+        cpp_ex::HashMap<int, int> map(source.begin(), source.end());
+
+        REQUIRE(map.getSize() == 3);
+        REQUIRE(map.at(2) == 20);
+    }
+}
+
+TEST_CASE("HashMap element access and modifiers", "[hash_map]")
+{
+    cpp_ex::HashMap<std::string, int> map;
+
+    SECTION("operator[] inserts default values")
+    {
+        map["a"] += 5;
+        map["a"] += 1;
+        REQUIRE(map["a"] == 6);
+        REQUIRE(map.getSize() == 1);
+    }
+
+    SECTION("at() throws for missing keys")
+    {
+        map["a"] = 1;
+        REQUIRE(map.at("a") == 1);
+        REQUIRE_THROWS_AS(map.at("missing"), std::out_of_range);
+    }
+
+    SECTION("insert() does not overwrite")
+    {
+        REQUIRE(map.insert({"a", 1}).second);
+        auto result = map.insert({"a", 2});
+        REQUIRE_FALSE(result.second);
+        REQUIRE(result.first->second == 1);
+    }
+
+    SECTION("insertOrAssign() overwrites")
+    {
+        REQUIRE(map.insertOrAssign("a", 1).second);
+        REQUIRE_FALSE(map.insertOrAssign("a", 2).second);
+        REQUIRE(map["a"] == 2);
+    }
+
+    SECTION("emplace() and tryEmplace()")
+    {
+        REQUIRE(map.emplace("a", 1).second);
+        REQUIRE_FALSE(map.emplace("a", 3).second);
+        REQUIRE(map.tryEmplace("b", 2).second);
+        REQUIRE_FALSE(map.tryEmplace("b", 4).second);
+        REQUIRE(map["a"] == 1);
+        REQUIRE(map["b"] == 2);
+    }
+
+    SECTION("erase() by key and by iterator")
+    {
+        map = {{"a", 1}, {"b", 2}, {"c", 3}};
+
+        REQUIRE(map.erase("b") == 1);
+        REQUIRE(map.erase("b") == 0);
+        REQUIRE_FALSE(map.contains("b"));
+
+        map.erase(map.find("a"));
+        REQUIRE(map.getSize() == 1);
+        REQUIRE(map.contains("c"));
+    }
+
+    SECTION("clear() keeps the map usable")
+    {
+        map = {{"a", 1}, {"b", 2}};
+        map.clear();
+        REQUIRE(map.isEmpty());
+        REQUIRE_FALSE(map.contains("a"));
+        map["c"] = 3;
+        REQUIRE(map.getSize() == 1);
+    }
+
+    SECTION("swap() method")
+    {
+        cpp_ex::HashMap<std::string, int> other = {{"x", 9}};
+        map["a"] = 1;
+        map.swap(other);
+        REQUIRE(map.contains("x"));
+        REQUIRE(other.contains("a"));
+    }
+}
+
+TEST_CASE("HashMap growth, rehash and tombstones", "[hash_map]")
+{
+    SECTION("Many inserts and lookups")
+    {
+        cpp_ex::HashMap<int, int> map;
+        for (int i = 0; i < 10000; ++i)
+        {
+            map[i] = i * 2;
+        }
+
+        REQUIRE(map.getSize() == 10000);
+        REQUIRE(map.getLoadFactor() <= 0.875f);
+        for (int i = 0; i < 10000; ++i)
+        {
+            REQUIRE(map.at(i) == i * 2);
+        }
+        REQUIRE_FALSE(map.contains(10000));
+        REQUIRE_FALSE(map.contains(-1));
+    }
+
+    SECTION("Interleaved erase and insert stays consistent")
+    {
+        cpp_ex::HashMap<int, int> map;
+        std::map<int, int> reference;
+
+        for (int round = 0; round < 20; ++round)
+        {
+            for (int i = 0; i < 500; ++i)
+            {
+                int key = (i * 7919 + round * 104729) % 3000;
+                map[key] = round;
+                reference[key] = round;
+            }
+            for (int i = 0; i < 300; ++i)
+            {
+                int key = (i * 31 + round * 17) % 3000;
+                REQUIRE(map.erase(key) == reference.erase(key));
+            }
+        }
+
+        REQUIRE(map.getSize() == reference.size());
+        for (const auto &pair : reference)
+        {
+            REQUIRE(map.at(pair.first) == pair.second);
+        }
+
+        size_t iterated = 0;
+        for (const auto &pair : map)
+        {
+            REQUIRE(reference.at(pair.first) == pair.second);
+            ++iterated;
+        }
+        REQUIRE(iterated == reference.size());
+    }
+
+    SECTION("reserve() avoids growth")
+    {
+        cpp_ex::HashMap<int, int> map;
+        map.reserve(1000);
+        auto capacity = map.getCapacity();
+        for (int i = 0; i < 1000; ++i)
+        {
+            map[i] = i;
+        }
+        REQUIRE(map.getCapacity() == capacity);
+    }
+
+    SECTION("rehash() keeps all entries")
+    {
+        cpp_ex::HashMap<int, int> map;
+        for (int i = 0; i < 100; ++i)
+        {
+            map[i] = i;
+        }
+        for (int i = 0; i < 90; ++i)
+        {
+            map.erase(i);
+        }
+        map.rehash(0);
+        REQUIRE(map.getSize() == 10);
+        REQUIRE(map.getCapacity() == 16);
+        for (int i = 90; i < 100; ++i)
+        {
+            REQUIRE(map.at(i) == i);
+        }
+    }
+}
+
+namespace
+{
+    // Only four distinct hashes: long probe chains, full groups and shared H2 values
+    struct CollidingHash
+    {
+        std::size_t operator()(int key) const noexcept
+        {
+            return static_cast<std::size_t>(key & 3);
+        }
+    };
+}
+
+TEST_CASE("HashMap batched lookups with colliding hashes and tombstones", "[hash_map]")
+{
+    using MapType = cpp_ex::HashMap<int, int, CollidingHash>;
+    MapType map;
+    for (int i = 0; i < 600; ++i)
+    {
+        map[i] = i;
+    }
+    // Erasing inside full groups leaves tombstones in the middle of the probe chains
+    for (int i = 0; i < 600; i += 3)
+    {
+        REQUIRE(map.erase(i) == 1);
+    }
+
+    cpp_ex::Vector<int> keys;
+    for (int i = -8; i < 640; ++i)
+    {
+        keys.pushBack(i);
+    }
+    keys.pushBack(3); // Erased key again, out of order
+
+    cpp_ex::Vector<MapType::iterator> results;
+    map.findMany(keys, results);
+    REQUIRE(results.getSize() == keys.getSize());
+    for (std::size_t i = 0; i < keys.getSize(); ++i)
+    {
+        REQUIRE(results[i] == map.find(keys[i]));
+    }
+
+    cpp_ex::Vector<bool> found;
+    REQUIRE(map.containsMany(keys, found) == map.getSize());
+    for (std::size_t i = 0; i < keys.getSize(); ++i)
+    {
+        REQUIRE(found[i] == map.contains(keys[i]));
+    }
+
+    // Reinserting reuses the tombstones; batches still agree with find()
+    for (int i = 0; i < 600; i += 6)
+    {
+        map[i] = -i;
+    }
+    const MapType &constMap = map;
+    cpp_ex::Vector<MapType::const_iterator> constResults;
+    constMap.findMany(keys, constResults);
+    for (std::size_t i = 0; i < keys.getSize(); ++i)
+    {
+        REQUIRE(constResults[i] == constMap.find(keys[i]));
+    }
+}
+
+TEST_CASE("HashMap with String keys", "[hash_map]")
+{
+    cpp_ex::HashMap<cpp_ex::String, int> map;
+    map[cpp_ex::String("alpha")] = 1;
+    map[cpp_ex::String("beta")] = 2;
+
+    REQUIRE(map.contains(cpp_ex::String("alpha")));
+    REQUIRE(map.at(cpp_ex::String("beta")) == 2);
+    REQUIRE_FALSE(map.contains(cpp_ex::String("gamma")));
+}
+
+TEST_CASE("HashMap additional methods", "[hash_map]")
+{
+    cpp_ex::HashMap<int, std::string> map = {
+        {1, "one"},
+        {2, "two"},
+        {3, "three"}};
+
+    SECTION("getKeys(), getValues() and getEntries()")
+    {
+        auto keys = map.getKeys();
+        keys.sort();
+        REQUIRE(keys == cpp_ex::Vector<int>{1, 2, 3});
+
+        auto values = map.getValues();
+        values.sort();
+        REQUIRE(values == cpp_ex::Vector<std::string>{"one", "three", "two"});
+
+        REQUIRE(map.getEntries().getSize() == 3);
+    }
+
+    SECTION("mapValues() method")
+    {
+        auto lengths = map.mapValues<size_t>([](const std::string &value)
+                                             { return value.length(); });
+        REQUIRE(lengths.getSize() == 3);
+        REQUIRE(lengths[1] == 3);
+        REQUIRE(lengths[3] == 5);
+    }
+
+    SECTION("filterEntries() method")
+    {
+        auto odd = map.filterEntries([](int key, const std::string &)
+                                     { return key % 2 == 1; });
+        REQUIRE(odd.getSize() == 2);
+        REQUIRE(odd.contains(1));
+        REQUIRE(odd.contains(3));
+    }
+
+    SECTION("forEach() method")
+    {
+        int sum = 0;
+        map.forEach([&sum](int key, std::string &value)
+                    {
+                        sum += key;
+                        value += "!"; });
+        REQUIRE(sum == 6);
+        REQUIRE(map[1] == "one!");
+    }
+
+    SECTION("merge(), difference() and intersection()")
+    {
+        cpp_ex::HashMap<int, std::string> other = {{3, "THREE"}, {4, "four"}};
+
+        auto merged = map.merge(other);
+        REQUIRE(merged.getSize() == 4);
+        REQUIRE(merged[3] == "three");
+        REQUIRE(merged[4] == "four");
+
+        auto diff = map.difference(other);
+        REQUIRE(diff.getSize() == 2);
+        REQUIRE_FALSE(diff.contains(3));
+
+        auto common = map.intersection(other);
+        REQUIRE(common.getSize() == 1);
+        REQUIRE(common[3] == "three");
+    }
+
+    SECTION("operator== ignores iteration order")
+    {
+        cpp_ex::HashMap<int, std::string> other;
+        other[3] = "three";
+        other[2] = "two";
+        other[1] = "one";
+        REQUIRE(map == other);
+        other[1] = "uno";
+        REQUIRE(map != other);
+    }
+}
+
@@ -0,0 +1,208 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/libs/core/interval_map.hpp"
+#include "../../src/libs/core/btree_map.hpp"
+#include "../../src/libs/core/flat_map.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr int kUniverse = 200;
+
+    // Checks the map against a plain array of optional values and that no two
+    // touching segments hold the same value
+    template <typename IntervalMapType>
+    void checkAgainst(const IntervalMapType &map, const std::vector<int> &reference)
+    {
+        for (int point = 0; point < kUniverse; ++point)
+        {
+            const int *value = map.find(point);
+            if (reference[point] < 0)
+            {
+                REQUIRE(value == nullptr);
+            }
+            else
+            {
+                REQUIRE(value != nullptr);
+                REQUIRE(*value == reference[point]);
+            }
+        }
+
+        auto segments = map.getSegments();
+        for (std::size_t i = 1; i < segments.getSize(); ++i)
+        {
+            REQUIRE(segments[i - 1].end <= segments[i].start);
+            bool touching = segments[i - 1].end == segments[i].start;
+            REQUIRE_FALSE((touching && segments[i - 1].value == segments[i].value));
+        }
+    }
+
+    template <typename IntervalMapType>
+    void randomizedAssignments()
+    {
+        std::uint64_t state = 11;
+        auto next = [&state]
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            return static_cast<int>(state >> 33);
+        };
+
+        IntervalMapType map;
+        std::vector<int> reference(kUniverse, -1);
+        for (int round = 0; round < 2000; ++round)
+        {
+            int from = next() % kUniverse;
+            int to = from + next() % 40;
+            to = to > kUniverse ? kUniverse : to;
+            if (next() % 4 == 0)
+            {
+                map.erase(from, to);
+                for (int point = from; point < to; ++point)
+                {
+                    reference[point] = -1;
+                }
+            }
+            else
+            {
+                int value = next() % 3; // Few values: lots of coalescing
+                map.assign(from, to, value);
+                for (int point = from; point < to; ++point)
+                {
+                    reference[point] = value;
+                }
+            }
+            if (round % 50 == 0)
+            {
+                checkAgainst(map, reference);
+            }
+        }
+        checkAgainst(map, reference);
+
+        // Overlap queries report whole segments touching the range, in order
+        for (int from = 0; from < kUniverse; from += 7)
+        {
+            int to = from + 13;
+            std::size_t expected = 0;
+            map.forEach([&](int start, int end, int)
+                        {
+                            if (start < to && from < end)
+                            {
+                                ++expected;
+                            } });
+            auto overlapping = map.getOverlapping(from, to);
+            REQUIRE(overlapping.getSize() == expected);
+            for (const auto &segment : overlapping)
+            {
+                REQUIRE(segment.start < to);
+                REQUIRE(from < segment.end);
+            }
+        }
+    }
+}
+
+TEST_CASE("IntervalMap assignment and coalescing", "[interval_map]")
+{
+    cpp_ex::IntervalMap<std::int64_t, std::string> map;
+
+    SECTION("Adjacent ranges with the same value become one segment")
+    {
+        map.assign(0, 10, "a");
+        map.assign(10, 20, "a");
+        REQUIRE(map.getSize() == 1);
+        REQUIRE(map.getSegmentAt(15)->start == 0);
+        REQUIRE(map.getSegmentAt(15)->end == 20);
+
+        map.assign(-5, 0, "a");
+        REQUIRE(map.getSize() == 1);
+        REQUIRE(map.getSegmentAt(0)->start == -5);
+    }
+
+    SECTION("Assigning inside a segment splits it")
+    {
+        map.assign(0, 20, "a");
+        map.assign(5, 15, "b");
+        REQUIRE(map.getSegments() == cpp_ex::Vector<decltype(map)::Segment>{{0, 5, "a"}, {5, 15, "b"}, {15, 20, "a"}});
+
+        // Restoring the value merges the three pieces again
+        map.assign(5, 15, "a");
+        REQUIRE(map.getSize() == 1);
+    }
+
+    SECTION("Assigning over several segments replaces them")
+    {
+        map = {{0, 10, "a"}, {10, 20, "b"}, {25, 30, "c"}, {30, 40, "d"}};
+        REQUIRE(map.getSize() == 4);
+        map.assign(5, 35, "x");
+        REQUIRE(map.getSegments() == cpp_ex::Vector<decltype(map)::Segment>{{0, 5, "a"}, {5, 35, "x"}, {35, 40, "d"}});
+    }
+
+    SECTION("Erasing a range trims and splits")
+    {
+        map.assign(0, 100, "a");
+        map.erase(40, 60);
+        REQUIRE(map.getSize() == 2);
+        REQUIRE_FALSE(map.contains(50));
+        REQUIRE(map.at(39) == "a");
+        REQUIRE(map.at(60) == "a");
+        REQUIRE_THROWS_AS(map.at(40), std::out_of_range);
+
+        map.erase(-10, 200);
+        REQUIRE(map.isEmpty());
+    }
+
+    SECTION("Empty and reversed ranges are ignored")
+    {
+        map.assign(5, 5, "a");
+        map.assign(7, 3, "a");
+        REQUIRE(map.isEmpty());
+        REQUIRE(map.find(5) == nullptr);
+        REQUIRE_FALSE(map.getSegmentAt(5).has_value());
+    }
+}
+
+TEST_CASE("IntervalMap overlap queries", "[interval_map]")
+{
+    cpp_ex::IntervalMap<int, int> map = {{0, 10, 1}, {20, 30, 2}, {30, 40, 3}};
+
+    REQUIRE(map.getOverlapping(5, 25).getSize() == 2);
+    REQUIRE(map.getOverlapping(10, 20).isEmpty());
+    REQUIRE(map.getOverlapping(39, 100).getSize() == 1);
+    REQUIRE(map.getOverlapping(-100, 100).getSize() == 3);
+    REQUIRE(map.getOverlapping(8, 8).isEmpty());
+
+    int sum = 0;
+    map.forEachOverlapping(9, 31, [&sum](int, int, int value)
+                           { sum += value; });
+    REQUIRE(sum == 6);
+}
+
+TEST_CASE("IntervalMap backends against a reference array", "[interval_map]")
+{
+    SECTION("Map")
+    {
+        randomizedAssignments<cpp_ex::IntervalMap<int, int>>();
+    }
+
+    SECTION("BTreeMap")
+    {
+        randomizedAssignments<cpp_ex::IntervalMap<int, int, cpp_ex::BTreeMap>>();
+    }
+
+    SECTION("FlatMap")
+    {
+        randomizedAssignments<cpp_ex::IntervalMap<int, int, cpp_ex::FlatMap>>();
+    }
+
+    SECTION("Custom comparator")
+    {
+        cpp_ex::IntervalMap<int, int, cpp_ex::Map, std::greater<int>> reversed;
+        reversed.assign(20, 10, 1); // [20, 10) in descending order
+        reversed.assign(15, 5, 1);
+        REQUIRE(reversed.getSize() == 1);
+        REQUIRE(reversed.contains(12));
+        REQUIRE_FALSE(reversed.contains(5));
+        REQUIRE(reversed.at(20) == 1);
+    }
+}
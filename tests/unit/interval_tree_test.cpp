@@ -0,0 +1,108 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/libs/core/interval_tree.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+TEST_CASE("IntervalTree basic operations", "[interval_tree]")
+{
+    cpp_ex::IntervalTree<int, std::string> tree = {{900, 1000, "standup"}, {930, 1100, "review"}, {1400, 1500, "demo"}};
+
+    SECTION("Stabbing queries")
+    {
+        auto at945 = tree.getStabbing(945);
+        REQUIRE(at945.getSize() == 2);
+        REQUIRE(at945[0].value == "standup");
+        REQUIRE(at945[1].value == "review");
+        REQUIRE(tree.getStabbing(1000).getSize() == 1); // Half-open: standup has ended
+        REQUIRE(tree.getStabbing(1200).isEmpty());
+    }
+
+    SECTION("Overlap queries")
+    {
+        REQUIRE(tree.getOverlapping(1050, 1450).getSize() == 2);
+        REQUIRE(tree.hasOverlap(1450, 1460));
+        REQUIRE_FALSE(tree.hasOverlap(1100, 1400));
+        REQUIRE_FALSE(tree.hasOverlap(1450, 1450));
+    }
+
+    SECTION("Duplicates, erase and empty intervals")
+    {
+        REQUIRE(tree.insert(900, 1000, "standup again"));
+        REQUIRE_FALSE(tree.insert(10, 10, "empty"));
+        REQUIRE(tree.getSize() == 4);
+        REQUIRE(tree.getStabbing(945).getSize() == 3);
+
+        REQUIRE(tree.erase(900, 1000));
+        REQUIRE(tree.erase(900, 1000));
+        REQUIRE_FALSE(tree.erase(900, 1000));
+        REQUIRE_FALSE(tree.erase(930, 1000));
+        REQUIRE(tree.getSize() == 2);
+        REQUIRE(tree.getStabbing(901).isEmpty());
+    }
+
+    SECTION("Copies are independent")
+    {
+        auto copy = tree;
+        copy.clear();
+        REQUIRE(copy.isEmpty());
+        REQUIRE(tree.getEntries().getSize() == 3);
+
+        auto moved = std::move(tree);
+        REQUIRE(moved.getSize() == 3);
+        REQUIRE(moved.getEntries()[0].start == 900);
+    }
+}
+
+TEST_CASE("IntervalTree against brute force", "[interval_tree]")
+{
+    std::uint64_t state = 5;
+    auto next = [&state]
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<int>(state >> 33);
+    };
+
+    cpp_ex::IntervalTree<int, int> tree;
+    std::vector<std::tuple<int, int, int>> reference;
+    for (int i = 0; i < 3000; ++i)
+    {
+        int start = next() % 10000;
+        int end = start + 1 + next() % 300;
+        if (!reference.empty() && next() % 4 == 0)
+        {
+            auto victim = reference[next() % reference.size()];
+            REQUIRE(tree.erase(std::get<0>(victim), std::get<1>(victim)));
+            // The tree removes one interval with these bounds, maybe not this value
+            auto it = std::find_if(reference.begin(), reference.end(), [&victim](const auto &entry)
+                                   { return std::get<0>(entry) == std::get<0>(victim) && std::get<1>(entry) == std::get<1>(victim); });
+            reference.erase(it);
+        }
+        else
+        {
+            tree.insert(start, end, i);
+            reference.emplace_back(start, end, i);
+        }
+    }
+    REQUIRE(tree.getSize() == reference.size());
+
+    auto entries = tree.getEntries();
+    REQUIRE(std::is_sorted(entries.begin(), entries.end(), [](const auto &a, const auto &b)
+                           { return a.start < b.start; }));
+
+    for (int point = 0; point < 10300; point += 37)
+    {
+        std::size_t expected = std::count_if(reference.begin(), reference.end(), [point](const auto &entry)
+                                             { return std::get<0>(entry) <= point && point < std::get<1>(entry); });
+        REQUIRE(tree.getStabbing(point).getSize() == expected);
+
+        int to = point + 50;
+        expected = std::count_if(reference.begin(), reference.end(), [point, to](const auto &entry)
+                                 { return std::get<0>(entry) < to && point < std::get<1>(entry); });
+        REQUIRE(tree.getOverlapping(point, to).getSize() == expected);
+        REQUIRE(tree.hasOverlap(point, to) == (expected > 0));
+    }
+}
@@ -0,0 +1,148 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+#include "../../src/libs/core/map.hpp"
+#include "../../src/libs/core/hash_map.hpp"
+#include "../../src/libs/core/flat_map.hpp"
+#include "../../src/libs/core/btree_map.hpp"
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+
+// Tests shared by every map that implements the same part of the cpp_ex::Map API.
+// Behaviour specific to one backend stays in that backend's own test file.
+
+namespace
+{
+    using TreeMap = cpp_ex::Map<int, int>;
+    using HashMap = cpp_ex::HashMap<int, int>;
+    using FlatMap = cpp_ex::FlatMap<int, int>;
+    // Small nodes: a few thousand keys already give a tree several levels deep
+    using SmallNodeBTreeMap = cpp_ex::BTreeMap<int, int, std::less<int>, 64>;
+}
+
+TEMPLATE_TEST_CASE("Batched lookups", "[map_interface]", TreeMap, HashMap, FlatMap, SmallNodeBTreeMap)
+{
+    using MapType = TestType;
+    MapType map;
+    for (int i = 0; i < 4000; i += 2)
+    {
+        map[i] = i * 10;
+    }
+
+    SECTION("findMany() matches find() for small and large batches")
+    {
+        for (int batch : {3, 500})
+        {
+            cpp_ex::Vector<int> keys;
+            for (int i = 0; i < batch; ++i)
+            {
+                keys.pushBack((i * 7919) % 4100);
+            }
+            keys.pushBack(keys[0]); // Duplicate key
+
+            cpp_ex::Vector<typename MapType::iterator> results;
+            map.findMany(keys, results);
+            REQUIRE(results.getSize() == keys.getSize());
+            for (std::size_t i = 0; i < keys.getSize(); ++i)
+            {
+                REQUIRE(results[i] == map.find(keys[i]));
+            }
+
+            const MapType &constMap = map;
+            cpp_ex::Vector<typename MapType::const_iterator> constResults;
+            constMap.findMany(keys, constResults);
+            for (std::size_t i = 0; i < keys.getSize(); ++i)
+            {
+                REQUIRE(constResults[i] == constMap.find(keys[i]));
+            }
+        }
+    }
+
+    SECTION("containsMany() flags hits and returns their count")
+    {
+        cpp_ex::Vector<int> keys = {0, 1, 2, 3998, 3999, 4000, -4};
+        cpp_ex::Vector<bool> found;
+        REQUIRE(map.containsMany(keys, found) == 3);
+        REQUIRE(found == cpp_ex::Vector<bool>{true, false, true, true, false, false, false});
+    }
+
+    SECTION("Empty map and empty batch")
+    {
+        MapType empty;
+        cpp_ex::Vector<bool> found;
+        REQUIRE(empty.containsMany(cpp_ex::Vector<int>{1, 2}, found) == 0);
+        REQUIRE(found == cpp_ex::Vector<bool>{false, false});
+
+        cpp_ex::Vector<typename MapType::iterator> results = {map.begin()};
+        map.findMany(cpp_ex::Vector<int>{}, results);
+        REQUIRE(results.isEmpty());
+    }
+}
+
+TEMPLATE_TEST_CASE("Parallel walks", "[map_interface]", TreeMap, HashMap, FlatMap)
+{
+    using MapType = TestType;
+    MapType map;
+    for (int i = 0; i < 20000; ++i)
+    {
+        map[(i * 7919) % 20011] = i;
+    }
+
+    SECTION("parallelMapValues() and parallelFilterEntries() match the sequential versions")
+    {
+        auto square = [](int value)
+        { return static_cast<long long>(value) * value; };
+        auto odd = [](int key, int value)
+        { return (key + value) % 2 == 1; };
+        auto mapped = map.template mapValues<long long>(square);
+        auto filtered = map.filterEntries(odd);
+        for (std::size_t threads : {0, 1, 3, 8})
+        {
+            REQUIRE(map.template parallelMapValues<long long>(square, threads).getEntries() == mapped.getEntries());
+            REQUIRE(map.parallelFilterEntries(odd, threads).getEntries() == filtered.getEntries());
+        }
+    }
+
+    SECTION("parallelForEach() visits every entry once")
+    {
+        std::atomic<long long> sum{0};
+        const MapType &constMap = map;
+        constMap.parallelForEach([&sum](int key, int value)
+                                 { sum += key + value; }, 4);
+        long long expected = 0;
+        map.forEach([&expected](int key, int value)
+                    { expected += key + value; });
+        REQUIRE(sum == expected);
+
+        map.parallelForEach([](int, int &value)
+                            { value = -value; }, 4);
+        REQUIRE(map[0] == 0);
+        REQUIRE(map[7919] == -1);
+    }
+
+    SECTION("Exceptions are rethrown after every thread finishes")
+    {
+        std::atomic<int> visited{0};
+        REQUIRE_THROWS_AS(map.parallelForEach([&visited](int key, int &)
+                                              {
+                                                  ++visited;
+                                                  if (key == 7919)
+                                                  {
+                                                      throw std::runtime_error("boom");
+                                                  } }, 4),
+                          std::runtime_error);
+        REQUIRE(visited > 0);
+    }
+
+    SECTION("Empty and tiny maps")
+    {
+        MapType empty;
+        REQUIRE(empty.parallelFilterEntries([](int, int)
+                                            { return true; }, 8)
+                    .isEmpty());
+        MapType one = {{1, 2}};
+        REQUIRE(one.template parallelMapValues<int>([](int value)
+                                                    { return value + 1; }, 8)[1] == 3);
+    }
+}
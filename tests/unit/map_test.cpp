@@ -7,6 +7,9 @@
 #include "../../src/libs/core/map.hpp"
 #include <string>
 #include <functional>
+#include <map>
+#include <atomic>
+#include <stdexcept>
 
 TEST_CASE("Map constructors", "[map]")
 {
@@ -187,6 +190,27 @@ TEST_CASE("Map conversion methods", "[map]")
         REQUIRE(stdMap.at(2) == "two");
         REQUIRE(stdMap.at(3) == "three");
     }
+
+    SECTION("toStdMap() copies from lvalues and moves from rvalues")
+    {
+        cpp_ex::Map<int, std::string> map = {
+            {1, "one"},
+            {2, "two"}};
+
+        std::map<int, std::string> copy = map.toStdMap();
+        REQUIRE(copy.size() == 2);
+        REQUIRE(map.getSize() == 2);
+
+        const auto *node = &*map.find(2);
+        std::map<int, std::string> moved = std::move(map).toStdMap();
+        REQUIRE(&*moved.find(2) == node);
+
+        cpp_ex::Map<int, std::string> back(std::move(moved));
+        REQUIRE(&*back.find(2) == node);
+
+        std::map<int, std::string> converted = std::move(back);
+        REQUIRE(&*converted.find(2) == node);
+    }
 }
 
 TEST_CASE("Map iterator methods", "[map]")
@@ -737,6 +761,591 @@ TEST_CASE("Map additional methods", "[map]")
         REQUIRE(intersectionMap[2] == "two"); // map1's values are used
         REQUIRE(intersectionMap[3] == "three");
     }
+
+    SECTION("difference() and intersection() with converted and mixed arguments")
+    {
+        cpp_ex::Map<int, int> map = {{1, 10}, {2, 20}, {3, 30}};
+
+        auto diffMap = map.difference({{1, 1}});
+        REQUIRE(diffMap.getSize() == 2);
+        REQUIRE_FALSE(diffMap.contains(1));
+
+        std::map<int, int> stdMap = {{2, 0}, {3, 0}, {4, 0}};
+        auto intersectionMap = map.intersection(stdMap);
+        REQUIRE(intersectionMap.getSize() == 2);
+        REQUIRE(intersectionMap[2] == 20);
+        REQUIRE(intersectionMap[3] == 30);
+
+        cpp_ex::Map<int, std::string> names = {{3, "three"}};
+        REQUIRE(map.difference(names).getSize() == 2);
+        REQUIRE(map.intersection(names).getSize() == 1);
+        REQUIRE(map.intersection(names)[3] == 30);
+    }
+}
+
+TEST_CASE("Map parallel walks split at the key snapshot", "[map]")
+{
+    cpp_ex::Map<int, int> map;
+    for (int i = 0; i < 20000; ++i)
+    {
+        map[(i * 7919) % 20011] = i;
+    }
+    auto square = [](int value)
+    { return static_cast<long long>(value) * value; };
+    auto odd = [](int key, int value)
+    { return (key + value) % 2 == 1; };
+    auto mapped = map.mapValues<long long>(square);
+    auto filtered = map.filterEntries(odd);
+
+    // A current key snapshot provides the split pivots
+    map.getKeysSnapshot();
+    REQUIRE(map.parallelMapValues<long long>(square, 5).getEntries() == mapped.getEntries());
+    map.erase(0);
+    REQUIRE(map.parallelFilterEntries(odd, 5).getSize() == filtered.getSize());
+}
+
+TEST_CASE("Map linear set operations", "[map]")
+{
+    cpp_ex::Map<int, std::string> map1 = {
+        {1, "one"},
+        {2, "two"},
+        {3, "three"}};
+
+    cpp_ex::Map<int, std::string> map2 = {
+        {0, "zero"},
+        {2, "TWO"},
+        {3, "THREE"},
+        {4, "four"}};
+
+    SECTION("merge(), difference() and intersection() keep the comparator")
+    {
+        cpp_ex::Map<int, int, std::greater<int>> desc1({{1, 1}, {3, 3}, {5, 5}}, std::greater<int>());
+        cpp_ex::Map<int, int, std::greater<int>> desc2({{2, 2}, {3, 30}}, std::greater<int>());
+
+        REQUIRE(desc1.merge(desc2).getKeys() == cpp_ex::Vector<int>{5, 3, 2, 1});
+        REQUIRE(desc1.merge(desc2)[3] == 3);
+        REQUIRE(desc1.difference(desc2).getKeys() == cpp_ex::Vector<int>{5, 1});
+        REQUIRE(desc1.intersection(desc2).getKeys() == cpp_ex::Vector<int>{3});
+    }
+
+    SECTION("difference() and intersection() accept maps with other value types")
+    {
+        cpp_ex::Map<int, bool> flags = {{2, true}, {9, false}};
+
+        REQUIRE(map1.difference(flags).getKeys() == cpp_ex::Vector<int>{1, 3});
+        REQUIRE(map1.intersection(flags).getKeys() == cpp_ex::Vector<int>{2});
+    }
+
+    SECTION("mergeInto() adds only the missing keys")
+    {
+        REQUIRE(map1.mergeInto(map2) == 2);
+        REQUIRE(map1.getKeys() == cpp_ex::Vector<int>{0, 1, 2, 3, 4});
+        REQUIRE(map1[2] == "two"); // Existing values are preserved
+        REQUIRE(map2.getSize() == 4);
+
+        cpp_ex::Map<int, std::string> more = {{5, "five"}, {1, "ONE"}};
+        REQUIRE(map1.mergeInto(std::move(more)) == 1);
+        REQUIRE(map1[5] == "five");
+        REQUIRE(map1[1] == "one");
+        REQUIRE(more.isEmpty());
+    }
+
+    SECTION("retainKeys() and removeKeys()")
+    {
+        auto retained = map1;
+        REQUIRE(retained.retainKeys(map2) == 1);
+        REQUIRE(retained.getKeys() == cpp_ex::Vector<int>{2, 3});
+
+        auto removed = map1;
+        REQUIRE(removed.removeKeys(map2) == 2);
+        REQUIRE(removed.getKeys() == cpp_ex::Vector<int>{1});
+
+        auto byVector = map1;
+        REQUIRE(byVector.retainKeys(cpp_ex::Vector<int>{3, 1, 7}) == 1);
+        REQUIRE(byVector.getKeys() == cpp_ex::Vector<int>{1, 3});
+        REQUIRE(byVector.removeKeys(cpp_ex::Vector<int>{3}) == 1);
+        REQUIRE(byVector.getKeys() == cpp_ex::Vector<int>{1});
+    }
+
+    SECTION("mergeAll() combines many maps, earlier maps win")
+    {
+        cpp_ex::Map<int, std::string> map3 = {{3, "tres"}, {6, "six"}};
+
+        auto combined = cpp_ex::Map<int, std::string>::mergeAll({map1, map2, map3});
+        REQUIRE(combined.getKeys() == cpp_ex::Vector<int>{0, 1, 2, 3, 4, 6});
+        REQUIRE(combined[2] == "two");
+        REQUIRE(combined[3] == "three");
+        REQUIRE(combined[6] == "six");
+
+        cpp_ex::Vector<cpp_ex::Map<int, std::string>> partials;
+        partials.pushBack(map3);
+        partials.pushBack(cpp_ex::Map<int, std::string>());
+        partials.pushBack(map1);
+        auto fromVector = cpp_ex::Map<int, std::string>::mergeAll(partials);
+        REQUIRE(fromVector.getSize() == 4);
+        REQUIRE(fromVector[3] == "tres");
+
+        REQUIRE(cpp_ex::Map<int, std::string>::mergeAll(cpp_ex::Vector<cpp_ex::Map<int, std::string>>()).isEmpty());
+    }
+
+    SECTION("Results match the per-element definitions on larger inputs")
+    {
+        cpp_ex::Map<int, int> evens;
+        cpp_ex::Map<int, int> thirds;
+        for (int i = 0; i < 3000; ++i)
+        {
+            if (i % 2 == 0)
+            {
+                evens[i] = i;
+            }
+            if (i % 3 == 0)
+            {
+                thirds[i] = -i;
+            }
+        }
+
+        auto merged = evens.merge(thirds);
+        auto common = evens.intersection(thirds);
+        auto onlyEvens = evens.difference(thirds);
+        REQUIRE(merged.getSize() == 2000);
+        REQUIRE(common.getSize() == 500);
+        REQUIRE(onlyEvens.getSize() == 1000);
+        for (int i = 0; i < 3000; ++i)
+        {
+            REQUIRE(merged.contains(i) == (i % 2 == 0 || i % 3 == 0));
+            REQUIRE(common.contains(i) == (i % 6 == 0));
+            REQUIRE(onlyEvens.contains(i) == (i % 2 == 0 && i % 3 != 0));
+        }
+        REQUIRE(merged[6] == 6);
+    }
+}
+
+TEST_CASE("Map node handles", "[map]")
+{
+    cpp_ex::Map<int, std::string> pending = {
+        {1, "one"},
+        {2, "two"},
+        {3, "three"}};
+    cpp_ex::Map<int, std::string> done;
+
+    SECTION("extract() and insert(node) move an entry without reallocating it")
+    {
+        const auto *entry = &*pending.find(2);
+        auto node = pending.extract(2);
+        REQUIRE_FALSE(node.empty());
+        REQUIRE(node.key() == 2);
+        REQUIRE_FALSE(pending.contains(2));
+
+        auto result = done.insert(std::move(node));
+        REQUIRE(result.inserted);
+        REQUIRE(&*result.position == entry);
+        REQUIRE(done.at(2) == "two");
+
+        REQUIRE(pending.extract(42).empty());
+    }
+
+    SECTION("A node key can be changed before reinserting it")
+    {
+        auto node = pending.extract(pending.find(1));
+        node.key() = 10;
+        pending.insert(pending.end(), std::move(node));
+        REQUIRE(pending.getKeys() == cpp_ex::Vector<int>{2, 3, 10});
+        REQUIRE(pending.at(10) == "one");
+    }
+
+    SECTION("Inserting a node with an existing key hands it back")
+    {
+        done.insert({1, "uno"});
+        auto result = done.insert(pending.extract(1));
+        REQUIRE_FALSE(result.inserted);
+        REQUIRE(result.node.mapped() == "one");
+        REQUIRE(done.at(1) == "uno");
+    }
+
+    SECTION("splice() relinks every entry with a missing key")
+    {
+        done = {{3, "tres"}, {4, "four"}};
+        const auto *entry = &*pending.find(1);
+        auto version = done.getVersion();
+
+        REQUIRE(done.splice(pending) == 2);
+        REQUIRE(done.getKeys() == cpp_ex::Vector<int>{1, 2, 3, 4});
+        REQUIRE(done.at(3) == "tres");
+        REQUIRE(&*done.find(1) == entry);
+        REQUIRE(pending.getKeys() == cpp_ex::Vector<int>{3}); // Conflicting key stays
+        REQUIRE(done.getVersion() != version);
+
+        cpp_ex::Map<int, std::string, std::greater<int>> reversed = {{5, "five"}};
+        REQUIRE(done.splice(reversed) == 1);
+        REQUIRE(reversed.isEmpty());
+        REQUIRE(done.splice(cpp_ex::Map<int, std::string>{{6, "six"}}) == 1);
+        REQUIRE(done.getSize() == 6);
+    }
+}
+
+TEST_CASE("Map sorted bulk construction", "[map]")
+{
+    SECTION("fromSorted() from a Vector, iterators and an initializer list")
+    {
+        cpp_ex::Vector<std::pair<int, std::string>> rows = {{1, "one"}, {2, "two"}, {3, "three"}};
+        auto map = cpp_ex::Map<int, std::string>::fromSorted(rows);
+        REQUIRE(map.getSize() == 3);
+        REQUIRE(map.at(2) == "two");
+
+        auto partial = cpp_ex::Map<int, std::string>::fromSorted(rows.begin(), rows.begin() + 2);
+        REQUIRE(partial.getKeys() == cpp_ex::Vector<int>{1, 2});
+
+        auto listed = cpp_ex::Map<int, std::string>::fromSorted({{1, "a"}, {1, "b"}, {5, "e"}});
+        REQUIRE(listed.getSize() == 2);
+        REQUIRE(listed.at(1) == "a"); // First duplicate wins
+    }
+
+    SECTION("fromSorted() with a custom comparator")
+    {
+        std::vector<std::pair<int, int>> rows = {{3, 30}, {2, 20}, {1, 10}};
+        auto map = cpp_ex::Map<int, int, std::greater<int>>::fromSorted(rows, std::greater<int>());
+        REQUIRE(map.getKeys() == cpp_ex::Vector<int>{3, 2, 1});
+    }
+
+    SECTION("Unsorted input still builds a correct map")
+    {
+        std::vector<std::pair<int, int>> rows = {{5, 5}, {1, 1}, {3, 3}, {1, 100}, {4, 4}};
+        auto map = cpp_ex::Map<int, int>::fromSorted(rows);
+        REQUIRE(map.getKeys() == cpp_ex::Vector<int>{1, 3, 4, 5});
+        REQUIRE(map.at(1) == 1);
+    }
+
+    SECTION("insertSorted() interleaves with the existing keys")
+    {
+        cpp_ex::Map<int, std::string> map = {{2, "two"}, {4, "four"}};
+        auto version = map.getVersion();
+
+        std::vector<std::pair<int, std::string>> batch = {{1, "one"}, {2, "dos"}, {3, "three"}, {5, "five"}};
+        REQUIRE(map.insertSorted(batch) == 3);
+        REQUIRE(map.getKeys() == cpp_ex::Vector<int>{1, 2, 3, 4, 5});
+        REQUIRE(map.at(2) == "two"); // Existing keys are kept
+        REQUIRE(map.getVersion() != version);
+
+        version = map.getVersion();
+        REQUIRE(map.insertSorted({{1, "uno"}, {5, "cinco"}}) == 0);
+        REQUIRE(map.getVersion() == version);
+    }
+
+    SECTION("mapValues() and filterEntries() keep the comparator")
+    {
+        cpp_ex::Map<int, int, std::greater<int>> map = {{1, 10}, {2, 20}, {3, 30}};
+        auto doubled = map.mapValues<int>([](int v)
+                                     { return v * 2; });
+        REQUIRE(doubled.getValues() == cpp_ex::Vector<int>{60, 40, 20});
+
+        auto odd = map.filterEntries([](int k, int)
+                                     { return k % 2 == 1; });
+        REQUIRE(odd.getKeys() == cpp_ex::Vector<int>{3, 1});
+        odd.insert({2, 0});
+        REQUIRE(odd.getKeys() == cpp_ex::Vector<int>{3, 2, 1});
+    }
+}
+
+TEST_CASE("Map views and key snapshot", "[map]")
+{
+    cpp_ex::Map<std::string, int> scores = {
+        {"alice", 95},
+        {"bob", 87},
+        {"carol", 72}};
+
+    SECTION("keysView() iterates the keys without copying them")
+    {
+        const std::string *first = &*scores.keysView().begin();
+        REQUIRE(first == &scores.begin()->first);
+
+        std::string joined;
+        for (const auto &name : scores.keysView())
+        {
+            joined += name;
+        }
+        REQUIRE(joined == "alicebobcarol");
+        REQUIRE(scores.keysView().getSize() == 3);
+        REQUIRE(scores.keysView().contains("bob"));
+        REQUIRE_FALSE(scores.keysView().contains("dave"));
+        REQUIRE(scores.keysView().toVector() == scores.getKeys());
+    }
+
+    SECTION("valuesView() gives mutable references on a non-const map")
+    {
+        for (auto &score : scores.valuesView())
+        {
+            score += 1;
+        }
+        REQUIRE(scores.at("alice") == 96);
+        REQUIRE(scores.valuesView().toVector() == scores.getValues());
+
+        const auto &constScores = scores;
+        REQUIRE(constScores.valuesView().reduce(0, std::plus<int>()) == 96 + 88 + 73);
+    }
+
+    SECTION("Vector algorithm vocabulary")
+    {
+        auto values = scores.valuesView();
+        REQUIRE(values.countIf([](int s)
+                               { return s >= 80; }) == 2);
+        REQUIRE(values.filter([](int s)
+                              { return s < 90; }) == cpp_ex::Vector<int>{87, 72});
+        REQUIRE(values.map([](int s)
+                           { return s / 10; }) == cpp_ex::Vector<int>{9, 8, 7});
+
+        auto lengths = scores.keysView().map([](const std::string &name)
+                                             { return name.size(); });
+        REQUIRE(lengths == cpp_ex::Vector<std::size_t>{5, 3, 5});
+
+        int sum = 0;
+        values.forEach([&sum](int s)
+                       { sum += s; });
+        REQUIRE(sum == 254);
+    }
+
+    SECTION("entriesView() yields the stored pairs")
+    {
+        auto entries = scores.entriesView();
+        REQUIRE(&*entries.begin() == &*scores.begin());
+        REQUIRE(entries.contains(std::pair<std::string, int>("bob", 87)));
+        REQUIRE_FALSE(entries.contains(std::pair<std::string, int>("bob", 88)));
+        REQUIRE(entries.toVector() == scores.getEntries());
+
+        auto high = entries.filter([](const auto &entry)
+                                   { return entry.second > 80; });
+        REQUIRE(high.getSize() == 2);
+        REQUIRE(high[1].first == "bob");
+
+        auto last = std::prev(entries.end());
+        REQUIRE(last->first == "carol");
+    }
+
+    SECTION("Views reflect later changes to the map")
+    {
+        auto keys = scores.keysView();
+        scores.insert({"dave", 60});
+        scores.erase("alice");
+        REQUIRE(keys.getSize() == 3);
+        REQUIRE(keys.toVector() == cpp_ex::Vector<std::string>{"bob", "carol", "dave"});
+        scores.clear();
+        REQUIRE(keys.isEmpty());
+    }
+
+    SECTION("getKeysSnapshot() is rebuilt only after keys change")
+    {
+        const auto &snapshot = scores.getKeysSnapshot();
+        REQUIRE(snapshot == cpp_ex::Vector<std::string>{"alice", "bob", "carol"});
+        const std::string *storage = snapshot.getData();
+        auto version = scores.getVersion();
+
+        // Lookups and value updates keep the cached keys
+        scores["bob"] = 10;
+        scores.at("carol") = 20;
+        REQUIRE(scores.find("alice") != scores.end());
+        REQUIRE(scores.getVersion() == version);
+        REQUIRE(scores.getKeysSnapshot().getData() == storage);
+
+        // Inserting keys that already exist changes nothing either
+        REQUIRE_FALSE(scores.insert({"bob", 1}).second);
+        REQUIRE_FALSE(scores.emplace("carol", 2).second);
+        scores.insert(scores.end(), {"alice", 3});
+        scores.emplaceHint(scores.end(), "alice", 3);
+        scores.insert({{"alice", 4}, {"bob", 5}});
+        REQUIRE(scores.insertSorted({{"alice", 6}}) == 0);
+        scores.erase(scores.begin(), scores.begin());
+        REQUIRE(scores.getVersion() == version);
+        REQUIRE(scores.getKeysSnapshot().getData() == storage);
+
+        scores["dave"] = 30;
+        REQUIRE(scores.getVersion() != version);
+        REQUIRE(scores.getKeysSnapshot() == cpp_ex::Vector<std::string>{"alice", "bob", "carol", "dave"});
+
+        version = scores.getVersion();
+        REQUIRE(scores.erase("zoe") == 0);
+        scores.erase("alice");
+        REQUIRE(scores.getVersion() != version);
+        REQUIRE(scores.getKeysSnapshot() == cpp_ex::Vector<std::string>{"bob", "carol", "dave"});
+
+        cpp_ex::Map<std::string, int> other = {{"x", 1}};
+        scores.swap(other);
+        REQUIRE(scores.getKeysSnapshot() == cpp_ex::Vector<std::string>{"x"});
+        REQUIRE(other.getKeysSnapshot().getSize() == 3);
+
+        scores.mergeInto(other);
+        REQUIRE(scores.getKeysSnapshot().getSize() == 4);
+
+        // Copies start without a snapshot of their own
+        cpp_ex::Map<std::string, int> copy = scores;
+        REQUIRE(copy.getKeysSnapshot() == scores.getKeysSnapshot());
+        REQUIRE(copy.getKeysSnapshot().getData() != scores.getKeysSnapshot().getData());
+    }
+}
+
+TEST_CASE("Map diff and applyDelta", "[map]")
+{
+    cpp_ex::Map<int, std::string> before = {{1, "one"}, {2, "two"}, {3, "three"}, {5, "five"}};
+    cpp_ex::Map<int, std::string> after = {{2, "two"}, {3, "THREE"}, {4, "four"}, {6, "six"}};
+
+    SECTION("diff() lists added, changed and removed entries in key order")
+    {
+        auto delta = before.diff(after);
+        REQUIRE(delta.removed == cpp_ex::Vector<int>{1, 5});
+        REQUIRE(delta.changed.getSize() == 1);
+        REQUIRE(delta.changed[0] == std::pair<int, std::string>(3, "THREE"));
+        REQUIRE(delta.added.getSize() == 2);
+        REQUIRE(delta.added[0].first == 4);
+        REQUIRE(delta.added[1].first == 6);
+        REQUIRE(delta.getChangeCount() == 5);
+        REQUIRE(before.diff(before).isEmpty());
+    }
+
+    SECTION("applyDelta() turns the old version into the new one")
+    {
+        auto replica = before;
+        replica.applyDelta(before.diff(after));
+        REQUIRE(replica == after);
+
+        // Aplicar dos veces no cambia nada más
+        auto delta = before.diff(after);
+        replica.applyDelta(delta);
+        REQUIRE(replica == after);
+
+        replica.applyDelta(after.diff(before));
+        REQUIRE(replica == before);
+    }
+
+    SECTION("Large maps and unsorted deltas")
+    {
+        cpp_ex::Map<int, int> base;
+        for (int i = 0; i < 10000; ++i)
+        {
+            base[i * 2] = i;
+        }
+        auto next = base;
+        for (int i = 0; i < 10000; i += 7)
+        {
+            next.erase(i * 2);
+            next[i * 2 + 1] = -i;
+        }
+        for (int i = 3; i < 10000; i += 11)
+        {
+            next[i * 2] = i + 1;
+        }
+        auto delta = base.diff(next);
+        auto replica = base;
+        replica.applyDelta(std::move(delta));
+        REQUIRE(replica == next);
+
+        cpp_ex::MapDelta<int, int> shuffled;
+        shuffled.added = {{51, 1}, {-3, 2}, {7, 3}};
+        shuffled.removed = {400, 0, 4000};
+        replica = base;
+        replica.applyDelta(shuffled);
+        REQUIRE(replica.at(-3) == 2);
+        REQUIRE(replica.at(7) == 3);
+        REQUIRE(replica.at(51) == 1);
+        REQUIRE_FALSE(replica.contains(0));
+        REQUIRE_FALSE(replica.contains(400));
+        REQUIRE_FALSE(replica.contains(4000));
+        REQUIRE(replica.getSize() == base.getSize());
+    }
+}
+
+TEST_CASE("Map mutation journal", "[map]")
+{
+    cpp_ex::Map<std::string, int> map = {{"a", 1}, {"b", 2}, {"c", 3}};
+    auto replica = map;
+
+    SECTION("checkpoint() returns only the touched keys")
+    {
+        REQUIRE_THROWS_AS(map.checkpoint(), std::logic_error);
+        map.enableJournal();
+        REQUIRE(map.isJournalEnabled());
+        map["a"] = 10;
+        auto version = map.getVersion();
+        REQUIRE(map.erase("missing") == 0);
+        REQUIRE(map.getVersion() == version);
+        REQUIRE(map.erase("b") == 1);
+        REQUIRE(map.getVersion() != version);
+        map.insert({"d", 4});
+        map.emplaceHint(map.end(), "e", 5);
+        map.insert({"a", 99}); // Ya existe: no cambia nada
+        map["f"] = 6;
+        map.erase("f"); // Añadida y borrada: no aparece
+        REQUIRE(map.getJournalSize() == 5);
+
+        auto delta = map.checkpoint();
+        REQUIRE(delta.removed == cpp_ex::Vector<std::string>{"b"});
+        REQUIRE(delta.changed.getSize() == 1);
+        REQUIRE(delta.changed[0].first == "a");
+        REQUIRE(delta.added.getSize() == 2);
+        REQUIRE(map.getJournalSize() == 0);
+        REQUIRE(map.checkpoint().isEmpty());
+
+        replica.applyDelta(delta);
+        REQUIRE(replica == map);
+    }
+
+    SECTION("Bulk modifiers, node handles and markChanged()")
+    {
+        map.enableJournal();
+        cpp_ex::Map<std::string, int> other = {{"c", 30}, {"x", 7}, {"y", 8}};
+        REQUIRE(map.splice(other) == 2);
+        map.removeKeys(cpp_ex::Vector<std::string>{"a"});
+        auto node = map.extract("x");
+        REQUIRE(map.insert(std::move(node)).inserted);
+        map.insertSorted({{"m", 1}, {"n", 2}});
+        map.find("b")->second = 20;
+        map.markChanged("b");
+
+        replica.applyDelta(map.checkpoint());
+        REQUIRE(replica == map);
+    }
+
+    SECTION("Whole-map replacements produce a reset delta")
+    {
+        map.enableJournal();
+        map.erase("a");
+        map = {{"z", 26}};
+        map["y"] = 25;
+        auto delta = map.checkpoint();
+        REQUIRE(delta.reset);
+        REQUIRE(delta.added.getSize() == 2);
+        replica.applyDelta(delta);
+        REQUIRE(replica == map);
+
+        map.clear();
+        replica.applyDelta(map.checkpoint());
+        REQUIRE(replica.isEmpty());
+
+        map.disableJournal();
+        map["q"] = 1;
+        REQUIRE(map.getJournalSize() == 0);
+    }
+
+    SECTION("A journaled replica records applied deltas")
+    {
+        replica.enableJournal();
+        cpp_ex::Map<std::string, int> next = {{"a", 1}, {"c", 33}, {"d", 4}};
+        replica.applyDelta(map.diff(next));
+        auto delta = replica.checkpoint();
+        REQUIRE(delta == map.diff(next));
+    }
+
+    SECTION("The journal shares the lazily allocated tracking state")
+    {
+        // Un Map sin diario ni snapshot solo añade un puntero a std::map
+        STATIC_REQUIRE(sizeof(cpp_ex::Map<int, int>) == sizeof(std::map<int, int>) + sizeof(void *));
+
+        map.enableJournal();
+        std::uint64_t version = map.getVersion();
+        map.insert({"d", 4});
+        map.disableJournal();
+        REQUIRE_FALSE(map.isJournalEnabled());
+        REQUIRE(map.getJournalSize() == 0);
+        map.erase("a");
+        REQUIRE(map.getVersion() == version + 2);
+    }
 }
 
 TEST_CASE("Map non-member functions", "[map]")
@@ -0,0 +1,192 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/libs/core/order_statistic_map.hpp"
+#include "../../src/libs/core/string.hpp"
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+
+TEST_CASE("OrderStatisticMap basic operations", "[order_statistic_map]")
+{
+    cpp_ex::OrderStatisticMap<int, std::string> map = {{30, "c"}, {10, "a"}, {20, "b"}};
+
+    SECTION("Ordered iteration in both directions")
+    {
+        REQUIRE(map.getSize() == 3);
+        std::string forward;
+        for (const auto &[key, value] : map)
+        {
+            forward += value;
+        }
+        REQUIRE(forward == "abc");
+
+        std::string backward;
+        for (auto it = map.rbegin(); it != map.rend(); ++it)
+        {
+            backward += it->second;
+        }
+        REQUIRE(backward == "cba");
+        REQUIRE(std::prev(map.end())->first == 30);
+    }
+
+    SECTION("insert, emplace, tryEmplace, insertOrAssign and operator[]")
+    {
+        REQUIRE_FALSE(map.insert({10, "x"}).second);
+        REQUIRE(map.emplace(15, "ab").second);
+        REQUIRE_FALSE(map.tryEmplace(15, "ignored").second);
+        REQUIRE_FALSE(map.insertOrAssign(15, "fifteen").second);
+        REQUIRE(map.at(15) == "fifteen");
+        map[40] = "d";
+        REQUIRE(map.getSize() == 5);
+        REQUIRE(map.at(40) == "d");
+        REQUIRE_THROWS_AS(map.at(99), std::out_of_range);
+    }
+
+    SECTION("find, bounds and erase")
+    {
+        REQUIRE(map.find(20)->second == "b");
+        REQUIRE(map.find(25) == map.end());
+        REQUIRE(map.lowerBound(20)->first == 20);
+        REQUIRE(map.upperBound(20)->first == 30);
+        REQUIRE(map.lowerBound(31) == map.end());
+        auto [first, last] = map.equalRange(10);
+        REQUIRE(std::distance(first, last) == 1);
+
+        auto next = map.erase(map.find(20));
+        REQUIRE(next->first == 30);
+        REQUIRE(map.erase(20) == 0);
+        REQUIRE(map.erase(10) == 1);
+        REQUIRE(map.getSize() == 1);
+        map.clear();
+        REQUIRE(map.isEmpty());
+        REQUIRE(map.begin() == map.end());
+    }
+
+    SECTION("Copies are deep and compare equal")
+    {
+        auto copy = map;
+        REQUIRE(copy == map);
+        copy[10] = "changed";
+        REQUIRE(map.at(10) == "a");
+        REQUIRE(copy != map);
+
+        auto moved = std::move(copy);
+        REQUIRE(moved.getSize() == 3);
+        REQUIRE(moved.rankOf(30) == 2);
+    }
+}
+
+TEST_CASE("OrderStatisticMap order statistics", "[order_statistic_map]")
+{
+    cpp_ex::OrderStatisticMap<int, int> map;
+    for (int i = 0; i < 100; ++i)
+    {
+        map[i * 10] = i;
+    }
+
+    SECTION("rankOf, atIndex, findByIndex and indexOf")
+    {
+        REQUIRE(map.rankOf(0) == 0);
+        REQUIRE(map.rankOf(500) == 50);
+        REQUIRE(map.rankOf(505) == 51);
+        REQUIRE(map.rankOf(-1) == 0);
+        REQUIRE(map.rankOf(10000) == 100);
+
+        REQUIRE(map.atIndex(0).first == 0);
+        REQUIRE(map.atIndex(99).first == 990);
+        REQUIRE_THROWS_AS(map.atIndex(100), std::out_of_range);
+        REQUIRE(map.findByIndex(100) == map.end());
+        map.atIndex(5).second = -5;
+        REQUIRE(map.at(50) == -5);
+
+        REQUIRE(map.indexOf(map.find(370)) == 37);
+        REQUIRE(map.indexOf(map.end()) == 100);
+    }
+
+    SECTION("countInRange is half-open")
+    {
+        REQUIRE(map.countInRange(0, 100) == 10);
+        REQUIRE(map.countInRange(5, 15) == 1);
+        REQUIRE(map.countInRange(100, 100) == 0);
+        REQUIRE(map.countInRange(200, 100) == 0);
+        REQUIRE(map.countInRange(-1000, 1000) == 100);
+    }
+
+    SECTION("percentile uses the nearest rank")
+    {
+        REQUIRE(map.percentile(0).first == 0);
+        REQUIRE(map.percentile(1).first == 0);
+        REQUIRE(map.percentile(50).first == 490);
+        REQUIRE(map.percentile(99.5).first == 990);
+        REQUIRE(map.percentile(100).first == 990);
+        REQUIRE_THROWS_AS(map.percentile(101), std::out_of_range);
+        cpp_ex::OrderStatisticMap<int, int> empty;
+        REQUIRE_THROWS_AS(empty.percentile(50), std::out_of_range);
+    }
+
+    SECTION("Custom comparator: descending leaderboard")
+    {
+        cpp_ex::OrderStatisticMap<int, std::string, std::greater<int>> board = {{1200, "ana"}, {900, "bo"}, {1500, "cy"}};
+        REQUIRE(board.rankOf(1200) == 1);
+        REQUIRE(board.atIndex(0).second == "cy");
+        REQUIRE(board.countInRange(1500, 900) == 2);
+    }
+
+    SECTION("Transparent lookups")
+    {
+        cpp_ex::OrderStatisticMap<cpp_ex::String, int, std::less<cpp_ex::String>> names = {{"b", 2}, {"a", 1}};
+        REQUIRE(names.contains("a"));
+        REQUIRE(names.rankOf("b") == 1);
+        REQUIRE(names.find("c") == names.end());
+    }
+}
+
+TEST_CASE("OrderStatisticMap matches std::map under random operations", "[order_statistic_map]")
+{
+    std::mt19937 random(12345);
+    cpp_ex::OrderStatisticMap<int, int> map;
+    std::map<int, int> reference;
+
+    for (int step = 0; step < 20000; ++step)
+    {
+        int key = static_cast<int>(random() % 2000);
+        switch (random() % 4)
+        {
+        case 0:
+        case 1:
+            map.insertOrAssign(key, step);
+            reference.insert_or_assign(key, step);
+            break;
+        case 2:
+            REQUIRE(map.erase(key) == reference.erase(key));
+            break;
+        default:
+        {
+            auto it = reference.lower_bound(key);
+            auto rank = static_cast<std::size_t>(std::distance(reference.begin(), it));
+            REQUIRE(map.rankOf(key) == rank);
+            if (it != reference.end())
+            {
+                REQUIRE(map.atIndex(rank) == *it);
+                REQUIRE(map.indexOf(map.lowerBound(key)) == rank);
+            }
+            else
+            {
+                REQUIRE(map.lowerBound(key) == map.end());
+            }
+        }
+        }
+        REQUIRE(map.getSize() == reference.size());
+    }
+
+    REQUIRE(std::equal(map.begin(), map.end(), reference.begin(), reference.end()));
+    REQUIRE(std::equal(map.rbegin(), map.rend(), reference.rbegin(), reference.rend()));
+
+    // Erase everything through iterators
+    for (auto it = map.begin(); it != map.end();)
+    {
+        it = map.erase(it);
+    }
+    REQUIRE(map.isEmpty());
+}
@@ -0,0 +1,224 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/libs/core/persistent_map.hpp"
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Only three distinct hashes: every key ends up in a collision node
+    struct CollidingHash
+    {
+        std::size_t operator()(int key) const
+        {
+            return static_cast<std::size_t>(key % 3);
+        }
+    };
+}
+
+TEST_CASE("PersistentMap versions", "[persistent_map]")
+{
+    cpp_ex::PersistentMap<std::string, int> v1 = {{"a", 1}, {"b", 2}};
+
+    SECTION("with() and without() leave the original untouched")
+    {
+        auto v2 = v1.with("c", 3);
+        auto v3 = v2.without("a");
+        auto v4 = v3.with("b", 20);
+
+        REQUIRE(v1.getSize() == 2);
+        REQUIRE_FALSE(v1.contains("c"));
+        REQUIRE(v2.getSize() == 3);
+        REQUIRE(v2.at("a") == 1);
+        REQUIRE(v3.getSize() == 2);
+        REQUIRE_FALSE(v3.contains("a"));
+        REQUIRE(v3.at("b") == 2);
+        REQUIRE(v4.at("b") == 20);
+        REQUIRE(v4.getSize() == 2);
+    }
+
+    SECTION("Lookups")
+    {
+        REQUIRE(*v1.find("a") == 1);
+        REQUIRE(v1.find("z") == nullptr);
+        REQUIRE(v1.count("b") == 1);
+        REQUIRE(v1.getOrDefault("z", -1) == -1);
+        REQUIRE_THROWS_AS(v1.at("z"), std::out_of_range);
+    }
+
+    SECTION("Removing a missing key shares the whole version")
+    {
+        auto same = v1.without("z");
+        REQUIRE(same.sharesRootWith(v1));
+        REQUIRE(same == v1);
+        REQUIRE_FALSE(v1.with("a", 1).sharesRootWith(v1));
+        REQUIRE(v1.with("a", 1) == v1);
+        REQUIRE(v1.with("a", 5) != v1);
+    }
+
+    SECTION("withUpdated() applies a function to the current value")
+    {
+        auto v2 = v1.withUpdated("a", 0, [](int value)
+                                 { return value + 10; })
+                      .withUpdated("n", 7, [](int value)
+                                   { return value + 10; });
+        REQUIRE(v2.at("a") == 11);
+        REQUIRE(v2.at("n") == 7);
+    }
+
+    SECTION("Emptying a map")
+    {
+        auto empty = v1.without("a").without("b");
+        REQUIRE(empty.isEmpty());
+        REQUIRE(empty.begin() == empty.end());
+        REQUIRE(empty.with("x", 1).getSize() == 1);
+    }
+}
+
+TEST_CASE("PersistentMap conversions and iteration", "[persistent_map]")
+{
+    cpp_ex::Map<int, std::string> source = {{3, "three"}, {1, "one"}, {2, "two"}};
+    cpp_ex::PersistentMap<int, std::string> map(source);
+
+    REQUIRE(map.getSize() == 3);
+    REQUIRE(map.toMap() == source);
+    REQUIRE(map.toMap<std::greater<int>>().getKeys() == cpp_ex::Vector<int>{3, 2, 1});
+
+    std::size_t visited = 0;
+    for (const auto &[key, value] : map)
+    {
+        REQUIRE(source.at(key) == value);
+        ++visited;
+    }
+    REQUIRE(visited == 3);
+    REQUIRE(map.getKeys().getSize() == 3);
+    REQUIRE(map.getValues().getSize() == 3);
+    REQUIRE(map.getEntries().getSize() == 3);
+
+    int sum = 0;
+    map.forEach([&sum](const int &key, const std::string &)
+                { sum += key; });
+    REQUIRE(sum == 6);
+}
+
+TEST_CASE("PersistentMap against std::map", "[persistent_map]")
+{
+    std::uint64_t state = 7;
+    auto next = [&state]
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return state >> 33;
+    };
+
+    SECTION("Random updates, keeping every version")
+    {
+        std::map<int, int> reference;
+        cpp_ex::PersistentMap<int, int> map;
+        std::vector<std::pair<cpp_ex::PersistentMap<int, int>, std::map<int, int>>> history;
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            int key = static_cast<int>(next() % 2000);
+            if (next() % 3 == 0)
+            {
+                reference.erase(key);
+                map = map.without(key);
+            }
+            else
+            {
+                reference[key] = i;
+                map = map.with(key, i);
+            }
+            if (i % 1000 == 0)
+            {
+                history.emplace_back(map, reference);
+            }
+        }
+
+        REQUIRE(map.getSize() == reference.size());
+        REQUIRE(map.toMap().getStdMap() == reference);
+
+        // Older versions still hold exactly what they had
+        for (const auto &[version, expected] : history)
+        {
+            REQUIRE(version.toMap().getStdMap() == expected);
+        }
+    }
+
+    SECTION("Full hash collisions")
+    {
+        std::map<int, int> reference;
+        cpp_ex::PersistentMap<int, int, CollidingHash> map;
+        for (int i = 0; i < 3000; ++i)
+        {
+            int key = static_cast<int>(next() % 300);
+            if (next() % 4 == 0)
+            {
+                reference.erase(key);
+                map = map.without(key);
+            }
+            else
+            {
+                reference[key] = i;
+                map = map.with(key, i);
+            }
+        }
+        REQUIRE(map.getSize() == reference.size());
+        std::size_t visited = 0;
+        for (const auto &[key, value] : map)
+        {
+            REQUIRE(reference.at(key) == value);
+            ++visited;
+        }
+        REQUIRE(visited == reference.size());
+    }
+}
+
+TEST_CASE("PersistentMap read from several threads", "[persistent_map]")
+{
+    cpp_ex::PersistentMap<int, int> base;
+    for (int i = 0; i < 1000; ++i)
+    {
+        base = base.with(i, i);
+    }
+
+    // Readers walk the base version while the main thread derives new ones from it
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t)
+    {
+        readers.emplace_back([base, &failed]
+                             {
+                                 for (int round = 0; round < 20; ++round)
+                                 {
+                                     long sum = 0;
+                                     for (const auto &[key, value] : base)
+                                     {
+                                         sum += value;
+                                     }
+                                     if (sum != 999L * 1000 / 2 || base.at(500) != 500)
+                                     {
+                                         failed = true;
+                                     }
+                                 } });
+    }
+
+    auto current = base;
+    for (int i = 0; i < 1000; ++i)
+    {
+        current = current.with(i, -i).without(i + 1);
+    }
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    REQUIRE_FALSE(failed.load());
+    REQUIRE(base.getSize() == 1000);
+    REQUIRE(base.at(1) == 1);
+    REQUIRE(current.at(0) == 0);
+    REQUIRE(current.at(999) == -999);
+}
@@ -0,0 +1,206 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/libs/core/radix_map.hpp"
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+TEST_CASE("RadixMap basic operations", "[radix_map]")
+{
+    cpp_ex::RadixMap<int> map = {{"/api/users", 1}, {"/api/users/admin", 2}, {"/api/orders", 3}, {"/static", 4}};
+
+    SECTION("Lookups with every kind of string key")
+    {
+        REQUIRE(map.getSize() == 4);
+        REQUIRE(map.at("/api/users") == 1);
+        REQUIRE(*map.find(std::string("/api/orders")) == 3);
+        REQUIRE(map.contains(cpp_ex::String("/static")));
+        REQUIRE(map.count(std::string_view("/api/users/admin")) == 1);
+
+        // Prefixes of stored keys are not keys themselves
+        REQUIRE(map.find("/api") == nullptr);
+        REQUIRE(map.find("/api/users/") == nullptr);
+        REQUIRE(map.find("/api/users/admins") == nullptr);
+        REQUIRE_THROWS_AS(map.at("/nope"), std::out_of_range);
+    }
+
+    SECTION("Insertion and assignment")
+    {
+        REQUIRE_FALSE(map.insert("/api/users", 10));
+        REQUIRE(map.at("/api/users") == 1);
+        REQUIRE_FALSE(map.insertOrAssign("/api/users", 10));
+        REQUIRE(map.at("/api/users") == 10);
+        REQUIRE(map.insert("/api", 5)); // Splits an existing edge
+        REQUIRE(map.at("/api") == 5);
+        map[""] = 42;
+        REQUIRE(map.at("") == 42);
+        REQUIRE(map.getSize() == 6);
+    }
+
+    SECTION("Erase keeps the trie compressed")
+    {
+        auto nodes = map.getNodeCount();
+        REQUIRE(map.erase("/api/users/admin") == 1);
+        REQUIRE(map.erase("/api/users/admin") == 0);
+        REQUIRE(map.erase("/api") == 0);
+        REQUIRE(map.getNodeCount() < nodes);
+
+        REQUIRE(map.erase("/api/users") == 1);
+        REQUIRE(map.erase("/api/orders") == 1);
+        REQUIRE(map.erase("/static") == 1);
+        REQUIRE(map.isEmpty());
+        REQUIRE(map.getNodeCount() == 1); // Only the root
+    }
+
+    SECTION("Longest prefix match")
+    {
+        auto match = map.findLongestPrefix("/api/users/42/profile");
+        REQUIRE(match);
+        REQUIRE(match.length == 10);
+        REQUIRE(*match.value == 1);
+        REQUIRE(map.findLongestPrefix("/api/users/admin/x").length == 16);
+        REQUIRE_FALSE(map.findLongestPrefix("/api/user"));
+        REQUIRE_FALSE(map.findLongestPrefix(""));
+
+        const auto &constMap = map;
+        REQUIRE(*constMap.findLongestPrefix("/static/app.js").value == 4);
+    }
+
+    SECTION("Prefix queries")
+    {
+        REQUIRE(map.getKeysWithPrefix("/api/") == cpp_ex::Vector<cpp_ex::String>{"/api/orders", "/api/users", "/api/users/admin"});
+        REQUIRE(map.countWithPrefix("/api/u") == 2); // Prefix ends inside an edge
+        REQUIRE(map.countWithPrefix("") == 4);
+        REQUIRE(map.countWithPrefix("/x") == 0);
+        REQUIRE(map.countWithPrefix("/api/users/admin/more") == 0);
+
+        map.forEachWithPrefix("/api/users", [](std::string_view, int &value)
+                              { value *= 100; });
+        REQUIRE(map.at("/api/users/admin") == 200);
+        REQUIRE(map.at("/api/orders") == 3);
+    }
+
+    SECTION("Ordered iteration, copies and equality")
+    {
+        std::vector<std::string> keys;
+        for (const auto &[key, value] : map)
+        {
+            keys.push_back(key);
+        }
+        REQUIRE(keys == std::vector<std::string>{"/api/orders", "/api/users", "/api/users/admin", "/static"});
+        REQUIRE(map.getValues() == cpp_ex::Vector<int>{3, 1, 2, 4});
+
+        for (auto it = map.begin(); it != map.end(); ++it)
+        {
+            it->second += 1;
+        }
+        auto copy = map;
+        REQUIRE(copy == map);
+        copy["/static"] = 0;
+        REQUIRE(copy != map);
+        REQUIRE(map.at("/static") == 5);
+
+        auto moved = std::move(copy);
+        REQUIRE(moved.getSize() == 4);
+        REQUIRE(copy.isEmpty());
+
+        // A moved-from map has no root until the next insertion
+        const auto &empty = copy;
+        REQUIRE(empty.begin() == empty.end());
+        REQUIRE(empty.find("/static") == nullptr);
+        REQUIRE_FALSE(empty.findLongestPrefix("/static"));
+        REQUIRE(empty.countWithPrefix("") == 0);
+        REQUIRE(empty.getNodeCount() == 0);
+        REQUIRE_THROWS_AS(empty.at("/static"), std::out_of_range);
+        REQUIRE(copy.erase("/static") == 0);
+        copy[""] = 7;
+        REQUIRE(empty.at("") == 7);
+        REQUIRE(copy.getNodeCount() == 1);
+
+        moved.clear();
+        REQUIRE(moved.getNodeCount() == 0);
+        REQUIRE(moved == cpp_ex::RadixMap<int>());
+        REQUIRE(std::is_nothrow_move_constructible_v<cpp_ex::RadixMap<int>>);
+        REQUIRE(std::is_nothrow_move_assignable_v<cpp_ex::RadixMap<int>>);
+    }
+}
+
+TEST_CASE("RadixMap wide nodes and random keys against std::map", "[radix_map]")
+{
+    std::uint64_t state = 3;
+    auto next = [&state]
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return state >> 33;
+    };
+
+    SECTION("Nodes grow past 16 children and shrink back")
+    {
+        cpp_ex::RadixMap<int> map;
+        for (int b = 0; b < 256; ++b)
+        {
+            map.insert(std::string("k") + static_cast<char>(b), b);
+        }
+        REQUIRE(map.getSize() == 256);
+        for (int b = 0; b < 256; ++b)
+        {
+            REQUIRE(map.at(std::string("k") + static_cast<char>(b)) == b);
+        }
+        auto keys = map.getKeys();
+        REQUIRE(static_cast<unsigned char>(keys[255].getStringView()[1]) == 255); // Byte order, not signed char order
+
+        for (int b = 0; b < 250; ++b)
+        {
+            REQUIRE(map.erase(std::string("k") + static_cast<char>(b)) == 1);
+        }
+        REQUIRE(map.getSize() == 6);
+        REQUIRE(map.at(std::string("k") + static_cast<char>(255)) == 255);
+        REQUIRE(map.countWithPrefix("k") == 6);
+    }
+
+    SECTION("Random paths")
+    {
+        const char *segments[] = {"/api", "/v1", "/v2", "/users", "/u", "/orders", "/o", "/x", "/42", "/a/b"};
+        std::map<std::string, int> reference;
+        cpp_ex::RadixMap<int> map;
+        for (int i = 0; i < 20000; ++i)
+        {
+            std::string key;
+            for (std::uint64_t parts = next() % 5; parts > 0; --parts)
+            {
+                key += segments[next() % 10];
+            }
+            if (next() % 3 == 0)
+            {
+                REQUIRE(map.erase(key) == reference.erase(key));
+            }
+            else
+            {
+                map.insertOrAssign(key, i);
+                reference[key] = i;
+            }
+        }
+
+        REQUIRE(map.getSize() == reference.size());
+        auto it = reference.begin();
+        map.forEach([&it](std::string_view key, int value)
+                    {
+                        REQUIRE(key == it->first);
+                        REQUIRE(value == it->second);
+                        ++it; });
+        REQUIRE(it == reference.end());
+
+        for (const char *prefix : {"/api", "/api/v1", "/u", "/users/o", "/v2/x/4"})
+        {
+            std::size_t expected = 0;
+            for (auto ref = reference.lower_bound(prefix); ref != reference.end() && ref->first.starts_with(prefix); ++ref)
+            {
+                ++expected;
+            }
+            REQUIRE(map.countWithPrefix(prefix) == expected);
+        }
+    }
+}
@@ -0,0 +1,216 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/libs/core/serialization.hpp"
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace
+{
+    enum class Color : std::uint8_t
+    {
+        Red,
+        Green
+    };
+
+    struct Point
+    {
+        int x;
+        int y;
+
+        bool operator==(const Point &other) const = default;
+    };
+}
+
+template <>
+struct cpp_ex::Serializer<Point>
+{
+    static void write(cpp_ex::BinaryWriter &out, const Point &point)
+    {
+        out.write(point.x);
+        out.write(point.y);
+    }
+
+    static Point read(cpp_ex::BinaryReader &in)
+    {
+        int x = in.read<int>();
+        int y = in.read<int>();
+        return {x, y};
+    }
+};
+
+TEST_CASE("CRC-32C", "[serialization]")
+{
+    // Check value of the Castagnoli polynomial
+    REQUIRE(cpp_ex::crc32c("123456789") == 0xE3069283u);
+    REQUIRE(cpp_ex::crc32c("") == 0u);
+
+    // Checksumming in pieces gives the same result
+    std::string text = "The quick brown fox jumps over the lazy dog";
+    std::uint32_t piecewise = cpp_ex::crc32c(std::string_view(text).substr(0, 13));
+    piecewise = cpp_ex::crc32c(std::string_view(text).substr(13), piecewise);
+    REQUIRE(piecewise == cpp_ex::crc32c(text));
+}
+
+TEST_CASE("BinaryWriter and BinaryReader round trips", "[serialization]")
+{
+    cpp_ex::BinaryWriter out;
+
+    SECTION("Scalars are little-endian and fixed width")
+    {
+        out.write(std::uint32_t{0x01020304});
+        REQUIRE(out.getBuffer() == std::string_view("\x04\x03\x02\x01", 4));
+
+        out.write(std::int16_t{-2});
+        out.write(-1.5);
+        out.write(true);
+        out.write(Color::Green);
+        out.write(std::numeric_limits<std::int64_t>::min());
+
+        cpp_ex::BinaryReader in(out.getBuffer());
+        REQUIRE(in.read<std::uint32_t>() == 0x01020304);
+        REQUIRE(in.read<std::int16_t>() == -2);
+        REQUIRE(in.read<double>() == -1.5);
+        REQUIRE(in.read<bool>());
+        REQUIRE(in.read<Color>() == Color::Green);
+        REQUIRE(in.read<std::int64_t>() == std::numeric_limits<std::int64_t>::min());
+        REQUIRE(in.isAtEnd());
+    }
+
+    SECTION("Varints use one byte per 7 bits")
+    {
+        out.writeVarint(0);
+        out.writeVarint(127);
+        out.writeVarint(128);
+        out.writeVarint(std::numeric_limits<std::uint64_t>::max());
+        REQUIRE(out.getSize() == 1 + 1 + 2 + 10);
+
+        cpp_ex::BinaryReader in(out.getBuffer());
+        REQUIRE(in.readVarint() == 0);
+        REQUIRE(in.readVarint() == 127);
+        REQUIRE(in.readVarint() == 128);
+        REQUIRE(in.readVarint() == std::numeric_limits<std::uint64_t>::max());
+    }
+
+    SECTION("Strings, pairs, vectors and user types")
+    {
+        cpp_ex::Vector<std::pair<cpp_ex::String, Point>> values;
+        values.pushBack({cpp_ex::String("origin"), Point{0, 0}});
+        values.pushBack({cpp_ex::String(""), Point{-3, 7}});
+        out.write(values);
+        out.write(std::string("tail"));
+
+        cpp_ex::BinaryReader in(out.getBuffer());
+        auto decoded = in.read<cpp_ex::Vector<std::pair<cpp_ex::String, Point>>>();
+        REQUIRE(decoded.getSize() == 2);
+        REQUIRE(decoded[0].first == "origin");
+        REQUIRE(decoded[1].second == Point{-3, 7});
+        REQUIRE(in.read<std::string>() == "tail");
+        REQUIRE(in.isAtEnd());
+    }
+
+    SECTION("takeBuffer() and patchU32()")
+    {
+        out.writeU32(0);
+        out.writeString("abc");
+        out.patchU32(0, static_cast<std::uint32_t>(out.getSize()));
+        std::string bytes = out.takeBuffer();
+        REQUIRE(out.getSize() == 0);
+        REQUIRE(cpp_ex::BinaryReader(bytes).readU32() == 8);
+    }
+}
+
+TEST_CASE("BinaryReader rejects malformed input", "[serialization]")
+{
+    using cpp_ex::exceptions::SerializationError;
+
+    SECTION("Truncated data")
+    {
+        cpp_ex::BinaryReader in(std::string_view("\x01\x02", 2));
+        REQUIRE_THROWS_AS(in.readU32(), SerializationError);
+        // A failed read consumes nothing
+        REQUIRE(in.getRemaining() == 2);
+    }
+
+    SECTION("Lengths larger than the input")
+    {
+        cpp_ex::BinaryWriter out;
+        out.writeVarint(1000);
+        out.writeBytes("abc", 3);
+        cpp_ex::BinaryReader in(out.getBuffer());
+        REQUIRE_THROWS_AS(in.readString(), SerializationError);
+
+        cpp_ex::BinaryReader vectorIn(out.getBuffer());
+        REQUIRE_THROWS_AS(vectorIn.read<cpp_ex::Vector<int>>(), SerializationError);
+    }
+
+    SECTION("Overlong varints and invalid bools")
+    {
+        std::string overlong(11, '\xFF');
+        REQUIRE_THROWS_AS(cpp_ex::BinaryReader(overlong).readVarint(), SerializationError);
+        REQUIRE_THROWS_AS(cpp_ex::BinaryReader(std::string_view("\x02", 1)).read<bool>(), SerializationError);
+    }
+}
+
+TEST_CASE("MapDelta serialization", "[serialization]")
+{
+    SECTION("Integer keys are stored as varint gaps")
+    {
+        cpp_ex::MapDelta<std::uint64_t, std::uint32_t> delta;
+        for (std::uint64_t i = 0; i < 1000; ++i)
+        {
+            delta.added.emplaceBack(1000000000 + i * 3, static_cast<std::uint32_t>(i));
+        }
+        delta.removed = {5, 17, 16}; // Fuera de orden: huecos negativos
+        cpp_ex::BinaryWriter out;
+        out.write(delta);
+        // 1 byte de hueco + 4 de valor por entrada, frente a 12 con claves de ancho fijo
+        REQUIRE(out.getSize() < 1000 * 5 + 32);
+
+        cpp_ex::BinaryReader in(out.getBuffer());
+        REQUIRE(in.read<cpp_ex::MapDelta<std::uint64_t, std::uint32_t>>() == delta);
+        REQUIRE(in.isAtEnd());
+    }
+
+    SECTION("String keys are front-coded")
+    {
+        cpp_ex::MapDelta<cpp_ex::String, std::string> delta;
+        delta.reset = true;
+        delta.added.emplaceBack(cpp_ex::String("session:000123"), "alice");
+        delta.added.emplaceBack(cpp_ex::String("session:000124"), "bob");
+        delta.changed.emplaceBack(cpp_ex::String(""), "empty key");
+        delta.removed = {cpp_ex::String("session:9"), cpp_ex::String("session:99")};
+        cpp_ex::BinaryWriter out;
+        out.write(delta);
+
+        cpp_ex::BinaryReader in(out.getBuffer());
+        auto decoded = in.read<cpp_ex::MapDelta<cpp_ex::String, std::string>>();
+        REQUIRE(decoded == delta);
+        REQUIRE(decoded.reset);
+
+        cpp_ex::MapDelta<std::string, int> plain;
+        plain.removed = {"user/alice", "user/bob"};
+        cpp_ex::BinaryWriter plainOut;
+        plainOut.write(plain);
+        // Indicador, tres recuentos, "user/alice" entera y solo "bob" de la segunda clave
+        REQUIRE(plainOut.getSize() == 1 + 3 + 12 + 5);
+        REQUIRE(cpp_ex::BinaryReader(plainOut.getBuffer()).read<cpp_ex::MapDelta<std::string, int>>() == plain);
+    }
+
+    SECTION("Malformed deltas")
+    {
+        using cpp_ex::exceptions::SerializationError;
+        using IntDelta = cpp_ex::MapDelta<int, int>;
+        using StringDelta = cpp_ex::MapDelta<std::string, int>;
+        REQUIRE_THROWS_AS(cpp_ex::BinaryReader(std::string_view("\x02\x00\x00\x00", 4)).read<IntDelta>(), SerializationError);
+
+        // Prefijo compartido más largo que la clave anterior
+        cpp_ex::BinaryWriter out;
+        out.writeU8(0);
+        out.writeVarint(1);
+        out.writeVarint(3);
+        out.writeString("abc");
+        REQUIRE_THROWS_AS(cpp_ex::BinaryReader(out.getBuffer()).read<StringDelta>(), SerializationError);
+        REQUIRE_THROWS_AS(cpp_ex::BinaryReader(std::string_view("\x00\x05", 2)).read<IntDelta>(), SerializationError);
+    }
+}
@@ -0,0 +1,232 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/libs/core/small_map.hpp"
+#include "../../src/libs/core/string.hpp"
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+
+TEST_CASE("SmallMap basic operations", "[small_map]")
+{
+    cpp_ex::SmallMap<int, std::string, 4> map = {{30, "c"}, {10, "a"}, {20, "b"}};
+
+    SECTION("Entries stay inline and sorted")
+    {
+        REQUIRE(map.isInline());
+        REQUIRE(map.getSize() == 3);
+        REQUIRE(map.getInlineCapacity() == 4);
+        std::string forward;
+        for (const auto &[key, value] : map)
+        {
+            forward += value;
+        }
+        REQUIRE(forward == "abc");
+
+        std::string backward;
+        for (auto it = map.rbegin(); it != map.rend(); ++it)
+        {
+            backward += it->second;
+        }
+        REQUIRE(backward == "cba");
+    }
+
+    SECTION("insert, emplace, tryEmplace, insertOrAssign and operator[]")
+    {
+        REQUIRE_FALSE(map.insert({10, "x"}).second);
+        REQUIRE(map.emplace(15, "ab").second);
+        REQUIRE_FALSE(map.tryEmplace(15, "ignored").second);
+        REQUIRE_FALSE(map.insertOrAssign(15, "fifteen").second);
+        REQUIRE(map.at(15) == "fifteen");
+        REQUIRE(map.isInline());
+        REQUIRE_THROWS_AS(map.at(99), std::out_of_range);
+    }
+
+    SECTION("find, bounds and erase")
+    {
+        REQUIRE(map.find(20)->second == "b");
+        REQUIRE(map.find(25) == map.end());
+        REQUIRE(map.lowerBound(20)->first == 20);
+        REQUIRE(map.upperBound(20)->first == 30);
+        REQUIRE(map.lowerBound(31) == map.end());
+        auto [first, last] = map.equalRange(10);
+        REQUIRE(std::distance(first, last) == 1);
+
+        auto next = map.erase(map.find(20));
+        REQUIRE(next->first == 30);
+        REQUIRE(map.erase(20) == 0);
+        REQUIRE(map.erase(10) == 1);
+        REQUIRE(map.getSize() == 1);
+        map.clear();
+        REQUIRE(map.isEmpty());
+        REQUIRE(map.begin() == map.end());
+    }
+
+    SECTION("Copies are deep and compare equal")
+    {
+        auto copy = map;
+        REQUIRE(copy == map);
+        copy[10] = "changed";
+        REQUIRE(map.at(10) == "a");
+        REQUIRE(copy != map);
+
+        auto moved = std::move(copy);
+        REQUIRE(moved.getSize() == 3);
+        REQUIRE(moved.at(10) == "changed");
+    }
+}
+
+TEST_CASE("SmallMap migrates past its inline capacity", "[small_map]")
+{
+    cpp_ex::SmallMap<int, int, 4> map;
+    for (int i = 0; i < 4; ++i)
+    {
+        map[i * 10] = i;
+    }
+    REQUIRE(map.isInline());
+
+    SECTION("The fifth entry moves everything to the Map backend")
+    {
+        map[5] = 42;
+        REQUIRE_FALSE(map.isInline());
+        REQUIRE(map.getSize() == 5);
+        REQUIRE(map.getKeys() == cpp_ex::Vector<int>{0, 5, 10, 20, 30});
+        REQUIRE(map.at(5) == 42);
+        REQUIRE(map.lowerBound(11)->first == 20);
+        REQUIRE(std::prev(map.end())->first == 30);
+    }
+
+    SECTION("Copies and moves keep the backend")
+    {
+        map[40] = 4;
+        auto copy = map;
+        REQUIRE_FALSE(copy.isInline());
+        REQUIRE(copy == map);
+        auto moved = std::move(copy);
+        REQUIRE(moved == map);
+        REQUIRE(copy.isEmpty());
+        REQUIRE(copy.isInline());
+    }
+
+    SECTION("shrinkToFit and clear come back inline")
+    {
+        map[40] = 4;
+        map.shrinkToFit();
+        REQUIRE_FALSE(map.isInline());
+        map.erase(40);
+        map.shrinkToFit();
+        REQUIRE(map.isInline());
+        REQUIRE(map.getKeys() == cpp_ex::Vector<int>{0, 10, 20, 30});
+
+        map[50] = 5;
+        map.clear();
+        REQUIRE(map.isInline());
+        map[1] = 1;
+        REQUIRE(map.getSize() == 1);
+    }
+
+    SECTION("Converts to and from Map")
+    {
+        cpp_ex::Map<int, int> plain = map.toMap();
+        REQUIRE(plain.getSize() == 4);
+        REQUIRE(plain.at(30) == 3);
+        cpp_ex::SmallMap<int, int, 4> back(plain);
+        REQUIRE(back == map);
+        plain[99] = 9;
+        cpp_ex::SmallMap<int, int, 4> spilled(plain);
+        REQUIRE_FALSE(spilled.isInline());
+        REQUIRE(spilled.toMap() == plain);
+    }
+}
+
+TEST_CASE("SmallMap helpers and custom keys", "[small_map]")
+{
+    SECTION("mapValues, filterEntries and emplaceHint")
+    {
+        cpp_ex::SmallMap<int, int, 8> map = {{1, 10}, {2, 20}, {3, 30}};
+        auto doubled = map.mapValues<long>([](int value)
+                                           { return 2L * value; });
+        REQUIRE(doubled.at(3) == 60L);
+        auto odd = map.filterEntries([](int key, int)
+                                     { return key % 2 == 1; });
+        REQUIRE(odd.getKeys() == cpp_ex::Vector<int>{1, 3});
+
+        map.emplaceHint(map.end(), 4, 40);
+        map.emplaceHint(map.begin(), 0, 0);
+        map.emplaceHint(map.begin(), 9, 90); // Wrong hint: still sorted
+        REQUIRE(map.getKeys() == cpp_ex::Vector<int>{0, 1, 2, 3, 4, 9});
+    }
+
+    SECTION("Transparent String lookups and descending order")
+    {
+        cpp_ex::SmallMap<cpp_ex::String, int, 4, std::less<cpp_ex::String>> names = {{"b", 2}, {"a", 1}};
+        REQUIRE(names.contains("a"));
+        REQUIRE(names.find("c") == names.end());
+        REQUIRE(names.lowerBound("aa")->second == 2);
+
+        cpp_ex::SmallMap<int, int, 4, std::greater<int>> desc = {{1, 1}, {3, 3}, {2, 2}};
+        REQUIRE(desc.begin()->first == 3);
+        REQUIRE(desc.lowerBound(2)->first == 2);
+        REQUIRE(desc.upperBound(2)->first == 1);
+    }
+
+    SECTION("Range erase")
+    {
+        cpp_ex::SmallMap<int, std::string, 8> map = {{1, "a"}, {2, "b"}, {3, "c"}, {4, "d"}};
+        auto it = map.erase(map.find(2), map.find(4));
+        REQUIRE(it->first == 4);
+        REQUIRE(map.getKeys() == cpp_ex::Vector<int>{1, 4});
+    }
+}
+
+TEST_CASE("SmallMap matches std::map under random operations", "[small_map]")
+{
+    std::mt19937 random(2024);
+    cpp_ex::SmallMap<int, std::string, 8> map;
+    std::map<int, std::string> reference;
+
+    for (int step = 0; step < 20000; ++step)
+    {
+        // Pocas claves: el mapa entra y sale del modo inline
+        int key = static_cast<int>(random() % 24);
+        switch (random() % 5)
+        {
+        case 0:
+        case 1:
+            map.insertOrAssign(key, std::to_string(step));
+            reference.insert_or_assign(key, std::to_string(step));
+            break;
+        case 2:
+            REQUIRE(map.erase(key) == reference.erase(key));
+            break;
+        case 3:
+            map.shrinkToFit();
+            REQUIRE(map.isInline() == (reference.size() <= 8));
+            break;
+        default:
+        {
+            auto it = reference.lower_bound(key);
+            auto found = map.lowerBound(key);
+            if (it == reference.end())
+            {
+                REQUIRE(found == map.end());
+            }
+            else
+            {
+                REQUIRE(*found == *it);
+            }
+            REQUIRE(map.contains(key) == reference.contains(key));
+        }
+        }
+        REQUIRE(map.getSize() == reference.size());
+    }
+
+    REQUIRE(std::equal(map.begin(), map.end(), reference.begin(), reference.end()));
+    REQUIRE(std::equal(map.rbegin(), map.rend(), reference.rbegin(), reference.rend()));
+
+    for (auto it = map.begin(); it != map.end();)
+    {
+        it = map.erase(it);
+    }
+    REQUIRE(map.isEmpty());
+}
@@ -0,0 +1,110 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/libs/core/static_map.hpp"
+#include <array>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    constexpr auto kMethods = cpp_ex::makeStaticMap<std::string_view, int>({{"GET", 1}, {"POST", 2}, {"PUT", 3}, {"DELETE", 4}, {"PATCH", 5}, {"a-rather-long-method-name", 6}});
+
+    // Built entirely at compile time
+    static_assert(kMethods.getSize() == 6);
+    static_assert(kMethods.at("POST") == 2);
+    static_assert(kMethods.at("a-rather-long-method-name") == 6);
+    static_assert(!kMethods.contains("post"));
+    static_assert(kMethods.getOrDefault("TRACE", -1) == -1);
+
+    constexpr auto kStatusCodes = cpp_ex::makeStaticMap<int, std::string_view>({{200, "OK"}, {404, "Not Found"}, {-1, "Unknown"}});
+    static_assert(kStatusCodes.at(404) == "Not Found");
+    static_assert(kStatusCodes.at(-1) == "Unknown");
+
+    constexpr auto kSquares = []
+    {
+        std::array<std::pair<std::uint32_t, std::uint32_t>, 1000> entries{};
+        for (std::uint32_t i = 0; i < 1000; ++i)
+        {
+            entries[i] = {i * 7919, i * i};
+        }
+        return cpp_ex::StaticMap<std::uint32_t, std::uint32_t, 1000>(entries);
+    }();
+    static_assert(kSquares.at(999u * 7919) == 999u * 999);
+}
+
+TEST_CASE("StaticMap lookups", "[static_map]")
+{
+    SECTION("String keys of every kind")
+    {
+        REQUIRE(*kMethods.find("GET") == 1);
+        REQUIRE(kMethods.at(std::string("PUT")) == 3);
+        REQUIRE(kMethods.at(cpp_ex::String("DELETE")) == 4);
+        REQUIRE(kMethods.count(std::string_view("PATCH")) == 1);
+        REQUIRE(kMethods.find("GETX") == nullptr);
+        REQUIRE(kMethods.find("") == nullptr);
+        REQUIRE_THROWS_AS(kMethods.at("OPTIONS"), std::out_of_range);
+    }
+
+    SECTION("Integer keys, including ones out of the key type's range")
+    {
+        REQUIRE(kStatusCodes.at(200) == "OK");
+        REQUIRE_FALSE(kStatusCodes.contains(500));
+        REQUIRE(kSquares.at(std::uint64_t{7919} * 3) == 9);
+        REQUIRE_FALSE(kSquares.contains(std::uint64_t{1} << 40));
+        REQUIRE_FALSE(kSquares.contains(-7919));
+    }
+
+    SECTION("Iteration visits every entry once")
+    {
+        std::set<std::uint32_t> keys;
+        for (const auto &[key, value] : kSquares)
+        {
+            REQUIRE(value == (key / 7919) * (key / 7919));
+            keys.insert(key);
+        }
+        REQUIRE(keys.size() == 1000);
+
+        int sum = 0;
+        kMethods.forEach([&sum](std::string_view, int value)
+                         { sum += value; });
+        REQUIRE(sum == 21);
+    }
+}
+
+TEST_CASE("StaticMap built at runtime", "[static_map]")
+{
+    SECTION("Every key of a large set is found")
+    {
+        std::array<std::pair<std::int64_t, int>, 5000> entries{};
+        for (int i = 0; i < 5000; ++i)
+        {
+            entries[i] = {static_cast<std::int64_t>(i) * 1000003 - 77, i};
+        }
+        cpp_ex::StaticMap<std::int64_t, int, 5000> map(entries);
+        for (int i = 0; i < 5000; ++i)
+        {
+            REQUIRE(map.at(static_cast<std::int64_t>(i) * 1000003 - 77) == i);
+            REQUIRE_FALSE(map.contains(static_cast<std::int64_t>(i) * 1000003 - 76));
+        }
+    }
+
+    SECTION("Duplicate keys are rejected")
+    {
+        std::array<std::pair<std::string_view, int>, 3> entries = {{{"a", 1}, {"b", 2}, {"a", 3}}};
+        REQUIRE_THROWS_AS((cpp_ex::StaticMap<std::string_view, int, 3>(entries)), std::invalid_argument);
+    }
+
+    SECTION("Empty and single-entry maps")
+    {
+        cpp_ex::StaticMap<int, int, 0> empty(std::array<std::pair<int, int>, 0>{});
+        REQUIRE(empty.isEmpty());
+        REQUIRE_FALSE(empty.contains(0));
+        REQUIRE(empty.begin() == empty.end());
+
+        constexpr auto single = cpp_ex::makeStaticMap<std::string_view, int>({{"only", 1}});
+        REQUIRE(single.at("only") == 1);
+        REQUIRE_FALSE(single.contains("other"));
+    }
+}
@@ -131,6 +131,35 @@ TEST_CASE("String conversion methods", "[string]")
 
         REQUIRE(stdStr == "Hello, World!");
     }
+
+    SECTION("toStdString() copies from lvalues and moves from rvalues")
+    {
+        cpp_ex::String str("A string long enough to live on the heap");
+        std::string copy = str.toStdString();
+        REQUIRE(copy == str.getString());
+
+        const char *buffer = str.getCString();
+        std::string moved = std::move(str).toStdString();
+        REQUIRE(moved == copy);
+        REQUIRE(moved.data() == buffer);
+
+        cpp_ex::String other("Another string long enough to live on the heap");
+        buffer = other.getCString();
+        std::string converted = std::move(other);
+        REQUIRE(converted.data() == buffer);
+    }
+
+    SECTION("Move construction and assignment")
+    {
+        std::string source = "A string long enough to live on the heap";
+        const char *buffer = source.data();
+        cpp_ex::String str(std::move(source));
+        REQUIRE(str.getCString() == buffer);
+
+        cpp_ex::String target;
+        target = std::move(str);
+        REQUIRE(target.getCString() == buffer);
+    }
 }
 
 TEST_CASE("String basic methods", "[string]")
@@ -0,0 +1,133 @@
+// Include Catch2 headers
+#include <catch2/catch_test_macros.hpp>
+#include "../../src/libs/core/string.hpp"
+#include "../../src/libs/core/map.hpp"
+#include "../../src/libs/core/hash_map.hpp"
+#include "allocation_counter.hpp"
+#include <string>
+#include <string_view>
+
+using cpp_ex::test::allocations;
+
+namespace
+{
+    // Longer than the small string buffer: building a String from it allocates
+    constexpr const char *kLongKey = "a key that is much too long for the small string optimization";
+}
+
+TEST_CASE("Map<String> transparent lookup", "[transparent_lookup]")
+{
+    cpp_ex::Map<cpp_ex::String, int> map;
+    map[cpp_ex::String(kLongKey)] = 1;
+    map[cpp_ex::String("short")] = 2;
+    map[cpp_ex::String("zebra")] = 3;
+
+    const std::string stdKey = kLongKey;
+    const std::string_view viewKey = kLongKey;
+    const cpp_ex::String stringKey = kLongKey;
+
+    SECTION("The counter sees a temporary String")
+    {
+        auto before = allocations();
+        cpp_ex::String temporary(kLongKey);
+        REQUIRE(allocations() > before);
+    }
+
+    SECTION("Lookups with literals, std::string and std::string_view do not allocate")
+    {
+        auto before = allocations();
+        bool found = map.contains(kLongKey) && map.contains(stdKey) && map.contains(viewKey) &&
+                     map.contains(stringKey) && map.find(viewKey) != map.end() &&
+                     map.count("short") == 1 && map.at(std::string_view("zebra")) == 3 &&
+                     !map.contains("missing key that is also too long for the small buffer");
+        auto after = allocations();
+
+        REQUIRE(found);
+        REQUIRE(after == before);
+    }
+
+    SECTION("Ordered lookups compare as string views")
+    {
+        auto before = allocations();
+        auto lower = map.lowerBound("s");
+        auto upper = map.upperBound(std::string_view("short"));
+        auto range = map.equalRange(stdKey);
+        auto after = allocations();
+
+        REQUIRE(after == before);
+        REQUIRE(lower->first == "short");
+        REQUIRE(upper->first == "zebra");
+        REQUIRE(std::distance(range.first, range.second) == 1);
+    }
+
+    SECTION("erase() and at() with foreign key types")
+    {
+        REQUIRE(map.erase(viewKey) == 1);
+        REQUIRE(map.erase("missing") == 0);
+        REQUIRE(map.getSize() == 2);
+        REQUIRE_THROWS_AS(map.at("missing"), std::out_of_range);
+
+        // Iterator overloads are still selected for iterators
+        map.erase(map.begin());
+        REQUIRE(map.getKeys() == cpp_ex::Vector<cpp_ex::String>{"zebra"});
+    }
+}
+
+TEST_CASE("HashMap<String> transparent lookup", "[transparent_lookup]")
+{
+    cpp_ex::HashMap<cpp_ex::String, int> map;
+    map[cpp_ex::String(kLongKey)] = 1;
+    map[cpp_ex::String("short")] = 2;
+
+    const std::string stdKey = kLongKey;
+    const std::string_view viewKey = kLongKey;
+
+    SECTION("Hashes agree across key types")
+    {
+        std::hash<cpp_ex::String> hash;
+        REQUIRE(hash(cpp_ex::String(kLongKey)) == hash(viewKey));
+        REQUIRE(hash(stdKey) == hash(kLongKey));
+    }
+
+    SECTION("Lookups with literals, std::string and std::string_view do not allocate")
+    {
+        auto before = allocations();
+        bool found = map.contains(kLongKey) && map.contains(stdKey) && map.contains(viewKey) &&
+                     map.find(viewKey) != map.end() && map.count("short") == 1 &&
+                     map.at(std::string_view("short")) == 2 &&
+                     !map.contains("missing key that is also too long for the small buffer");
+        auto after = allocations();
+
+        REQUIRE(found);
+        REQUIRE(after == before);
+    }
+
+    SECTION("erase() and at() with foreign key types")
+    {
+        auto before = allocations();
+        auto erased = map.erase(stdKey);
+        auto after = allocations();
+
+        REQUIRE(erased == 1);
+        REQUIRE(after == before);
+        REQUIRE(map.erase("short") == 1);
+        REQUIRE(map.isEmpty());
+        REQUIRE_THROWS_AS(map.at(viewKey), std::out_of_range);
+    }
+}
+
+TEST_CASE("Non-transparent maps keep the key_type overloads", "[transparent_lookup]")
+{
+    // std::less<std::string> is not transparent: the literal is converted to a key
+    cpp_ex::Map<std::string, int> map = {{"one", 1}};
+    REQUIRE(map.contains("one"));
+    REQUIRE(map.erase("one") == 1);
+
+    // std::less<> is transparent and works with the standard string types
+    cpp_ex::Map<std::string, int, std::less<>> transparent = {{kLongKey, 1}};
+    auto before = allocations();
+    bool found = transparent.contains(std::string_view(kLongKey));
+    auto after = allocations();
+    REQUIRE(found);
+    REQUIRE(after == before);
+}
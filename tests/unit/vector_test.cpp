@@ -194,6 +194,26 @@ TEST_CASE("Vector conversion methods", "[vector]")
             REQUIRE(stdVec[i] == static_cast<int>(i + 1));
         }
     }
+
+    SECTION("toStdVector() copies from lvalues and moves from rvalues")
+    {
+        cpp_ex::Vector<int> vec = {1, 2, 3};
+        std::vector<int> copy = vec.toStdVector();
+        REQUIRE(copy == std::vector<int>{1, 2, 3});
+        REQUIRE(vec.getSize() == 3);
+
+        const int *buffer = vec.getData();
+        std::vector<int> moved = std::move(vec).toStdVector();
+        REQUIRE(moved.data() == buffer);
+
+        cpp_ex::Vector<int> other = {4, 5};
+        buffer = other.getData();
+        std::vector<int> converted = std::move(other);
+        REQUIRE(converted.data() == buffer);
+
+        cpp_ex::Vector<int> back(std::move(converted));
+        REQUIRE(back.getData() == buffer);
+    }
 }
 
 TEST_CASE("Vector element access methods", "[vector]")